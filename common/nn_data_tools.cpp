@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring>
 #include <nmmintrin.h>
 #include <algorithm>
+#include <cmath>
 #include <chrono>
 #include <memory>
 
@@ -643,6 +644,29 @@ void nn_data_convert_float_to_int32_fixedpoint(nn::data<float> *in,
         outbuffer[i] =  static_cast<int32_t>(inbuffer[i] * scale);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void nn_data_convert_float_to_int8_per_output(nn::data<float> *in,
+                                              nn::data<int8_t> *out,
+                                              nn::data<float> *scales){
+    const size_t num_output = in->size[in->dimension - 1];
+    const size_t per_output = in->count() / num_output;
+    auto inbuffer = static_cast<float *>(in->buffer);
+    auto outbuffer = static_cast<int8_t *>(out->buffer);
+    auto scalebuffer = static_cast<float *>(scales->buffer);
+
+    for (size_t o = 0; o < num_output; ++o) {
+        float max_abs = 0.0f;
+        for (size_t i = 0; i < per_output; ++i)
+            max_abs = std::max(max_abs, std::fabs(inbuffer[o * per_output + i]));
+
+        // 7 bit range keeps pairwise u8 x s8 sums of vpmaddubsw within int16
+        const float scale = max_abs > 0.0f ? 64.0f / max_abs : 1.0f;
+        scalebuffer[o] = scale;
+        for (size_t i = 0; i < per_output; ++i)
+            outbuffer[o * per_output + i] = static_cast<int8_t>(std::lround(inbuffer[o * per_output + i] * scale));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 nn::data<float, 4>*  nn_data_load_from_image_list_for_int16(    // Load of all data from a batch of image files
     std::vector<std::string>*  filelist,                                 // Pointer to vector contained a batch of filenames of images
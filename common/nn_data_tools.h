@@ -114,6 +114,12 @@ void nn_data_convert_float_to_int32_fixedpoint(nn::data<float> *in,
                                                nn::data<int32_t> *out,
                                                float scale);
 
+/* quantizes float weights (last dimension indexes output maps) to int8 in [-64, 64] range,
+   scale of each output map (int8 value = weight * scale) is written to 'scales' */
+void nn_data_convert_float_to_int8_per_output(nn::data<float> *in,
+                                              nn::data<int8_t> *out,
+                                              nn::data<float> *scales);
+
 nn::data<float, 4> *nn_data_load_from_image_list_for_int16(std::vector<std::string> *filelist,
                                                            uint32_t std_size,
                                                            uint32_t batching_size);
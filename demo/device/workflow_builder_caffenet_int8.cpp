@@ -0,0 +1,855 @@
+/*
+Copyright (c) 2014, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of Intel Corporation nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "workflow_builder.h"
+#include "common/nn_data_tools.h"
+
+#include <cmath>
+
+static NN_WORKLOAD_DATA_TYPE in_formats[] =
+        { NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH };
+
+static NN_WORKLOAD_DATA_TYPE out_formats[] =
+        { NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH };
+
+enum  workflow_layers {
+    input,
+    mean_substract,
+    convert,
+    conv1,
+    pool1,
+    norm1,
+    subv1_1,
+    subv1_2,
+    conv2_1,
+    conv2_2,
+    merge2,
+    pool2,
+    norm2,
+    conv3,
+    subv3_1,
+    subv3_2,
+    conv4_1,
+    conv4_2,
+    conv5_1,
+    conv5_2,
+    merge5,
+    pool5,
+    fc6,
+    fc7,
+    fc8,
+    softmax,
+    output,
+    last_workflow_item = output
+};
+
+enum  workflow_layer_factor {
+    conv1_factor,
+    conv2_1_factor,
+    conv2_2_factor,
+    conv3_factor,
+    conv4_1_factor,
+    conv4_2_factor,
+    conv5_1_factor,
+    conv5_2_factor,
+    fc6_factor,
+    fc7_factor,
+    fc8_factor,
+    last_factor = fc8_factor
+};
+
+
+
+class workflow_builder_caffenet_int8 : public workflow_builder_base
+{
+
+public:
+
+    workflow_builder_caffenet_int8() : workflow_builder_base(227) {
+        RGB_order = false;
+        image_process = fi::resize_image_to_square;
+
+        for(auto wl : workflow_layer) wl = nullptr;
+        for(auto wlwf : workflow_layer_weights_float) wlwf = nullptr;
+        for(auto wlbf : workflow_layer_weights_float) wlbf = nullptr;
+        for(auto wlwi : workflow_layer_weights_int8) wlwi = nullptr;
+        for(auto wlsc : workflow_layer_weights_scale) wlsc = nullptr;
+        try {
+            read_file_to_vector(labels, "weights_caffenet/names.txt", false);
+            read_file_to_vector(wwids, "weights_caffenet/wwids.txt", false);
+        }
+        catch(std::runtime_error &e) {
+            error_ = e.what();
+        }
+    }
+
+    bool is_valid() { return error_.empty(); }
+
+    virtual NN_WORKLOAD_DATA_TYPE* get_input_formats() {return in_formats;}
+    virtual NN_WORKLOAD_DATA_TYPE* get_output_formats() {return out_formats;}
+
+private:
+    std::string error_;
+
+        // pointers to successive workflow parts
+    nn_workflow_item_t        *workflow_layer[last_workflow_item+1];
+
+    // pointers to nn_datas containing weights and biases;
+    nn::data<float>           *workflow_layer_weights_float[last_factor+1];
+    nn::data<float>           *workflow_layer_biases_float[last_factor+1];
+    nn::data<int8_t>          *workflow_layer_weights_int8[last_factor+1];
+    nn::data<float>           *workflow_layer_weights_scale[last_factor+1];
+    nn::data<float>           *mean_factor = nullptr;
+
+    nn_workflow_t           *workflow = nullptr;
+    nn_device_interface_0_t *di = nullptr;
+
+public:
+
+#ifdef DEBUG_CHECK
+    /*
+     *  This function prints maximum and minimum values from biases/weights buffer.
+     */
+    void printDebugMaxMin(nn::data<float> *data, const char *name){
+        float max = -1000, min = 1000;
+        size_t count = data->count();
+        for (int i = 0; i < count; ++i)
+        {
+            float value = ((float *)data->buffer)[i];
+            if (max < value)
+                max = value;
+            if (min > value)
+                min = value;
+        }
+
+        printf("%s max: %f\n", name, max);
+        printf("%s min: %f\n", name, min);
+    }
+#endif
+
+    void cleanup(){
+
+        if(!is_valid()) throw std::runtime_error(error_);
+
+        /* ****************************************************************************************** */
+        /* Cleanup in memory                                                                          */
+        /* ****************************************************************************************** */
+        std::cout
+            << "Cleanup in memory"
+            << std::endl
+            << "========================================================"
+            << std::endl;
+
+
+        if(!is_valid()) throw std::runtime_error(error_);
+
+        for(auto wl : workflow_layer)
+                di->workflow_item_delete_function(wl);
+
+        di->workflow_delete_function(workflow);
+
+        for(auto wlwf : workflow_layer_weights_float)
+            if(wlwf!=nullptr) delete wlwf;
+
+        for(auto wlwi : workflow_layer_weights_int8)
+            if(wlwi!=nullptr) delete wlwi;
+
+        for(auto wlsc : workflow_layer_weights_scale)
+            if(wlsc!=nullptr) delete wlsc;
+
+        for(auto wlbf : workflow_layer_biases_float)
+            if(wlbf!=nullptr) delete wlbf;
+
+        if(mean_factor!=nullptr) delete mean_factor;
+    }
+
+
+    virtual nn_workflow_t *init_workflow(nn_device_interface_0_t *_di){
+
+        if(!is_valid()) throw std::runtime_error(error_);
+
+        this->di = _di;
+
+        std::cout
+            << "--------------------------------------------------------"
+            << std::endl
+            << "Loading weights and biases"
+            << std::endl << std::endl;
+
+        // Load weights and biases
+        auto load_biases_or_weights = [](std::string wb_file_name) {
+            nn::data<float> *wb_pointer = nn_data_load_from_file_time_measure(wb_file_name);
+            if (wb_pointer == nullptr) {
+                std::cerr << "Can't load " << wb_file_name << std::endl;
+                throw;
+            }
+            return wb_pointer;
+        };
+
+        try {
+            mean_factor                                     = load_biases_or_weights("weights_caffenet/imagenet_mean.nnd");
+            workflow_layer_weights_float[conv1_factor]      = load_biases_or_weights("weights_caffenet/conv1_weights.nnd");
+            workflow_layer_biases_float[conv1_factor]       = load_biases_or_weights("weights_caffenet/conv1_biases.nnd");
+            workflow_layer_weights_float[conv2_1_factor]    = load_biases_or_weights("weights_caffenet/conv2_g1_weights.nnd");
+            workflow_layer_biases_float[conv2_1_factor]     = load_biases_or_weights("weights_caffenet/conv2_g1_biases.nnd");
+            workflow_layer_weights_float[conv2_2_factor]    = load_biases_or_weights("weights_caffenet/conv2_g2_weights.nnd");
+            workflow_layer_biases_float[conv2_2_factor]     = load_biases_or_weights("weights_caffenet/conv2_g2_biases.nnd");
+            workflow_layer_weights_float[conv3_factor]      = load_biases_or_weights("weights_caffenet/conv3_weights.nnd");
+            workflow_layer_biases_float[conv3_factor]       = load_biases_or_weights("weights_caffenet/conv3_biases.nnd");
+            workflow_layer_weights_float[conv4_1_factor]    = load_biases_or_weights("weights_caffenet/conv4_g1_weights.nnd");
+            workflow_layer_biases_float[conv4_1_factor]     = load_biases_or_weights("weights_caffenet/conv4_g1_biases.nnd");
+            workflow_layer_weights_float[conv4_2_factor]    = load_biases_or_weights("weights_caffenet/conv4_g2_weights.nnd");
+            workflow_layer_biases_float[conv4_2_factor]     = load_biases_or_weights("weights_caffenet/conv4_g2_biases.nnd");
+            workflow_layer_weights_float[conv5_1_factor]    = load_biases_or_weights("weights_caffenet/conv5_g1_weights.nnd");
+            workflow_layer_biases_float[conv5_1_factor]     = load_biases_or_weights("weights_caffenet/conv5_g1_biases.nnd");
+            workflow_layer_weights_float[conv5_2_factor]    = load_biases_or_weights("weights_caffenet/conv5_g2_weights.nnd");
+            workflow_layer_biases_float[conv5_2_factor]     = load_biases_or_weights("weights_caffenet/conv5_g2_biases.nnd");
+            workflow_layer_weights_float[fc6_factor]        = load_biases_or_weights("weights_caffenet/fc6_weights.nnd");
+            workflow_layer_biases_float[fc6_factor]         = load_biases_or_weights("weights_caffenet/fc6_biases.nnd");
+            workflow_layer_weights_float[fc7_factor]        = load_biases_or_weights("weights_caffenet/fc7_weights.nnd");
+            workflow_layer_biases_float[fc7_factor]         = load_biases_or_weights("weights_caffenet/fc7_biases.nnd");
+            workflow_layer_weights_float[fc8_factor]        = load_biases_or_weights("weights_caffenet/fc8_weights.nnd");
+            workflow_layer_biases_float[fc8_factor]         = load_biases_or_weights("weights_caffenet/fc8_biases.nnd");
+        }
+        catch (...) {
+            return workflow;
+        }
+        di->workflow_create_function(&workflow,1,1);
+
+        // Activations are uint8 with real value = q / scale. Scales follow int16 fixed point fractions of caffenet_int16
+        // (2^fraction, 7 bits less since uint8 keeps top 8 bits of 16 bit range).
+        //                                                            { c1    c2_1  c2_2  c3    c4_1  c4_2  c5_1  c5_2  fc6   fc7   fc8   }
+        const int    nnwrkld_output_fraction[last_factor+1]         = { 3,    7,    7,    6,    7,    7,    8,    8,    10,   12,   26    };
+        float nnwrkld_output_scale[last_factor+1];
+        for(auto i = 0; i<=last_factor;++i)
+            nnwrkld_output_scale[i] = std::ldexp(1.0f, nnwrkld_output_fraction[i] - 7);
+
+        // mean subtracted image lies in (-170, 170), it is stored with zero point in the middle of uint8 range
+        const float    input_scale = 0.75f;
+        const uint8_t  input_zero_point = 128;
+
+        for(auto i = 0; i<=last_factor;++i) {
+            auto num_output = workflow_layer_weights_float[i]->size[workflow_layer_weights_float[i]->dimension - 1];
+            workflow_layer_weights_int8[i] = new nn::data<int8_t>(static_cast<const size_t*>(workflow_layer_weights_float[i]->size),workflow_layer_weights_float[i]->dimension);
+            workflow_layer_weights_scale[i] = new nn::data<float>(num_output);
+            nn_data_convert_float_to_int8_per_output(workflow_layer_weights_float[i],workflow_layer_weights_int8[i],workflow_layer_weights_scale[i]);
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 0 (input)
+        //         output: 227x227x3
+        {
+            di->workflow_item_create_function(&workflow_layer[input],0,nullptr,1);
+
+            workflow_layer[input]->type = NN_WORK_ITEM_TYPE_INPUT;
+            workflow_layer[input]->arguments.input.index = 0;
+            workflow_layer[input]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[input]->output_format[0].format_3d ={{img_size,img_size,3}};
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 0 (imagenet_mean_subtract)
+        //         output: 227x227x3
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor ={workflow_layer[input],0};
+            di->workflow_item_create_function(&workflow_layer[mean_substract],1,&inputs_descriptor,1);
+
+            workflow_layer[mean_substract]->type = NN_WORK_ITEM_TYPE_ARITHMETIC;
+            workflow_layer[mean_substract]->arguments.forward_arithmetic.factor = mean_factor;
+            workflow_layer[mean_substract]->arguments.forward_arithmetic.arithmetic_function = NN_ARITHMETIC_FUNCTION_SUBTRACTION;
+
+            workflow_layer[mean_substract]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[mean_substract]->output_format[0].format_3d ={{img_size,img_size,3}};
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 0 Convert float to uint8
+        //
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[mean_substract], 0 };
+            di->workflow_item_create_function(&workflow_layer[convert], 1, &inputs_descriptor, 1);
+
+            workflow_layer[convert]->type = NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8;
+            workflow_layer[convert]->arguments.forward_convert_float_to_uint8.output_scale = input_scale;
+            workflow_layer[convert]->arguments.forward_convert_float_to_uint8.output_zero_point = input_zero_point;
+
+            workflow_layer[convert]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[convert]->output_format[0].format_3d = nn_output_format_3d{ { img_size, img_size, 4 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 01
+        //           convo: 11x11 stride 4x4; ReLU; output: 55x55x96
+        //         maxpool: 3x3 stride 2x2;
+        //            norm: RESPONSE_ACROSS_MAPS
+        //          output: 27x27x96
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[convert], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv1], 1, &inputs_descriptor, 1);
+
+            workflow_layer[conv1]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv1]->name = "c1";
+
+            workflow_layer[conv1]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+            workflow_layer[conv1]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+
+            workflow_layer[conv1]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv1_factor];
+            workflow_layer[conv1]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv1_factor];
+
+            workflow_layer[conv1]->arguments.forward_convolution_int8.center_offset[0] = 0;
+            workflow_layer[conv1]->arguments.forward_convolution_int8.center_offset[1] = 0;
+
+            workflow_layer[conv1]->arguments.forward_convolution_int8.stride[0] = 4;
+            workflow_layer[conv1]->arguments.forward_convolution_int8.stride[1] = 4;
+
+            workflow_layer[conv1]->arguments.forward_convolution_int8.quantization.input_scale = input_scale;
+            workflow_layer[conv1]->arguments.forward_convolution_int8.quantization.input_zero_point = input_zero_point;
+            workflow_layer[conv1]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv1_factor];
+            workflow_layer[conv1]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv1_factor];
+
+            workflow_layer[conv1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv1]->output_format[0].format_3d = { { 55, 55, 96 } };
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[conv1], 0 };
+            di->workflow_item_create_function(&workflow_layer[pool1], 1, &inputs_descriptor, 1);
+
+            workflow_layer[pool1]->type = NN_WORK_ITEM_TYPE_MAX_POOLING_INT8;
+            workflow_layer[pool1]->name = "p1";
+
+            workflow_layer[pool1]->arguments.forward_pooling_fixedpoint.mode = NN_POOLING_MODE_MAX;
+            workflow_layer[pool1]->arguments.forward_pooling_fixedpoint.pool_size[0] = 3;
+            workflow_layer[pool1]->arguments.forward_pooling_fixedpoint.pool_size[1] = 3;
+            workflow_layer[pool1]->arguments.forward_pooling_fixedpoint.pool_stride[0] = 2;
+            workflow_layer[pool1]->arguments.forward_pooling_fixedpoint.pool_stride[1] = 2;
+
+            workflow_layer[pool1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[pool1]->output_format[0].format_3d = { { 27, 27, 96 } };
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[pool1], 0 };
+            di->workflow_item_create_function(&workflow_layer[norm1], 1, &inputs_descriptor, 1);
+
+            workflow_layer[norm1]->type = NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8;
+            workflow_layer[norm1]->name = "lrn1";
+
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.k = 1;
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.n = 5;
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.alpha = 0.00002f;
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.beta = 0.75f;
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.input_scale = nnwrkld_output_scale[conv1_factor];
+            workflow_layer[norm1]->arguments.normalization_response_across_maps_int8.output_scale = nnwrkld_output_scale[conv1_factor];
+
+            workflow_layer[norm1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[norm1]->output_format[0].format_3d = { { 27, 27, 96 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 02
+        //           split: 2 (z-axis 96/2); output 27x27x(2*96/2)
+        //           convo: 5x5 stride 1x1; ReLU; 0-padded output: 27x27x(2*256/2)
+        //           merge: (z-axis)
+        //         maxpool: 3x3 stride 2x2;
+        //            norm: RESPONSE_ACROSS_MAPS
+        //          output: 13x13x256
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[norm1], 0 };
+            di->workflow_item_create_function(&workflow_layer[subv1_1], 1, &inputs_descriptor, 1); // view g1
+
+            workflow_layer[subv1_1]->type = NN_WORK_ITEM_TYPE_VIEW;
+            workflow_layer[subv1_1]->arguments.view.origin[0] = 0;
+            workflow_layer[subv1_1]->arguments.view.origin[1] = 0;
+            workflow_layer[subv1_1]->arguments.view.origin[2] = 0;
+
+            workflow_layer[subv1_1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[subv1_1]->output_format[0].format_3d = { { 27, 27, 96 / 2 } };
+
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[norm1], 0 };
+            di->workflow_item_create_function(&workflow_layer[subv1_2], 1, &inputs_descriptor, 1);   // view g2
+
+            workflow_layer[subv1_2]->type = NN_WORK_ITEM_TYPE_VIEW;
+            workflow_layer[subv1_2]->arguments.view.origin[0] = 0;
+            workflow_layer[subv1_2]->arguments.view.origin[1] = 0;
+            workflow_layer[subv1_2]->arguments.view.origin[2] = (96 / 2);
+
+            workflow_layer[subv1_2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[subv1_2]->output_format[0].format_3d = { { 27, 27, 96 / 2 } };
+        }
+
+        // convolution 2, g1: 5x5 stride 1x1; ReLU; 0-padded output: 13x13x(2*96/2)
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[subv1_1], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv2_1], 1, &inputs_descriptor, 1);
+
+            workflow_layer[conv2_1]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv2_1]->name = "c2g1";
+
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv2_1_factor];
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv2_1_factor];
+
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.center_offset[0] = 2;
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.center_offset[1] = 2;
+
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv1_factor];
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv2_1_factor];
+            workflow_layer[conv2_1]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv2_1_factor];
+
+            workflow_layer[conv2_1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv2_1]->output_format[0].format_3d = { { 27, 27, 256 / 2 } };
+        }
+
+        // convolution 2, g2: 5x5 stride 1x1; ReLU; 0-padded output: 13x13x(2*96/2)
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[subv1_2], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv2_2], 1, &inputs_descriptor, 1);
+
+            workflow_layer[conv2_2]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv2_2]->name = "c2g2";
+
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv2_2_factor];
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv2_2_factor];
+
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.center_offset[0] = 2;
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.center_offset[1] = 2;
+
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv1_factor];
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv2_2_factor];
+            workflow_layer[conv2_2]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv2_2_factor];
+
+            workflow_layer[conv2_2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv2_2]->output_format[0].format_3d = { { 27, 27, 256 / 2 } };
+        }
+
+        // merge g1 and g2
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor[] = { { workflow_layer[conv2_1], 0 }, { workflow_layer[conv2_2], 0 } };
+            di->workflow_item_create_function(&workflow_layer[merge2], 2, inputs_descriptor, 1);
+
+            workflow_layer[merge2]->type = NN_WORK_ITEM_TYPE_MERGE;
+            workflow_layer[merge2]->arguments.forward_merge.axis = 2; // value 2 for z-axis
+
+            workflow_layer[merge2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[merge2]->output_format[0].format_3d = { { 27, 27, 256 } };
+        }
+
+        // maxpool: 3x3 stride 2x2;
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[merge2], 0 };
+            di->workflow_item_create_function(&workflow_layer[pool2], 1, &inputs_descriptor, 1); // pooling
+
+            workflow_layer[pool2]->type = NN_WORK_ITEM_TYPE_MAX_POOLING_INT8;
+            workflow_layer[pool2]->name = "p2";
+
+            workflow_layer[pool2]->arguments.forward_pooling_fixedpoint.mode = NN_POOLING_MODE_MAX;
+            workflow_layer[pool2]->arguments.forward_pooling_fixedpoint.pool_size[0] = 3;
+            workflow_layer[pool2]->arguments.forward_pooling_fixedpoint.pool_size[1] = 3;
+
+            workflow_layer[pool2]->arguments.forward_pooling_fixedpoint.pool_stride[0] = 2;
+            workflow_layer[pool2]->arguments.forward_pooling_fixedpoint.pool_stride[1] = 2;
+
+            workflow_layer[pool2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[pool2]->output_format[0].format_3d = { { 13, 13, 256 } };
+        }
+
+        //norm: RESPONSE_ACROSS_MAPS; output: 13x13x256
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[pool2], 0 };
+            di->workflow_item_create_function(&workflow_layer[norm2], 1, &inputs_descriptor, 1);
+
+            workflow_layer[norm2]->type = NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8;
+            workflow_layer[norm2]->name = "lrn2";
+
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.k = 1;
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.n = 5;
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.alpha = 0.00002f;
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.beta = 0.75f;
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.input_scale = nnwrkld_output_scale[conv2_2_factor];
+            workflow_layer[norm2]->arguments.normalization_response_across_maps_int8.output_scale = nnwrkld_output_scale[conv2_2_factor];
+
+            workflow_layer[norm2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[norm2]->output_format[0].format_3d = { { 13, 13, 256 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 03
+        //           convo: 3x3 stride 1x1; ReLU; 0-padded
+        //          output: 13x13x384
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[norm2], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv3], 1, &inputs_descriptor, 1);
+
+            workflow_layer[conv3]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv3]->name = "c3";
+
+            workflow_layer[conv3]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv3]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv3]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv3_factor];
+            workflow_layer[conv3]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv3_factor];
+
+            workflow_layer[conv3]->arguments.forward_convolution_int8.center_offset[0] = 1;
+            workflow_layer[conv3]->arguments.forward_convolution_int8.center_offset[1] = 1;
+
+            workflow_layer[conv3]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv3]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv3]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv2_2_factor];
+            workflow_layer[conv3]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv3]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv3_factor];
+            workflow_layer[conv3]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv3_factor];
+
+            workflow_layer[conv3]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv3]->output_format[0].format_3d = { { 13, 13, 384 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 04
+        //           split: 2 (z-axis 384/2)
+        //           convo: 3x3 stride 1x1; ReLU; 0-padded
+        //          output: 13x13x(2*384/2) (continue split to next stage)
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[conv3], 0 };
+            di->workflow_item_create_function(&workflow_layer[subv3_1], 1, &inputs_descriptor, 1); // view g1
+
+            workflow_layer[subv3_1]->type = NN_WORK_ITEM_TYPE_VIEW;
+            workflow_layer[subv3_1]->arguments.view.origin[0] = 0;
+            workflow_layer[subv3_1]->arguments.view.origin[1] = 0;
+            workflow_layer[subv3_1]->arguments.view.origin[2] = 0;
+
+            workflow_layer[subv3_1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[subv3_1]->output_format[0].format_3d = { { 13, 13, 384 / 2 } };
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[conv3], 0 };
+            di->workflow_item_create_function(&workflow_layer[subv3_2], 1, &inputs_descriptor, 1); // view g2
+
+            workflow_layer[subv3_2]->type = NN_WORK_ITEM_TYPE_VIEW;
+            workflow_layer[subv3_2]->arguments.view.origin[0] = 0;
+            workflow_layer[subv3_2]->arguments.view.origin[1] = 0;
+            workflow_layer[subv3_2]->arguments.view.origin[2] = 384 / 2;
+
+            workflow_layer[subv3_2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[subv3_2]->output_format[0].format_3d = { { 13, 13, 384 / 2 } };
+
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[subv3_1], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv4_1], 1, &inputs_descriptor, 1); // conv g1
+
+            workflow_layer[conv4_1]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv4_1]->name = "c4g1";
+
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv4_1_factor];
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv4_1_factor];
+
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.center_offset[0] = 1;
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.center_offset[1] = 1;
+
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv3_factor];
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv4_1_factor];
+            workflow_layer[conv4_1]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv4_1_factor];
+
+            workflow_layer[conv4_1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv4_1]->output_format[0].format_3d = { { 13, 13, 384 / 2 } };
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[subv3_2], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv4_2], 1, &inputs_descriptor, 1); // conv g2
+
+            workflow_layer[conv4_2]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv4_2]->name = "c4g2";
+
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv4_2_factor];
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv4_2_factor];
+
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.center_offset[0] = 1;
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.center_offset[1] = 1;
+
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv3_factor];
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv4_2_factor];
+            workflow_layer[conv4_2]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv4_2_factor];
+
+            workflow_layer[conv4_2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv4_2]->output_format[0].format_3d = { { 13, 13, 384 / 2 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 05
+        //           convo: 3x3 stride 1x1; ReLU; 0-padded; output: 13x13x(2*256/2)
+        //           merge: (z-axis)
+        //         maxpool: 3x3 stride 2x2;
+        //          output: 13x13x256
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[conv4_1], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv5_1], 1, &inputs_descriptor, 1); // conv g1
+
+            workflow_layer[conv5_1]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv5_1]->name = "c5g1";
+
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv5_1_factor];
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv5_1_factor];
+
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.center_offset[0] = 1;
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.center_offset[1] = 1;
+
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv4_1_factor];
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv5_1_factor];
+            workflow_layer[conv5_1]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv5_1_factor];
+
+            workflow_layer[conv5_1]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv5_1]->output_format[0].format_3d = { { 13, 13, 256 / 2 } };
+        }
+
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[conv4_2], 0 };
+            di->workflow_item_create_function(&workflow_layer[conv5_2], 1, &inputs_descriptor, 1); // conv g2
+
+            workflow_layer[conv5_2]->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+            workflow_layer[conv5_2]->name = "c5g2";
+
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.weights = workflow_layer_weights_int8[conv5_2_factor];
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.biases = workflow_layer_biases_float[conv5_2_factor];
+
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.center_offset[0] = 1;
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.center_offset[1] = 1;
+
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.stride[0] = 1;
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.stride[1] = 1;
+
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.quantization.input_scale = nnwrkld_output_scale[conv4_2_factor];
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.quantization.input_zero_point = 0;
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.quantization.output_scale = nnwrkld_output_scale[conv5_2_factor];
+            workflow_layer[conv5_2]->arguments.forward_convolution_int8.quantization.weights_scale = workflow_layer_weights_scale[conv5_2_factor];
+
+            workflow_layer[conv5_2]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[conv5_2]->output_format[0].format_3d = { { 13, 13, 256 / 2 } };
+        }
+
+        // merge g1 and g2
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor[] = {{workflow_layer[conv5_1],0},{workflow_layer[conv5_2],0}};
+            di->workflow_item_create_function(&workflow_layer[merge5], 2, inputs_descriptor, 1);
+
+            workflow_layer[merge5]->type = NN_WORK_ITEM_TYPE_MERGE;
+            workflow_layer[merge5]->arguments.forward_merge.axis = 2; // value 2 for z-axis
+
+            workflow_layer[merge5]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[merge5]->output_format[0].format_3d = { { 13, 13, 256 } };
+        }
+
+        // maxpool: 3x3 stride 2x2;
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[merge5], 0 };
+            di->workflow_item_create_function(&workflow_layer[pool5], 1, &inputs_descriptor, 1); // pooling
+
+            workflow_layer[pool5]->type = NN_WORK_ITEM_TYPE_MAX_POOLING_INT8;
+            workflow_layer[pool5]->name = "p5";
+
+            workflow_layer[pool5]->arguments.forward_pooling_fixedpoint.mode = NN_POOLING_MODE_MAX;
+            workflow_layer[pool5]->arguments.forward_pooling_fixedpoint.pool_size[0] = 3;
+            workflow_layer[pool5]->arguments.forward_pooling_fixedpoint.pool_size[1] = 3;
+
+            workflow_layer[pool5]->arguments.forward_pooling_fixedpoint.pool_stride[0] = 2;
+            workflow_layer[pool5]->arguments.forward_pooling_fixedpoint.pool_stride[1] = 2;
+
+            workflow_layer[pool5]->output_format[0].format = NN_DATA_FORMAT_3D;
+            workflow_layer[pool5]->output_format[0].format_3d = { { 6, 6, 256 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 06
+        //            full: ReLU
+        //          output: 4096
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[pool5], 0 };
+            di->workflow_item_create_function(&workflow_layer[fc6], 1, &inputs_descriptor, 1);
+
+            workflow_layer[fc6]->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8;
+            workflow_layer[fc6]->name = "fc6";
+
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.weights = workflow_layer_weights_int8[fc6_factor];
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.biases = workflow_layer_biases_float[fc6_factor];
+
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.quantization.input_scale = nnwrkld_output_scale[conv5_2_factor];
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.quantization.input_zero_point = 0;
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.quantization.output_scale = nnwrkld_output_scale[fc6_factor];
+            workflow_layer[fc6]->arguments.forward_fully_connected_int8.quantization.weights_scale = workflow_layer_weights_scale[fc6_factor];
+
+            workflow_layer[fc6]->output_format[0].format = NN_DATA_FORMAT_1D;
+            workflow_layer[fc6]->output_format[0].format_1d = { { 4096 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 07
+        //            full: ReLU
+        //          output: 4096
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[fc6], 0 };
+            di->workflow_item_create_function(&workflow_layer[fc7], 1, &inputs_descriptor, 1);
+
+            workflow_layer[fc7]->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8;
+            workflow_layer[fc7]->name = "fc7";
+
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.weights = workflow_layer_weights_int8[fc7_factor];
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.biases = workflow_layer_biases_float[fc7_factor];
+
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.quantization.input_scale = nnwrkld_output_scale[fc6_factor];
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.quantization.input_zero_point = 0;
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.quantization.output_scale = nnwrkld_output_scale[fc7_factor];
+            workflow_layer[fc7]->arguments.forward_fully_connected_int8.quantization.weights_scale = workflow_layer_weights_scale[fc7_factor];
+
+            workflow_layer[fc7]->output_format[0].format = NN_DATA_FORMAT_1D;
+            workflow_layer[fc7]->output_format[0].format_1d = { { 4096 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 08
+        //            full: float output;
+        //          output: 1000
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[fc7], 0 };
+            di->workflow_item_create_function(&workflow_layer[fc8], 1, &inputs_descriptor, 1);
+
+            workflow_layer[fc8]->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32;
+            workflow_layer[fc8]->name = "fc8";
+
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.weights = workflow_layer_weights_int8[fc8_factor];
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.biases = workflow_layer_biases_float[fc8_factor];
+
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.quantization.input_scale = nnwrkld_output_scale[fc7_factor];
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.quantization.input_zero_point = 0;
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.quantization.output_scale = 1.0f;   // float output is dequantized
+            workflow_layer[fc8]->arguments.forward_fully_connected_int8.quantization.weights_scale = workflow_layer_weights_scale[fc8_factor];
+
+            workflow_layer[fc8]->output_format[0].format = NN_DATA_FORMAT_1D;
+            workflow_layer[fc8]->output_format[0].format_1d = { { 1000 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 09 (softmax)
+        //          output: 1000
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[fc8], 0 };
+            di->workflow_item_create_function(&workflow_layer[softmax], 1, &inputs_descriptor, 1);
+
+            workflow_layer[softmax]->type = NN_WORK_ITEM_TYPE_SOFTMAX;
+
+            workflow_layer[softmax]->output_format[0].format = NN_DATA_FORMAT_1D;
+            workflow_layer[softmax]->output_format[0].format_1d = { { 1000 } };
+        }
+
+        // ------------------------------------------------------------------------------------------
+        // STAGE 10 (output)
+        //          output: 1000
+        {
+            nn_workflow_use_descriptor_t inputs_descriptor = { workflow_layer[softmax], 0 };
+            di->workflow_item_create_function(&workflow_layer[output], 1, &inputs_descriptor, 1);
+
+            workflow_layer[output]->type = NN_WORK_ITEM_TYPE_OUTPUT;
+
+            workflow_layer[output]->output_format[0].format = NN_DATA_FORMAT_1D;
+            workflow_layer[output]->output_format[0].format_1d = { { 1000 } };
+        }
+
+        // -------------------------------------------------------------------------------------------
+        // END of workflow stages definition
+        // -------------------------------------------------------------------------------------------
+        workflow->input[0] = workflow_layer[input];
+        workflow->output[0] = workflow_layer[output];
+        // -------------------------------------------------------------------------------------------
+
+        return workflow;
+    }
+};
+
+// Code below creates 'attach_' object in anonymous namespace at global scope.
+// This ensures, that object itself is not visible to other compilation units
+// and it's constructor is ran befor main execution starts.
+// The sole function of this construction is attaching this workflow builder to
+// library of workflow builders (singleton command pattern).
+namespace {
+    struct attach {
+        workflow_builder_caffenet_int8 builder;
+        attach() {
+            workflow_builder::instance().add("caffenet_int8", &builder);
+        }
+    };
+
+    attach attach_;
+}
\ No newline at end of file
@@ -426,6 +426,11 @@ class primitives_workload_caffenet_float : public primitives_workload_base {
                 load_weights_and_biases(
                     device, primitives, elem.name, elem.weights_file, elem.bias_file,
                     parameters_ready_events, temporary_data);
+
+            // parameters are copied asynchronously, they must be ready before first execution
+            primitives.wait(parameters_ready_events.size(), parameters_ready_events.data());
+            for (auto event : parameters_ready_events)
+                primitives.delete_event(event);
         }
 
         //outputs
@@ -511,11 +516,16 @@ class primitives_workload_caffenet_float : public primitives_workload_base {
                     nullptr);
                 next_prev_events.push_back(event);
             }
+            for (auto event : prev_events)
+                primitives.delete_event(event);
             prev_events.swap(next_prev_events);
         }
-        layers.events["output_ready"] =
-            primitives.copy_from_opaque_async(device, &output, layers.outputs["SF"], 1, &layers.events["SF"], nullptr);
-        primitives.wait(1, &layers.events["output_ready"]);
+        auto output_ready =
+            primitives.copy_from_opaque_async(device, &output, layers.outputs["SF"], prev_events.size(), prev_events.data(), nullptr);
+        primitives.wait(1, &output_ready);
+        primitives.delete_event(output_ready);
+        for (auto event : prev_events)
+            primitives.delete_event(event);
     }
 
     void cleanup() override
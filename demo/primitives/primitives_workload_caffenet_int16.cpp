@@ -673,6 +673,11 @@ class primitives_workload_caffenet_int16 : public primitives_workload_base {
 
         //primitives.create_inputs(layers.sf, 1, &layers.inputs["SF"], 0, nullptr);
         primitives.create_outputs(layers.sf, 1, &layers.outputs["SF"], 0, nullptr);
+
+        // parameters are copied asynchronously, they must be ready before first execution
+        primitives.wait(parameters_ready_events.size(), parameters_ready_events.data());
+        for (auto event : parameters_ready_events)
+            primitives.delete_event(event);
     }
 
     template<typename... Ts>
@@ -722,6 +727,11 @@ class primitives_workload_caffenet_int16 : public primitives_workload_base {
         const size_t batch_size = input.size[3];
         auto input_internal = primitives.map_input(layers.a1, 0, &input, nullptr);
 
+        // events of previous execution are completed at this point
+        for (auto& pair : layers.events)
+            primitives.delete_event(pair.second);
+        layers.events.clear();
+
         layers.events["A1"] = primitives.forward_async(layers.a1, 1, &input_internal, 1, &layers.weights["A1"], 1, &layers.outputs["A1"], 0, nullptr, nullptr);
         primitives.wait(1, &layers.events["A1"]);
         layers.events["Convert_f32_i16"] = primitives.forward_async(layers.convert_float_int16, 1, &layers.outputs["A1"], 0, nullptr, 1, &layers.outputs["Convert_f32_i16"], 1, &layers.events["A1"], nullptr);
@@ -739,7 +749,7 @@ class primitives_workload_caffenet_int16 : public primitives_workload_base {
         c2[0] = layers.events["C2_1"];
         c2[1] = layers.events["C2_2"];
         layers.events["P2"] = primitives.forward_async(layers.p2, 1, &layers.inputs["P2"], 0, nullptr, 1, &layers.outputs["P2"], 2, c2, nullptr);
-        layers.events["N2"] = primitives.forward_async(layers.n2, 1, &layers.outputs["P2"], 0, nullptr, 1, &layers.outputs["N2"], 0, nullptr, nullptr);
+        layers.events["N2"] = primitives.forward_async(layers.n2, 1, &layers.outputs["P2"], 0, nullptr, 1, &layers.outputs["N2"], 1, &layers.events["P2"], nullptr);
         nn_opaque_data_t *c3_params[2] = { layers.weights["C3"], layers.bias["C3"] };
         layers.events["C3"] = primitives.forward_async(layers.c3, 1, &layers.outputs["N2"], 2, c3_params, 1, &layers.outputs["C3"], 1, &layers.events["N2"], nullptr);
 
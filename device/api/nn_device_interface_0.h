@@ -86,6 +86,7 @@ From creation to execution:
     - batch size (number of input data sets processed in parallel)
     - estimate of time needed to process <workload>
     - estimate of energy required to process <workload>
+    - count of threads these estimates are made for
     This query alows user to choose compilation variant that has best
     metrics (performance, perf/watt) or a certain input/output format
     (what allows chaining workloads between different devices).
@@ -101,6 +102,11 @@ From creation to execution:
     User pushes <workload> execution request through the device interface, passing sets of input
     and output buffers along with the <workload> pointer. Execution is done asynchronously.
     User specifies condition variable to be updated with value of execution status.
+    Status is NN_API_WORK_IN_PROGRESS until work is done, then it becomes NN_API_WORK_FINISHED
+    or error code. User can poll it or block on it with workload_wait_function. Buffers passed
+    to execution must stay valid until then.
+    Device that does not support asynchronous execution (or has it disabled with
+    NN_PARAMETER_ASYNCHRONOUS_EXECUTION) finishes work before returning from execute call.
 
 */
 
@@ -165,6 +171,14 @@ typedef enum {
     /* lrn normalization */
     NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN,
 
+    /* int8 quantized layers: uint8 activations, int8 weights, per output map weight scales */
+    NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8,
+    NN_WORK_ITEM_TYPE_CONVOLUTION_INT8,
+    NN_WORK_ITEM_TYPE_MAX_POOLING_INT8,
+    NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8,
+    NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8,     /* uint8 output, supports ReLU activation only */
+    NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32, /* float output, supports None activation */
+
     /* complex/merged work items */
 
     /* generic convolution, with non-overlapping max pooling on 2x2 area with 2x2 stride
@@ -212,11 +226,30 @@ typedef enum {
 } NN_NORMALIZATION_MODE;
 
 
-/* parameters for parameter_get_function
-   Current unused. */
+/* parameters for parameter_get_function & parameter_set_function */
 typedef enum {
     NN_PARAMETER_ = 0,
-    NN_PARAMETER_LAST = NN_PARAMETER_
+    NN_PARAMETER_ASYNCHRONOUS_EXECUTION,    /* uint32_t; non-zero: workload_execute_function returns before work is finished */
+    NN_PARAMETER_JIT_CODE_CACHE,            /* null-terminated char string; path of file with JIT code reused between
+                                               processes, read and updated when workflow is compiled; empty disables */
+    NN_PARAMETER_AUTO_TUNING,               /* uint32_t; non-zero: compilation times viable implementations of each
+                                               layer and uses the fastest one */
+    NN_PARAMETER_TUNING_FILE,               /* null-terminated char string; path of file with tuning decisions, read
+                                               and updated when workflow is compiled; empty keeps them in memory */
+    NN_PARAMETER_NUMA_EXECUTION,            /* uint32_t; number of worker groups, each pinned to CPUs and memory of
+                                               one NUMA node, that workloads compiled afterwards split batch between;
+                                               1 - group per node, 0 - disabled; get returns number of groups */
+    NN_PARAMETER_LOW_LATENCY_DISPATCH,      /* uint32_t; microseconds idle worker threads busy-wait for next job,
+                                               jobs are then handed to them without locks; 0 - disabled (default) */
+    NN_PARAMETER_THREAD_PLACEMENT,          /* uint32_t; 0 - worker threads run on any CPU (default), 1 - pinned once
+                                               to separate physical cores, 2 - additionally hyperthread siblings of
+                                               these cores run memory bound jobs; topology is read from sysfs */
+    NN_PARAMETER_FIXEDPOINT_CALIBRATION,    /* uint32_t; non-zero: workloads compiled afterwards record ranges of outputs
+                                               of their named items and of float weights when executed */
+    NN_PARAMETER_FIXEDPOINT_CONFIGURATION,  /* null-terminated char string; path of file with fractions of int16 layers
+                                               derived from recorded ranges, read when workflow is compiled and
+                                               updated after recording executions; empty keeps them in memory */
+    NN_PARAMETER_LAST = NN_PARAMETER_FIXEDPOINT_CONFIGURATION
 } NN_PARAMETER;
 
 
@@ -274,6 +307,16 @@ typedef struct nn_argument_activation_fixedpoint {
     }  fractions;
 } nn_argument_activation_fixedpoint_t;
 
+/* quantization of int8 layers
+   Real value of uint8 activation q is (q - zero_point) / scale, real value of int8 weight w of output map o is
+   w / weights_scale[o]. Weights have to be in [-64, 64] range, so pairwise products never saturate. */
+typedef struct nn_argument_quantization_int8 {
+    float                       input_scale;        /* scale of input activations */
+    uint8_t                     input_zero_point;   /* uint8 value representing real zero in input */
+    float                       output_scale;       /* scale of output activations, ignored for float outputs */
+    nn_data_t                  *weights_scale;      /* float scale for each output map */
+} nn_argument_quantization_int8_t;
+
 
 /* container for normalization function arguments */
 typedef struct nn_argument_normalization {
@@ -458,6 +501,43 @@ typedef struct nn_arguments_forward_pooling_fixedpoint
     NN_POOLING_MODE             mode;               /* pooling mode */
 } nn_arguments_forward_pooling_fixedpoint_t;
 
+/* arguments for int8 convolution layers */
+typedef struct nn_arguments_forward_convolution_int8
+{
+    nn_data_t                  *biases;             /* float biases */
+    nn_data_t                  *weights;            /* int8 weights */
+    NN_PADDING_MODE             padding;            /* padding mode */
+    uint32_t                    stride[2];          /* stride during filtering operation */
+    uint32_t                    center_offset[2];   /* offset of center point in convolution filter */
+    nn_argument_activation_t    activation;         /* activation data, only ReLU is supported */
+    nn_argument_quantization_int8_t quantization;   /* scales of input, output & weights */
+} nn_arguments_forward_convolution_int8_t;
+
+/* arguments for int8 fully connected layers */
+typedef struct nn_arguments_forward_fully_connected_int8
+{
+    nn_data_t                  *biases;             /* float biases for each neuron */
+    nn_data_t                  *weights;            /* int8 weights for each neuron */
+    nn_argument_activation_t    activation;         /* activation data */
+    nn_argument_quantization_int8_t quantization;   /* scales of input, output & weights */
+} nn_arguments_forward_fully_connected_int8_t;
+
+/* arguments for int8 normalization layers */
+typedef struct nn_arguments_normalization_response_across_maps_int8 {
+    float alpha;                                    /* alpha in normalization equations */
+    float beta;                                     /* beta in normalization equations */
+    uint32_t k;                                     /* k in normalization equations */
+    uint32_t n;                                     /* normalization size */
+    float input_scale;                              /* scale of input activations */
+    float output_scale;                             /* scale of output activations */
+} nn_arguments_normalization_response_across_maps_int8_t;
+
+/* arguments for convert float to uint8 layers */
+typedef struct nn_arguments_forward_convert_float_to_uint8 {
+    float                       output_scale;       /* output is round(input * scale) + zero_point */
+    uint8_t                     output_zero_point;  /* value of real zero, also used for padding */
+} nn_arguments_forward_convert_float_to_uint8_t;
+
 /* workflow item is a representation of a single calculation (for example a single convolution).
    It contains asynchronous calculation state (created, in progress, finished, error) and all parameters
    required for processing. */
@@ -495,8 +575,14 @@ typedef struct nn_workflow_item {
         nn_arguments_forward_pooling_fixedpoint_t                       forward_pooling_fixedpoint;
         nn_arguments_normalization_response_across_maps_forward_i16qn_t normalization_response_across_maps_forward_i16qn;
 
+        /* int8 layers, max pooling uses forward_pooling_fixedpoint */
+        nn_arguments_forward_convolution_int8_t                         forward_convolution_int8;
+        nn_arguments_forward_fully_connected_int8_t                     forward_fully_connected_int8;
+        nn_arguments_normalization_response_across_maps_int8_t          normalization_response_across_maps_int8;
+
         /* conversion layers */
         nn_arguments_forward_convert_float_to_int16_fixedpoint_t        forward_convert_float_to_int16_fixedpoint;
+        nn_arguments_forward_convert_float_to_uint8_t                   forward_convert_float_to_uint8;
 
         /* arguments for for complex NN layers */
         nn_arguments_forward_convolution_pooling_max_2x2_stride_2x2_t   forward_convolution_pooling_max_2x2_stride_2x2;
@@ -545,7 +631,11 @@ typedef struct nn_workload {
 /* workflow metrics contains information about single compilation variant
    Those metrics currently include:
        - entry 0: time  needed to calulcate workload in nanoseconds
-       - entry 1: power needed to calculate workload in nanojoules */
+       - entry 1: power needed to calculate workload in nanojoules
+       - entry 2: time needed to calculate workload on single thread in nanoseconds
+       - entry 3: count of arithmetic operations
+       - entry 4: count of bytes read and written
+       - entry 5: count of worker threads estimate is made for, up to threads of device */
 typedef struct nn_workflow_metrics {
     NN_WORKLOAD_DATA_TYPE *const input_format;  /* array containing formats of inputs */
     NN_WORKLOAD_DATA_TYPE *const output_format; /* array containing formats of outputs */
@@ -558,7 +648,8 @@ typedef struct nn_workflow_metrics {
 typedef struct nn_workflow_metrics_array {
     const uint32_t      input_count;    /* count of inputs in this workload */
     const uint32_t      output_count;   /* count of outputs in this workload */
-    nn_workflow_metrics_t **array;      /* array of variant entries */
+    nn_workflow_metrics_t **array;      /* array of variant entries, terminated by null pointer
+                                           sorted by time per image, fastest first */
 } nn_workflow_metrics_array_t;
 
 typedef struct nn_workload_params {
@@ -729,6 +820,16 @@ typedef NN_API_STATUS (NN_API_CALL_CONVENTION *nn_set_use_jit_primitives_t)(
     int flag                                 /* flag to enable/disable jit primitives (use with forward and batch 24n only) */
     );
 
+/* waits for asynchronous execution of workload
+   Returns NN_API_WORK_IN_PROGRESS if work wasn't finished within timeout, otherwise final status of execution.
+   Timeout equal 0 only polls status, NN_WAIT_INFINITE waits until work is finished. */
+#define NN_WAIT_INFINITE UINT32_MAX
+typedef NN_API_STATUS (NN_API_CALL_CONVENTION *nn_workload_wait_function_t)(
+    nn_workload_t          *workload,        /* workload that was started */
+    NN_API_STATUS          *status,          /* status passed to workload_execute_function */
+    uint32_t                timeout_ms       /* timeout in milliseconds */
+    );
+
 /* interface structure *******************************************************/
 
 
@@ -753,6 +854,7 @@ typedef struct nn_device_interface_0_t {
     nn_workload_query_param_function_t              workload_query_param_function;
     nn_workload_recover_param_function_t            workload_recover_param_function;
     nn_set_use_jit_primitives_t                     use_jit_primitives;
+    nn_workload_wait_function_t                     workload_wait_function;
 } nn_device_interface_0_t;
 
 
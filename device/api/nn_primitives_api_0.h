@@ -153,6 +153,8 @@ typedef NN_API_STATUS(NN_API_CALL_CONVENTION *nn_primitives_delete_primitive_t)(
     );
 
 /* Delete event and free its resources
+    Event may be deleted before its task completes - task is still executed and events depending on it are still
+    honoured. Deleted event must not be used as dependency of later calls.
     Returns: NN_API_STATUS_OK on success
 */
 typedef NN_API_STATUS (NN_API_CALL_CONVENTION *nn_primitives_delete_event_t)(
@@ -160,7 +162,8 @@ typedef NN_API_STATUS (NN_API_CALL_CONVENTION *nn_primitives_delete_event_t)(
     );
 
 /* Wait until dependencies are ready
-    Returns: NN_API_STATUS_OK on success
+    NULL events are treated as completed. Task which failed (or depended on failed task) completes with error status.
+    Returns: NN_API_STATUS_OK on success, error status of first failed task otherwise
 */
 typedef NN_API_STATUS(NN_API_CALL_CONVENTION *nn_primitives_wait_t)(
     size_t dependencies_count, /* size of dependencies array */
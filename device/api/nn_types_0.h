@@ -32,7 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef struct nn_opaque_data nn_opaque_data_t;
 typedef struct nn_device nn_device_t;
 typedef struct nn_primitive_t *nn_primitive_handle_t;
-typedef struct nn_event{} nn_event_t;
+typedef struct nn_event *nn_event_t;
 
 /* status of API call
    All API functions return this enum. */
@@ -57,6 +57,10 @@ struct nn_primitive_t {
     virtual std::vector<nn_workload_data_t *> create_outputs(bool allocate_delta = false) = 0;
 
     virtual bool validate_input(size_t index, nn_workload_data_t *data) = 0;
+
+    // Returns true if forward works only on buffers passed to prepare_forward (e.g. JIT code with embedded
+    // addresses). Workloads containing such primitive cannot be executed on private buffers of execution contexts.
+    virtual bool forward_bound_to_prepared_buffers() const { return false; }
 };
 
 struct nn_device {};
@@ -30,6 +30,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdlib>
 #include <stdexcept>
 #include <string>
+#include <algorithm>
+#include <immintrin.h>
 #include "nn_workload_data.h"
 #include "nn_allocate.h"
 
@@ -183,6 +185,8 @@ static void nn_workload_data_parent_create(nn_workload_data_t *nn_workload_data,
         data_type_size = sizeof(short);
     } else if (layout->data_type == NN_DATATYPE_INT32) {
         data_type_size = sizeof(int);
+    } else if (layout->data_type == NN_DATATYPE_INT8 || layout->data_type == NN_DATATYPE_UINT8) {
+        data_type_size = sizeof(char);
     } else {
         throw std::runtime_error("invalid memory layout -> invalid data type");
     }
@@ -338,137 +342,303 @@ uint32_t calculate_idx(const nn_workload_data_t* data, uint32_t n, uint32_t x, u
     return index;
 }
 
-/*
-    Copy data from source to destination.
-    Data ordering and may differ between source and destination,
-    but lenghts in corresponding dimensions must be equal.
+namespace
+{
+// Size of copy from which contiguous rows are written with streaming stores. Such copy does not fit
+// in last level cache, so caching the destination would only evict data of other work items.
+const uint64_t copy_streaming_threshold = 8 * 1024 * 1024;
 
-    Assumption is that source and destination have different layouts,
-    so we can't just use memcpy()
-*/
+// Size in bytes of rows into which long rows of copy are split.
+const uint64_t copy_row_size = 64 * 1024;
+
+void copy_contiguous(char *destination, const char *source, uint64_t size, bool streaming)
+{
+    if (streaming && size >= 4 * sizeof(__m256i))
+    {
+        auto head = (sizeof(__m256i) - reinterpret_cast<uintptr_t>(destination) % sizeof(__m256i)) % sizeof(__m256i);
+        memcpy(destination, source, head);
+        destination += head;
+        source += head;
+        size -= head;
+
+        for (; size >= sizeof(__m256i); size -= sizeof(__m256i), destination += sizeof(__m256i), source += sizeof(__m256i))
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(destination), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source)));
+    }
 
-template<typename T, bool copy_delta>
-NN_DATA_STATUS nn_workload_copy(nn_workload_data_t* destination, const nn_workload_data_t* source)
+    memcpy(destination, source, size);
+}
+
+template <typename T>
+void copy_strided(T *destination, const T *source, uint64_t length, int64_t destination_stride, int64_t source_stride)
 {
-    uint32_t n, x, y, z, p, q;
+    for (uint64_t i = 0; i < length; ++i)
+        destination[i * destination_stride] = source[i * source_stride];
+}
 
-    // Get sizes of both views (source & destination)
-    unsigned int source_sizes[NN_DATA_COORD_MAX + 1];
-    unsigned int destination_sizes[NN_DATA_COORD_MAX + 1];
+void copy_strided(char *destination, const char *source, uint32_t element_size, uint64_t length, int64_t destination_stride, int64_t source_stride)
+{
+    switch (element_size)
+    {
+    case 1: copy_strided(reinterpret_cast<uint8_t *>(destination), reinterpret_cast<const uint8_t *>(source), length, destination_stride, source_stride); break;
+    case 2: copy_strided(reinterpret_cast<uint16_t *>(destination), reinterpret_cast<const uint16_t *>(source), length, destination_stride, source_stride); break;
+    case 4: copy_strided(reinterpret_cast<uint32_t *>(destination), reinterpret_cast<const uint32_t *>(source), length, destination_stride, source_stride); break;
+    case 8: copy_strided(reinterpret_cast<uint64_t *>(destination), reinterpret_cast<const uint64_t *>(source), length, destination_stride, source_stride); break;
+    default:
+        for (uint64_t i = 0; i < length; ++i)
+            memcpy(destination + i * destination_stride * element_size, source + i * source_stride * element_size, element_size);
+    }
+}
+
+/* transposes 8x8 tile of 32-bit elements: row i of source becomes column i of destination */
+inline void transpose_tile_8x8(float *destination, int64_t destination_stride, const float *source, int64_t source_stride)
+{
+    __m256 r0 = _mm256_loadu_ps(source + 0 * source_stride);
+    __m256 r1 = _mm256_loadu_ps(source + 1 * source_stride);
+    __m256 r2 = _mm256_loadu_ps(source + 2 * source_stride);
+    __m256 r3 = _mm256_loadu_ps(source + 3 * source_stride);
+    __m256 r4 = _mm256_loadu_ps(source + 4 * source_stride);
+    __m256 r5 = _mm256_loadu_ps(source + 5 * source_stride);
+    __m256 r6 = _mm256_loadu_ps(source + 6 * source_stride);
+    __m256 r7 = _mm256_loadu_ps(source + 7 * source_stride);
+
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(destination + 0 * destination_stride, _mm256_permute2f128_ps(r0, r4, 0x20));
+    _mm256_storeu_ps(destination + 1 * destination_stride, _mm256_permute2f128_ps(r1, r5, 0x20));
+    _mm256_storeu_ps(destination + 2 * destination_stride, _mm256_permute2f128_ps(r2, r6, 0x20));
+    _mm256_storeu_ps(destination + 3 * destination_stride, _mm256_permute2f128_ps(r3, r7, 0x20));
+    _mm256_storeu_ps(destination + 4 * destination_stride, _mm256_permute2f128_ps(r0, r4, 0x31));
+    _mm256_storeu_ps(destination + 5 * destination_stride, _mm256_permute2f128_ps(r1, r5, 0x31));
+    _mm256_storeu_ps(destination + 6 * destination_stride, _mm256_permute2f128_ps(r2, r6, 0x31));
+    _mm256_storeu_ps(destination + 7 * destination_stride, _mm256_permute2f128_ps(r3, r7, 0x31));
+}
 
+/* copies plane of 32-bit elements contiguous along first coordinate in destination and along second one in source */
+void copy_transposed(const nn_workload_copy_plan_t *plan, uint64_t length_b, float *destination, const float *source)
+{
+    const auto length_a = plan->lengths[0];
+    const auto source_stride = plan->source_strides[0];
+    const auto destination_stride = plan->destination_strides[1];
+    const auto full_a = length_a / 8 * 8, full_b = length_b / 8 * 8;
+
+    for (uint64_t b = 0; b < full_b; b += 8)
+    {
+        for (uint64_t a = 0; a < full_a; a += 8)
+            transpose_tile_8x8(destination + b * destination_stride + a, destination_stride, source + a * source_stride + b, source_stride);
+
+        for (uint64_t bb = b; bb < b + 8; ++bb)
+            for (uint64_t a = full_a; a < length_a; ++a)
+                destination[bb * destination_stride + a] = source[a * source_stride + bb];
+    }
+
+    for (uint64_t b = full_b; b < length_b; ++b)
+        for (uint64_t a = 0; a < length_a; ++a)
+            destination[b * destination_stride + a] = source[a * source_stride + b];
+}
+} //namespace
+
+/*
+    Prepares copy from source to destination.
+    Data ordering may differ between source and destination, but lengths of views
+    in corresponding dimensions must be equal.
+*/
+NN_DATA_STATUS nn_workload_copy_plan(nn_workload_copy_plan_t* plan, nn_workload_data_t* destination, const nn_workload_data_t* source, bool copy_delta)
+{
+    assert(plan != NULL);
     assert(source != NULL);
     assert(destination != NULL);
 
-    if (source == NULL || destination == NULL)
+    if (plan == NULL || source == NULL || destination == NULL)
     {
         return NN_DATA_STATUS_ERROR_INVALID_POINTER;
     }
 
-    source_sizes[NN_DATA_COORD_n] = source->view_end.t[NN_DATA_COORD_n] - source->view_begin.t[NN_DATA_COORD_n] + 1;
-    source_sizes[NN_DATA_COORD_x] = source->view_end.t[NN_DATA_COORD_x] - source->view_begin.t[NN_DATA_COORD_x] + 1 ;
-    source_sizes[NN_DATA_COORD_y] = source->view_end.t[NN_DATA_COORD_y] - source->view_begin.t[NN_DATA_COORD_y] + 1 ;
-    source_sizes[NN_DATA_COORD_z] = source->view_end.t[NN_DATA_COORD_z] - source->view_begin.t[NN_DATA_COORD_z] + 1 ;
-    source_sizes[NN_DATA_COORD_p] = source->view_end.t[NN_DATA_COORD_p] - source->view_begin.t[NN_DATA_COORD_p] + 1 ;
-    source_sizes[NN_DATA_COORD_q] = source->view_end.t[NN_DATA_COORD_q] - source->view_begin.t[NN_DATA_COORD_q] + 1 ;
-
-    destination_sizes[NN_DATA_COORD_n] = destination->view_end.t[NN_DATA_COORD_n] - destination->view_begin.t[NN_DATA_COORD_n] + 1;
-    destination_sizes[NN_DATA_COORD_x] = destination->view_end.t[NN_DATA_COORD_x] - destination->view_begin.t[NN_DATA_COORD_x] + 1 ;
-    destination_sizes[NN_DATA_COORD_y] = destination->view_end.t[NN_DATA_COORD_y] - destination->view_begin.t[NN_DATA_COORD_y] + 1 ;
-    destination_sizes[NN_DATA_COORD_z] = destination->view_end.t[NN_DATA_COORD_z] - destination->view_begin.t[NN_DATA_COORD_z] + 1 ;
-    destination_sizes[NN_DATA_COORD_p] = destination->view_end.t[NN_DATA_COORD_p] - destination->view_begin.t[NN_DATA_COORD_p] + 1 ;
-    destination_sizes[NN_DATA_COORD_q] = destination->view_end.t[NN_DATA_COORD_q] - destination->view_begin.t[NN_DATA_COORD_q] + 1 ;
-
-    if( (source_sizes[NN_DATA_COORD_n] != destination_sizes[NN_DATA_COORD_n]) ||
-        (source_sizes[NN_DATA_COORD_x] != destination_sizes[NN_DATA_COORD_x]) ||
-        (source_sizes[NN_DATA_COORD_y] != destination_sizes[NN_DATA_COORD_y]) ||
-        (source_sizes[NN_DATA_COORD_z] != destination_sizes[NN_DATA_COORD_z]) ||
-        (source_sizes[NN_DATA_COORD_p] != destination_sizes[NN_DATA_COORD_p]) ||
-        (source_sizes[NN_DATA_COORD_q] != destination_sizes[NN_DATA_COORD_q])
-        ) throw std::runtime_error("Error: Can not copy data, dimensions must be equal.");
-
-    // Views sizes need to match
-    if (memcmp(source_sizes, destination_sizes, sizeof(unsigned int) * (NN_DATA_COORD_MAX + 1)) != 0 )
+    if (memcmp(&get_length(*source).t[0], &get_length(*destination).t[0], sizeof(uint32_t) * (NN_DATA_COORD_MAX + 1)) != 0)
+        throw std::runtime_error("Error: Can not copy data, dimensions must be equal.");
+
+    assert(source->parent->data_type_size == destination->parent->data_type_size);
+
+    struct dimension_t
     {
-        // Cannot copy if lenghts don't match
-        return NN_DATA_STATUS_ERROR_INVALID_MEMORY_LAYOUT;
-    }
+        uint64_t length;
+        int64_t  destination_stride;
+        int64_t  source_stride;
+    } dimensions[NN_DATA_COORD_MAX + 1];
+    uint32_t count = 0;
+
+    auto destination_base = reinterpret_cast<char *>(copy_delta ? destination->parent->delta_buffer : destination->parent->data_buffer);
+    auto source_base = reinterpret_cast<const char *>(copy_delta ? source->parent->delta_buffer : source->parent->data_buffer);
+    const auto element_size = destination->parent->data_type_size;
 
-    // Try fast path for buffers with same layout and dimensionality.
-    if(source->parent->layout == destination->parent->layout &&
-       source->parent->dimension == destination->parent->dimension)
+    for (uint32_t coordinate = 0; coordinate <= NN_DATA_COORD_MAX; ++coordinate)
     {
-        bool no_view = true;
+        int64_t destination_stride = (coordinate < destination->parent->dimension) ? destination->parent->strides[coordinate] : 0;
+        int64_t source_stride = (coordinate < source->parent->dimension) ? source->parent->strides[coordinate] : 0;
 
-        // Get number of dimensions to check.
-        const uint32_t num_dimensions = source->parent->dimension;
+        destination_base += destination->view_begin.t[coordinate] * destination_stride * element_size;
+        source_base += source->view_begin.t[coordinate] * source_stride * element_size;
 
-        // Check if there are no views on any used dimensions.
-        for(uint32_t dimension = 0; dimension < num_dimensions; ++dimension)
-        {
-            // Get coordinate for this dimension.
-            const auto coordinate = source->parent->layout.ordering.t[dimension];
+        auto length = get_length(*source, static_cast<nn_workload_data_coord_index_t>(coordinate));
+        if (length > 1)
+            dimensions[count++] = { length, destination_stride, source_stride };
+    }
+
+    // Order dimensions from innermost to outermost one of destination and merge the ones contiguous in both buffers.
+    std::sort(dimensions, dimensions + count, [](const dimension_t &left, const dimension_t &right) {
+        return left.destination_stride < right.destination_stride;
+    });
+
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (merged > 0 &&
+            dimensions[i].destination_stride == dimensions[merged - 1].destination_stride * static_cast<int64_t>(dimensions[merged - 1].length) &&
+            dimensions[i].source_stride == dimensions[merged - 1].source_stride * static_cast<int64_t>(dimensions[merged - 1].length))
+            dimensions[merged - 1].length *= dimensions[i].length;
+        else
+            dimensions[merged++] = dimensions[i];
+    }
+
+    if (merged == 0)
+        dimensions[merged++] = { 1, 1, 1 };
 
-            // Check buffers view on this coordinate.
-            if(source_sizes[coordinate] != source->parent->lengths.t[coordinate] ||
-               destination_sizes[coordinate] != destination->parent->lengths.t[coordinate])
+    plan->kind = nn_workload_copy_plan_t::strided;
+    plan->row_dimensions = 1;
+    if (dimensions[0].destination_stride == 1 && dimensions[0].source_stride == 1)
+    {
+        plan->kind = nn_workload_copy_plan_t::contiguous;
+    }
+    else if (dimensions[0].destination_stride == 1 && element_size == sizeof(float))
+    {
+        // Innermost dimension of source is the second dimension copied by each transposed row.
+        for (uint32_t i = 1; i < merged; ++i)
+            if (dimensions[i].source_stride == 1)
             {
-                // View detected.
-                no_view = false;
+                std::rotate(dimensions + 1, dimensions + i, dimensions + i + 1);
+                plan->kind = nn_workload_copy_plan_t::transposed;
+                plan->row_dimensions = 2;
                 break;
             }
-        }
-
-        if(no_view)
-        {
-            memcpy( destination->parent->data_buffer, source->parent->data_buffer, destination->parent->buffer_size );
-            return NN_DATA_STATUS_OK;
-        }
     }
 
-    for (q = 0; q < source_sizes[NN_DATA_COORD_q]; q++)
-    for (p = 0; p < source_sizes[NN_DATA_COORD_p]; p++)
-    for (z = 0; z < source_sizes[NN_DATA_COORD_z]; z++)
-    for (y = 0; y < source_sizes[NN_DATA_COORD_y]; y++)
-    for (x = 0; x < source_sizes[NN_DATA_COORD_x]; x++)
-    for (n = 0; n < source_sizes[NN_DATA_COORD_n]; n++)
-    if(copy_delta)
-        nn_workload_data_get_delta<T>(destination, n, x, y, z, p, q) = nn_workload_data_get_delta<T>(source, n, x, y, z, p, q);
-    else
-        nn_workload_data_get<T>(destination, n, x, y, z, p, q) = nn_workload_data_get<T>(source, n, x, y, z, p, q);
+    // Long rows are split, so that single row is small enough to be shared by threads.
+    // Transposed rows are split along their second dimension in multiples of tile size.
+    const auto split = plan->row_dimensions - 1;
+    uint64_t chunk = std::max<uint64_t>(copy_row_size / element_size, 1);
+    if (plan->kind == nn_workload_copy_plan_t::transposed)
+        chunk = std::max<uint64_t>(chunk / dimensions[0].length / 8 * 8, 8);
 
-    destination->parent->tag = source->parent->tag;
+    plan->split_length = 0;
+    if (dimensions[split].length > chunk && merged <= NN_DATA_COORD_MAX)
+    {
+        std::copy_backward(dimensions + split + 1, dimensions + merged, dimensions + merged + 1);
+        plan->split_length = dimensions[split].length;
+        dimensions[split + 1] = { (dimensions[split].length + chunk - 1) / chunk,
+                                  dimensions[split].destination_stride * static_cast<int64_t>(chunk),
+                                  dimensions[split].source_stride * static_cast<int64_t>(chunk) };
+        dimensions[split].length = chunk;
+        ++merged;
+    }
+
+    plan->destination = destination_base;
+    plan->source = source_base;
+    plan->element_size = element_size;
+    plan->dimensions = merged;
+    plan->rows = 1;
+    plan->elements = 1;
+    for (uint32_t i = 0; i < merged; ++i)
+    {
+        plan->lengths[i] = dimensions[i].length;
+        plan->destination_strides[i] = dimensions[i].destination_stride;
+        plan->source_strides[i] = dimensions[i].source_stride;
+        if (i >= plan->row_dimensions)
+            plan->rows *= dimensions[i].length;
+    }
+    for (uint32_t coordinate = 0; coordinate <= NN_DATA_COORD_MAX; ++coordinate)
+        plan->elements *= get_length(*source, static_cast<nn_workload_data_coord_index_t>(coordinate));
+    plan->streaming = plan->kind == nn_workload_copy_plan_t::contiguous && plan->elements * element_size >= copy_streaming_threshold;
 
     return NN_DATA_STATUS_OK;
 }
 
+void nn_workload_copy_rows(const nn_workload_copy_plan_t* plan, uint64_t row_begin, uint64_t row_end)
+{
+    const auto element_size = plan->element_size;
+    const auto split = plan->row_dimensions - 1;
+
+    for (auto row = row_begin; row < row_end; ++row)
+    {
+        int64_t destination_offset = 0, source_offset = 0;
+        auto index = row;
+        for (auto dimension = plan->row_dimensions; dimension < plan->dimensions; ++dimension)
+        {
+            auto coordinate = index % plan->lengths[dimension];
+            index /= plan->lengths[dimension];
+            destination_offset += coordinate * plan->destination_strides[dimension];
+            source_offset += coordinate * plan->source_strides[dimension];
+        }
+
+        auto destination = plan->destination + destination_offset * element_size;
+        auto source = plan->source + source_offset * element_size;
 
+        // Last part of split row may be shorter.
+        auto length = plan->lengths[split];
+        if (plan->split_length)
+            length = std::min(length, plan->split_length - row % plan->lengths[split + 1] * length);
+
+        switch (plan->kind)
+        {
+        case nn_workload_copy_plan_t::contiguous:
+            copy_contiguous(destination, source, length * element_size, plan->streaming);
+            break;
+        case nn_workload_copy_plan_t::strided:
+            copy_strided(destination, source, element_size, length, plan->destination_strides[0], plan->source_strides[0]);
+            break;
+        case nn_workload_copy_plan_t::transposed:
+            copy_transposed(plan, length, reinterpret_cast<float *>(destination), reinterpret_cast<const float *>(source));
+            break;
+        }
+    }
+
+    if (plan->streaming)
+        _mm_sfence();
+}
+
+/*
+    Copy data from source to destination.
+    Data ordering and may differ between source and destination,
+    but lenghts in corresponding dimensions must be equal.
+*/
 NN_DATA_STATUS nn_workload_copy(nn_workload_data_t* destination, const nn_workload_data_t* source, bool copy_delta)
 {
-    auto type = source->parent->layout.data_type;
-
-    assert(type == destination->parent->layout.data_type);
-
-    // TODO: this seems wrong, refactoring needed :)
-    switch(type){
-        case NN_DATATYPE_FLOAT:
-            if(copy_delta)
-                return nn_workload_copy<float, true>(destination, source);
-            else
-                return nn_workload_copy<float, false >(destination, source);
-        case NN_DATATYPE_INT32:
-            if(copy_delta)
-                return nn_workload_copy<int32_t, true>(destination, source);
-            else
-                return nn_workload_copy<int32_t, false >(destination, source);
-        case NN_DATATYPE_INT16:
-            if(copy_delta)
-                return nn_workload_copy<int16_t, true>(destination, source);
-            else
-                return nn_workload_copy<int16_t, false >(destination, source);
-        default:
-            assert(0);
-            return NN_DATA_STATUS_ERROR_DATA_NOT_CONSISTENT;
-    }
+    assert(source == NULL || destination == NULL || source->parent->layout.data_type == destination->parent->layout.data_type);
+
+    nn_workload_copy_plan_t plan;
+    auto status = nn_workload_copy_plan(&plan, destination, source, copy_delta);
+    if (status != NN_DATA_STATUS_OK)
+        return status;
+
+    nn_workload_copy_rows(&plan, 0, plan.rows);
+
+    destination->parent->tag = source->parent->tag;
+
+    return NN_DATA_STATUS_OK;
 }
 
 nn_workload_data_layout_t nn::layout_t<nn::layout_nxyzpq_f32>::layout     = { { NN_DATA_COORD_n, NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_z, NN_DATA_COORD_p, NN_DATA_COORD_q }, NN_DATATYPE_FLOAT };
@@ -511,3 +681,6 @@ nn_workload_data_layout_t nn::layout_t<nn::layout_xyzpqn_i32>::layout     = { {
 nn_workload_data_layout_t nn::layout_t<nn::layout_xzynpq_i32>::layout     = { { NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_z, NN_DATA_COORD_p, NN_DATA_COORD_q, NN_DATA_COORD_n }, NN_DATATYPE_INT32 };
 nn_workload_data_layout_t nn::layout_t<nn::layout_zpxynq_i32>::layout     = { { NN_DATA_COORD_z, NN_DATA_COORD_p, NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_n, NN_DATA_COORD_q }, NN_DATATYPE_INT32 };
 nn_workload_data_layout_t nn::layout_t<nn::layout_zxynpq_i32>::layout     = { { NN_DATA_COORD_z, NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_n, NN_DATA_COORD_p, NN_DATA_COORD_q }, NN_DATATYPE_INT32 };
+
+nn_workload_data_layout_t nn::layout_t<nn::layout_pxyznq_u8>::layout      = { { NN_DATA_COORD_p, NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_z, NN_DATA_COORD_n, NN_DATA_COORD_q }, NN_DATATYPE_UINT8 };
+nn_workload_data_layout_t nn::layout_t<nn::layout_pzxyqn_i8>::layout      = { { NN_DATA_COORD_p, NN_DATA_COORD_z, NN_DATA_COORD_x, NN_DATA_COORD_y, NN_DATA_COORD_q, NN_DATA_COORD_n }, NN_DATATYPE_INT8 };
@@ -62,7 +62,8 @@ typedef enum {
     NN_WORKLOAD_DATA_TAG_OBLOCKIO,   /* weights layout for fully connected layer, with batching */
     NN_WORKLOAD_DATA_TAG_I2O32IXYO,
     NN_WORKLOAD_DATA_TAG_I2O8IO,
-    NN_WORKLOAD_DATA_TAG_ZXY
+    NN_WORKLOAD_DATA_TAG_ZXY,
+    NN_WORKLOAD_DATA_TAG_I4O32IXYO   /* weights layout for int8 convolution and fully connected layers */
 } nn_workload_data_tag_t;
 
 /* Supported data types */
@@ -70,7 +71,9 @@ typedef enum
 {
     NN_DATATYPE_FLOAT,
     NN_DATATYPE_INT16,
-    NN_DATATYPE_INT32
+    NN_DATATYPE_INT32,
+    NN_DATATYPE_INT8,
+    NN_DATATYPE_UINT8
 } nn_workload_data_type_t;
 
 typedef enum
@@ -234,6 +237,8 @@ namespace nn {
     template <> struct type_to_datatype<float> : std::integral_constant<nn_workload_data_type_t, NN_DATATYPE_FLOAT>{};
     template <> struct type_to_datatype<int16_t> : std::integral_constant<nn_workload_data_type_t, NN_DATATYPE_INT16>{};
     template <> struct type_to_datatype<int32_t> : std::integral_constant<nn_workload_data_type_t, NN_DATATYPE_INT32>{};
+    template <> struct type_to_datatype<int8_t> : std::integral_constant<nn_workload_data_type_t, NN_DATATYPE_INT8>{};
+    template <> struct type_to_datatype<uint8_t> : std::integral_constant<nn_workload_data_type_t, NN_DATATYPE_UINT8>{};
 }
 
 /*
@@ -361,6 +366,40 @@ static inline const T &nn_workload_data_get_delta(
     return delta_buffer[calculate_idx(data, n, x, y, z, p, q)];
 };
 
+/*
+    Plan of copy between two views of equal lengths.
+    Coordinates of length 1 are dropped and neighbouring coordinates contiguous in both buffers
+    are merged, so copy is done in rows: contiguous runs (memcpy or streaming stores), strided
+    runs, or planes transposed in 8x8 tiles when source and destination have different innermost
+    coordinate. Rows are independent and may be copied by different threads.
+*/
+struct nn_workload_copy_plan_t {
+    enum row_kind_t { contiguous, strided, transposed };
+
+    row_kind_t  kind;
+    char       *destination;
+    const char *source;
+    uint32_t    element_size;
+    uint32_t    dimensions;         /* merged dimensions, [0] is innermost one of destination */
+    uint32_t    row_dimensions;     /* dimensions copied by single row: 1, or 2 for transposed rows */
+    uint64_t    lengths[NN_DATA_COORD_MAX + 1];
+    int64_t     destination_strides[NN_DATA_COORD_MAX + 1];   /* in elements */
+    int64_t     source_strides[NN_DATA_COORD_MAX + 1];        /* in elements */
+    uint64_t    split_length;       /* length of last row dimension before it was split into rows, 0 if not split */
+    uint64_t    rows;
+    uint64_t    elements;
+    bool        streaming;          /* destination is written with non-temporal stores */
+};
+
+NN_DATA_STATUS nn_workload_copy_plan(
+    nn_workload_copy_plan_t* plan, nn_workload_data_t* destination, const nn_workload_data_t* source, bool delta_copy
+    );
+
+/* Copies rows [row_begin, row_end) of plan. */
+void nn_workload_copy_rows(
+    const nn_workload_copy_plan_t* plan, uint64_t row_begin, uint64_t row_end
+    );
+
 /*
     Copy data from source to destination.
     Data ordering and may differ between source and destination,
@@ -436,10 +475,15 @@ namespace nn {
     class layout_zpxynq_i32;
     class layout_zxynpq_i32;
 
+    class layout_pxyznq_u8;
+    class layout_pzxyqn_i8;
+
     template<typename T> struct get_layout_type;
 
     template<> struct get_layout_type<int16_t>               { using type = int16_t; };
     template<> struct get_layout_type<int32_t>               { using type = int32_t; };
+    template<> struct get_layout_type<int8_t>                { using type = int8_t; };
+    template<> struct get_layout_type<uint8_t>               { using type = uint8_t; };
 
     template<> struct get_layout_type<layout_unknown>        { using type = std::nullptr_t; };
     template<> struct get_layout_type<layout_f32>            { using type = float; };
@@ -485,6 +529,9 @@ namespace nn {
     template<> struct get_layout_type<layout_zpxynq_i32>     { using type = int32_t; };
     template<> struct get_layout_type<layout_zxynpq_i32>     { using type = int32_t; };
 
+    template<> struct get_layout_type<layout_pxyznq_u8>      { using type = uint8_t; };
+    template<> struct get_layout_type<layout_pzxyqn_i8>      { using type = int8_t; };
+
     template <typename T> struct layout_t;
 
     template <> struct layout_t<layout_unknown> {};
@@ -531,9 +578,13 @@ namespace nn {
     template <> struct layout_t<layout_zpxynq_i32>     { static nn_workload_data_layout_t layout; };
     template <> struct layout_t<layout_zxynpq_i32>     { static nn_workload_data_layout_t layout; };
 
+    template <> struct layout_t<layout_pxyznq_u8>      { static nn_workload_data_layout_t layout; };
+    template <> struct layout_t<layout_pzxyqn_i8>      { static nn_workload_data_layout_t layout; };
+
     template<typename T = layout_unknown> class workload_data : public ::nn_workload_data_t {
 
         static_assert(std::is_same<T, int16_t>::value || std::is_same<T, int32_t>::value
+        || std::is_same<T, int8_t>::value || std::is_same<T, uint8_t>::value
 
         || std::is_same<T, layout_unknown>::value
         || std::is_same<T, layout_f32>::value
@@ -578,6 +629,9 @@ namespace nn {
         || std::is_same<T, layout_xzynpq_i32>::value
         || std::is_same<T, layout_zpxynq_i32>::value
         || std::is_same<T, layout_zxynpq_i32>::value
+
+        || std::is_same<T, layout_pxyznq_u8>::value
+        || std::is_same<T, layout_pzxyqn_i8>::value
         , "type not supported");
 
     public:
@@ -28,17 +28,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "device/common/nn_device_internal.h"
+#include "device/cpu/core/jit_code_cache.h"
+#include "device/cpu/api_internal/nn_workflow_cost_model.h"
+#include "device/cpu/api_internal/nn_fixedpoint_calibration.h"
+#include "device/cpu/api_internal/nn_kernel_tuner.h"
+#include "device/cpu/api_internal/nn_numa_topology.h"
 
 #include <cstdint>
 
 #include <algorithm>
+#include <functional>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <queue>
+#include <deque>
+#include <future>
 #include <memory>
+#include <exception>
 #include <condition_variable>
 #include <assert.h>
+#include <immintrin.h>
 
 #ifdef __linux__
 #include <pthread.h>
@@ -60,10 +71,23 @@ Thread pool usage:
        request_handle that is also sent inside request.
     3. Specific implementation of opaque internal structure can be made if required.
     4. After 'job' is created, use push_job function.
-        - This function blocks execution until all worker threads complete their work.
-        - You can't send 'job' that have more requests than there are threads available.
-          Such action will result in assertion.
+        - This function blocks execution until all requests of this job complete.
+        - Job can contain any number of requests, they are queued on per-thread deques
+          and idle threads steal work from busy ones, so it is fine to split work
+          into many more requests than there are threads.
+        - push_job can be called from inside a request callback (nested parallelism),
+          calling worker then processes requests itself while waiting for its job.
         - This function does not clear nor deallocate job vector, you must do it by yourself.
+        - If request throws, remaining requests still run and exception is rethrown by push_job.
+    5. In low latency mode (set_spin_time) idle workers busy-wait for next job instead of parking,
+       and job pushed from outside of pool is published to all of them at once: workers and calling
+       thread take requests by atomic counter and caller waits on counter of completed requests,
+       so there are no locks nor wake-ups on the way. Only one such job is in flight, others (nested
+       or pushed at the same time from other threads) go through deques.
+    6. With topology-aware placement (set_placement) workers are pinned once to separate physical cores.
+       Hyperthread siblings of these cores get secondary workers, started when siblings placement is first
+       requested, which run only jobs pushed with push_job_with_siblings - useful for memory bound work,
+       where second thread on core hides latency.
 */
 
 // Internal implementation of request handle used by the thread pool.
@@ -84,270 +108,230 @@ struct nn_multithreaded_request
     void* request_handle;
 };
 
-// Semaphore class used in thread pool implementation.
-class nn_semaphore
+// Single request queued in thread pool together with job it belongs to.
+class nn_task_group;
+struct nn_task
+{
+    nn_multithreaded_request* request;
+    nn_task_group* group;
+};
+
+// Counts requests of one push_job call that are not completed yet, keeps first exception thrown by them.
+class nn_task_group
 {
 public:
-    // Setup semaphore and clear its counter.
-    nn_semaphore()
-        : mtx(),
-          mtx_lock(mtx, std::defer_lock),
-          count(0) {}
+    nn_task_group(size_t count)
+        : pending(count),
+          done(count == 0) {}
 
-    // Set semaphore specific value that will be later decremented.
-    void set_semaphore(size_t _count)
+    // Called after each request of the group is processed.
+    void task_done()
     {
-        // Thread pool queue should be cleared which is indicated by semaphore value (==0).
-        mtx_lock.lock();
-        assert(count == 0);
-        count = _count;
+        if (pending.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            done = true;
+            cv.notify_all();
+        }
     }
 
-    // Notifies waiters, decrements semaphore value and atomically clears working state
-    // under semaphore lock. This method is called under wake lock also - as should
-    // be every place changing request value.
-    void atomic_clear_state_and_notify(nn_multithreaded_request** request)
+    // Called by request that threw, before it is marked as done.
+    void task_failed(std::exception_ptr error)
     {
-        std::unique_lock<std::mutex> lck(mtx);
-        *request = nullptr;
-        --count;
-        cv.notify_one();
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!exception)
+            exception = error;
     }
 
-    // Waits until tasks count will be equal to zero.
-    void wait_for_all_and_clear()
+    bool is_done() const
     {
-        cv.wait(mtx_lock, [this]() { return count == 0; });
-        mtx_lock.unlock();
+        return pending.load() == 0;
     }
 
-    // Wait until any thread is done
-    void wait_change()
+    // Blocks until all requests of the group are processed. Spins for a while
+    // before parking on condition variable, since most jobs are short.
+    // Rethrows exception of failed request in waiting thread.
+    void wait(uint32_t spin_count)
     {
-        cv.wait(mtx_lock);
+        for (uint32_t spin = 0; spin < spin_count && !is_done(); ++spin)
+            std::this_thread::yield();
+
+        // Always synchronize on mutex - group lives on caller stack and must
+        // not be destroyed while last worker is still notifying it.
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return done; });
+        if (exception)
+            std::rethrow_exception(exception);
     }
 
 private:
-    // This mutex is locked so 'count' member can't be accessed in more than one thread.
+    std::atomic<size_t> pending;
+    bool done;
+    std::exception_ptr exception;
     std::mutex mtx;
-    std::unique_lock<std::mutex> mtx_lock;
     std::condition_variable cv;
-
-    // Number of tasks in pool queue.
-    size_t count;
 };
 
-// Basic thread worker class.
-class nn_thread_worker
+// Double-ended queue of tasks owned by single worker. Owner takes tasks from
+// the back (most recently pushed, still hot in cache), thieves from the front.
+class nn_task_deque
 {
 public:
-    nn_thread_worker(uint32_t id, nn_semaphore* semaphore)
-        : hypervisor_semaphore(semaphore),
-        current_request(nullptr),
-        thread_id(id),
-        worker_awaken(false),
-        close_worker(false),
-        worker_thread(&nn_thread_worker::task_loop, this)
+    void push(const nn_task& task)
     {
-        // Wait until OS complete thread creation and call main thread function.
-        while (!worker_awaken)
-            ;
+        std::lock_guard<std::mutex> lock(mtx);
+        tasks.push_back(task);
     }
 
-    ~nn_thread_worker()
+    bool pop(nn_task& task)
     {
-        {
-            // Set termination flag and wake up thread. Mutex will make
-            // sure it wont happen during current task processing.
-            std::lock_guard<std::mutex> wake_lock(wake_mutex);
-            close_worker = true;
-            wake_condition.notify_one();
-        }
+        std::lock_guard<std::mutex> lock(mtx);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
 
-        // Wait for termination.
-        worker_thread.join();
+    bool steal(nn_task& task)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
     }
 
+private:
+    std::mutex mtx;
+    std::deque<nn_task> tasks;
+};
+
+class nn_thread_worker_pool;
+
+// Basic thread worker class.
+class nn_thread_worker
+{
+public:
+    nn_thread_worker(uint32_t id, nn_thread_worker_pool* pool)
+        : pool(pool),
+          thread_id(id) {}
 
-    // Adds request to the thread.
-    void add_request(nn_multithreaded_request* request)
+    ~nn_thread_worker()
     {
-        if (request == nullptr) throw std::invalid_argument("null request sent");
-        {
-            // Locks wake mutex - it will get unlocked after worker
-            // thread will cleanup itself after previous work.
-            std::lock_guard<std::mutex> wake_lock(wake_mutex);
-            current_request = request;
-            wake_condition.notify_one();
-        }
+        // Pool is responsible for asking worker to stop, just wait for termination.
+        if (worker_thread.joinable())
+            worker_thread.join();
     }
 
-    // Checks if there is any request processed.
-    bool is_ready() const
+    // Starts worker thread - must be called after all workers of the pool are created,
+    // since worker can steal from any of them.
+    inline void start();
+
+    uint32_t get_id() const
     {
-        return current_request == nullptr;
+        return thread_id;
     }
 
-#ifdef __linux__
-    void get_affinity_np(size_t cpusetsize, cpu_set_t *cpuset)
+    bool is_current_thread() const
     {
-        int err =  pthread_getaffinity_np(worker_thread.native_handle(), sizeof(cpu_set_t), cpuset);
-        if(err != 0)
-        {
-            throw std::runtime_error(std::string("Error getting affinity of thread. pthread_getaffinity_np error code: ") + std::to_string(err));
-        }
+        return worker_thread.get_id() == std::this_thread::get_id();
     }
 
-    void set_affinity_np(size_t cpusetsize, cpu_set_t *cpuset)
+    nn_task_deque& get_deque()
     {
-        int err = pthread_setaffinity_np(worker_thread.native_handle(), sizeof(cpu_set_t), cpuset);
-        if( err != 0 )
-        {
-            throw std::runtime_error(std::string("Error setting affinity of thread. pthread_setaffinity_np error code: ") + std::to_string(err));
-        }
+        return deque;
     }
-#endif
-
 
-private:
-    // Main worker thread routine.
-    void task_loop()
+    void set_cpus(const std::vector<uint32_t>& cpus)
     {
-        // Aquire wake mutex so no other thread can incorrectly interfere in thread values.
-        std::unique_lock<std::mutex> wake_lock(wake_mutex);
-
-        // Let constructor know that thread is fully created and safely locked.
-        worker_awaken = true;
-
-        // Main loop.
-        while (!close_worker)
-        {
-            // Waits for notification that can be caused by new task or destructor.
-            // When thread is in waiting state, it removes lock so other threads can push
-            // new jobs into it or check its state. But after thread is notified, it locks
-            // it again, so no code under this mutex can interfere during task processing.
-            // It also causes thread to wait until all other threads changing its state
-            // complete their work before thread starts.
-            wake_condition.wait(wake_lock);
-
-            // Safety check for spurious wake up or other wake up that shouldnt cause thread
-            // to work on data - e.g. it could be termination call.
-            bool assign_check;
-            {
-                assign_check = current_request != nullptr;
-
-                if (assign_check)
-                {
-                    // Call user callback with sent request handle.
-                    current_request->callback(current_request->request_handle);
-
-                    // Safely clears request state and notifies pool semaphore.
-                    hypervisor_semaphore->atomic_clear_state_and_notify(&current_request);
-                }
-            }
-        }
+        nn_set_thread_cpus(worker_thread, cpus);
     }
 
-     // Semaphore of thread pool, shader by all threads.
-    nn_semaphore* hypervisor_semaphore;
-
-    // Value used both as request handle and indicator of thread state.
-    nn_multithreaded_request* current_request;
+private:
+    // Thread pool worker belongs to.
+    nn_thread_worker_pool* pool;
 
     // ID of thread visible by thread pool.
     uint32_t thread_id;
 
-    // Special controlling values.
-    volatile bool worker_awaken;
-    volatile bool close_worker;
-
-    // Mutexes used by a thread.
-    mutable std::mutex wake_mutex;
-    std::condition_variable wake_condition;
+    // Tasks pushed to this worker.
+    nn_task_deque deque;
 
     // Main object of worker thread.
     std::thread worker_thread;
 };
 
-// Class that provides Hardware specific info eg. number of logical cores and physical cores
-// TODO: make it a singleton, Windows support
-struct platform_info
+// Placement of worker threads on CPUs.
+enum class nn_thread_placement_mode
 {
-    long num_logical_processors;
-    long num_physical_processors_per_socket;
-    long num_hw_threads_per_socket;
-    unsigned int num_ht_threads;
-    unsigned int num_total_phys_cores;
+    none,           // workers run on any CPU of pool
+    physical_cores, // workers pinned to separate physical cores
+    siblings        // as above, secondary workers on hyperthread siblings run jobs that opt in
 };
 
-
-class nn_hardware_platform
+// Job published to all workers of pool at once (low latency mode).
+// Generation is odd while job is being replaced; workers register as active before taking
+// requests and check generation again, so publisher can wait until no one uses previous job.
+struct nn_broadcast_job
 {
-    public:
-        nn_hardware_platform() : m_num_logical_processors(0), m_num_physical_processors_per_socket(0), m_num_hw_threads_per_socket(0) ,m_num_ht_threads(1), m_num_total_phys_cores(1)
-        {
-#ifdef __linux__
-            m_num_logical_processors = sysconf(_SC_NPROCESSORS_ONLN);
-
-            m_num_physical_processors_per_socket = 0;
-
-            std::ifstream ifs;
-            ifs.open("/proc/cpuinfo");
-
-            // If there is no /proc/cpuinfo fallback to default scheduler
-            if(ifs.good() == false) {
-                m_num_physical_processors_per_socket = m_num_logical_processors;
-                assert(0);  // No cpuinfo? investigate that
-                return;
-            }
-            std::string cpuinfo_content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-            std::stringstream cpuinfo_stream(cpuinfo_content);
-            std::string cpuinfo_line;
-            while(std::getline(cpuinfo_stream,cpuinfo_line,'\n')){
-                if(cpuinfo_line.find("cpu cores") != std::string::npos) {
-                    // convert std::string into number eg. skip colon and after it in the same line  should be number of physical cores per socket
-                    std::stringstream( cpuinfo_line.substr(cpuinfo_line.find(":") + 1) ) >> m_num_physical_processors_per_socket;
-                    break;
-                }
-                if(cpuinfo_line.find("siblings") != std::string::npos) {
-                    // convert std::string into number eg. skip colon and after it in the same line  should be number of HW threads per socket
-                    std::stringstream( cpuinfo_line.substr(cpuinfo_line.find(":") + 1) ) >> m_num_hw_threads_per_socket;
-                }
-            }
-            // There is cpuinfo, but parsing did not get quite right? Investigate it
-            assert( m_num_physical_processors_per_socket > 0);
-            assert( m_num_hw_threads_per_socket > 0);
+    nn_broadcast_job()
+        : generation(0),
+          busy(false),
+          requests(nullptr),
+          count(0),
+          next(0),
+          done(0),
+          active(0) {}
+
+    // Keeps first exception thrown by requests, rethrown to thread that pushed job.
+    void request_failed(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (!exception)
+            exception = error;
+    }
 
-            // Calculate how many threads can be run on single cpu core , in case of lack of hw info attributes assume 1
-            m_num_ht_threads =  m_num_physical_processors_per_socket != 0 ? m_num_hw_threads_per_socket/ m_num_physical_processors_per_socket : 1;
-            // calculate total number of physical cores eg. how many full Hw threads we can run in parallel
-            m_num_total_phys_cores = m_num_hw_threads_per_socket != 0 ? m_num_logical_processors / m_num_hw_threads_per_socket * m_num_physical_processors_per_socket : 1;
+    std::exception_ptr take_exception()
+    {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        auto result = exception;
+        exception = nullptr;
+        return result;
+    }
 
-            ifs.close();
-#endif
-        }
-    void get_platform_info(platform_info& pi)
-    {
-       pi.num_logical_processors = m_num_logical_processors;
-       pi.num_physical_processors_per_socket = m_num_physical_processors_per_socket;
-       pi.num_hw_threads_per_socket = m_num_hw_threads_per_socket;
-       pi.num_ht_threads = m_num_ht_threads;
-       pi.num_total_phys_cores = m_num_total_phys_cores;
-    }
-    private:
-        long m_num_logical_processors;
-        long m_num_physical_processors_per_socket;
-        long m_num_hw_threads_per_socket;
-        unsigned int m_num_ht_threads;
-        unsigned int m_num_total_phys_cores;
+    std::atomic<uint64_t> generation;
+    std::atomic<bool> busy;
+    nn_multithreaded_request* requests;
+    size_t count;
+    std::atomic<size_t> next;
+    std::atomic<size_t> done;
+    std::atomic<uint32_t> active;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
 };
 
 // Thread pool implementation.
 class nn_thread_worker_pool
 {
 public:
-    // Basic constructor.
-    nn_thread_worker_pool(size_t cfg_num_threads = 0) : m_max_physical_threads(0)
+    // Number of polls made by idle thread before it is parked on condition variable.
+    static const uint32_t spin_count = 2000;
+
+    // Number of busy-wait iterations between checks of time in low latency mode.
+    static const uint32_t pause_count = 64;
+
+    // Basic constructor. Workers are restricted to given CPUs, if there are any.
+    nn_thread_worker_pool(size_t cfg_num_threads = 0, const std::vector<uint32_t>& cpus = {})
+        : primary_threads(0),
+          started_threads(0),
+          placement_mode(nn_thread_placement_mode::none),
+          queued_tasks(0),
+          queued_secondary_tasks(0),
+          sleeping_threads(0),
+          sleeping_secondary_threads(0),
+          close_workers(false),
+          next_thread(0),
+          spin_time_ns(0)
     {
         size_t num_threads;
 
@@ -369,141 +353,254 @@ public:
         // subthreads, pool will process all jobs on its own.
         if (num_threads > 1)
         {
-            for (auto thread_id = 0; thread_id < num_threads; ++thread_id)
+            // Topology is read once, workers are pinned according to it only when placement is enabled.
+            auto cores = nn_cpu_cores(cpus);
+            for (auto& core : cores)
+                pool_cpus.insert(pool_cpus.end(), core.cpus.begin(), core.cpus.end());
+            placement = nn_place_threads(cores, num_threads);
+
+            // Primary workers first, then secondary ones - one per hyperthread sibling. Threads of
+            // secondary workers are started only when placement on siblings is requested.
+            primary_threads = num_threads;
+            for (size_t thread_id = 0; thread_id < num_threads + placement.secondary.size(); ++thread_id)
             {
-                auto thread = std::unique_ptr<nn_thread_worker>(new nn_thread_worker(thread_id, &semaphore));
+                auto thread = std::unique_ptr<nn_thread_worker>(new nn_thread_worker(static_cast<uint32_t>(thread_id), this));
                 threads.push_back(std::move(thread));
             }
 
-#ifdef __linux__
-        nn_hardware_platform hw_platform;
-        platform_info hw_info;
-        hw_platform.get_platform_info(hw_info);
-
-        // Get original affinity of threads (assuming it is same for all threads)
-        threads[0]->get_affinity_np(sizeof(cpu_set_t), &m_original_cpuset);
-
-        // Create affinity mask by masking out bits responsible for logical threads to
-        // avoid running more than one thread on the same physical core.
-        // In other words affinity mask needs to modified so no more bits than one are set for
-        // same physical core
-        // This is useful for Fully connected layer under linux where linux scheduler
-        // happens to run two threads on one core while having physical cores available and idle
-        // Also count number of physical threads we can have to compare it at runtime
-        // with number of working threads to be processing to decide if affinity should be changed for threads
-        m_physical_cpuset = m_original_cpuset;
-        if( hw_info.num_ht_threads > 1) {
-            for( unsigned int i = 0; i < hw_info.num_logical_processors; ++i ) {
-                if( CPU_ISSET(i,&m_physical_cpuset) ) {
-                    ++m_max_physical_threads;
-                    for(unsigned int j = i + hw_info.num_total_phys_cores; j < hw_info.num_logical_processors; ++j ) {
-                        CPU_CLR(j,&m_physical_cpuset);
-                    }
-                }
-            }
-        }
+            for (size_t index = 0; index < primary_threads; ++index)
+                threads[index]->start();
 
-        // verification (printing of set of physical mask) .
-        // Please do nto remove it as it is helpful during development process!
-        //printf("Affinity[%d]: ",0);
-        //for(unsigned int j =0; j< hw_info.num_logical_processors; ++j) {
-           //printf("%d,",CPU_ISSET(j,&m_physical_cpuset) == true ? 1 : 0);
-        //}
-        //printf("\n");
-#else
-    //TODO: windows
-#endif
+            for (size_t index = 0; index < primary_threads; ++index)
+                threads[index]->set_cpus(cpus);
+            started_threads = primary_threads;
         }
-
-
     }
 
     ~nn_thread_worker_pool()
     {
+        {
+            // Set termination flag and wake up all parked threads.
+            std::lock_guard<std::mutex> lock(park_mutex);
+            close_workers = true;
+            park_condition.notify_all();
+            secondary_park_condition.notify_all();
+        }
+
+        // Workers are joined in their destructors.
+        threads.clear();
     }
 
     // Get number of worker threads available.
     size_t get_num_threads()
     {
         // If there are no worker threads, then one thread is available - the pool thread.
-        if (threads.size()) return threads.size();
+        if (primary_threads) return primary_threads;
         else return 1;
     }
 
-    void push_job_on_physical_cores_if_beneficial(std::vector<nn_multithreaded_request>& requests)
+    // Number of threads running jobs pushed with push_job_with_siblings.
+    size_t get_num_threads_with_siblings()
     {
-        // We have observed that linux task scheduler is distributing
-        // computational tasks on the same physical CPU core when no
-        // other important job is running on diffrent CPU core
-        // which makes all computation running slower than expected
-        // So in case of having enough CPU physical cores to run
-        // threads separatly eg. one physical thread on one physical CPU core,
-        // we modify affinity not allow scheduler to have to threads on the same physical CPU core
-#ifdef __linux__
-        // check if it is affordable to run job with set affinity
-        if(m_max_physical_threads >= requests.size()) {
-            this->push_job_on_physical_cores(requests);
-        } else {
-#endif
-            this->push_job(requests);
-#ifdef __linux
-        }
-#endif
+        if (placement_mode.load() == nn_thread_placement_mode::siblings)
+            return threads.size();
+        return get_num_threads();
     }
 
+    // Time idle workers busy-wait for next job before parking; non-zero enables low latency mode.
+    void set_spin_time(std::chrono::nanoseconds time)
+    {
+        spin_time_ns = static_cast<uint64_t>(std::max<int64_t>(time.count(), 0));
+    }
 
-    // Push job queue setting calculated previously affinity
-    void push_job_on_physical_cores(std::vector<nn_multithreaded_request>& requests)
+    std::chrono::nanoseconds get_spin_time() const
     {
-        // Sent requests to worker threads.
-        if (threads.size() != 0)
+        return std::chrono::nanoseconds(spin_time_ns.load());
+    }
+
+    // Pins workers according to topology; affinity is changed only here, never while jobs are pushed.
+    void set_placement(nn_thread_placement_mode mode)
+    {
+        std::lock_guard<std::mutex> lock(placement_mutex);
+        if (mode == placement_mode.load() || threads.empty())
         {
-            // Setup semaphore and lock its mutex.
-            semaphore.set_semaphore(requests.size());
+            placement_mode = mode;
+            return;
+        }
 
-            auto threads_begin = std::begin(threads);
-            auto threads_end = std::end(threads);
+        if (mode == nn_thread_placement_mode::siblings && started_threads.load() != threads.size())
+        {
+            for (size_t index = primary_threads; index < threads.size(); ++index)
+            {
+                threads[index]->start();
+                threads[index]->set_cpus({placement.secondary[index - primary_threads]});
+            }
+            started_threads = threads.size();
+        }
 
-            // Run tasks.
-            for (auto& request : requests)
+        if (mode == nn_thread_placement_mode::none)
+        {
+            for (size_t index = 0; index < started_threads.load(); ++index)
+                threads[index]->set_cpus(pool_cpus);
+        }
+        else if (placement_mode.load() == nn_thread_placement_mode::none)
+        {
+            for (size_t index = 0; index < placement.primary.size(); ++index)
+                threads[index]->set_cpus({placement.primary[index]});
+            for (size_t index = primary_threads; index < started_threads.load(); ++index)
+                threads[index]->set_cpus({placement.secondary[index - primary_threads]});
+        }
+        placement_mode = mode;
+    }
+
+    nn_thread_placement_mode get_placement() const
+    {
+        return placement_mode.load();
+    }
+
+    // Push job queue.
+    void push_job(std::vector<nn_multithreaded_request>& requests)
+    {
+        push_job_on_workers(requests, false);
+    }
+
+    // Push job queue that can be run also by secondary workers on hyperthread siblings,
+    // if they are enabled - otherwise same as push_job.
+    void push_job_with_siblings(std::vector<nn_multithreaded_request>& requests)
+    {
+        push_job_on_workers(requests, placement_mode.load() == nn_thread_placement_mode::siblings);
+    }
+
+    // Main worker thread routine.
+    void task_loop(uint32_t id)
+    {
+        // Secondary workers take only tasks pushed to them and never busy-wait,
+        // so they don't take execution resources of core from primary ones.
+        const bool secondary = id >= primary_threads;
+        auto& sleeping = secondary ? sleeping_secondary_threads : sleeping_threads;
+        auto& condition = secondary ? secondary_park_condition : park_condition;
+
+        // Last generation of broadcast job this worker has taken part in.
+        uint64_t seen_generation = 0;
+        auto work_available = [&]() {
+            if (secondary)
+                return queued_secondary_tasks.load() != 0 || close_workers.load();
+            return queued_tasks.load() != 0 || close_workers.load() || broadcast_pending(seen_generation);
+        };
+
+        while (true)
+        {
+            if (!secondary && broadcast_pending(seen_generation))
             {
-                auto ready_thread = threads_end;
+                run_broadcast_job(seen_generation);
+                continue;
+            }
 
-                // Find waiting thread.
-                do{
-                    ready_thread = std::find_if(threads_begin, threads_end,
-                        [&](std::unique_ptr<nn_thread_worker> const& thread) { return thread->is_ready(); });
-                    if (ready_thread != threads_end)
+            nn_task task;
+            if (acquire_task(id, task))
+            {
+                run_task(task);
+                continue;
+            }
+
+            // Nothing to do - poll for a while, new job is usually pushed shortly
+            // after previous one (next layer). In low latency mode poll without
+            // giving up CPU for configured time.
+            bool available = false;
+            auto spin_time = spin_time_ns.load();
+            if (spin_time != 0 && !secondary)
+            {
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(spin_time);
+                while (!(available = work_available()))
+                {
+                    for (uint32_t pause = 0; pause < pause_count && !(available = work_available()); ++pause)
+                        _mm_pause();
+                    if (available || std::chrono::steady_clock::now() > deadline)
                         break;
-                    semaphore.wait_change();
-                } while (ready_thread == threads_end);
+                }
+            }
+            else
+            {
+                for (uint32_t spin = 0; spin < spin_count && !(available = work_available()); ++spin)
+                    std::this_thread::yield();
+            }
 
-                // It will hit if there are no ready threads.
-                assert(ready_thread != threads_end);
+            if (!available)
+            {
+                // Park thread until new tasks arrive or pool is destroyed.
+                std::unique_lock<std::mutex> lock(park_mutex);
+                sleeping.fetch_add(1);
+                condition.wait(lock, work_available);
+                sleeping.fetch_sub(1);
+            }
 
-#ifdef __linux__
-                // Set affintiy of thread so only one thread per core (physical cores) are allowed
-                (**ready_thread).set_affinity_np(sizeof(cpu_set_t), &m_physical_cpuset);
-#else
-                // TODO: Windows
-#endif
-                // Add request to ready thread found.
-                (**ready_thread).add_request(&request);
+            if (close_workers.load() && queued_tasks.load() == 0)
+                break;
+        }
+    }
+
+private:
+
+    // Pushes job to primary workers, or to all of them when siblings are used, and waits for it.
+    void push_job_on_workers(std::vector<nn_multithreaded_request>& requests, bool with_siblings)
+    {
+        // Sent requests to worker threads.
+        if (threads.size() != 0 && requests.size() != 0)
+        {
+            nn_task_group group(requests.size());
+
+            // Find out if job is pushed from inside of other job (nested parallelism).
+            auto started_end = std::begin(threads) + started_threads.load();
+            auto current_worker = std::find_if(std::begin(threads), started_end,
+                [](std::unique_ptr<nn_thread_worker> const& thread) { return thread->is_current_thread(); });
+
+            if (current_worker == started_end && !with_siblings && spin_time_ns.load() != 0 && push_broadcast_job(requests))
+                return;
+
+            size_t secondary_tasks = 0;
+            if (current_worker != started_end)
+            {
+                // Keep nested requests local, idle threads will steal them.
+                for (auto& request : requests)
+                    (**current_worker).get_deque().push(nn_task{&request, &group});
+                if ((**current_worker).get_id() >= primary_threads)
+                    secondary_tasks = requests.size();
+            }
+            else
+            {
+                // Distribute requests evenly over all workers.
+                const size_t workers = with_siblings ? threads.size() : primary_threads;
+                auto first_thread = next_thread.fetch_add(1);
+                for (size_t index = 0; index < requests.size(); ++index)
+                {
+                    auto worker = (first_thread + index) % workers;
+                    if (worker >= primary_threads)
+                        ++secondary_tasks;
+                    threads[worker]->get_deque().push(nn_task{&requests[index], &group});
+                }
             }
 
-            // Wait for all threads and clear semaphore locks.
-            semaphore.wait_for_all_and_clear();
+            queued_secondary_tasks.fetch_add(secondary_tasks);
+            queued_tasks.fetch_add(requests.size());
+            wake_workers(secondary_tasks != 0);
 
-#ifdef __linux__
-            // Revert original affinity mask
-            for( auto& thread : threads)
+            if (current_worker != started_end)
             {
-                (*thread).set_affinity_np(sizeof(cpu_set_t), &m_original_cpuset);
+                // Worker can't just block - it would starve pool in case of deeper nesting.
+                // Process any available tasks (starting from own ones) until job is completed.
+                auto id = (**current_worker).get_id();
+                while (!group.is_done())
+                {
+                    nn_task task;
+                    if (acquire_task(id, task))
+                        run_task(task);
+                    else
+                        std::this_thread::yield();
+                }
             }
-#else
-            // TODO: Windows
-#endif
 
+            // Wait for all requests of this job.
+            group.wait(spin_count);
         }
         else
         {
@@ -515,74 +612,293 @@ public:
         }
     }
 
-    // Push job queue.
-    void push_job(std::vector<nn_multithreaded_request>& requests)
+
+    bool broadcast_pending(uint64_t seen_generation) const
     {
-        // Sent requests to worker threads.
-        if (threads.size() != 0)
-        {
-            // Setup semaphore and lock its mutex.
-            semaphore.set_semaphore(requests.size());
+        auto generation = broadcast.generation.load();
+        return generation % 2 == 0 && generation != seen_generation;
+    }
 
-            auto threads_begin = std::begin(threads);
-            auto threads_end = std::end(threads);
+    // Takes requests of broadcast job until there are none left.
+    void run_broadcast_job(uint64_t& seen_generation)
+    {
+        auto generation = broadcast.generation.load();
+        seen_generation = generation;
 
-            // Run tasks.
-            for (auto& request : requests)
+        broadcast.active.fetch_add(1);
+        if (broadcast.generation.load() == generation)
+        {
+            for (auto index = broadcast.next.fetch_add(1); index < broadcast.count; index = broadcast.next.fetch_add(1))
             {
-                auto ready_thread = threads_end;
+                // Request that throws still counts as done, otherwise pushing thread would wait forever.
+                auto& request = broadcast.requests[index];
+                try
+                {
+                    request.callback(request.request_handle);
+                }
+                catch (...)
+                {
+                    broadcast.request_failed(std::current_exception());
+                }
+                broadcast.done.fetch_add(1);
+            }
+        }
+        broadcast.active.fetch_sub(1);
+    }
 
-                // Find waiting thread.
-                do{
-                    ready_thread = std::find_if(threads_begin, threads_end,
-                        [&](std::unique_ptr<nn_thread_worker> const& thread) { return thread->is_ready(); });
-                    if (ready_thread != threads_end)
-                        break;
-                    semaphore.wait_change();
-                } while (ready_thread == threads_end);
+    // Publishes job to all workers and runs it together with them; false if other broadcast job is in flight.
+    bool push_broadcast_job(std::vector<nn_multithreaded_request>& requests)
+    {
+        bool expected = false;
+        if (!broadcast.busy.compare_exchange_strong(expected, true))
+            return false;
+
+        // Workers which took part in previous job must leave it before it is replaced.
+        broadcast.generation.fetch_add(1);
+        while (broadcast.active.load() != 0)
+            _mm_pause();
+
+        broadcast.requests = requests.data();
+        broadcast.count = requests.size();
+        broadcast.next = 0;
+        broadcast.done = 0;
+        auto generation = broadcast.generation.fetch_add(1) + 1;
+        wake_workers(false);
+
+        // Calling thread works too - with short jobs it often finishes them before workers wake up.
+        uint64_t seen_generation = generation - 2;
+        run_broadcast_job(seen_generation);
+
+        // Completion barrier: wait for requests taken by workers.
+        while (broadcast.done.load() != requests.size())
+            _mm_pause();
+
+        auto exception = broadcast.take_exception();
+        broadcast.busy = false;
+        if (exception)
+            std::rethrow_exception(exception);
+        return true;
+    }
 
-                // It will hit if there are no ready threads.
-                assert(ready_thread != threads_end);
+    // Takes task from own deque or, if it is empty, steals one from other workers.
+    // Primary workers steal from all workers, secondary ones only from each other.
+    bool acquire_task(uint32_t id, nn_task& task)
+    {
+        const bool secondary = id >= primary_threads;
+        if ((secondary ? queued_secondary_tasks : queued_tasks).load() == 0)
+            return false;
 
-                // Add request to ready thread found.
-                (**ready_thread).add_request(&request);
+        size_t victim = id;
+        bool acquired = threads[id]->get_deque().pop(task);
+        if (secondary)
+        {
+            const size_t secondary_threads = threads.size() - primary_threads;
+            for (size_t offset = 1; !acquired && offset < secondary_threads; ++offset)
+            {
+                victim = primary_threads + (id - primary_threads + offset) % secondary_threads;
+                acquired = threads[victim]->get_deque().steal(task);
             }
-
-            // Wait for all threads and clear semaphore locks.
-            semaphore.wait_for_all_and_clear();
         }
         else
         {
-            // Singlethreaded pool... run tasks sequentially by itself.
-            for (auto& request : requests)
+            for (size_t offset = 1; !acquired && offset < primary_threads; ++offset)
             {
-                request.callback(request.request_handle);
+                victim = (id + offset) % primary_threads;
+                acquired = threads[victim]->get_deque().steal(task);
             }
+            for (size_t index = primary_threads; !acquired && index < threads.size() && queued_secondary_tasks.load() != 0; ++index)
+            {
+                victim = index;
+                acquired = threads[victim]->get_deque().steal(task);
+            }
+        }
+
+        if (acquired)
+        {
+            if (victim >= primary_threads)
+                queued_secondary_tasks.fetch_sub(1);
+            queued_tasks.fetch_sub(1);
         }
+
+        return acquired;
     }
 
-private:
+    // Request that throws is still counted as done, so neither its job nor worker is lost.
+    void run_task(nn_task& task)
+    {
+        try
+        {
+            task.request->callback(task.request->request_handle);
+        }
+        catch (...)
+        {
+            task.group->task_failed(std::current_exception());
+        }
+        task.group->task_done();
+    }
 
-    // Main semaphore, visible by all worker threads.
-    nn_semaphore semaphore;
+    void wake_workers(bool secondary)
+    {
+        // Parked thread increments sleeping counter under park mutex before checking
+        // queue, so either it sees new tasks or we see it sleeping.
+        if (sleeping_threads.load() != 0 || (secondary && sleeping_secondary_threads.load() != 0))
+        {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            park_condition.notify_all();
+            if (secondary)
+                secondary_park_condition.notify_all();
+        }
+    }
 
-    // Vector of worker threads.
+    // Vector of worker threads, primary ones first.
     std::vector<std::unique_ptr<nn_thread_worker>> threads;
+    size_t primary_threads;
+
+    // Number of workers whose threads run - secondary ones are started by first placement on siblings.
+    std::atomic<size_t> started_threads;
+
+    // All CPUs of pool, and CPUs of workers used when placement is enabled.
+    std::vector<uint32_t> pool_cpus;
+    nn_thread_placement placement;
+    std::atomic<nn_thread_placement_mode> placement_mode;
+    std::mutex placement_mutex;
+
+    // Number of tasks waiting in all deques, and in deques of secondary workers.
+    std::atomic<size_t> queued_tasks;
+    std::atomic<size_t> queued_secondary_tasks;
+
+    // Parking of idle threads.
+    std::atomic<size_t> sleeping_threads;
+    std::atomic<size_t> sleeping_secondary_threads;
+    std::atomic<bool> close_workers;
+    std::mutex park_mutex;
+    std::condition_variable park_condition;
+    std::condition_variable secondary_park_condition;
+
+    // Worker that receives first request of next external job.
+    std::atomic<size_t> next_thread;
+
+    // Low latency mode: time of busy-waiting and job published to all workers.
+    std::atomic<uint64_t> spin_time_ns;
+    nn_broadcast_job broadcast;
+};
 
-#ifdef __linux__
-    cpu_set_t m_original_cpuset;
-    cpu_set_t m_physical_cpuset;
-#endif
-    unsigned int m_max_physical_threads;    // Number of physical threads we can run on separate cpu cores. This value consider affinity mask set externaly
+inline void nn_thread_worker::start()
+{
+    worker_thread = std::thread(&nn_thread_worker_pool::task_loop, pool, thread_id);
+}
+
+// Runs asynchronous requests (eg. workload executions) on its own threads, so caller doesn't
+// have to wait for them. Requests use thread pool for actual computations, several requests
+// can be in flight at the same time. Threads are created when first request is pushed.
+class nn_request_dispatcher
+{
+public:
+    // Maximum number of requests processed concurrently.
+    static const size_t max_requests_in_flight = 4;
+
+    // Threads are restricted to given CPUs, if there are any.
+    nn_request_dispatcher(const std::vector<uint32_t>& cpus = {})
+        : cpus(cpus),
+          close_dispatcher(false) {}
+
+    ~nn_request_dispatcher()
+    {
+        {
+            // Requests already pushed are processed before threads exit.
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            close_dispatcher = true;
+            queue_condition.notify_all();
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    void push(std::function<void()> request)
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (threads.size() == 0)
+            for (size_t index = 0; index < max_requests_in_flight; ++index)
+            {
+                threads.push_back(std::thread(&nn_request_dispatcher::request_loop, this));
+                nn_set_thread_cpus(threads.back(), cpus);
+            }
+
+        requests.push(std::move(request));
+        queue_condition.notify_one();
+    }
+
+    // Runs function on one of dispatcher threads, returned future gets its completion or exception.
+    std::future<void> run(std::function<void()> function)
+    {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::move(function));
+        auto result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+private:
+    void request_loop()
+    {
+        while (true)
+        {
+            std::function<void()> request;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                queue_condition.wait(lock, [this]() { return close_dispatcher || !requests.empty(); });
+                if (requests.empty())
+                    break;
+
+                request = std::move(requests.front());
+                requests.pop();
+            }
+
+            request();
+        }
+    }
+
+    std::vector<uint32_t> cpus;
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> requests;
+    std::mutex queue_mutex;
+    std::condition_variable queue_condition;
+    bool close_dispatcher;
 };
 
 // Internal implementation of device structure.
 struct nn_device_internal : nn_device_t
 {
-    nn_device_internal() : thread_pool() {};
-    nn_device_internal(size_t num_threads) : thread_pool(num_threads) {};
+    nn_device_internal() : thread_pool(), asynchronous_execution(false) {};
+    nn_device_internal(size_t num_threads) : thread_pool(num_threads), asynchronous_execution(false) {};
+    nn_device_internal(size_t num_threads, const std::vector<uint32_t>& cpus)
+        : thread_pool(num_threads, cpus), request_dispatcher(cpus), asynchronous_execution(false) {};
 
     nn_thread_worker_pool thread_pool;
+
+    // Executions of workloads when asynchronous mode is enabled (NN_PARAMETER_ASYNCHRONOUS_EXECUTION).
+    // Declared after thread pool, so pending requests are finished before pool is destroyed.
+    nn_request_dispatcher request_dispatcher;
+    std::atomic<bool> asynchronous_execution;
+
+    // Code of JIT kernels reused between processes (NN_PARAMETER_JIT_CODE_CACHE).
+    jit_code_cache jit_cache;
+
+    // Implementations of layers chosen by timing (NN_PARAMETER_AUTO_TUNING, NN_PARAMETER_TUNING_FILE).
+    kernel_tuner tuner;
+
+    // Fractions of int16 layers calibrated on float workloads (NN_PARAMETER_FIXEDPOINT_CALIBRATION,
+    // NN_PARAMETER_FIXEDPOINT_CONFIGURATION).
+    fixedpoint_calibration calibration;
+
+    // Throughput of machine used by workflow metrics, measured on first query.
+    nn_machine_model machine_model;
+
+    // Worker groups used by workloads compiled while NUMA execution is enabled (NN_PARAMETER_NUMA_EXECUTION).
+    // Each group is a device with all threads pinned to CPUs of one node. Workloads own references to groups
+    // they were compiled for, so groups outlive change of parameter.
+    std::vector<std::shared_ptr<nn_device_internal>> numa_groups;
+    std::mutex numa_mutex;
 };
 
 void copy_data(nn_device_internal *device, nn_data_t *destination, const nn_workload_data_t *source);
@@ -74,6 +74,7 @@ template <typename T> struct data_helper<NN_WORKLOAD_DATA_TAG_ZBLOCKXYZN, T> {
 template<typename T> inline nn_workload_data_layout_t &data_helper_layout_lookup_pxyznq();
 template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_pxyznq<float>()                     { return nn::layout_t<nn::layout_pxyznq_f32>::layout; }
 template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_pxyznq<int16_t>()                   { return nn::layout_t<nn::layout_pxyznq_i16>::layout; }
+template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_pxyznq<uint8_t>()                   { return nn::layout_t<nn::layout_pxyznq_u8>::layout; }
 template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_pxyznq<nn::layout_zblockxyzn_f32>() { return nn::layout_t<nn::layout_pxyznq_i16>::layout; }
 
 template <typename T>
@@ -1061,6 +1062,78 @@ template <typename T> struct data_helper<NN_WORKLOAD_DATA_TAG_I2O8IO, T> {
     }
 };
 
+/* int8 weights: 32 output maps times 4 consecutive input maps form 128 byte vector (p), vectors are ordered by
+   input group (z), kernel column (x), kernel row (y) and block of output maps (q); fully connected layers use
+   input width & height as kernel size; weights have to be in [-64, 64] range */
+template <typename T> struct data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, T> {
+    static const nn_workload_data_layout_t &layout;
+
+    static const uint32_t i_block_size = 4;
+    static const uint32_t o_block_size = 32;
+
+    template <bool copy_delta>
+    static void copy(nn_device_internal *device, nn::workload_data<T> *destination, const nn::data<T, 4> *source)
+    {
+        copy_impl(destination, static_cast<const T *>(source->buffer), source->size[0], source->size[1], source->size[2], source->size[3]);
+    }
+
+    template <bool copy_delta>
+    static void copy(nn_device_internal *device, nn::workload_data<T> *destination, const nn::data<T, 2> *source)
+    {
+        copy_impl(destination, static_cast<const T *>(source->buffer), 1, 1, source->size[0], source->size[1]);
+    }
+
+    static nn::workload_data<T> *create(
+        nn_device_internal *device,
+        uint32_t x_size,
+        uint32_t y_size,
+        uint32_t i_size,
+        uint32_t o_size) {
+
+        const nn_workload_data_coords_t size(
+            1,
+            x_size,
+            y_size,
+            (i_size - 1) / i_block_size + 1,
+            i_block_size * o_block_size,
+            (o_size - 1) / o_block_size + 1
+        );
+
+        return new nn::workload_data<T>(NN_WORKLOAD_DATA_TAG_I4O32IXYO, size, layout);
+    }
+
+private:
+    static void copy_impl(nn::workload_data<T> *destination, const T *src, size_t x_size, size_t y_size, size_t i_size, size_t o_size)
+    {
+        assert(destination->parent->layout == layout);
+
+        auto destination_length = destination->get_length();
+        assert(destination_length.t[NN_DATA_COORD_x] == x_size);
+        assert(destination_length.t[NN_DATA_COORD_y] == y_size);
+
+        auto dst = static_cast<T *>(destination->parent->data_buffer);
+
+        for (auto q = 0u; q < destination_length.t[NN_DATA_COORD_q]; ++q)
+            for (auto y = 0u; y < destination_length.t[NN_DATA_COORD_y]; ++y)
+                for (auto x = 0u; x < destination_length.t[NN_DATA_COORD_x]; ++x)
+                    for (auto z = 0u; z < destination_length.t[NN_DATA_COORD_z]; ++z)
+                        for (auto p = 0u; p < destination_length.t[NN_DATA_COORD_p]; ++p)
+                        {
+                            const auto i = z * i_block_size + p % i_block_size;
+                            const auto o = q * o_block_size + p / i_block_size;
+                            T value = 0;
+                            if (i < i_size && o < o_size)
+                                value = src[x + x_size * (y + y_size * (i + i_size * o))];
+                            if (value < -64 || value > 64)
+                                throw std::runtime_error("int8 weights have to be in [-64, 64] range");
+                            *(dst++) = value;
+                        }
+    }
+};
+
+template <typename T>
+const nn_workload_data_layout_t &data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, T>::layout = nn::layout_t<nn::layout_pzxyqn_i8>::layout;
+
 template<typename T> inline nn_workload_data_layout_t &data_helper_layout_lookup_xzynpq();
 template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_xzynpq<int16_t>() { return nn::layout_t<nn::layout_xzynpq_i16>::layout; }
 template<> inline nn_workload_data_layout_t &data_helper_layout_lookup_xzynpq<int32_t>() { return nn::layout_t<nn::layout_xzynpq_i32>::layout; }
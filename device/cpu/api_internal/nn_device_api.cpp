@@ -49,7 +49,8 @@ nn_device_interface_0_t device_interface_0 = {
     nn_translate_api_status_0_function,
     nn_workload_query_param_0_function,
     nn_workload_recover_param_0_function,
-    nn_set_use_jit_primitives_0_function
+    nn_set_use_jit_primitives_0_function,
+    nn_workload_wait_0_function
 };
 
 /* loads & initializes device
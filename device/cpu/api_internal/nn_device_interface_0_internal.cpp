@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/cpu/core/layer_convolution_avx2.h"
 #include "device/cpu/core/layer_convolution_avx2_batch24n.h"
 #include "device/cpu/core/layer_convolution_pooling_avx2.h"
+#include "device/cpu/core/layer_convolution_normalization_pooling_avx2.h"
 #include "device/cpu/core/layer_fully_connected_avx2.h"
 #include "device/cpu/core/layer_softmax_avx2.h"
 #include "device/cpu/core/layer_softmax_avx2_batch24n.h"
@@ -48,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/cpu/core/layer_loss_function.h"
 #include "device/cpu/core/layer_relu_avx2.h"
 #include "device/cpu/core/layer_dropout.h"
+#include "device/cpu/core/helper_workload_data_copy.h"
 #include "nn_device_interface_0_internal.h"
 #include "device/cpu/core/layer_fully_connected_avx2_batch24n.h"
 #include "data_helper.h"
@@ -66,6 +68,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_set>
 #include <unordered_map>
 #include <iterator>
+#include <chrono>
+#include <limits>
 
 #define ENABLE_WORKLOAD_MONITORING 0
 
@@ -100,6 +104,12 @@ void nn_workload_item_data_marshaling(nn_workload_item* item, int stage_num)
     case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT: item_name = "cnn_pool2x2_i16";break;
     case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
     case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN: item_name =  "fc_i16";break;
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8: item_name = "conv_float2u8";break;
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8: item_name = "cnn_i8";break;
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8: item_name = "pooling_i8";break;
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8: item_name = "norm_i8";break;
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32: item_name = "fc_i8";break;
     case NN_WORK_ITEM_TYPE_SOFTMAX:
     case NN_WORK_ITEM_TYPE_SOFTMAX_FIXEDPOINT: item_name = "softmax";break;
     case NN_WORK_ITEM_TYPE_MERGE: item_name =  "merge";break;
@@ -239,6 +249,25 @@ template <> struct flow_item_helper<NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOI
     }
 };
 
+template <> struct flow_item_helper<NN_WORK_ITEM_TYPE_CONVOLUTION_INT8> {
+    static const nn_arguments_forward_convolution_int8_t &get_arguments(const nn_workflow_item *flow_item) {
+        return flow_item->arguments.forward_convolution_int8;
+    }
+
+    static void calculate_padding(const nn_workflow_item *flow_item, size_t input_w, size_t input_h, size_t &left_padding, size_t &right_padding, size_t &top_padding, size_t &bottom_padding){
+        auto& arguments = get_arguments(flow_item);
+
+        size_t padding_w = (flow_item->output_format[0].format_3d.size[0] - 1) * arguments.stride[0] - input_w + arguments.weights->size[0];
+        size_t padding_h = (flow_item->output_format[0].format_3d.size[1] - 1) * arguments.stride[1] - input_h + arguments.weights->size[1];
+
+        left_padding = arguments.center_offset[0];
+        right_padding = padding_w - arguments.center_offset[0];
+
+        top_padding = arguments.center_offset[1];
+        bottom_padding = padding_h - arguments.center_offset[1];
+    }
+};
+
 template <> struct flow_item_helper<NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT> {
     static const nn_arguments_forward_merged_convolution_pooling_max_2x2_stride_2x2_fixedpoint_t &get_arguments(const nn_workflow_item *flow_item) {
         return flow_item->arguments.forward_convolution_pooling_fixedpoint;
@@ -350,10 +379,36 @@ static void nn_workflow_compile_0_function_calculate_output_padding(const nn_wor
             nn_workflow_compile_0_function_update_output_padding_for_use<NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2>(use_item, output_w, output_h, left_padding, right_padding, top_padding, bottom_padding);
             nn_workflow_compile_0_function_update_output_padding_for_use<NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT>(use_item, output_w, output_h, left_padding, right_padding, top_padding, bottom_padding);
             nn_workflow_compile_0_function_update_output_padding_for_use<NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT>(use_item, output_w, output_h, left_padding, right_padding, top_padding, bottom_padding);
+            nn_workflow_compile_0_function_update_output_padding_for_use<NN_WORK_ITEM_TYPE_CONVOLUTION_INT8>(use_item, output_w, output_h, left_padding, right_padding, top_padding, bottom_padding);
         }
     }
 }
 
+/* Batch block primitives process batch padded to a multiple of BATCH_ACCEPTED_BLOCK (tail block is filled with
+   zeros by conversion to batch block layout). They are used when at least half of padded batch are real images. */
+bool nn_workflow_compile_0_function_use_batch_block(uint32_t batch)
+{
+    const uint32_t padded_batch = (batch + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK * BATCH_ACCEPTED_BLOCK;
+    return nn::use_asmjit_primitives and (2 * batch >= padded_batch);
+}
+
+/* z block of uint8 output of int8 item: largest one (up to 32 maps) that divides number of output maps and
+   z ranges of views taken from the output, so that views start at block boundary. */
+static uint32_t nn_workflow_compile_0_function_int8_z_block(const nn_workflow_item *flow_item)
+{
+    std::vector<uint32_t> view_offsets_z;
+    for (size_t it_use = 0; it_use < flow_item->use_count; ++it_use) {
+        auto use_item = flow_item->use[it_use].item;
+        if (use_item->type == NN_WORK_ITEM_TYPE_VIEW) {
+            auto origin_z = use_item->arguments.view.origin[2];
+            view_offsets_z.push_back(origin_z);
+            view_offsets_z.push_back(origin_z + get_format_size<2>(use_item->output_format[0]));
+        }
+    }
+
+    return int8_fixedpoint::helper_z_block_xyz_u8::select_block_size(get_format_size<2>(flow_item->output_format[0]), view_offsets_z);
+}
+
 void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_item,
                                                      nn_workflow_item_t *flow_item,
                                                      uint32_t batch,
@@ -373,9 +428,8 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
         assert(args.padding == NN_PADDING_MODE_DATA_OR_ZERO);
 
         using namespace convolution;
-        if (nn::use_asmjit_primitives && (batch % 24 == 0) && (args.weights->size[0] < 7))
-        {
-            load_item->primitive = new layer::convolution_f32_batch24n(
+        auto create_batch24n = [&]() -> nn_primitive_t * {
+            return new layer::convolution_f32_batch24n(
                 make<Batch>(batch),
                 OutputDimensions{make<OutputHeight>(flow_item->output_format[0].format >= NN_DATA_FORMAT_2D ? flow_item->output_format[0].format_2d.size[1] : 1),
                                  make<OutputWidth>(flow_item->output_format[0].format_1d.size[0]),
@@ -388,10 +442,9 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
                            Stride{make<Rows>(args.stride[1]), make<Cols>(args.stride[0])}},
                 args.activation,
                 device);
-        }
-        else
-        {
-            load_item->primitive = new layer::convolution_f32(
+        };
+        auto create_f32 = [&]() -> nn_primitive_t * {
+            return new layer::convolution_f32(
                 args.weights->size[0],
                 args.weights->size[1],
                 args.weights->size[2],
@@ -409,7 +462,21 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
                 output_top_padding,
                 output_bottom_padding,
                 device);
-        }
+        };
+
+        // first candidate is preferred by heuristics
+        std::vector<kernel_tuner::candidate> candidates = {{"f32", create_f32}};
+        if (nn_workflow_compile_0_function_use_batch_block(batch))
+            candidates.insert(args.weights->size[0] < 7 ? candidates.begin() : candidates.end(),
+                              {"batch24n", create_batch24n});
+
+        load_item->primitive = device->tuner.choose(
+            tuning_key("convolution",
+                       args.weights->size[0], args.weights->size[1], args.weights->size[2], args.weights->size[3],
+                       get_format_size<0>(flow_item->output_format[0]), get_format_size<1>(flow_item->output_format[0]),
+                       args.center_offset[0], args.center_offset[1], args.stride[0], args.stride[1],
+                       args.activation.function, batch, device->thread_pool.get_num_threads()),
+            candidates);
         break;
     }
     case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2:
@@ -449,31 +516,46 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
 
         bool use_3d_input = input.item->output_format[input.index].format == NN_DATA_FORMAT_3D;
 
-        if (nn::use_asmjit_primitives and (batch % 24 == 0))
-            load_item->primitive = new layer::fully_connected_f32_batch24n(
-                (use_3d_input ? (std::max(args.weights->size[0], size_t(1))
-                                * std::max(args.weights->size[1], size_t(1))
-                                * std::max(args.weights->size[2], size_t(1)))
-                    : args.weights->size[0]),
-                (use_3d_input ? args.weights->size[3] : args.weights->size[1]),
-                args.activation,
-                batch,
-                device);
-        else if(use_3d_input)
-            load_item->primitive = new layer::fully_connected_f32(
-                args.weights->size[0], args.weights->size[1], args.weights->size[2],
-                args.weights->size[3],
-                args.activation,
-                batch,
-                device);
-        else
-            load_item->primitive = new layer::fully_connected_f32(
-                args.weights->size[0],
-                args.weights->size[1],
-                args.activation,
-                batch,
-                device);
+        auto num_input = use_3d_input ? (std::max(args.weights->size[0], size_t(1))
+                                         * std::max(args.weights->size[1], size_t(1))
+                                         * std::max(args.weights->size[2], size_t(1)))
+                                      : args.weights->size[0];
+        auto num_output = use_3d_input ? args.weights->size[3] : args.weights->size[1];
+
+        auto create_batch24n = [&]() -> nn_primitive_t * {
+            return new layer::fully_connected_f32_batch24n(num_input, num_output, args.activation, batch, device);
+        };
+        auto create_f32 = [&](size_t thread_limit) -> nn_primitive_t * {
+            auto primitive = use_3d_input
+                ? new layer::fully_connected_f32(
+                    args.weights->size[0], args.weights->size[1], args.weights->size[2],
+                    args.weights->size[3],
+                    args.activation,
+                    batch,
+                    device)
+                : new layer::fully_connected_f32(
+                    args.weights->size[0],
+                    args.weights->size[1],
+                    args.activation,
+                    batch,
+                    device);
+            primitive->set_thread_limit(thread_limit);
+            return primitive;
+        };
 
+        // first candidate is preferred by heuristics; f32 kernels also compete with fewer threads, since splitting
+        // small layers over all threads may cost more than it saves
+        std::vector<kernel_tuner::candidate> candidates;
+        if (nn_workflow_compile_0_function_use_batch_block(batch))
+            candidates.push_back({"batch24n", create_batch24n});
+        if (candidates.empty() || batch == 1 || batch == 8 || batch == 48)
+            for (auto threads = std::min(device->thread_pool.get_num_threads(), max_threads); threads > 0; threads /= 2)
+                candidates.push_back({"f32_threads_" + std::to_string(threads), std::bind(create_f32, threads)});
+
+        load_item->primitive = device->tuner.choose(
+            tuning_key("fully_connected", num_input, num_output, use_3d_input, args.activation.function, batch,
+                       device->thread_pool.get_num_threads()),
+            candidates);
         break;
     }
     case NN_WORK_ITEM_TYPE_POOLING:
@@ -574,11 +656,8 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
         }
         case NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS:
         {
-            auto load_input = load_item->input[0];
-            auto prev_output = load_input.item->output[load_input.index];
-            if (nn::use_asmjit_primitives and (batch % 24 == 0))
-                load_item->primitive =
-                    new layer::normalization_response_across_maps_f32_batch24n(
+            auto create_batch24n = [&]() -> nn_primitive_t * {
+                return new layer::normalization_response_across_maps_f32_batch24n(
                         args.normalization.alpha,
                         args.normalization.beta,
                         args.normalization.k,
@@ -588,9 +667,9 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
                                          make<OutputFeats>(get_format_size<2>(flow_item->output_format[0]))},
                         batch,
                         device);
-            else
-                load_item->primitive =
-                    new layer::normalization_response_across_maps_f32(args.normalization.alpha,
+            };
+            auto create_f32 = [&]() -> nn_primitive_t * {
+                return new layer::normalization_response_across_maps_f32(args.normalization.alpha,
                                                                       args.normalization.beta,
                                                                       args.normalization.k,
                                                                       args.normalization.n,
@@ -603,6 +682,21 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
                                                                       output_top_padding,
                                                                       output_bottom_padding,
                                                                       device);
+            };
+
+            std::vector<kernel_tuner::candidate> candidates = {{"f32", create_f32}};
+            if (nn_workflow_compile_0_function_use_batch_block(batch))
+                candidates.insert(candidates.begin(), {"batch24n", create_batch24n});
+
+            load_item->primitive = device->tuner.choose(
+                tuning_key("normalization_response_across_maps",
+                           args.normalization.n,
+                           get_format_size<0>(flow_item->output_format[0]),
+                           get_format_size<1>(flow_item->output_format[0]),
+                           get_format_size<2>(flow_item->output_format[0]),
+                           batch,
+                           device->thread_pool.get_num_threads()),
+                candidates);
             break;
         }
         default:
@@ -613,10 +707,15 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
         break;
     }
     case NN_WORK_ITEM_TYPE_SOFTMAX: {
-        if (nn::use_asmjit_primitives and (batch % 24 == 0))
-            load_item->primitive = new layer::softmax_f32_batch24n(get_format_size<0>(flow_item->output_format[0]), batch, device);
-        else
-            load_item->primitive = new layer::softmax_f32(get_format_size<0>(flow_item->output_format[0]), batch, device);
+        auto num_features = get_format_size<0>(flow_item->output_format[0]);
+        std::vector<kernel_tuner::candidate> candidates = {
+            {"f32", [&]() -> nn_primitive_t * { return new layer::softmax_f32(num_features, batch, device); }}};
+        if (nn_workflow_compile_0_function_use_batch_block(batch))
+            candidates.insert(candidates.begin(),
+                {"batch24n", [&]() -> nn_primitive_t * { return new layer::softmax_f32_batch24n(num_features, batch, device); }});
+
+        load_item->primitive = device->tuner.choose(
+            tuning_key("softmax", num_features, batch, device->thread_pool.get_num_threads()), candidates);
         break;
     }
     case NN_WORK_ITEM_TYPE_SOFTMAX_LOSS:
@@ -801,6 +900,136 @@ void nn_workflow_compile_0_function_create_primitive(nn_workload_item_t *load_it
             device);
         break;
     }
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8: {
+        auto &args = flow_item->arguments.forward_convert_float_to_uint8;
+
+        load_item->primitive = new int8_fixedpoint::convert_float_to_uint8(
+            flow_item->output_format[0].format_3d.size[2],
+            flow_item->output_format[0].format_1d.size[0],
+            flow_item->output_format[0].format >= NN_DATA_FORMAT_2D ? flow_item->output_format[0].format_2d.size[1] : 1,
+            batch,
+            nn_workflow_compile_0_function_int8_z_block(flow_item),
+            output_left_padding,
+            output_right_padding,
+            output_top_padding,
+            output_bottom_padding,
+            args.output_scale,
+            args.output_zero_point,
+            device);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8: {
+        auto &args = flow_item->arguments.forward_convolution_int8;
+        assert((flow_item->output_format[0].format >= NN_DATA_FORMAT_3D ? flow_item->output_format[0].format_3d.size[2]
+                                                                     : 1) == args.weights->size[3]);
+        assert(args.padding == NN_PADDING_MODE_DATA_OR_ZERO);
+
+        load_item->primitive = new int8_fixedpoint::convolution_i8(
+            args.weights->size[0],
+            args.weights->size[1],
+            args.weights->size[2],
+            args.weights->size[3],
+            flow_item->output_format[0].format_1d.size[0],
+            flow_item->output_format[0].format >= NN_DATA_FORMAT_2D ? flow_item->output_format[0].format_2d.size[1] : 1,
+            args.center_offset[0],
+            args.center_offset[1],
+            args.stride[0],
+            args.stride[1],
+            args.activation,
+            args.quantization.input_scale,
+            args.quantization.input_zero_point,
+            args.quantization.output_scale,
+            batch,
+            nn_workflow_compile_0_function_int8_z_block(flow_item),
+            output_left_padding,
+            output_right_padding,
+            output_top_padding,
+            output_bottom_padding,
+            device);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8: {
+        auto &args = flow_item->arguments.forward_pooling_fixedpoint;
+
+        load_item->primitive = new int8_fixedpoint::pooling_i8(
+            args.mode,
+            flow_item->output_format[0].format_3d.size[2],
+            flow_item->output_format[0].format_1d.size[0],
+            flow_item->output_format[0].format >= NN_DATA_FORMAT_2D ? flow_item->output_format[0].format_2d.size[1] : 1,
+            args.pool_size[0],
+            args.pool_size[1],
+            args.pool_stride[0],
+            args.pool_stride[1],
+            args.center_offset[0],
+            args.center_offset[1],
+            batch,
+            nn_workflow_compile_0_function_int8_z_block(flow_item),
+            output_left_padding,
+            output_right_padding,
+            output_top_padding,
+            output_bottom_padding,
+            device);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8: {
+        auto &args = flow_item->arguments.normalization_response_across_maps_int8;
+
+        load_item->primitive = new int8_fixedpoint::normalization_response_across_maps_i8(
+            args.k,
+            args.n,
+            args.alpha,
+            args.beta,
+            args.input_scale,
+            args.output_scale,
+            get_format_size<0>(flow_item->output_format[0]),
+            get_format_size<1>(flow_item->output_format[0]),
+            get_format_size<2>(flow_item->output_format[0]),
+            batch,
+            nn_workflow_compile_0_function_int8_z_block(flow_item),
+            output_left_padding,
+            output_right_padding,
+            output_top_padding,
+            output_bottom_padding,
+            device);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32: {
+        auto &args = flow_item->arguments.forward_fully_connected_int8;
+        auto& input = flow_item->input[0];
+
+        assert(input.item->output_format[input.index].format == NN_DATA_FORMAT_1D ||
+                input.item->output_format[input.index].format == NN_DATA_FORMAT_3D);
+
+        // 4D weights cover whole input image, 2D weights need 1D input
+        bool use_3d_input = args.weights->dimension == 4;
+        const size_t input_w = use_3d_input ? args.weights->size[0] : 1;
+        const size_t input_h = use_3d_input ? args.weights->size[1] : 1;
+        const size_t num_input = use_3d_input ? args.weights->size[2] : args.weights->size[0];
+        const size_t num_output = use_3d_input ? args.weights->size[3] : args.weights->size[1];
+
+        if (load_item->type == NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8)
+            load_item->primitive = new int8_fixedpoint::fully_connected_i8<uint8_t>(
+                input_w, input_h, num_input, num_output,
+                args.activation,
+                args.quantization.input_scale,
+                args.quantization.input_zero_point,
+                args.quantization.output_scale,
+                batch,
+                nn_workflow_compile_0_function_int8_z_block(flow_item),
+                device);
+        else
+            load_item->primitive = new int8_fixedpoint::fully_connected_i8<float>(
+                input_w, input_h, num_input, num_output,
+                args.activation,
+                args.quantization.input_scale,
+                args.quantization.input_zero_point,
+                args.quantization.output_scale,
+                batch,
+                nn_workflow_compile_0_function_int8_z_block(flow_item),
+                device);
+        break;
+    }
     }
 }
 
@@ -889,6 +1118,226 @@ nn_workload_data_coords_t calculate_size(uint32_t batch, NN_WORKLOAD_DATA_TYPE t
     return nn_workload_data_coords_t( size_n, size_x, size_y, size_z, size_p, size_q );
 }
 
+/* Key of workflow item in fixed point configuration: its name; unnamed inputs are numbered, other unnamed items
+   have empty key and are not calibrated. */
+std::string nn_workflow_calibration_key(const nn_workflow_item_t *flow_item)
+{
+    if (flow_item->name != nullptr && *flow_item->name != '\0' && std::strcmp(flow_item->name, "unnamed") != 0)
+        return flow_item->name;
+    if (flow_item->type == NN_WORK_ITEM_TYPE_INPUT)
+        return "input" + std::to_string(flow_item->arguments.input.index);
+    return std::string();
+}
+
+/* float weights of workflow item, nullptr if it has none */
+const nn_data_t *nn_workflow_float_weights(const nn_workflow_item_t *flow_item)
+{
+    switch (flow_item->type)
+    {
+    case NN_WORK_ITEM_TYPE_CONVOLUTION:
+        return flow_item->arguments.forward_convolution.weights;
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED:
+        return flow_item->arguments.forward_fully_connected.weights;
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2:
+        return flow_item->arguments.forward_convolution_pooling_max_2x2_stride_2x2.weights;
+    default:
+        return nullptr;
+    }
+}
+
+int32_t nn_workflow_fixedpoint_fraction(
+    const nn_workflow_item_t *flow_item,
+    fixedpoint_calibration   *calibration,
+    bool                      unify_merged = true);
+
+/* Fractions of calibrated layer with int16 weights quantized by workflow builder. Accumulator fraction follows
+   calibrated input fraction, unless accumulator would then overflow on values of calibrated output range: weights
+   lose low bits in that case. Output is shifted right from accumulator, so it can't have more fractional bits. */
+struct nn_fixedpoint_layer_fractions
+{
+    int32_t weights_shift;
+    int32_t accumulator;
+    int32_t output;
+};
+
+nn_fixedpoint_layer_fractions nn_workflow_calibrated_fractions(
+    const nn_workflow_item_t                 *flow_item,
+    const nn_argument_activation_fixedpoint_t &activation,     /* fractions given in arguments */
+    int32_t                                   output_fraction, /* calibrated */
+    int32_t                                   output_bits,
+    fixedpoint_calibration                   &calibration)
+{
+    auto weights_fraction =
+        activation.fractions.accumulator - nn_workflow_fixedpoint_fraction(flow_item->input[0].item, nullptr);
+    auto input_fraction = nn_workflow_fixedpoint_fraction(flow_item->input[0].item, &calibration);
+    // int32 accumulator has 32 - output_bits more bits of range than output
+    auto accumulator_limit = output_fraction + 32 - output_bits;
+    auto calibrated_weights_fraction = std::max(std::min(weights_fraction, accumulator_limit - input_fraction), 0);
+    auto accumulator_fraction = input_fraction + calibrated_weights_fraction;
+    return {calibrated_weights_fraction - weights_fraction, accumulator_fraction, std::min(output_fraction, accumulator_fraction)};
+}
+
+/* Fractional bits of fixed point output of int16 workflow item, -1 if item doesn't output fixed point data.
+   With calibration, fractions configured for conversions (under key of their float input), convolutions, fully
+   connected layers and normalizations replace ones given in arguments. Merged buffer has single format, so items
+   feeding merge take the smallest fraction of all its inputs. Pooling, views and merges keep format of input. */
+int32_t nn_workflow_fixedpoint_fraction(
+    const nn_workflow_item_t *flow_item,
+    fixedpoint_calibration   *calibration,      /* nullptr: fractions given in arguments */
+    bool                      unify_merged)
+{
+    fixedpoint_calibration::layer_format format;
+    auto configured = [&](const nn_workflow_item_t *item) {
+        return calibration != nullptr && calibration->find(nn_workflow_calibration_key(item), format);
+    };
+    auto calibrated_output = [&](const nn_argument_activation_fixedpoint_t &activation, int32_t output_fraction, int32_t output_bits) {
+        return nn_workflow_calibrated_fractions(flow_item, activation, output_fraction, output_bits, *calibration).output;
+    };
+
+    int32_t fraction;
+    switch (flow_item->type)
+    {
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_INT16_FIXEDPOINT:
+        fraction = configured(flow_item->input[0].item)
+            ? format.output_fraction
+            : flow_item->arguments.forward_convert_float_to_int16_fixedpoint.output_fraction;
+        break;
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT: {
+        auto &activation = flow_item->arguments.forward_convolution_int16_fixedpoint.activation;
+        fraction = configured(flow_item)
+            ? calibrated_output(activation, format.output_fraction, 16)
+            : activation.fractions.output;
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT: {
+        auto &activation = flow_item->arguments.forward_convolution_pooling_fixedpoint.activation;
+        fraction = configured(flow_item)
+            ? calibrated_output(activation, format.output_fraction, 16)
+            : activation.fractions.output;
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN: {
+        auto &activation = flow_item->arguments.fully_connected_forward_i16qn_i16qn.activation;
+        fraction = configured(flow_item)
+            ? calibrated_output(activation, format.output_fraction, 16)
+            : activation.fractions.output;
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN: {
+        // int32 output has 16 more bits of range than int16 one calibrated
+        auto &activation = flow_item->arguments.fully_connected_forward_i16qn_i32qn.activation;
+        fraction = configured(flow_item)
+            ? calibrated_output(activation, std::min(format.output_fraction + 16, 30), 32)
+            : activation.fractions.output;
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN:
+        fraction = configured(flow_item)
+            ? format.output_fraction
+            : flow_item->arguments.normalization_response_across_maps_forward_i16qn.fractions.output;
+        break;
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT16_FIXEDPOINT:
+    case NN_WORK_ITEM_TYPE_VIEW:
+    case NN_WORK_ITEM_TYPE_MERGE:
+        return nn_workflow_fixedpoint_fraction(flow_item->input[0].item, calibration);
+    default:
+        return -1;
+    }
+
+    if (calibration != nullptr && unify_merged)
+        for (uint32_t use = 0; use < flow_item->use_count; ++use)
+        {
+            auto merge = flow_item->use[use].item;
+            if (merge->type != NN_WORK_ITEM_TYPE_MERGE)
+                continue;
+            for (uint32_t input = 0; input < merge->input_count; ++input)
+                fraction = std::min(fraction, nn_workflow_fixedpoint_fraction(merge->input[input].item, calibration, false));
+        }
+    return fraction;
+}
+
+/* Shifts of int16 weights and int32 biases of layer, quantized by workflow builder, to format of calibrated layer. */
+struct nn_fixedpoint_rescale
+{
+    int32_t weights;
+    int32_t biases;
+};
+
+/* Returns copy of int16 workflow item with fractions taken from fixed point configuration, or empty pointer if
+   configuration has nothing for the item. Parameters have to be shifted to new formats as given in rescale. */
+std::unique_ptr<nn_workflow_item_t> nn_workflow_calibrated_item(
+    const nn_workflow_item_t *flow_item,
+    fixedpoint_calibration   &calibration,
+    nn_fixedpoint_rescale    &rescale)
+{
+    rescale = {0, 0};
+    if (calibration.empty())
+        return nullptr;
+
+    std::unique_ptr<nn_workflow_item_t> calibrated(new nn_workflow_item_t(*flow_item));
+    auto &arguments = calibrated->arguments;
+    auto output_fraction = [&]() { return nn_workflow_fixedpoint_fraction(flow_item, &calibration); };
+    auto input_fraction = [&]() { return nn_workflow_fixedpoint_fraction(flow_item->input[0].item, &calibration); };
+    auto update_activation = [&](nn_argument_activation_fixedpoint_t &activation, int32_t output_bits) {
+        auto fractions = nn_workflow_calibrated_fractions(flow_item, activation, output_fraction(), output_bits, calibration);
+        rescale.weights = fractions.weights_shift;
+        rescale.biases = fractions.accumulator - activation.fractions.accumulator;
+        activation.fractions.accumulator = static_cast<uint16_t>(fractions.accumulator);
+        activation.fractions.output = static_cast<uint16_t>(fractions.output);
+    };
+
+    switch (flow_item->type)
+    {
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_INT16_FIXEDPOINT:
+        arguments.forward_convert_float_to_int16_fixedpoint.output_fraction = static_cast<int8_t>(output_fraction());
+        break;
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT:
+        update_activation(arguments.forward_convolution_int16_fixedpoint.activation, 16);
+        break;
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT:
+        update_activation(arguments.forward_convolution_pooling_fixedpoint.activation, 16);
+        break;
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
+        update_activation(arguments.fully_connected_forward_i16qn_i16qn.activation, 16);
+        break;
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN:
+        update_activation(arguments.fully_connected_forward_i16qn_i32qn.activation, 32);
+        break;
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN:
+        arguments.normalization_response_across_maps_forward_i16qn.fractions.input = static_cast<uint16_t>(input_fraction());
+        arguments.normalization_response_across_maps_forward_i16qn.fractions.output = static_cast<uint16_t>(output_fraction());
+        break;
+    case NN_WORK_ITEM_TYPE_SOFTMAX_FIXEDPOINT:
+        arguments.forward_softmax_fixedpoint.input_fraction = static_cast<int8_t>(input_fraction());
+        break;
+    default:
+        return nullptr;
+    }
+
+    if (std::memcmp(&calibrated->arguments, &flow_item->arguments, sizeof(flow_item->arguments)) == 0)
+        return nullptr;
+    return calibrated;
+}
+
+/* shifts fixed point values by given number of bits, rounding to nearest when shifting right and saturating
+   when shifting left */
+template <typename T_int>
+void nn_workload_data_shift_fixedpoint(nn_workload_data_t *data, int32_t shift)
+{
+    auto values = static_cast<T_int *>(data->parent->data_buffer);
+    auto count = data->parent->buffer_size / sizeof(T_int);
+    for (size_t index = 0; index < count; ++index)
+    {
+        int64_t value = values[index];
+        if (shift > 0)
+            value = std::min<int64_t>(std::max<int64_t>(value * (int64_t(1) << shift), std::numeric_limits<T_int>::min()),
+                                     std::numeric_limits<T_int>::max());
+        else
+            value = (value + (int64_t(1) << (-shift - 1))) >> -shift;
+        values[index] = static_cast<T_int>(value);
+    }
+}
+
 template <typename T_FindLoadItem>
 void nn_workflow_compile_0_function_copy_item(
              nn_workload_item_t *load_item,
@@ -900,6 +1349,12 @@ void nn_workflow_compile_0_function_copy_item(
              nn_device_internal *device
              ) {
 
+    // fractions of int16 layers calibrated on float workloads (NN_PARAMETER_FIXEDPOINT_CONFIGURATION)
+    nn_fixedpoint_rescale rescale;
+    auto calibrated_item = nn_workflow_calibrated_item(flow_item, device->calibration, rescale);
+    if (calibrated_item)
+        flow_item = calibrated_item.get();
+
     // copy name
     load_item->name = flow_item->name;
 
@@ -1166,6 +1621,12 @@ void nn_workflow_compile_0_function_copy_item(
     case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
     case NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT:
     case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT:
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8:
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8:
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8:
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32:
     {
         load_item->output[0] = load_item->primitive->create_outputs()[0];
         break;
@@ -1256,6 +1717,9 @@ void nn_workflow_compile_0_function_copy_item(
         else
             load_item->arguments.input.copy_on_merge = false;
     }
+    if( NN_WORK_ITEM_TYPE_OUTPUT == flow_item->type ) {
+        load_item->arguments.output.aliased = false;
+    }
 
     switch(load_item->type) {
     case NN_WORK_ITEM_TYPE_CONVOLUTION: {
@@ -1342,11 +1806,38 @@ void nn_workflow_compile_0_function_copy_item(
 
         break;
     }
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32: {
+        auto parameters = load_item->primitive->create_parameters();
+        bool is_convolution = load_item->type == NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+        auto weights = is_convolution ? flow_item->arguments.forward_convolution_int8.weights : flow_item->arguments.forward_fully_connected_int8.weights;
+        auto biases = is_convolution ? flow_item->arguments.forward_convolution_int8.biases : flow_item->arguments.forward_fully_connected_int8.biases;
+        auto &quantization = is_convolution ? flow_item->arguments.forward_convolution_int8.quantization : flow_item->arguments.forward_fully_connected_int8.quantization;
+
+        copy_data(device, parameters[0], weights);
+        if (biases)
+            copy_data(device, parameters[1], biases);
+        else
+            memset(parameters[1]->parent->data_buffer, 0, parameters[1]->parent->buffer_size);
+        copy_data(device, parameters[2], quantization.weights_scale);
+
+        load_item->parameters.resize(parameters.size());
+        for (size_t i = 0; i < parameters.size(); ++i)
+            load_item->parameters[i] = parameters[i];
+
+        break;
+    }
     default:
         // This is the case when all workflow item arguments are empty or do not contain buffers.
         ;
     }
 
+    // int16 weights and int32 biases of int16 layers were quantized with fractions given in arguments
+    if (rescale.weights != 0)
+        nn_workload_data_shift_fixedpoint<int16_t>(load_item->parameters[0], rescale.weights);
+    if (rescale.biases != 0)
+        nn_workload_data_shift_fixedpoint<int32_t>(load_item->parameters[1], rescale.biases);
 }
 
 template <typename T_FlowUpdateFunc>
@@ -1384,13 +1875,17 @@ void add_conversions_to_batch_block(
         auto input_data = input_descr.get_data_view();
         if (input_data->parent->layout == (nn::data_helper<NN_WORKLOAD_DATA_TAG_NBLOCKZXYN, nn::layout_nblockzxyn_f32>::layout))
             continue;
-        if (input_data->parent->layout != (nn::data_helper<NN_WORKLOAD_DATA_TAG_ZXYN, nn::layout_zxyn_f32>::layout))
+        nn_workload_item_t *conversion = nullptr;
+        if (input_data->parent->layout == (nn::data_helper<NN_WORKLOAD_DATA_TAG_ZXYN, nn::layout_zxyn_f32>::layout))
+            conversion = create_to_batch_block_conversion(
+                input_descr,
+                get_length(*input_data, NN_DATA_COORD_x),
+                get_length(*input_data, NN_DATA_COORD_y),
+                get_length(*input_data, NN_DATA_COORD_z));
+        else if (input_data->parent->layout == (nn::data_helper<NN_WORKLOAD_DATA_TAG_NX, nn::layout_nx_f32>::layout))
+            conversion = create_to_batch_block_conversion(input_descr, 1, 1, get_length(*input_data, NN_DATA_COORD_x));
+        else
             throw std::runtime_error("implementation error: invalid input data layout for conversion to batch block layout");
-        auto conversion = create_to_batch_block_conversion(
-            input_descr,
-            get_length(*input_data, NN_DATA_COORD_x),
-            get_length(*input_data, NN_DATA_COORD_y),
-            get_length(*input_data, NN_DATA_COORD_z));
 
         update_flow(conversion, load_item);
         input_descr.item = conversion;
@@ -1490,15 +1985,12 @@ void nn_workflow_compile_add_batch_block_conversions(
         for (auto input_descr : elem.first->input)
             if (input_descr.item == load_item)
                 used_by.push_back(elem.first);
-    if (batch % BATCH_ACCEPTED_BLOCK == 0)
+    if (load_item->output.empty()) return;
+    if (load_item->output.front()->parent->layout == nn::data_helper<NN_WORKLOAD_DATA_TAG_NBLOCKZXYN, nn::layout_nblockzxyn_f32>::layout)
     {
-        if (load_item->output.empty()) return;
-        if (load_item->output.front()->parent->layout == nn::data_helper<NN_WORKLOAD_DATA_TAG_NBLOCKZXYN, nn::layout_nblockzxyn_f32>::layout)
-        {
-            if (load_item->type != NN_WORK_ITEM_TYPE_MERGE)
-                add_conversions_to_batch_block(load_item, update_flow, batch, device);
-            add_conversions_from_batch_block(load_item, update_flow, used_by, batch, device);
-        }
+        if (load_item->type != NN_WORK_ITEM_TYPE_MERGE)
+            add_conversions_to_batch_block(load_item, update_flow, batch, device);
+        add_conversions_from_batch_block(load_item, update_flow, used_by, batch, device);
     }
 }
 
@@ -1931,6 +2423,12 @@ std::string str(NN_WORK_ITEM_TYPE type)
     case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN: return "NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN";
     case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2: return "NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2";
     case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT: return "NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT";
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8: return "NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8";
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8: return "NN_WORK_ITEM_TYPE_CONVOLUTION_INT8";
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8: return "NN_WORK_ITEM_TYPE_MAX_POOLING_INT8";
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8: return "NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8";
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8: return "NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8";
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32: return "NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32";
     case NN_WORK_ITEM_TYPE_CONVERT_DATA_LAYOUT: return "NN_WORK_ITEM_TYPE_CONVERT_DATA_LAYOUT";
     default: return "unknown";
     }
@@ -1979,28 +2477,442 @@ void nn_merge_layer_if_beneficial(
     all_items.erase(it);
 }
 
-} //namespace
-
-/* compile workflow into workload */
-NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
-    nn_workload_t         **workload,       /* resulting workload */
-    nn_device_t            *device,         /* device context */
-    nn_workflow_t          *workflow,       /* workflow to be compiled */
-    NN_WORKLOAD_DATA_TYPE  *input_format,   /* array containing formats of inputs */
-    NN_WORKLOAD_DATA_TYPE  *output_format,  /* array containing formats of outputs */
-    uint32_t                batch           /* batch size for compilation */
-    )
+/* Convolution used only by response normalization across maps, which is used only by max pooling, becomes single
+   item computing all three in tiles of pooled rows. Convolution item keeps its parameters and takes output and
+   flow item of pooling, items of normalization and pooling are removed from flow and deleted. */
+template <typename T_Flow>
+void nn_merge_convolution_normalization_pooling_if_beneficial(
+    nn_workload_item_t* load_item,
+    T_Flow&             all_items)
 {
-    if(!workload || !device || !workflow) return NN_API_STATUS_ERROR_INVALID_POINTER;
+    if (load_item->type != NN_WORK_ITEM_TYPE_CONVOLUTION) return;
 
-    for(auto index=0u; index<workflow->input_count; ++index)
-        if(workflow->input[index] ->type!=NN_WORK_ITEM_TYPE_INPUT)
-            return NN_API_STATUS_ERROR_INVALID_WORKFLOW; // TODO: more granular error code here
-    for(auto index=0u; index<workflow->output_count; ++index)
-        if(workflow->output[index]->type!=NN_WORK_ITEM_TYPE_OUTPUT)
-            return NN_API_STATUS_ERROR_INVALID_WORKFLOW; // TODO: more granular error code here
+    auto single_use = [&](nn_workload_item_t* item) -> nn_workload_item_t* {
+            nn_workload_item_t* next_item = nullptr;
+            for (auto elem : all_items)
+                for (auto input_descr : elem.first->input)
+                    if (input_descr.item == item)
+                    {
+                        if (next_item != nullptr || input_descr.index != 0) return nullptr;
+                        next_item = elem.first;
+                    }
+            return next_item;
+        };
+
+    auto normalization_item = single_use(load_item);
+    if (not normalization_item || normalization_item->type != NN_WORK_ITEM_TYPE_NORMALIZATION) return;
+    auto pooling_item = single_use(normalization_item);
+    if (not pooling_item || pooling_item->type != NN_WORK_ITEM_TYPE_POOLING) return;
+
+    // learning keeps intermediate outputs and reaches buffers of forward items directly
+    if (load_item->output.size() != 1 || normalization_item->output.size() != 1 || pooling_item->output.size() != 1) return;
+    for (auto elem : all_items)
+        if (elem.first->forward_item == load_item ||
+            elem.first->forward_item == normalization_item ||
+            elem.first->forward_item == pooling_item)
+            return;
+
+    auto conv_primitive = dynamic_cast<layer::convolution_f32*>(load_item->primitive);
+    auto normalization_primitive = dynamic_cast<layer::normalization_response_across_maps_f32*>(normalization_item->primitive);
+    auto pooling_primitive = dynamic_cast<layer::pooling_f32*>(pooling_item->primitive);
+    if (not conv_primitive || not normalization_primitive || not pooling_primitive) return;
+    if (not layer::convolution_normalization_pooling_f32::can_fuse(conv_primitive, normalization_primitive, pooling_primitive)) return;
+
+    load_item->primitive = new layer::convolution_normalization_pooling_f32(
+        std::unique_ptr<layer::convolution_f32>(conv_primitive),
+        std::unique_ptr<layer::normalization_response_across_maps_f32>(normalization_primitive),
+        std::unique_ptr<layer::pooling_f32>(pooling_primitive));
+    normalization_item->primitive = nullptr;
+    pooling_item->primitive = nullptr;
+
+    delete load_item->output[0];
+    load_item->output[0] = pooling_item->output[0];
+    pooling_item->output[0] = nullptr;
+    delete normalization_item->output[0];
+
+    for (auto elem : all_items)
+        for (auto &input_descr : elem.first->input)
+            if (input_descr.item == pooling_item)
+                input_descr.item = load_item;
+
+    auto find = [&](nn_workload_item_t* item) {
+            auto it = std::find_if(all_items.begin(), all_items.end(),
+                [&](decltype(all_items.front()) elem){ return elem.first == item; });
+            assert(it != all_items.end());
+            return it;
+        };
+    find(load_item)->second = find(pooling_item)->second;
+    all_items.erase(find(normalization_item));
+    all_items.erase(find(pooling_item));
+
+    delete normalization_item;
+    delete pooling_item;
+}
+
+/* Learning workloads reach buffers of forward items through forward_item links and
+   update parameters in place, so not all their dependencies are visible through inputs. */
+bool nn_workload_is_learning(nn_workload_opaque_t *workload_opaque)
+{
+    for (auto item : workload_opaque->order_of_execution)
+        if (item->forward_item != nullptr ||
+            item->type == NN_WORK_ITEM_TYPE_LOSS_FUNCTION ||
+            item->type == NN_WORK_ITEM_TYPE_AVERAGE_DELTAS ||
+            item->type == NN_WORK_ITEM_TYPE_UPDATE_ARGUMENTS)
+            return true;
+    return false;
+}
+
+/* Packs intermediate buffers of workload into single arena.
+   Buffer is live from first to last item in order of execution that references it.
+   Buffers with disjoint lifetimes share memory of arena. Items touching buffer that reuses memory
+   get all items touching previous occupant as predecessors, so concurrent execution stays safe. */
+void nn_workflow_compile_0_function_plan_memory(
+    nn_workload_opaque_t             *workload_opaque,
+    std::vector<std::set<size_t>>    &predecessors     /* per item in order of execution */
+    )
+{
+    struct buffer_lifetime {
+        nn_workload_data_t *view;       // any view of buffer produced by workload item
+        uint32_t            view_count; // views of buffer owned by workload items
+        bool                full_view;  // at least one view covers whole buffer (no paddings)
+        size_t              first;
+        size_t              last;
+        size_t              size;
+        size_t              offset;
+        std::set<size_t>    users;      // positions of items referencing buffer
+    };
+
+    auto &order = workload_opaque->order_of_execution;
+
+    if (nn_workload_is_learning(workload_opaque)) return;
+
+    auto covers_whole_buffer = [](const nn_workload_data_t *view) {
+        for (auto dim = 0; dim < view->parent->dimension; ++dim)
+            if (view->view_begin.t[dim] != 0 || view->view_end.t[dim] + 1 != view->parent->lengths.t[dim])
+                return false;
+        return true;
+    };
+
+    std::vector<buffer_lifetime> buffers;
+    std::unordered_map<nn_workload_data_core_t *, size_t> buffer_index;
+    std::vector<const uint8_t *> client_buffers;
+
+    auto reference = [&](nn_workload_data_t *view, size_t position, bool owned_by_item) {
+        if (view == nullptr) return;
+        auto core = view->parent.get();
+
+        if (core->use_client_buffer && core->data_buffer != nullptr)
+            client_buffers.push_back(static_cast<const uint8_t *>(core->data_buffer));
+
+        auto found = buffer_index.find(core);
+        if (found == buffer_index.end())
+        {
+            found = buffer_index.emplace(core, buffers.size()).first;
+            buffers.push_back({view, 0, false, position, position, nn_aligned_size(core->buffer_size), 0, {}});
+        }
+
+        auto &buffer = buffers[found->second];
+        buffer.first = std::min(buffer.first, position);
+        buffer.last = std::max(buffer.last, position);
+        buffer.users.insert(position);
+        if (owned_by_item)
+        {
+            ++buffer.view_count;
+            buffer.full_view |= covers_whole_buffer(view);
+        }
+    };
+
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        for (auto &input : order[position]->input)
+            reference(input.get_data_view(), position, false);
+        for (auto output : order[position]->output)
+            reference(output, position, true);
+    }
+
+    // Only buffers allocated by workload, referenced solely by its items and not aliased
+    // by client-buffer views can be moved. Paddings must keep zeros set at compilation.
+    std::vector<buffer_lifetime *> planned;
+    for (auto &buffer : buffers)
+    {
+        auto core = buffer.view->parent.get();
+        if (core->use_client_buffer || core->data_buffer == nullptr || core->delta_buffer != nullptr) continue;
+        if (!buffer.full_view || buffer.view->parent.use_count() != buffer.view_count) continue;
+
+        auto begin = static_cast<const uint8_t *>(core->data_buffer);
+        auto aliased = std::any_of(client_buffers.begin(), client_buffers.end(),
+            [&](const uint8_t *client) { return client >= begin && client < begin + core->buffer_size; });
+        if (aliased) continue;
+
+        planned.push_back(&buffer);
+    }
+
+    if (planned.size() < 2) return;
+
+    // Greedy placement: biggest buffers first, each at lowest offset free during its lifetime.
+    std::stable_sort(planned.begin(), planned.end(),
+        [](const buffer_lifetime *lhs, const buffer_lifetime *rhs) { return lhs->size > rhs->size; });
+
+    size_t arena_size = 0, separate_size = 0;
+    for (auto it = planned.begin(); it != planned.end(); ++it)
+    {
+        auto buffer = *it;
+
+        std::vector<buffer_lifetime *> conflicting;
+        for (auto placed = planned.begin(); placed != it; ++placed)
+            if ((*placed)->first <= buffer->last && buffer->first <= (*placed)->last)
+                conflicting.push_back(*placed);
+        std::sort(conflicting.begin(), conflicting.end(),
+            [](const buffer_lifetime *lhs, const buffer_lifetime *rhs) { return lhs->offset < rhs->offset; });
+
+        buffer->offset = 0;
+        for (auto placed : conflicting)
+        {
+            if (buffer->offset + buffer->size <= placed->offset) break;
+            buffer->offset = std::max(buffer->offset, placed->offset + placed->size);
+        }
+
+        arena_size = std::max(arena_size, buffer->offset + buffer->size);
+        separate_size += buffer->size;
+    }
+
+    if (arena_size >= separate_size) return;
+
+    auto arena = static_cast<uint8_t *>(nn_allocate_aligned(arena_size));
+    if (arena == nullptr) throw std::bad_alloc();
+
+    for (auto buffer : planned)
+    {
+        auto core = buffer->view->parent.get();
+        nn_free_aligned(core->data_buffer);
+        core->data_buffer = arena + buffer->offset;
+        core->use_client_buffer = true;
+    }
+
+    for (auto buffer : planned)
+        for (auto previous : planned)
+        {
+            auto memory_shared = previous->offset < buffer->offset + buffer->size &&
+                                 buffer->offset < previous->offset + previous->size;
+            if (!memory_shared || previous->last >= buffer->first) continue;
+
+            for (auto user : buffer->users)
+                predecessors[user].insert(previous->users.begin(), previous->users.end());
+        }
+
+    workload_opaque->activation_arena = arena;
+    workload_opaque->activation_arena_size = arena_size;
+}
+
+/* Makes producers of outputs write directly to buffers passed to execution, so results are not copied.
+   Producer's buffer is replaced by buffer of output when both have the same lengths, layout and view, it is owned
+   by producer and no other item shares it (views, merges, in-place layers). Done after prepare_forward, so primitives bound to buffers they
+   were prepared for are recognized and keep them. */
+void nn_workflow_compile_0_function_alias_outputs(nn_workload_opaque_t *workload_opaque)
+{
+    if (nn_workload_is_learning(workload_opaque)) return;
+
+    for (auto item : workload_opaque->output)
+    {
+        if (item->type != NN_WORK_ITEM_TYPE_OUTPUT || item->input.size() != 1) continue;
+
+        auto producer = item->input[0].item;
+        auto producer_view = item->input[0].get_data_view();
+        auto output_view = item->output[0];
+        if (producer->type == NN_WORK_ITEM_TYPE_INPUT || producer->type == NN_WORK_ITEM_TYPE_VIEW) continue;
+        if (producer->primitive != nullptr && producer->primitive->forward_bound_to_prepared_buffers()) continue;
+        if (producer_view->parent.use_count() != 1 || producer_view->parent->delta_buffer != nullptr) continue;
+
+        // buffer borrowed from other item (eg. batch conversion of single picture is just a view)
+        if (producer_view->parent->use_client_buffer) continue;
+
+        auto &source = *producer_view->parent;
+        auto &destination = *output_view->parent;
+        if (source.data_type_size != destination.data_type_size
+            || source.lengths != destination.lengths
+            || !(source.layout == destination.layout)
+            || producer_view->view_begin != output_view->view_begin
+            || producer_view->view_end != output_view->view_end)
+            continue;
+
+        producer_view->parent = output_view->parent;
+        item->arguments.output.aliased = true;
+    }
+}
+
+/* Builds dependency graph over order of execution: item depends on producers of its inputs
+   and on predecessors found earlier (memory reuse). Workload is executed in parallel only when
+   graph has independent branches. */
+void nn_workflow_compile_0_function_build_dependencies(
+    nn_workload_opaque_t             *workload_opaque,
+    std::vector<std::set<size_t>>    &predecessors     /* per item in order of execution */
+    )
+{
+    auto &order = workload_opaque->order_of_execution;
+
+    std::unordered_map<nn_workload_item_t *, size_t> position_of;
+    for (size_t position = 0; position < order.size(); ++position)
+        position_of[order[position]] = position;
+
+    for (size_t position = 0; position < order.size(); ++position)
+        for (auto &input : order[position]->input)
+        {
+            auto producer = position_of.find(input.item);
+            if (producer != position_of.end())
+                predecessors[position].insert(producer->second);
+        }
+
+    workload_opaque->item_successors.assign(order.size(), {});
+    workload_opaque->item_predecessor_count.assign(order.size(), 0);
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        workload_opaque->item_predecessor_count[position] = static_cast<uint32_t>(predecessors[position].size());
+        for (auto predecessor : predecessors[position])
+            workload_opaque->item_successors[predecessor].push_back(position);
+    }
+
+    auto roots = std::count(workload_opaque->item_predecessor_count.begin(), workload_opaque->item_predecessor_count.end(), 0u);
+    auto branching = std::any_of(workload_opaque->item_successors.begin(), workload_opaque->item_successors.end(),
+        [](const std::vector<size_t> &successors) { return successors.size() > 1; });
+
+    workload_opaque->parallel_execution =
+        !ENABLE_WORKLOAD_MONITORING && !nn_workload_is_learning(workload_opaque) && (roots > 1 || branching);
+
+#if ENABLE_WORKLOAD_PROFILING
+    for (auto item : order)
+        workload_opaque->profiling_data.work_item_cycles[item];
+#endif
+}
+
+/* Splits batch between NUMA worker groups. Slices are multiples of batch block (or of 8 pictures) when batch
+   allows it, so replicas keep blocked primitives and aligned buffers; groups left without pictures get 0. */
+std::vector<uint32_t> nn_workflow_compile_0_function_numa_slices(uint32_t batch, size_t group_count)
+{
+    const uint32_t unit = (batch % BATCH_ACCEPTED_BLOCK == 0) ? BATCH_ACCEPTED_BLOCK : (batch % 8 == 0) ? 8 : 1;
+    const size_t units = batch / unit;
+
+    std::vector<uint32_t> slices;
+    for (size_t group = 0; group < group_count; ++group)
+        slices.push_back(static_cast<uint32_t>((units * (group + 1) / group_count - units * group / group_count) * unit));
+    return slices;
+}
+
+/* Waits for all futures, then rethrows first failure - tasks reference state of caller until they finish. */
+void nn_wait_for_all(std::vector<std::future<void>> &tasks)
+{
+    std::exception_ptr failure;
+    for (auto &task : tasks)
+        try
+        {
+            task.get();
+        }
+        catch (...)
+        {
+            if (!failure)
+                failure = std::current_exception();
+        }
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+/* Compiles replica of workflow on each NUMA worker group for its slice of batch.
+   Replica is compiled by thread pinned to its group, so weights copied and buffers cleared during compilation
+   are placed in memory of group's node (first touch policy). Learning workflows are not split - replicas would
+   learn separately - false is returned for them and workload has to be compiled for whole device. */
+bool nn_workflow_compile_0_function_on_numa_groups(
+    nn_workload_opaque_t                                   *workload_opaque,
+    nn_workflow_t                                          *workflow,
+    NN_WORKLOAD_DATA_TYPE                                  *input_format,
+    NN_WORKLOAD_DATA_TYPE                                  *output_format,
+    const std::vector<std::shared_ptr<nn_device_internal>> &groups)
+{
+    auto slices = nn_workflow_compile_0_function_numa_slices(workload_opaque->batch, groups.size());
+    std::vector<nn_workload_t *> replicas(groups.size(), nullptr);
+    std::vector<std::future<void>> compilations;
+    for (size_t group = 0; group < groups.size(); ++group)
+        if (slices[group] != 0)
+            compilations.push_back(groups[group]->request_dispatcher.run([&, group]() {
+                if (nn_workflow_compile_0_function(
+                        &replicas[group], groups[group].get(), workflow, input_format, output_format, slices[group])
+                    != NN_API_STATUS_OK)
+                    throw std::bad_alloc();
+            }));
+
+    auto delete_replicas = [&]() {
+        for (auto replica : replicas)
+            if (replica != nullptr)
+                nn_workload_delete_0_function(replica);
+    };
     try
     {
+        nn_wait_for_all(compilations);
+    }
+    catch (...)
+    {
+        delete_replicas();
+        throw;
+    }
+
+    auto first_replica = std::find_if(replicas.begin(), replicas.end(), [](nn_workload_t *replica) { return replica != nullptr; });
+    if (nn_workload_is_learning(static_cast<nn_workload_opaque_t *>(*first_replica)))
+    {
+        delete_replicas();
+        return false;
+    }
+
+    for (size_t group = 0; group < groups.size(); ++group)
+        if (replicas[group] != nullptr)
+        {
+            workload_opaque->numa_workloads.push_back(static_cast<nn_workload_opaque_t *>(replicas[group]));
+            workload_opaque->numa_groups.push_back(groups[group]);
+        }
+    return true;
+}
+
+} //namespace
+
+/* items of workflow in order they are executed by compiled workload */
+std::vector<nn_workflow_item_t*> nn_workflow_items_in_execution_order(nn_workflow_t* workflow)
+{
+    return flow_items_in_execution_order(workflow);
+}
+
+/* true if workflow compiled for given batch uses batch block primitives */
+bool nn_workflow_uses_batch_block(uint32_t batch)
+{
+    return nn_workflow_compile_0_function_use_batch_block(batch);
+}
+
+/* compile workflow into workload */
+NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
+    nn_workload_t         **workload,       /* resulting workload */
+    nn_device_t            *device,         /* device context */
+    nn_workflow_t          *workflow,       /* workflow to be compiled */
+    NN_WORKLOAD_DATA_TYPE  *input_format,   /* array containing formats of inputs */
+    NN_WORKLOAD_DATA_TYPE  *output_format,  /* array containing formats of outputs */
+    uint32_t                batch           /* batch size for compilation */
+    )
+{
+    if(!workload || !device || !workflow) return NN_API_STATUS_ERROR_INVALID_POINTER;
+
+    for(auto index=0u; index<workflow->input_count; ++index)
+        if(workflow->input[index] ->type!=NN_WORK_ITEM_TYPE_INPUT)
+            return NN_API_STATUS_ERROR_INVALID_WORKFLOW; // TODO: more granular error code here
+    for(auto index=0u; index<workflow->output_count; ++index)
+        if(workflow->output[index]->type!=NN_WORK_ITEM_TYPE_OUTPUT)
+            return NN_API_STATUS_ERROR_INVALID_WORKFLOW; // TODO: more granular error code here
+    try
+    {
+        // kernels generated by earlier processes are taken from cache by prepare_forward
+        auto &jit_cache = static_cast<nn_device_internal *>(device)->jit_cache;
+        jit_cache.load();
+        // layers are tuned when their primitives are created, decisions of earlier compiles are reused
+        auto &tuner = static_cast<nn_device_internal *>(device)->tuner;
+        tuner.load();
+        // int16 layers take fractions calibrated on float workloads, float workloads may record new ranges
+        auto &calibration = static_cast<nn_device_internal *>(device)->calibration;
+        calibration.load();
+
         nn_workload_t aux = {
             device,
             workflow->input_count,
@@ -2013,6 +2925,20 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
         std::copy(input_format, input_format + workflow->input_count, workload_opaque->input_format);
         std::copy(output_format, output_format + workflow->output_count, workload_opaque->output_format);
 
+        // with NUMA execution enabled workload only dispatches slices of batch to replicas compiled by worker groups
+        std::vector<std::shared_ptr<nn_device_internal>> numa_groups;
+        {
+            auto device_internal = static_cast<nn_device_internal *>(device);
+            std::lock_guard<std::mutex> lock(device_internal->numa_mutex);
+            numa_groups = device_internal->numa_groups;
+        }
+        if (!numa_groups.empty() &&
+            nn_workflow_compile_0_function_on_numa_groups(workload_opaque, workflow, input_format, output_format, numa_groups))
+        {
+            *workload = workload_opaque;
+            return NN_API_STATUS_OK;
+        }
+
         auto whole_flow = flow_items_in_execution_order(workflow);
         std::vector<std::pair<nn_workload_item_t*, nn_workflow_item_t*>> flow_and_load;
         std::transform(whole_flow.begin(), whole_flow.end(), std::back_inserter(flow_and_load),
@@ -2034,11 +2960,27 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
                 batch,
                 find_load_item,
                 reinterpret_cast<nn_device_internal*>(device));
+
+        if (calibration.get_enabled())
+            for (auto& elem : flow_and_load)
+            {
+                auto key = nn_workflow_calibration_key(elem.second);
+                if (key.empty() || elem.second->forward_item != nullptr)
+                    continue;
+                workload_opaque->calibration_keys[elem.first] = key;
+                if (auto weights = nn_workflow_float_weights(elem.second))
+                    calibration.record_weights(key, weights);
+            }
         
         auto flow_and_load_merged = flow_and_load;
         for (auto& elem : flow_and_load)
             nn_merge_layer_if_beneficial(elem.first, flow_and_load_merged);
 
+        // calibrating workloads record ranges of every layer, so they keep layers separate
+        if (!calibration.get_enabled())
+            for (size_t index = 0; index < flow_and_load_merged.size(); ++index)
+                nn_merge_convolution_normalization_pooling_if_beneficial(flow_and_load_merged[index].first, flow_and_load_merged);
+
         auto flow_and_load_with_conversions = flow_and_load_merged;
         for (auto& elem : flow_and_load_merged)
             nn_workflow_compile_add_batch_block_conversions(
@@ -2060,6 +3002,11 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
                        std::back_inserter(workload_opaque->order_of_execution),
                        [](std::pair<nn_workload_item_t*, nn_workflow_item_t*> elem){ return elem.first; });
 
+        // Intermediate buffers are moved to shared arena before primitives get prepared for them.
+        std::vector<std::set<size_t>> predecessors(workload_opaque->order_of_execution.size());
+        nn_workflow_compile_0_function_plan_memory(workload_opaque, predecessors);
+        nn_workflow_compile_0_function_build_dependencies(workload_opaque, predecessors);
+
         // Now create param list.
         for(auto item : workload_opaque->order_of_execution)
         {
@@ -2162,6 +3109,20 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
             std::vector<const nn_workload_data_t *> params(item->parameters.begin(), item->parameters.end());
             item->primitive->prepare_forward(inputs, params, item->output);
         }
+        jit_cache.save();
+        tuner.save();
+        nn_workflow_compile_0_function_alias_outputs(workload_opaque);
+
+        // Executions may run concurrently on private buffers unless they are learning or some primitive
+        // can work only on buffers it was prepared for.
+        workload_opaque->concurrent_execution =
+            !ENABLE_WORKLOAD_MONITORING && !nn_workload_is_learning(workload_opaque) &&
+            std::none_of(workload_opaque->order_of_execution.begin(), workload_opaque->order_of_execution.end(),
+                [](nn_workload_item_t *item) {
+                    return item->primitive != nullptr && item->primitive->forward_bound_to_prepared_buffers();
+                });
+        if (workload_opaque->concurrent_execution)
+            workload_opaque->idle_contexts.push_back(&workload_opaque->primary_context);
 
         // set result
         *workload = workload_opaque;
@@ -2179,6 +3140,503 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_compile_0_function(
     return NN_API_STATUS_OK;
 }
 
+namespace
+{
+/* runs single work item of workload on calling thread
+   Items of learning workloads are run only in primary context, so they access item buffers directly. */
+void nn_workload_execute_item(
+    nn_workload_opaque_t          *workload_opaque, /* workload to be run */
+    nn_workload_execution_context *context,         /* buffers of this execution */
+    nn_workload_item_t            *item,            /* work item to be run */
+    void *                        *input,           /* array of pointers with input data */
+    void *                        *output           /* array of pointers with output data */
+    ) {
+#if ENABLE_WORKLOAD_PROFILING
+    auto t0 = __rdtsc();
+#endif
+
+    std::vector<nn_workload_data_t *> outputs;
+    for (auto view : item->output)
+        outputs.push_back(context->view(view));
+
+    switch(item->type) {
+    case NN_WORK_ITEM_TYPE_INPUT: {
+        // Copy input.
+        auto item_input = reinterpret_cast<nn_data_t*>(input[item->arguments.input.index]);
+
+        // If you want inputs to be copied don't assign them to output (buffers will override each other)
+        // This situation take place only when merge is next layer after inputs
+        if( !item->arguments.input.copy_on_merge ) {
+            // If after input there isn't merge, do standard way
+            outputs[0]->parent->data_buffer = item_input->buffer;  // TODO validate if input have same lengths and layout as one given during compilation.
+        }
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_OUTPUT: {
+        // Copy result to workload output.
+        // Aliased output was already written by its producer (see nn_workload_execute_in_context).
+        if (item->arguments.output.aliased) break;
+
+        auto item_output = reinterpret_cast<nn_data_t*>(output[item->arguments.output.index]);
+
+        outputs[0]->parent->data_buffer = item_output->buffer;
+        layer::workload_data_copy(
+            static_cast<nn_device_internal *>(workload_opaque->device)->thread_pool,
+            outputs[0],
+            context->view(item->input[0].get_data_view()));
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_MERGE: {
+        uint32_t z_offset = 0;
+
+        for( uint32_t i = 0; i < item->input.size() ; ++i ) {
+            if( NN_WORK_ITEM_TYPE_INPUT == item->input[i].item->type
+            && item->input[i].item->arguments.input.copy_on_merge
+            ) {
+
+                // get input buffer from inputs table
+                auto item_input = reinterpret_cast< nn_data_t* >(input[item->input[i].item->arguments.input.index]);
+
+                auto dim = item_input->dimension;
+                assert( 4 == dim );
+                auto size_ptr = item_input->size;
+                uint32_t input_buf_x  = static_cast<uint32_t>( *(size_ptr + 1)),
+                         input_buf_y  = static_cast<uint32_t>( *(size_ptr + 2)),
+                         input_buf_z  = static_cast<uint32_t>( *(size_ptr + 0)),
+                         input_buf_n  = static_cast<uint32_t>( *(size_ptr + 3));
+
+                auto destination = outputs[0];
+                auto source = context->view(item->input[i].item->output[0]);
+
+                unsigned int source_sizes      [NN_DATA_COORD_MAX + 1],
+                             destination_sizes [NN_DATA_COORD_MAX + 1];
+
+                for( int i = 0 ; i < NN_DATA_COORD_MAX+1 ; ++i){
+                    source_sizes[i]      = source->view_end.t[i]      - source->view_begin.t[i]      + 1;
+                    destination_sizes[i] = destination->view_end.t[i] - destination->view_begin.t[i] + 1;
+                }
+
+                // check if destination size is >= for z merge
+                assert(    destination_sizes[NN_DATA_COORD_n] == source_sizes[NN_DATA_COORD_n]
+                        && destination_sizes[NN_DATA_COORD_x] == source_sizes[NN_DATA_COORD_x]
+                        && destination_sizes[NN_DATA_COORD_y] == source_sizes[NN_DATA_COORD_y]
+                        && destination_sizes[NN_DATA_COORD_z] >= source_sizes[NN_DATA_COORD_z]
+                        && destination_sizes[NN_DATA_COORD_p] == source_sizes[NN_DATA_COORD_p]
+                        && destination_sizes[NN_DATA_COORD_q] == source_sizes[NN_DATA_COORD_q] );
+
+                // check if z is not out of bounds
+                assert( destination->view_end.t[NN_DATA_COORD_z] + 1 >= source_sizes[NN_DATA_COORD_z] + z_offset );
+
+                // check if input_buffer's sizes are equal to source_sizes
+                assert(    input_buf_z == source_sizes[NN_DATA_COORD_z]
+                        && input_buf_x == source_sizes[NN_DATA_COORD_x]
+                        && input_buf_y == source_sizes[NN_DATA_COORD_y]
+                        && input_buf_n == source_sizes[NN_DATA_COORD_n] );
+
+                // Input buffer is in ZXYN layout; copy it into its part of merged view along Z.
+                nn::workload_data<> input_data(
+                    destination->parent->tag,
+                    item_input->buffer,
+                    {source_sizes[NN_DATA_COORD_n], source_sizes[NN_DATA_COORD_x], source_sizes[NN_DATA_COORD_y],
+                     source_sizes[NN_DATA_COORD_z], source_sizes[NN_DATA_COORD_p], source_sizes[NN_DATA_COORD_q]},
+                    nn::layout_t<nn::layout_zxynpq_f32>::layout);
+
+                nn_workload_data_coords_t part_begin = {0, 0, 0, z_offset, 0, 0};
+                nn_workload_data_coords_t part_end = {
+                    source_sizes[NN_DATA_COORD_n] - 1, source_sizes[NN_DATA_COORD_x] - 1, source_sizes[NN_DATA_COORD_y] - 1,
+                    z_offset + source_sizes[NN_DATA_COORD_z] - 1, source_sizes[NN_DATA_COORD_p] - 1, source_sizes[NN_DATA_COORD_q] - 1};
+                nn_workload_data_t destination_part;
+                nn_workload_data_placement_create_view(&destination_part, destination, &part_begin, &part_end);
+
+                layer::workload_data_copy(
+                    static_cast<nn_device_internal *>(workload_opaque->device)->thread_pool, &destination_part, &input_data);
+
+                z_offset += source_sizes[NN_DATA_COORD_z];
+              }
+        }
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_VIEW: {
+        // Nothing to do here - it's just limiting access to input by attaching view to it.
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_BACKPROP: {
+        layer::run_multithreaded_convolve_work_item_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_BACKPROP: {
+        layer::run_multithreaded_FC_work_item_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_POOLING_BACKPROP: {
+        layer::wrapper_pooling_work_item_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_BACKPROP: {
+        layer::wrapper_normalization_work_item_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_SOFTMAX_BACKPROP: {
+        layer::wrapper_softmax_work_item_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_SOFTMAX_LOSS_BACKPROP: {
+        layer::run_softmax_loss_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_RELU_1D_BACKPROP:
+    case NN_WORK_ITEM_TYPE_RELU_3D_BACKPROP:
+    {
+        layer::run_relu_backward(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_LOSS_FUNCTION: {
+        layer::run_loss_function(item);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_UPDATE_ARGUMENTS: {
+        layer::run_parameter_update(item, static_cast<nn_device_internal*>(workload_opaque->device));
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_DROPOUT: {
+        item->primitive->forward(
+            {context->view(item->input[0].get_data_view()),
+             context->view(item->input[1].get_data_view()),
+             context->view(item->input[2].get_data_view())},
+            {nullptr},
+            outputs);
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_DROPOUT_BACKPROP: {
+        auto primitive = (item->forward_item != nullptr) ? item->forward_item->primitive : item->primitive;
+        auto input = item->input[0].get_data_view();
+        auto output = item->output[0];
+
+        // TODO: change this when workflow compilation starts using parent->delta_buffer
+        assert(input->parent->delta_buffer == nullptr);
+        assert(output->parent->delta_buffer == nullptr);
+        input->parent->delta_buffer = input->parent->data_buffer;
+        output->parent->delta_buffer = output->parent->data_buffer;
+
+        primitive->backward(
+            {output, item->input[1].get_data_view(), item->input[2].get_data_view()},
+            {nullptr},
+            {input});
+
+        // TODO: change this when workflow compilation starts using parent->delta_buffer
+        // revert changes made above
+        input->parent->delta_buffer = nullptr;
+        output->parent->delta_buffer = nullptr;
+
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_AVERAGE_DELTAS: {
+        layer::run_average_delta(item, static_cast<nn_device_internal *>(workload_opaque->device));
+        break;
+    }
+    case NN_WORK_ITEM_TYPE_CONVERT_DATA_LAYOUT: {
+        if (item->primitive == nullptr) {
+            layer::run_convert_to_data_layout_work_item(
+                item, context->view(item->input[0].get_data_view()), outputs[0],
+                static_cast<nn_device_internal *>(workload_opaque->device));
+            break;
+        }
+    }
+    default: {
+        assert(item->primitive != nullptr);
+
+        std::vector<const nn_workload_data_t *> inputs;
+        for(auto& input_descriptor : item->input)
+            inputs.push_back(context->view(input_descriptor.get_data_view()));
+
+        item->primitive->forward(inputs, {item->parameters.begin(), item->parameters.end()}, outputs);
+    }
+    } // switch
+
+    if (!workload_opaque->calibration_keys.empty())
+    {
+        auto key = workload_opaque->calibration_keys.find(item);
+        if (key != workload_opaque->calibration_keys.end() && !outputs.empty())
+            static_cast<nn_device_internal *>(workload_opaque->device)->calibration.record_output(key->second, outputs[0]);
+    }
+
+#if ENABLE_WORKLOAD_PROFILING
+    auto t1 = __rdtsc();
+    // Entries are created at compilation, so concurrently run items do not modify the map;
+    // the same item may still be run by executions in different contexts.
+    std::lock_guard<std::mutex> lock(workload_opaque->profiling_mutex);
+    workload_opaque->profiling_data.work_item_cycles[item].push_back(t1 - t0);
+#endif
+}
+
+/* runs all work items of workload on calling thread */
+void nn_workload_execute_items(
+    nn_workload_opaque_t          *workload_opaque, /* workload to be run */
+    nn_workload_execution_context *context,         /* buffers of this execution */
+    void *                        *input,           /* array of pointers with input data */
+    void *                        *output           /* array of pointers with output data */
+    ) {
+#if  ENABLE_WORKLOAD_MONITORING
+    uint16_t  item_count=0;
+#endif // ENABLE_WORKLOAD_MONITORING
+    for(auto item : workload_opaque->order_of_execution) {
+        nn_workload_execute_item(workload_opaque, context, item, input, output);
+
+#if ENABLE_WORKLOAD_MONITORING
+        nn_workload_item_data_marshaling(item, ++item_count);
+#endif // ENABLE_WORKLOAD_MONITORING
+    }
+}
+
+/* runs work items of workload as soon as their predecessors are done
+   Item that completes continues with single ready successor on its own thread, several ready
+   successors are pushed to thread pool as nested job. Jobs of layers running concurrently share
+   workers of pool through work stealing. */
+void nn_workload_execute_graph(
+    nn_workload_opaque_t          *workload_opaque, /* workload to be run */
+    nn_workload_execution_context *context,         /* buffers of this execution */
+    void *                        *input,           /* array of pointers with input data */
+    void *                        *output           /* array of pointers with output data */
+    ) {
+    auto &order = workload_opaque->order_of_execution;
+    auto device = static_cast<nn_device_internal *>(workload_opaque->device);
+
+    std::unique_ptr<std::atomic<uint32_t>[]> pending(new std::atomic<uint32_t>[order.size()]);
+    std::vector<size_t> roots;
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        pending[position] = workload_opaque->item_predecessor_count[position];
+        if (workload_opaque->item_predecessor_count[position] == 0)
+            roots.push_back(position);
+    }
+
+    // First failure stops scheduling of further items, it is rethrown on calling thread.
+    std::atomic<bool> failed(false);
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    std::function<void(const std::vector<size_t> &)> run_concurrently;
+    std::function<void(size_t)> run_from = [&](size_t position) {
+        while (!failed)
+        {
+            try
+            {
+                nn_workload_execute_item(workload_opaque, context, order[position], input, output);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) failure = std::current_exception();
+                failed = true;
+                return;
+            }
+
+            std::vector<size_t> ready;
+            for (auto successor : workload_opaque->item_successors[position])
+                if (--pending[successor] == 0)
+                    ready.push_back(successor);
+
+            if (ready.size() != 1)
+            {
+                if (!ready.empty()) run_concurrently(ready);
+                return;
+            }
+            position = ready.front();
+        }
+    };
+
+    run_concurrently = [&](const std::vector<size_t> &ready) {
+        std::vector<nn_multithreaded_request> jobs;
+        for (auto position : ready)
+            jobs.push_back({[&run_from, position](void *) { run_from(position); }, nullptr});
+        device->thread_pool.push_job(jobs);
+    };
+
+    run_concurrently(roots);
+
+    if (failure) std::rethrow_exception(failure);
+}
+
+/* runs workload in given context on calling thread or, when workload has independent branches, on thread pool */
+void nn_workload_execute_in_context(
+    nn_workload_opaque_t          *workload_opaque, /* workload to be run */
+    nn_workload_execution_context *context,         /* buffers of this execution */
+    void *                        *input,           /* array of pointers with input data */
+    void *                        *output           /* array of pointers with output data */
+    ) {
+    // Producers of aliased outputs write directly to buffers passed to execution.
+    for (auto item : workload_opaque->output)
+        if (item->type == NN_WORK_ITEM_TYPE_OUTPUT && item->arguments.output.aliased)
+            context->view(item->output[0])->parent->data_buffer =
+                reinterpret_cast<nn_data_t *>(output[item->arguments.output.index])->buffer;
+
+    if (workload_opaque->parallel_execution)
+        nn_workload_execute_graph(workload_opaque, context, input, output);
+    else
+        nn_workload_execute_items(workload_opaque, context, input, output);
+
+    if (!workload_opaque->calibration_keys.empty())
+        static_cast<nn_device_internal *>(workload_opaque->device)->calibration.save();
+}
+
+/* creates context with private copies of all buffers written by work items
+   Buffers placed in activation arena get the same offsets in private arena. Buffers of inputs and
+   outputs are attached to user data at execution. Private buffers are zeroed, as buffers with
+   paddings are at compilation. */
+std::unique_ptr<nn_workload_execution_context> nn_workload_create_execution_context(
+    nn_workload_opaque_t *workload_opaque  /* workload to create context for */
+    ) {
+    std::unique_ptr<nn_workload_execution_context> context(new nn_workload_execution_context);
+
+    auto arena_begin = static_cast<char *>(workload_opaque->activation_arena);
+    auto arena_end = arena_begin + workload_opaque->activation_arena_size;
+    if (arena_begin != nullptr)
+    {
+        context->activation_arena = nn_allocate_aligned(workload_opaque->activation_arena_size);
+        if (context->activation_arena == nullptr)
+            throw std::bad_alloc();
+    }
+
+    // buffers of inputs and outputs, also when aliased by their producers
+    std::set<nn_workload_data_core_t *> client_cores;
+    for (auto item : workload_opaque->order_of_execution)
+        if (item->type == NN_WORK_ITEM_TYPE_INPUT || item->type == NN_WORK_ITEM_TYPE_OUTPUT)
+            for (auto compiled_view : item->output)
+                client_cores.insert(compiled_view->parent.get());
+
+    std::map<nn_workload_data_core_t *, std::shared_ptr<nn_workload_data_core_t>> cores;
+    for (auto item : workload_opaque->order_of_execution)
+        for (auto compiled_view : item->output)
+        {
+            auto &core = cores[compiled_view->parent.get()];
+            if (!core)
+            {
+                auto &compiled_core = *compiled_view->parent;
+                auto buffer = static_cast<char *>(compiled_core.data_buffer);
+
+                if (client_cores.count(&compiled_core) != 0)
+                    core = std::make_shared<nn_workload_data_core_t>(
+                        compiled_core.data_type_size, compiled_core.lengths, compiled_core.layout, nullptr, true, false);
+                else if (buffer >= arena_begin && buffer < arena_end)
+                    core = std::make_shared<nn_workload_data_core_t>(
+                        compiled_core.data_type_size, compiled_core.lengths, compiled_core.layout,
+                        static_cast<char *>(context->activation_arena) + (buffer - arena_begin), false, false);
+                else
+                {
+                    core = std::make_shared<nn_workload_data_core_t>(
+                        compiled_core.data_type_size, compiled_core.lengths, compiled_core.layout, nullptr, false, false);
+                    memset(core->data_buffer, 0, core->buffer_size);
+                }
+                core->tag = compiled_core.tag;
+            }
+
+            context->views[compiled_view].reset(new nn_workload_data_t{compiled_view->view_begin, compiled_view->view_end, core});
+        }
+
+    return context;
+}
+
+void nn_workload_execute(nn_workload_opaque_t *workload_opaque, void **input, void **output);
+
+/* runs workload compiled for NUMA worker groups: each replica processes its slice of batch on threads of its group
+   Slices are views of caller's data, batch has to be the last dimension of all inputs and outputs. */
+void nn_workload_execute_on_numa_groups(
+    nn_workload_opaque_t *workload_opaque, /* workload to be run */
+    void *               *input,           /* array of pointers with input data */
+    void *               *output           /* array of pointers with output data */
+    ) {
+    std::vector<std::unique_ptr<nn_data_t, decltype(&nn_data_delete)>> views;
+    auto slice = [&](void *data_public, uint32_t first_picture, uint32_t pictures) -> void * {
+        auto data = static_cast<nn_data_t *>(data_public);
+        if (data->dimension == 0 || data->size[data->dimension - 1] != workload_opaque->batch)
+            throw std::runtime_error("NUMA execution: batch is not the last dimension of data");
+
+        std::vector<size_t> size(data->size, data->size + data->dimension);
+        size.back() = pictures;
+        auto picture_size = nn_data_buffer_size_ptr(data->sizeof_value, data->dimension - 1, data->size);
+        views.emplace_back(
+            nn_data_create_shared_ptr(static_cast<char *>(data->buffer) + first_picture * picture_size,
+                                      data->sizeof_value, data->dimension, size.data()),
+            &nn_data_delete);
+        if (!views.back())
+            throw std::bad_alloc();
+        return views.back().get();
+    };
+
+    const auto replicas = workload_opaque->numa_workloads.size();
+    std::vector<std::vector<void *>> inputs(replicas), outputs(replicas);
+    uint32_t first_picture = 0;
+    for (size_t replica = 0; replica < replicas; ++replica)
+    {
+        auto pictures = workload_opaque->numa_workloads[replica]->batch;
+        for (uint32_t index = 0; index < workload_opaque->input_count; ++index)
+            inputs[replica].push_back(slice(input[index], first_picture, pictures));
+        for (uint32_t index = 0; index < workload_opaque->output_count; ++index)
+            outputs[replica].push_back(slice(output[index], first_picture, pictures));
+        first_picture += pictures;
+    }
+
+    std::vector<std::future<void>> executions;
+    for (size_t replica = 0; replica < replicas; ++replica)
+        executions.push_back(workload_opaque->numa_groups[replica]->request_dispatcher.run([&, replica]() {
+            nn_workload_execute(workload_opaque->numa_workloads[replica], inputs[replica].data(), outputs[replica].data());
+        }));
+    nn_wait_for_all(executions);
+}
+
+/* runs workload with given inputs & outputs
+   Workloads which can run concurrently take idle execution context, or create new one if all are in use;
+   other workloads are serialized on primary context. */
+void nn_workload_execute(
+    nn_workload_opaque_t *workload_opaque, /* workload to be run */
+    void *               *input,           /* array of pointers with input data */
+    void *               *output           /* array of pointers with output data */
+    ) {
+    if (!workload_opaque->numa_workloads.empty())
+    {
+        nn_workload_execute_on_numa_groups(workload_opaque, input, output);
+        return;
+    }
+
+    if (!workload_opaque->concurrent_execution)
+    {
+        std::lock_guard<std::mutex> lock(workload_opaque->execute_mutex);
+        nn_workload_execute_in_context(workload_opaque, &workload_opaque->primary_context, input, output);
+        return;
+    }
+
+    nn_workload_execution_context *context;
+    {
+        std::lock_guard<std::mutex> lock(workload_opaque->context_mutex);
+        if (workload_opaque->idle_contexts.empty())
+        {
+            workload_opaque->contexts.push_back(nn_workload_create_execution_context(workload_opaque));
+            context = workload_opaque->contexts.back().get();
+        }
+        else
+        {
+            context = workload_opaque->idle_contexts.back();
+            workload_opaque->idle_contexts.pop_back();
+        }
+    }
+
+    // Context is returned to idle list also when execution fails.
+    struct context_release
+    {
+        nn_workload_opaque_t *workload_opaque;
+        nn_workload_execution_context *context;
+        ~context_release()
+        {
+            std::lock_guard<std::mutex> lock(workload_opaque->context_mutex);
+            workload_opaque->idle_contexts.push_back(context);
+        }
+    } release{workload_opaque, context};
+
+    nn_workload_execute_in_context(workload_opaque, context, input, output);
+}
+
+} //namespace
+
 /* executes workload with given inputs & outputs */
 NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_execute_0_function(
     nn_workload_t      *workload_public,/* workload to be started */
@@ -2187,232 +3645,92 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_execute_0_function(
     NN_API_STATUS      *status          /* asynchronous status */
     ) {
 
-    if (!workload_public || !input || (!output && workload_public->output_count))
+    if (!workload_public || !input || (!output && workload_public->output_count) || !status)
         return NN_API_STATUS_ERROR_INVALID_POINTER;
     else {
-        try {
-            *status = NN_API_WORK_IN_PROGRESS;
-            auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload_public);
-#if  ENABLE_WORKLOAD_MONITORING
-            uint16_t  item_count=0;
-#endif // ENABLE_WORKLOAD_MONITORING
-            for(auto item : workload_opaque->order_of_execution) {
-#if ENABLE_WORKLOAD_PROFILING
+        auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload_public);
+        auto device = static_cast<nn_device_internal *>(workload_public->device);
 
-                auto t0 = __rdtsc();
-#endif
-
-                switch(item->type) {
-                case NN_WORK_ITEM_TYPE_INPUT: {
-                    // Copy input.
-                    auto item_input = reinterpret_cast<nn_data_t*>(input[item->arguments.input.index]);
-
-                    // If you want inputs to be copied don't assign them to output (buffers will override each other)
-                    // This situation take place only when merge is next layer after inputs
-                    if( !item->arguments.input.copy_on_merge ) {
-                        // If after input there isn't merge, do standard way
-                        item->output[0]->parent->data_buffer = item_input->buffer;  // TODO validate if input have same lengths and layout as one given during compilation.
-                    }
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_OUTPUT: {
-                    // Copy result to workload output.
-                    auto item_output = reinterpret_cast<nn_data_t*>(output[item->arguments.output.index]);
-
-                    item->output[0]->parent->data_buffer = item_output->buffer;
-                    nn_workload_data_copy(item->output[0], item->input[0].get_data_view());
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_MERGE: {
-                    uint32_t z_offset = 0;
-
-                    for( uint32_t i = 0; i < item->input.size() ; ++i ) {
-                        if( NN_WORK_ITEM_TYPE_INPUT == item->input[i].item->type
-                        && item->input[i].item->arguments.input.copy_on_merge
-                        ) {
-
-                            // get input buffer from inputs table
-                            auto item_input = reinterpret_cast< nn_data_t* >(input[item->input[i].item->arguments.input.index]);
-
-                            auto dim = item_input->dimension;
-                            assert( 4 == dim );
-                            auto size_ptr = item_input->size;
-                            uint32_t input_buf_x  = static_cast<uint32_t>( *(size_ptr + 1)),
-                                     input_buf_y  = static_cast<uint32_t>( *(size_ptr + 2)),
-                                     input_buf_z  = static_cast<uint32_t>( *(size_ptr + 0)),
-                                     input_buf_n  = static_cast<uint32_t>( *(size_ptr + 3));
-
-                            auto destination = item->output[0];
-                            auto source = item->input[i].item->output[0];
-
-                            unsigned int source_sizes      [NN_DATA_COORD_MAX + 1],
-                                         destination_sizes [NN_DATA_COORD_MAX + 1];
-
-                            for( int i = 0 ; i < NN_DATA_COORD_MAX+1 ; ++i){
-                                source_sizes[i]      = source->view_end.t[i]      - source->view_begin.t[i]      + 1;
-                                destination_sizes[i] = destination->view_end.t[i] - destination->view_begin.t[i] + 1;
-                            }
+        if (device->asynchronous_execution) {
+            // Pointer arrays belong to caller and may be gone before request is processed.
+            std::vector<void *> inputs(input, input + workload_public->input_count);
+            std::vector<void *> outputs(output, output + workload_public->output_count);
 
-                            // check if destination size is >= for z merge
-                            assert(    destination_sizes[NN_DATA_COORD_n] == source_sizes[NN_DATA_COORD_n]
-                                    && destination_sizes[NN_DATA_COORD_x] == source_sizes[NN_DATA_COORD_x]
-                                    && destination_sizes[NN_DATA_COORD_y] == source_sizes[NN_DATA_COORD_y]
-                                    && destination_sizes[NN_DATA_COORD_z] >= source_sizes[NN_DATA_COORD_z]
-                                    && destination_sizes[NN_DATA_COORD_p] == source_sizes[NN_DATA_COORD_p]
-                                    && destination_sizes[NN_DATA_COORD_q] == source_sizes[NN_DATA_COORD_q] );
-
-                            // check if z is not out of bounds
-                            assert( destination->view_end.t[NN_DATA_COORD_z] + 1 >= source_sizes[NN_DATA_COORD_z] + z_offset );
-
-                            // check if input_buffer's sizes are equal to source_sizes
-                            assert(    input_buf_z == source_sizes[NN_DATA_COORD_z]
-                                    && input_buf_x == source_sizes[NN_DATA_COORD_x]
-                                    && input_buf_y == source_sizes[NN_DATA_COORD_y]
-                                    && input_buf_n == source_sizes[NN_DATA_COORD_n] );
-
-                            auto input_buf = static_cast< float* >(item_input->buffer);
-
-                            for( uint32_t p = 0; p < source_sizes[NN_DATA_COORD_p]; p++ )
-                            for( uint32_t q = 0; q < source_sizes[NN_DATA_COORD_q]; q++ )
-                            for( uint32_t n = 0; n < source_sizes[NN_DATA_COORD_n]; n++ )
-                            for( uint32_t z = 0; z < source_sizes[NN_DATA_COORD_z]; z++ )
-                            for( uint32_t y = 0; y < source_sizes[NN_DATA_COORD_y]; y++ )
-                            for( uint32_t x = 0; x < source_sizes[NN_DATA_COORD_x]; x++ ) {
-                                auto tmp = input_buf[ z +
-                                                        source_sizes[NN_DATA_COORD_z] * x +
-                                                        source_sizes[NN_DATA_COORD_z] * source_sizes[NN_DATA_COORD_x] * y +
-                                                        source_sizes[NN_DATA_COORD_z] * source_sizes[NN_DATA_COORD_x] * source_sizes[NN_DATA_COORD_y] * n +
-                                                        source_sizes[NN_DATA_COORD_z] * source_sizes[NN_DATA_COORD_x] * source_sizes[NN_DATA_COORD_y] * source_sizes[NN_DATA_COORD_n] * p +
-                                                        source_sizes[NN_DATA_COORD_z] * source_sizes[NN_DATA_COORD_x] * source_sizes[NN_DATA_COORD_y] * source_sizes[NN_DATA_COORD_n] * source_sizes[NN_DATA_COORD_p] * q ];
-
-                                nn_workload_data_get<float>( destination, n, x, y, z + z_offset, p, q ) = tmp;
-                            }
+            {
+                std::lock_guard<std::mutex> lock(workload_opaque->completion_mutex);
+                *status = NN_API_WORK_IN_PROGRESS;
+                ++workload_opaque->in_flight_count;
+            }
 
-                            z_offset += source_sizes[NN_DATA_COORD_z];
-                          }
-                    }
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_VIEW: {
-                    // Nothing to do here - it's just limiting access to input by attaching view to it.
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_CONVOLUTION_BACKPROP: {
-                    layer::run_multithreaded_convolve_work_item_backward(item);
-                    break;
+            device->request_dispatcher.push([workload_opaque, inputs, outputs, status]() mutable {
+                NN_API_STATUS result = NN_API_WORK_FINISHED;
+                try {
+                    nn_workload_execute(workload_opaque, inputs.data(), outputs.data());
                 }
-                case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_BACKPROP: {
-                    layer::run_multithreaded_FC_work_item_backward(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_POOLING_BACKPROP: {
-                    layer::wrapper_pooling_work_item_backward(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_NORMALIZATION_BACKPROP: {
-                    layer::wrapper_normalization_work_item_backward(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_SOFTMAX_BACKPROP: {
-                    layer::wrapper_softmax_work_item_backward(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_SOFTMAX_LOSS_BACKPROP: {
-                    layer::run_softmax_loss_backward(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_RELU_1D_BACKPROP:
-                case NN_WORK_ITEM_TYPE_RELU_3D_BACKPROP:
-                {
-                    layer::run_relu_backward(item);
-                    break;
+                catch(NN_API_STATUS error) {
+                    result = error;
                 }
-                case NN_WORK_ITEM_TYPE_LOSS_FUNCTION: {
-                    layer::run_loss_function(item);
-                    break;
+                catch( std::exception & ) {
+                    result = NN_API_STATUS_ERROR_OTHER;
                 }
-                case NN_WORK_ITEM_TYPE_UPDATE_ARGUMENTS: {
-                    layer::run_parameter_update(item, static_cast<nn_device_internal*>(workload_public->device));
-                    break;
+                catch(...) {
+                    result = NN_API_STATUS_ERROR_OUT_OF_MEMORY;
                 }
-                case NN_WORK_ITEM_TYPE_DROPOUT: {
-                    item->primitive->forward(
-                        {item->input[0].get_data_view(), item->input[1].get_data_view(), item->input[2].get_data_view()},
-                        {nullptr},
-                        item->output);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_DROPOUT_BACKPROP: {
-                    auto primitive = (item->forward_item != nullptr) ? item->forward_item->primitive : item->primitive;
-                    auto input = item->input[0].get_data_view();
-                    auto output = item->output[0];
-
-                    // TODO: change this when workflow compilation starts using parent->delta_buffer
-                    assert(input->parent->delta_buffer == nullptr);
-                    assert(output->parent->delta_buffer == nullptr);
-                    input->parent->delta_buffer = input->parent->data_buffer;
-                    output->parent->delta_buffer = output->parent->data_buffer;
-
-                    primitive->backward(
-                        {output, item->input[1].get_data_view(), item->input[2].get_data_view()},
-                        {nullptr},
-                        {input});
-
-                    // TODO: change this when workflow compilation starts using parent->delta_buffer
-                    // revert changes made above
-                    input->parent->delta_buffer = nullptr;
-                    output->parent->delta_buffer = nullptr;
-
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_AVERAGE_DELTAS: {
-                    layer::run_average_delta(item);
-                    break;
-                }
-                case NN_WORK_ITEM_TYPE_CONVERT_DATA_LAYOUT: {
-                    if (item->primitive == nullptr) {
-                        layer::run_convert_to_data_layout_work_item(item);
-                        break;
-                    }
-                }
-                default: {
-                    assert(item->primitive != nullptr);
-
-                    std::vector<const nn_workload_data_t *> inputs;
-                    for(auto& input_descriptor : item->input)
-                        inputs.push_back(input_descriptor.get_data_view());
 
-                    item->primitive->forward(inputs, {item->parameters.begin(), item->parameters.end()}, item->output);
-                }
-                } // switch
+                std::lock_guard<std::mutex> lock(workload_opaque->completion_mutex);
+                *status = result;
+                --workload_opaque->in_flight_count;
+                workload_opaque->completion.notify_all();
+            });
 
-#if ENABLE_WORKLOAD_PROFILING
-                auto t1 = __rdtsc();
-                workload_opaque->profiling_data.work_item_cycles[item].push_back(t1 - t0);
-#endif
+            return NN_API_STATUS_OK;
+        }
 
-#if ENABLE_WORKLOAD_MONITORING
-                nn_workload_item_data_marshaling(item, ++item_count);
-#endif // ENABLE_WORKLOAD_MONITORING
-            }
+        try {
+            *status = NN_API_WORK_IN_PROGRESS;
+            nn_workload_execute(workload_opaque, input, output);
+            *status = NN_API_WORK_FINISHED;
         }
-        catch(NN_API_STATUS status)
+        catch(NN_API_STATUS error)
         {
-            return status;
+            *status = error;
+            return error;
         }
-        catch( std::exception &e )
+        catch( std::exception & )
         {
-            std::cerr << e.what();
-            throw;
+            *status = NN_API_STATUS_ERROR_OTHER;
+            return NN_API_STATUS_ERROR_OTHER;
         }
         catch(...)
         {
+            *status = NN_API_STATUS_ERROR_OUT_OF_MEMORY;
             return NN_API_STATUS_ERROR_OUT_OF_MEMORY;
         }
     }
     return NN_API_STATUS_OK;
 }
 
+/* waits for asynchronous execution of workload */
+NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_wait_0_function(
+    nn_workload_t          *workload_public, /* workload that was started */
+    NN_API_STATUS          *status,          /* status passed to nn_workload_execute_0_function */
+    uint32_t                timeout_ms       /* timeout in milliseconds, 0 - poll only */
+    ) {
+    if (!workload_public || !status)
+        return NN_API_STATUS_ERROR_INVALID_POINTER;
+
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload_public);
+    auto finished = [status]() { return *status != NN_API_WORK_IN_PROGRESS; };
+
+    std::unique_lock<std::mutex> lock(workload_opaque->completion_mutex);
+    if (timeout_ms == NN_WAIT_INFINITE)
+        workload_opaque->completion.wait(lock, finished);
+    else
+        workload_opaque->completion.wait_for(lock, std::chrono::milliseconds(timeout_ms), finished);
+
+    return *status;
+}
+
 #if ENABLE_WORKLOAD_PROFILING
 void nn_workload_print_profiling_data(nn_workload_opaque_t* workload_opaque)
 {
@@ -2445,6 +3763,12 @@ void nn_workload_print_profiling_data(nn_workload_opaque_t* workload_opaque)
             case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT: return "cnn_pool2x2_i16";
             case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
             case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN: return  "fc_i16";
+            case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8: return "conv_float2u8";
+            case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8: return "cnn_i8";
+            case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8: return "pooling_i8";
+            case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8: return "norm_i8";
+            case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+            case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32: return "fc_i8";
             case NN_WORK_ITEM_TYPE_SOFTMAX:
             case NN_WORK_ITEM_TYPE_SOFTMAX_FIXEDPOINT: return "softmax";
             case NN_WORK_ITEM_TYPE_MERGE: return  "merge";
@@ -2490,10 +3814,21 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_delete_0_function(
         try {
             auto workload_opaque = static_cast<nn_workload_opaque_t*>(workload_public);
 
+            {
+                // Asynchronous executions still reference workload.
+                std::unique_lock<std::mutex> lock(workload_opaque->completion_mutex);
+                workload_opaque->completion.wait(lock, [workload_opaque]() { return workload_opaque->in_flight_count == 0; });
+            }
+
 #if ENABLE_WORKLOAD_PROFILING
-            nn_workload_print_profiling_data(workload_opaque);
+            if (workload_opaque->numa_workloads.empty())
+                nn_workload_print_profiling_data(workload_opaque);
 #endif
 
+            // replicas are deleted before references to their worker groups are released
+            for (auto replica : workload_opaque->numa_workloads)
+                nn_workload_delete_0_function(replica);
+
             for (auto& item : workload_opaque->order_of_execution)
             {
                 for(auto& parameter : item->parameters)
@@ -2515,6 +3850,8 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_delete_0_function(
                 item = nullptr;
             }
 
+            nn_free_aligned(workload_opaque->activation_arena);
+
             delete workload_opaque->input_format;
             delete workload_opaque->output_format;
             delete workload_opaque;
@@ -2530,22 +3867,6 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_delete_0_function(
     return NN_API_STATUS_OK;
 }
 
-/* query workflow for metrics of compilation variants */
-NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_metrics_query_0_function(
-    nn_workflow_metrics_array_t **array,/* resulting array of variants */
-    nn_device_t        *device,         /* device context */
-    nn_workflow_t      *workflow        /* workflow to be querried */
-    ) {
-    return NN_API_STATUS_ERROR_OTHER;
-}
-
-/* delete array of workload metrics */
-NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_metrics_delete_0_function(
-    nn_workflow_metrics_array_t *array  /* array to delete */
-    ) {
-    return NN_API_STATUS_ERROR_OTHER;
-}
-
 /* validate parameters of work_item for this particular device */
 NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_item_validate_0_function(
     nn_device_t        *device,         /* target device */
@@ -2554,13 +3875,90 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_item_validate_0_function(
     return NN_API_STATUS_ERROR_OTHER;
 }
 
+namespace
+{
+/* Replaces worker groups used by workloads compiled later; 0 - NUMA execution disabled, 1 - group per NUMA node,
+   more - given number of groups spread over nodes. Each group has one worker per physical core of its CPUs. */
+void nn_device_set_numa_groups(nn_device_internal *device, uint32_t group_count)
+{
+    std::vector<std::shared_ptr<nn_device_internal>> groups;
+    if (group_count != 0)
+    {
+        auto nodes = nn_numa_nodes();
+        if (group_count == 1)
+            group_count = static_cast<uint32_t>(nodes.size());
+
+        for (auto &cpus : nn_numa_worker_groups(nodes, group_count))
+        {
+            groups.push_back(std::make_shared<nn_device_internal>(std::max(nn_cpu_cores(cpus).size(), size_t(1)), cpus));
+            groups.back()->thread_pool.set_spin_time(device->thread_pool.get_spin_time());
+            groups.back()->thread_pool.set_placement(device->thread_pool.get_placement());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(device->numa_mutex);
+    device->numa_groups.swap(groups);
+}
+} //namespace
+
 NN_API_STATUS NN_API_CALL_CONVENTION nn_device_parameter_get_0_function(
     nn_device_t        *device,         /* target context */
     NN_PARAMETER        parameter,      /* parameter to get */
     void               *buffer,         /* buffer to store result to */
     uint32_t            size            /* size of buffer */
     ) {
-    return NN_API_STATUS_ERROR_OTHER;
+    if(!device || !buffer) return NN_API_STATUS_ERROR_INVALID_POINTER;
+
+    switch(parameter) {
+    case NN_PARAMETER_ASYNCHRONOUS_EXECUTION:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        *static_cast<uint32_t *>(buffer) = static_cast<nn_device_internal *>(device)->asynchronous_execution ? 1 : 0;
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_JIT_CODE_CACHE: {
+        auto path = static_cast<nn_device_internal *>(device)->jit_cache.get_path();
+        if(size < path.size() + 1) return NN_API_STATUS_ERROR_OTHER;
+        std::copy(path.c_str(), path.c_str() + path.size() + 1, static_cast<char *>(buffer));
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_AUTO_TUNING:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        *static_cast<uint32_t *>(buffer) = static_cast<nn_device_internal *>(device)->tuner.get_enabled() ? 1 : 0;
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_TUNING_FILE: {
+        auto path = static_cast<nn_device_internal *>(device)->tuner.get_path();
+        if(size < path.size() + 1) return NN_API_STATUS_ERROR_OTHER;
+        std::copy(path.c_str(), path.c_str() + path.size() + 1, static_cast<char *>(buffer));
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_NUMA_EXECUTION: {
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        auto device_internal = static_cast<nn_device_internal *>(device);
+        std::lock_guard<std::mutex> lock(device_internal->numa_mutex);
+        *static_cast<uint32_t *>(buffer) = static_cast<uint32_t>(device_internal->numa_groups.size());
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_LOW_LATENCY_DISPATCH:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        *static_cast<uint32_t *>(buffer) = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            static_cast<nn_device_internal *>(device)->thread_pool.get_spin_time()).count());
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_THREAD_PLACEMENT:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        *static_cast<uint32_t *>(buffer) = static_cast<uint32_t>(static_cast<nn_device_internal *>(device)->thread_pool.get_placement());
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_FIXEDPOINT_CALIBRATION:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        *static_cast<uint32_t *>(buffer) = static_cast<nn_device_internal *>(device)->calibration.get_enabled() ? 1 : 0;
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_FIXEDPOINT_CONFIGURATION: {
+        auto path = static_cast<nn_device_internal *>(device)->calibration.get_path();
+        if(size < path.size() + 1) return NN_API_STATUS_ERROR_OTHER;
+        std::copy(path.c_str(), path.c_str() + path.size() + 1, static_cast<char *>(buffer));
+        return NN_API_STATUS_OK;
+    }
+    default:
+        return NN_API_STATUS_ERROR_OTHER;
+    }
 }
 
 NN_API_STATUS NN_API_CALL_CONVENTION nn_device_parameter_set_0_function(
@@ -2569,7 +3967,80 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_device_parameter_set_0_function(
     void               *buffer,         /* buffer with argument */
     uint32_t            size            /* size of buffer */
     ) {
-    return NN_API_STATUS_ERROR_OTHER;
+    if(!device || !buffer) return NN_API_STATUS_ERROR_INVALID_POINTER;
+
+    switch(parameter) {
+    case NN_PARAMETER_ASYNCHRONOUS_EXECUTION:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->asynchronous_execution = *static_cast<uint32_t *>(buffer) != 0;
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_JIT_CODE_CACHE: {
+        auto path = static_cast<const char *>(buffer);
+        auto length = std::find(path, path + size, '\0') - path;
+        if(length == size) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->jit_cache.set_path(std::string(path, length));
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_AUTO_TUNING:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->tuner.set_enabled(*static_cast<uint32_t *>(buffer) != 0);
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_TUNING_FILE: {
+        auto path = static_cast<const char *>(buffer);
+        auto length = std::find(path, path + size, '\0') - path;
+        if(length == size) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->tuner.set_path(std::string(path, length));
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_NUMA_EXECUTION:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        try {
+            nn_device_set_numa_groups(static_cast<nn_device_internal *>(device), *static_cast<uint32_t *>(buffer));
+        }
+        catch(...) {
+            return NN_API_STATUS_ERROR_OTHER;
+        }
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_LOW_LATENCY_DISPATCH: {
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        auto device_internal = static_cast<nn_device_internal *>(device);
+        std::chrono::microseconds spin_time(*static_cast<uint32_t *>(buffer));
+        device_internal->thread_pool.set_spin_time(spin_time);
+        std::lock_guard<std::mutex> lock(device_internal->numa_mutex);
+        for (auto &group : device_internal->numa_groups)
+            group->thread_pool.set_spin_time(spin_time);
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_THREAD_PLACEMENT: {
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        auto mode = *static_cast<uint32_t *>(buffer);
+        if(mode > static_cast<uint32_t>(nn_thread_placement_mode::siblings)) return NN_API_STATUS_ERROR_OTHER;
+        auto device_internal = static_cast<nn_device_internal *>(device);
+        try {
+            device_internal->thread_pool.set_placement(static_cast<nn_thread_placement_mode>(mode));
+            std::lock_guard<std::mutex> lock(device_internal->numa_mutex);
+            for (auto &group : device_internal->numa_groups)
+                group->thread_pool.set_placement(static_cast<nn_thread_placement_mode>(mode));
+        }
+        catch(...) {
+            return NN_API_STATUS_ERROR_OTHER;
+        }
+        return NN_API_STATUS_OK;
+    }
+    case NN_PARAMETER_FIXEDPOINT_CALIBRATION:
+        if(size < sizeof(uint32_t)) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->calibration.set_enabled(*static_cast<uint32_t *>(buffer) != 0);
+        return NN_API_STATUS_OK;
+    case NN_PARAMETER_FIXEDPOINT_CONFIGURATION: {
+        auto path = static_cast<const char *>(buffer);
+        auto length = std::find(path, path + size, '\0') - path;
+        if(length == size) return NN_API_STATUS_ERROR_OTHER;
+        static_cast<nn_device_internal *>(device)->calibration.set_path(std::string(path, length));
+        return NN_API_STATUS_OK;
+    }
+    default:
+        return NN_API_STATUS_ERROR_OTHER;
+    }
 }
 
 /* returns list of parameters found in workload along with their sizes */
@@ -2580,6 +4051,9 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_query_param_0_function(
     )
 {
     nn_workload_opaque_t *workload_opaque = static_cast<nn_workload_opaque_t *>(workload_public);
+    if (!workload_opaque->numa_workloads.empty())
+        return nn_workload_query_param_0_function(workload_opaque->numa_workloads.front(), params, num_params);
+
     *params = &workload_opaque->params[0];
     *num_params = static_cast<uint32_t>(workload_opaque->params.size());
 
@@ -2593,6 +4067,9 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_recover_param_0_function(
     )
 {
     auto workload_opaque = static_cast<nn_workload_opaque_t*>(workload_public);
+    if (!workload_opaque->numa_workloads.empty())
+        return nn_workload_recover_param_0_function(workload_opaque->numa_workloads.front(), param_name, data);
+
     auto& data_wrapper = *static_cast<nn::data<float>*>(data);
 
     try
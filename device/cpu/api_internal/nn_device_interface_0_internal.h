@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/api/nn_device_api.h"
 #include "device/api/nn_device_interface_0.h"
 #include "device/common/nn_workload_data.h"
+#include "device/common/nn_allocate.h"
 #include "cpu_device_internal.h"
 #include <vector>
 #include <deque>
@@ -83,6 +84,14 @@ struct arguments_input {
     bool                        copy_on_merge;
 };
 
+/* arguments for output layers
+   Index identifies output when workload has more than 1 output.
+   Aliased says if producer writes directly to buffer passed to execution instead of copying result to it */
+struct arguments_output {
+    uint32_t                    index;          /* output index */
+    bool                        aliased;
+};
+
 /* arguments for convolution fixed point layers */
 struct arguments_forward_convolution_fixedpoint
 {
@@ -132,7 +141,7 @@ typedef struct nn_workload_item {
     union {
         /* arguments for simple NN layers */
         nn::arguments_input                                             input;
-        nn_arguments_output_t                                           output;
+        nn::arguments_output                                            output;
         nn_arguments_view_t                                             view;
         nn_arguments_update_t                                           update;
         nn_arguments_loss_function_t                                    loss_function;
@@ -149,8 +158,14 @@ typedef struct nn_workload_item {
         nn_arguments_forward_pooling_fixedpoint_t                       forward_pooling_fixedpoint;
         nn_arguments_normalization_response_across_maps_forward_i16qn_t normalization_response_across_maps_forward_i16qn;
 
+        /* int8 layers, max pooling uses forward_pooling_fixedpoint */
+        nn_arguments_forward_convolution_int8_t                         forward_convolution_int8;
+        nn_arguments_forward_fully_connected_int8_t                     forward_fully_connected_int8;
+        nn_arguments_normalization_response_across_maps_int8_t          normalization_response_across_maps_int8;
+
         /* conversion layers */
         nn_arguments_forward_convert_float_to_int16_fixedpoint_t        forward_convert_float_to_fixedpoint;
+        nn_arguments_forward_convert_float_to_uint8_t                   forward_convert_float_to_uint8;
         nn_arguments_convert_data_layout_t                              convert_data_layout;
 
         /* arguments for for complex NN layers */
@@ -165,6 +180,10 @@ typedef struct nn_workload_item {
     nn_primitive_handle_t                       primitive;
 } nn_workload_item_t;
 
+// Arguments of workflow item are copied to workload item as raw bytes during compilation.
+static_assert(sizeof(nn_workload_item_t::arguments) == sizeof(nn_workflow_item_t::arguments),
+              "arguments of workload item and workflow item must have the same size");
+
 
 typedef struct nn_workload_use_descriptor
 {
@@ -181,10 +200,42 @@ typedef struct profiling_data{
     std::map<nn_workload_item*, std::vector<uint64_t>> work_item_cycles;
 } profiling_data_t;
 
+/* buffers used by single execution of workload
+   Primitives, weights and JIT code are shared by all executions. Primary context uses buffers created during
+   compilation; additional contexts have private copies of all buffers written by work items, so executions
+   running at the same time do not overwrite each other's activations. */
+struct nn_workload_execution_context
+{
+    nn_workload_execution_context()
+        : activation_arena(nullptr)
+    {}
+
+    ~nn_workload_execution_context()
+    {
+        views.clear();
+        nn_free_aligned(activation_arena);
+    }
+
+    /* returns view of this context corresponding to view created during compilation */
+    nn_workload_data_t *view(nn_workload_data_t *compiled_view) const
+    {
+        auto found = views.find(compiled_view);
+        return (found == views.end()) ? compiled_view : found->second.get();
+    }
+
+    std::map<const nn_workload_data_t *, std::unique_ptr<nn_workload_data_t>> views;
+    void                              *activation_arena;
+};
+
 struct nn_workload_opaque_t : nn_workload_t
 {
     nn_workload_opaque_t(nn_workload_t workload_public)
         : nn_workload_t(workload_public)
+        , activation_arena(nullptr)
+        , activation_arena_size(0)
+        , parallel_execution(false)
+        , concurrent_execution(false)
+        , in_flight_count(0)
     {}
 
     std::vector<nn_workload_item_t *>  input;
@@ -196,7 +247,39 @@ struct nn_workload_opaque_t : nn_workload_t
     std::vector<std::vector<uint32_t>> param_sizes;
 #if ENABLE_WORKLOAD_PROFILING
     profiling_data_t                  profiling_data;
+    std::mutex                        profiling_mutex;
 #endif
+
+    /* memory shared by intermediate buffers with disjoint lifetimes, owned by workload */
+    void                              *activation_arena;
+    size_t                             activation_arena_size;
+
+    /* dependency graph over order_of_execution; independent items run concurrently when parallel_execution is set */
+    std::vector<std::vector<size_t>>   item_successors;
+    std::vector<uint32_t>              item_predecessor_count;
+    bool                               parallel_execution;
+
+    /* when concurrent_execution is set each execution takes idle context (primary one first) or creates new one,
+       otherwise executions share primary context and are serialized on execute_mutex */
+    nn_workload_execution_context      primary_context;
+    std::vector<std::unique_ptr<nn_workload_execution_context>> contexts;
+    std::vector<nn_workload_execution_context *> idle_contexts;
+    std::mutex                         context_mutex;
+    std::mutex                         execute_mutex;
+    bool                               concurrent_execution;
+
+    /* workloads compiled by NUMA worker groups for their slices of batch (NN_PARAMETER_NUMA_EXECUTION); when there are
+       any, this workload has no items and its executions are split between them */
+    std::vector<nn_workload_opaque_t *> numa_workloads;
+    std::vector<std::shared_ptr<nn_device_internal>> numa_groups;
+
+    /* keys of items whose output ranges are recorded by executions (NN_PARAMETER_FIXEDPOINT_CALIBRATION) */
+    std::map<nn_workload_item_t *, std::string> calibration_keys;
+
+    /* completion_mutex guards updates of asynchronous statuses and count of executions in flight */
+    std::mutex                         completion_mutex;
+    std::condition_variable            completion;
+    uint32_t                           in_flight_count;
 };
 
 /* create empty workflow */
@@ -305,3 +388,15 @@ NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_recover_param_0_function(
  */
 NN_API_STATUS NN_API_CALL_CONVENTION nn_set_use_jit_primitives_0_function(int flag);
 
+/* waits for asynchronous execution of workload */
+NN_API_STATUS NN_API_CALL_CONVENTION nn_workload_wait_0_function(
+    nn_workload_t          *workload_public, /* workload that was started */
+    NN_API_STATUS          *status,          /* status passed to nn_workload_execute_0_function */
+    uint32_t                timeout_ms       /* timeout in milliseconds, 0 - poll only */
+    );
+
+/* items of workflow in order they are executed by compiled workload */
+std::vector<nn_workflow_item_t*> nn_workflow_items_in_execution_order(nn_workflow_t* workflow);
+
+/* true if workflow compiled for given batch uses batch block primitives */
+bool nn_workflow_uses_batch_block(uint32_t batch);
@@ -0,0 +1,203 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "nn_fixedpoint_calibration.h"
+#include "device/common/nn_workload_data.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+const char C_magic[] = "NNFXP001";
+
+// int16 values of fixed point data
+const float C_int16_max = 32767.0f;
+
+// fractions are shift counts of 32-bit arithmetic in layers
+const int32_t C_max_fraction = 30;
+} //namespace
+
+const float fixedpoint_calibration::saturation_margin = 1.25f;
+
+void fixedpoint_calibration::set_enabled(bool value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = value;
+}
+
+bool fixedpoint_calibration::get_enabled()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return enabled;
+}
+
+void fixedpoint_calibration::set_path(const std::string &new_path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (new_path == path)
+        return;
+
+    // formats belong to file they were loaded from or will be saved to
+    layers.clear();
+    loaded = false;
+    modified = false;
+    path = new_path;
+}
+
+std::string fixedpoint_calibration::get_path()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+void fixedpoint_calibration::load()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (loaded or path.empty())
+        return;
+    loaded = true;
+
+    // missing file or file of other version: ranges are recorded anew and file is overwritten by next save
+    std::ifstream file(path);
+    std::string magic;
+    if (not std::getline(file, magic) or magic != C_magic)
+        return;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() or line[0] == '#')
+            continue;
+
+        // fractions in file may be edited by hand, so they are taken as they are instead of derived from ranges
+        std::istringstream fields(line);
+        std::string name;
+        layer_format format;
+        if (fields >> name >> format.output_fraction >> format.weights_fraction >> format.output_range >> format.weights_range)
+            layers[name] = format;
+    }
+}
+
+void fixedpoint_calibration::save()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path.empty() or not modified)
+        return;
+
+    std::ofstream file(path, std::ios::trunc);
+    file << C_magic << '\n';
+    file << "# saturation margin " << saturation_margin << '\n';
+    file << "# name output_fraction weights_fraction output_range weights_range\n";
+    for (auto &layer : layers)
+        file << layer.first << ' '
+             << layer.second.output_fraction << ' '
+             << layer.second.weights_fraction << ' '
+             << layer.second.output_range << ' '
+             << layer.second.weights_range << '\n';
+    if (file)
+        modified = false;
+}
+
+fixedpoint_calibration::layer_format &fixedpoint_calibration::layer(const std::string &name)
+{
+    auto found = layers.find(name);
+    if (found == layers.end())
+        found = layers.emplace(name, layer_format{0.0f, 0.0f, fraction(0.0f), -1}).first;
+    return found->second;
+}
+
+void fixedpoint_calibration::record_output(const std::string &name, const nn_workload_data_t *output)
+{
+    if (output->parent->layout.data_type != NN_DATATYPE_FLOAT)
+        return;
+
+    float range = 0.0f;
+    auto lengths = get_length(*output);
+    for (uint32_t q = 0; q < lengths.t[NN_DATA_COORD_q]; ++q)
+        for (uint32_t p = 0; p < lengths.t[NN_DATA_COORD_p]; ++p)
+            for (uint32_t z = 0; z < lengths.t[NN_DATA_COORD_z]; ++z)
+                for (uint32_t y = 0; y < lengths.t[NN_DATA_COORD_y]; ++y)
+                    for (uint32_t x = 0; x < lengths.t[NN_DATA_COORD_x]; ++x)
+                        for (uint32_t n = 0; n < lengths.t[NN_DATA_COORD_n]; ++n)
+                            range = std::max(range, std::fabs(nn_workload_data_get<float>(output, n, x, y, z, p, q)));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto is_new = layers.count(name) == 0;
+    auto &format = layer(name);
+    if (is_new or range > format.output_range)
+    {
+        format.output_range = std::max(format.output_range, range);
+        format.output_fraction = fraction(format.output_range);
+        modified = true;
+    }
+}
+
+void fixedpoint_calibration::record_weights(const std::string &name, const nn_data_t *weights)
+{
+    if (weights == nullptr or weights->sizeof_value != sizeof(float))
+        return;
+
+    auto values = static_cast<const float *>(weights->buffer);
+    auto count = nn_data_buffer_size_ptr(1, weights->dimension, weights->size);
+    float range = 0.0f;
+    for (size_t index = 0; index < count; ++index)
+        range = std::max(range, std::fabs(values[index]));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &format = layer(name);
+    format.weights_range = std::max(format.weights_range, range);
+    format.weights_fraction = fraction(format.weights_range);
+    modified = true;
+}
+
+bool fixedpoint_calibration::find(const std::string &name, layer_format &format)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = layers.find(name);
+    if (found == layers.end())
+        return false;
+    format = found->second;
+    return true;
+}
+
+bool fixedpoint_calibration::empty()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return layers.empty();
+}
+
+int32_t fixedpoint_calibration::fraction(float range)
+{
+    if (not (range > 0.0f))
+        return 15;
+
+    auto bits = static_cast<int32_t>(std::floor(std::log2(C_int16_max / (range * saturation_margin))));
+    return std::min(std::max(bits, 0), C_max_fraction);
+}
@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include "device/api/nn_data_0.h"
+
+struct nn_workload_data_t;
+
+/* Fixed point formats of int16 layers derived from ranges of values seen by float workload run on sample data.
+   Recording is opt-in (NN_PARAMETER_FIXEDPOINT_CALIBRATION): workloads compiled while it is enabled track the largest
+   magnitude of outputs of their named items on every execution, along with magnitudes of float weights. Fractions
+   chosen for the ranges are written to text file (NN_PARAMETER_FIXEDPOINT_CONFIGURATION), which int16 compilation
+   reads to replace fractions given in arguments of items of the same name. Workloads split between NUMA worker
+   groups don't record. */
+class fixedpoint_calibration
+{
+public:
+    struct layer_format
+    {
+        float   output_range;       // largest magnitude of output value seen
+        float   weights_range;      // largest magnitude of weight, 0 if layer has no weights
+        int32_t output_fraction;    // fractional bits of int16 output
+        int32_t weights_fraction;   // fractional bits of int16 weights, -1 if layer has no weights
+    };
+
+    // Headroom over range seen in samples, so values slightly larger than ones calibrated on don't saturate.
+    static const float saturation_margin;
+
+    fixedpoint_calibration() : enabled(false), loaded(false), modified(false) {}
+
+    void set_enabled(bool value);
+    bool get_enabled();
+
+    // sets configuration file, empty path keeps formats in memory only; file is read by next load
+    void set_path(const std::string &path);
+    std::string get_path();
+
+    // reads file (once per path), called when workload is compiled
+    void load();
+
+    // writes file if any range was recorded since load
+    void save();
+
+    // extends range of output of layer by values of float view
+    void record_output(const std::string &name, const nn_workload_data_t *output);
+
+    // extends range of weights of layer by values of float weights
+    void record_weights(const std::string &name, const nn_data_t *weights);
+
+    // returns false if there is no format for layer
+    bool find(const std::string &name, layer_format &format);
+
+    bool empty();
+
+    // largest number of fractional bits that keeps value of given magnitude (with margin) in int16 range
+    static int32_t fraction(float range);
+
+private:
+    fixedpoint_calibration(const fixedpoint_calibration &) = delete;
+    fixedpoint_calibration &operator=(const fixedpoint_calibration &) = delete;
+
+    layer_format &layer(const std::string &name);
+
+    std::mutex mutex;
+    std::string path;
+    bool enabled;
+    bool loaded;
+    bool modified;
+    std::map<std::string, layer_format> layers;
+};
@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "nn_kernel_tuner.h"
+#include "device/common/nn_device_internal.h"
+#include "device/common/nn_workload_data.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+const char C_magic[] = "NNTUNE01";
+
+// Timed runs of each candidate after warm-up; the fastest one is taken, so noise of other processes is skipped.
+const uint32_t C_tuning_runs = 5;
+
+typedef std::vector<std::unique_ptr<nn_workload_data_t>> owned_buffers;
+
+owned_buffers take_zeroed(const std::vector<nn_workload_data_t *> &buffers)
+{
+    owned_buffers result;
+    for (auto buffer : buffers)
+    {
+        result.emplace_back(buffer);
+        std::memset(buffer->parent->data_buffer, 0, buffer->parent->buffer_size);
+    }
+    return result;
+}
+
+std::vector<const nn_workload_data_t *> as_const(const owned_buffers &buffers)
+{
+    std::vector<const nn_workload_data_t *> result;
+    for (auto &buffer : buffers)
+        result.push_back(buffer.get());
+    return result;
+}
+
+std::vector<nn_workload_data_t *> as_mutable(const owned_buffers &buffers)
+{
+    std::vector<nn_workload_data_t *> result;
+    for (auto &buffer : buffers)
+        result.push_back(buffer.get());
+    return result;
+}
+} //namespace
+
+void kernel_tuner::set_enabled(bool value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = value;
+}
+
+bool kernel_tuner::get_enabled()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return enabled;
+}
+
+void kernel_tuner::set_path(const std::string &new_path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (new_path == path)
+        return;
+
+    // decisions belong to file they were loaded from or will be saved to
+    decisions.clear();
+    loaded = false;
+    modified = false;
+    path = new_path;
+}
+
+std::string kernel_tuner::get_path()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+void kernel_tuner::load()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (loaded or path.empty())
+        return;
+    loaded = true;
+
+    // missing file or file of other version: decisions are made again and file is overwritten by next save
+    std::ifstream file(path);
+    std::string magic;
+    if (not std::getline(file, magic) or magic != C_magic)
+        return;
+
+    std::string key, decision;
+    while (file >> key >> decision)
+        decisions.emplace(key, decision);
+}
+
+void kernel_tuner::save()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path.empty() or not modified)
+        return;
+
+    std::ofstream file(path, std::ios::trunc);
+    file << C_magic << '\n';
+    for (auto &decision : decisions)
+        file << decision.first << ' ' << decision.second << '\n';
+    if (file)
+        modified = false;
+}
+
+double kernel_tuner::measure(const candidate &candidate)
+{
+    try
+    {
+        std::unique_ptr<nn_primitive_t> primitive(candidate.create());
+        auto inputs = take_zeroed(primitive->create_inputs(false));
+        auto parameters = take_zeroed(primitive->create_parameters(false));
+        auto outputs = take_zeroed(primitive->create_outputs(false));
+
+        primitive->prepare_forward(as_const(inputs), as_const(parameters), as_mutable(outputs));
+        primitive->forward(as_const(inputs), as_const(parameters), as_mutable(outputs));
+
+        auto best = std::numeric_limits<double>::infinity();
+        for (auto run = 0u; run < C_tuning_runs; ++run)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            primitive->forward(as_const(inputs), as_const(parameters), as_mutable(outputs));
+            std::chrono::duration<double> time = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, time.count());
+        }
+        return best;
+    }
+    catch (...)
+    {
+        // candidate doesn't support this configuration
+        return std::numeric_limits<double>::infinity();
+    }
+}
+
+nn_primitive_t *kernel_tuner::choose(const std::string &key, const std::vector<candidate> &candidates)
+{
+    if (candidates.empty())
+        throw std::invalid_argument("kernel_tuner: no candidates for " + key);
+
+    std::string decision;
+    bool tune;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = decisions.find(key);
+        if (found != decisions.end())
+            decision = found->second;
+        tune = enabled and decision.empty() and candidates.size() > 1;
+    }
+
+    if (tune)
+    {
+        auto best = std::numeric_limits<double>::infinity();
+        for (auto &candidate : candidates)
+        {
+            auto time = measure(candidate);
+            if (time < best)
+            {
+                best = time;
+                decision = candidate.name;
+            }
+        }
+
+        if (not decision.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decisions[key] = decision;
+            modified = true;
+        }
+    }
+
+    // decisions from file naming candidates which are no longer viable fall back to heuristic choice
+    auto chosen = std::find_if(candidates.begin(), candidates.end(),
+                               [&](const candidate &candidate) { return candidate.name == decision; });
+    return (chosen != candidates.end() ? *chosen : candidates.front()).create();
+}
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct nn_primitive_t;
+
+/* Chooses implementation of layer among viable candidates by timing them on the machine workflow is compiled on.
+   Tuning is opt-in (NN_PARAMETER_AUTO_TUNING); otherwise the first candidate, which the compiler's heuristics
+   prefer, is used. Decisions are kept for the lifetime of device and, when path is set (NN_PARAMETER_TUNING_FILE),
+   read from and written to a text file, so later compiles reuse them without tuning. */
+class kernel_tuner
+{
+public:
+    struct candidate
+    {
+        std::string name;                           // identifies candidate in tuning file
+        std::function<nn_primitive_t *()> create;   // creates new instance of primitive
+    };
+
+    kernel_tuner() : enabled(false), loaded(false), modified(false) {}
+
+    void set_enabled(bool value);
+    bool get_enabled();
+
+    // sets file with decisions, empty path keeps decisions in memory only; file is read by next load
+    void set_path(const std::string &path);
+    std::string get_path();
+
+    // reads file (once per path), called when workload is compiled
+    void load();
+
+    // writes file if any decision was made since load
+    void save();
+
+    // returns primitive of candidate decided for key; candidates are timed if tuning is enabled and key is new
+    nn_primitive_t *choose(const std::string &key, const std::vector<candidate> &candidates);
+
+private:
+    kernel_tuner(const kernel_tuner &) = delete;
+    kernel_tuner &operator=(const kernel_tuner &) = delete;
+
+    // best time of forward pass of candidate run on zero-filled buffers, infinity if candidate can't run
+    static double measure(const candidate &candidate);
+
+    std::mutex mutex;
+    std::string path;
+    bool enabled;
+    bool loaded;
+    bool modified;
+    std::map<std::string, std::string> decisions;
+};
+
+/* Returns key of tuning decision made of layer name and its arguments. */
+template <typename... T_args>
+std::string tuning_key(const char *name, T_args... args)
+{
+    std::string key = name;
+    for (auto arg : {static_cast<uint64_t>(args)...})
+        key += "," + std::to_string(arg);
+    return key;
+}
@@ -0,0 +1,235 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "nn_numa_topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+#ifdef __linux__
+std::vector<uint32_t> allowed_cpus()
+{
+    std::vector<uint32_t> cpus;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
+        return cpus;
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &cpuset))
+            cpus.push_back(cpu);
+    return cpus;
+}
+#else
+std::vector<uint32_t> allowed_cpus()
+{
+    std::vector<uint32_t> cpus(std::max(std::thread::hardware_concurrency(), 1u));
+    for (uint32_t cpu = 0; cpu < cpus.size(); ++cpu)
+        cpus[cpu] = cpu;
+    return cpus;
+}
+#endif
+} //namespace
+
+std::vector<uint32_t> nn_parse_cpu_list(const std::string &list)
+{
+    std::vector<uint32_t> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c); }), range.end());
+        if (range.empty())
+            continue;
+
+        auto dash = range.find('-');
+        auto first = std::stoul(range.substr(0, dash));
+        auto last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+        if (last < first)
+            throw std::runtime_error("invalid cpu list: " + list);
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(static_cast<uint32_t>(cpu));
+    }
+    return cpus;
+}
+
+std::vector<nn_numa_node> nn_numa_nodes()
+{
+    auto allowed = allowed_cpus();
+    std::vector<nn_numa_node> nodes;
+
+#ifdef __linux__
+    const std::string nodes_path = "/sys/devices/system/node/";
+    if (auto directory = opendir(nodes_path.c_str()))
+    {
+        while (auto entry = readdir(directory))
+        {
+            std::string name(entry->d_name);
+            if (name.compare(0, 4, "node") != 0 || name.size() == 4
+                || !std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit(c); }))
+                continue;
+
+            std::ifstream file(nodes_path + name + "/cpulist");
+            std::string list;
+            if (!std::getline(file, list))
+                continue;
+
+            nn_numa_node node{static_cast<uint32_t>(std::stoul(name.substr(4))), {}};
+            for (auto cpu : nn_parse_cpu_list(list))
+                if (std::binary_search(allowed.begin(), allowed.end(), cpu))
+                    node.cpus.push_back(cpu);
+            if (!node.cpus.empty())
+                nodes.push_back(node);
+        }
+        closedir(directory);
+    }
+#endif
+
+    if (nodes.empty() && !allowed.empty())
+        nodes.push_back(nn_numa_node{0, allowed});
+
+    std::sort(nodes.begin(), nodes.end(), [](const nn_numa_node &lhs, const nn_numa_node &rhs) { return lhs.id < rhs.id; });
+    return nodes;
+}
+
+std::vector<std::vector<uint32_t>> nn_numa_worker_groups(const std::vector<nn_numa_node> &nodes, size_t group_count)
+{
+    std::vector<std::vector<uint32_t>> groups(group_count);
+    if (nodes.empty())
+        return groups;
+
+    for (size_t node = 0; node < nodes.size() && node < group_count; ++node)
+    {
+        auto &cpus = nodes[node].cpus;
+        auto groups_on_node = (group_count - node + nodes.size() - 1) / nodes.size();
+        for (size_t index = 0; index < groups_on_node; ++index)
+        {
+            auto &group = groups[node + index * nodes.size()];
+            if (cpus.size() < groups_on_node)
+                group = cpus;
+            else
+                group.assign(cpus.begin() + cpus.size() * index / groups_on_node,
+                             cpus.begin() + cpus.size() * (index + 1) / groups_on_node);
+        }
+    }
+    return groups;
+}
+
+std::vector<nn_cpu_core> nn_cpu_cores(const std::vector<uint32_t> &cpus)
+{
+    auto selected = cpus.empty() ? allowed_cpus() : cpus;
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    // cores keyed by lowest CPU of their sibling list, ordered by first selected CPU
+    std::vector<std::pair<uint32_t, nn_cpu_core>> cores;
+    for (auto cpu : selected)
+    {
+        auto key = cpu;
+#ifdef __linux__
+        std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+        std::string list;
+        if (std::getline(file, list))
+        {
+            auto siblings = nn_parse_cpu_list(list);
+            if (!siblings.empty())
+                key = *std::min_element(siblings.begin(), siblings.end());
+        }
+#endif
+        auto core = std::find_if(cores.begin(), cores.end(),
+                                 [key](const std::pair<uint32_t, nn_cpu_core> &entry) { return entry.first == key; });
+        if (core == cores.end())
+            cores.push_back({key, nn_cpu_core{{cpu}}});
+        else
+            core->second.cpus.push_back(cpu);
+    }
+
+    std::vector<nn_cpu_core> result;
+    for (auto &core : cores)
+        result.push_back(core.second);
+    return result;
+}
+
+nn_thread_placement nn_place_threads(const std::vector<nn_cpu_core> &cores, size_t primary_count)
+{
+    nn_thread_placement placement;
+
+    // CPUs in order of preference: first CPUs of all cores, then second ones, etc.
+    std::vector<uint32_t> order;
+    for (size_t sibling = 0; order.size() < primary_count; ++sibling)
+    {
+        auto previous_size = order.size();
+        for (auto &core : cores)
+            if (sibling < core.cpus.size())
+                order.push_back(core.cpus[sibling]);
+        if (order.size() == previous_size)
+            break;
+    }
+    if (order.empty())
+        return placement;
+
+    for (size_t index = 0; index < primary_count; ++index)
+        placement.primary.push_back(order[index % order.size()]);
+
+    // siblings of cores used by primary workers
+    for (auto &core : cores)
+    {
+        if (std::find(placement.primary.begin(), placement.primary.end(), core.cpus[0]) == placement.primary.end())
+            continue;
+        for (auto cpu : core.cpus)
+            if (std::find(placement.primary.begin(), placement.primary.end(), cpu) == placement.primary.end())
+                placement.secondary.push_back(cpu);
+    }
+    return placement;
+}
+
+void nn_set_thread_cpus(std::thread &thread, const std::vector<uint32_t> &cpus)
+{
+#ifdef __linux__
+    if (cpus.empty())
+        return;
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (auto cpu : cpus)
+        CPU_SET(cpu, &cpuset);
+
+    int err = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset);
+    if (err != 0)
+        throw std::runtime_error(std::string("Error setting affinity of thread. pthread_setaffinity_np error code: ") + std::to_string(err));
+#endif
+}
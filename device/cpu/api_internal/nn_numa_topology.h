@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* CPUs of single NUMA node which this process is allowed to run on */
+struct nn_numa_node
+{
+    uint32_t id;
+    std::vector<uint32_t> cpus;
+};
+
+/* logical CPUs of single physical core (hyperthread siblings) */
+struct nn_cpu_core
+{
+    std::vector<uint32_t> cpus;
+};
+
+/* CPUs workers of pool are pinned to: primary workers get separate physical cores while there are any,
+   hyperthread siblings of their cores are left for secondary workers */
+struct nn_thread_placement
+{
+    std::vector<uint32_t> primary;
+    std::vector<uint32_t> secondary;
+};
+
+/* parses CPU list in format used by kernel, eg. "0-3,8,10-11" */
+std::vector<uint32_t> nn_parse_cpu_list(const std::string &list);
+
+/* NUMA nodes of machine, read from sysfs and restricted to affinity of calling thread (taskset, cgroup cpusets);
+   nodes without allowed CPUs are skipped. Without NUMA information single node with all allowed CPUs is returned. */
+std::vector<nn_numa_node> nn_numa_nodes();
+
+/* CPUs of each of group_count worker groups; groups are assigned to nodes round robin, CPUs of node shared
+   by several groups are divided evenly between them (all of them when there are fewer CPUs than groups) */
+std::vector<std::vector<uint32_t>> nn_numa_worker_groups(const std::vector<nn_numa_node> &nodes, size_t group_count);
+
+/* physical cores of given CPUs (all CPUs allowed for calling thread when empty), read from thread_siblings_list
+   in sysfs; siblings outside of given CPUs are skipped. Without topology information each CPU is separate core. */
+std::vector<nn_cpu_core> nn_cpu_cores(const std::vector<uint32_t> &cpus = {});
+
+/* placement of primary_count workers on cores; primary workers take first CPU of each core, then siblings,
+   and wrap around when there are more workers than CPUs; siblings not taken are given to secondary workers */
+nn_thread_placement nn_place_threads(const std::vector<nn_cpu_core> &cores, size_t primary_count);
+
+/* restricts thread to given CPUs; empty list leaves affinity unchanged */
+void nn_set_thread_cpus(std::thread &thread, const std::vector<uint32_t> &cpus);
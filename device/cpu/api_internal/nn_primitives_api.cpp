@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/cpu/core/helper_zxyn_f32.h"
 #include "device/cpu/core/layer_arithmetic_operation.h"
 
+#include <iostream>
+
 nn_device_t *NN_API_CALL_CONVENTION create_device_with_thread_count(size_t num_threads, NN_API_STATUS *status) {
     SET_STATUS(NN_API_STATUS_OK);
     return new nn_device_internal(num_threads);
@@ -54,12 +56,180 @@ NN_API_STATUS NN_API_CALL_CONVENTION delete_primitive(nn_primitive_handle_t prim
     delete primitive;
     return NN_API_STATUS_OK;
 }
+
+/* Event of asynchronous primitives call.
+   Task is handed to dispatcher when all events it depends on are completed, so independent calls run
+   concurrently (each of them using device thread pool for its computations). Event is referenced by
+   user handle and by its pending task; it is freed when both are released. */
+struct nn_event
+{
+    nn_event(std::function<void()> task)
+        : task(std::move(task))
+        , references(2)
+        , pending_dependencies(1)
+        , completed(false)
+        , status(NN_API_STATUS_OK) {}
+
+    std::function<void()>   task;
+    std::atomic<uint32_t>   references;
+    std::atomic<uint32_t>   pending_dependencies;   // +1 until scheduling call finishes registering dependencies
+    std::mutex              event_mutex;
+    std::condition_variable event_condition;
+    bool                    completed;
+    NN_API_STATUS           status;                 // task result or error inherited from dependency
+    std::vector<nn_event *> dependents;             // events waiting for this one, guarded by event_mutex
+};
+
+namespace
+{
+// Dispatcher shared by all devices - forward/backward calls only get primitive handle.
+// It is never destroyed, so no threads are joined during library unload.
+nn_request_dispatcher &primitives_dispatcher()
+{
+    static nn_request_dispatcher *dispatcher = new nn_request_dispatcher;
+    return *dispatcher;
+}
+
+void release_event(nn_event *event)
+{
+    if (--event->references == 0)
+        delete event;
+}
+
+void dependency_completed(nn_event *event, NN_API_STATUS dependency_status);
+
+void complete_event(nn_event *event, NN_API_STATUS result)
+{
+    std::vector<nn_event *> dependents;
+    {
+        std::lock_guard<std::mutex> lock(event->event_mutex);
+        event->completed = true;
+        event->status = result;
+        dependents.swap(event->dependents);
+        event->event_condition.notify_all();
+    }
+
+    for (auto dependent : dependents)
+        dependency_completed(dependent, result);
+
+    release_event(event);
+}
+
+void run_event(nn_event *event)
+{
+    NN_API_STATUS result;
+    {
+        std::lock_guard<std::mutex> lock(event->event_mutex);
+        result = event->status;
+    }
+
+    // Task is skipped when one of its dependencies failed.
+    if (result == NN_API_STATUS_OK)
+    {
+        try
+        {
+            event->task();
+        }
+        catch (NN_API_STATUS status)
+        {
+            result = status;
+        }
+        catch (std::bad_alloc &)
+        {
+            result = NN_API_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        catch (std::exception &exception)
+        {
+            std::cerr << "primitives task failed: " << exception.what() << std::endl;
+            result = NN_API_STATUS_ERROR_OTHER;
+        }
+        catch (...)
+        {
+            result = NN_API_STATUS_ERROR_OTHER;
+        }
+    }
+
+    // Release captured arguments before anyone waiting on event is woken up.
+    event->task = nullptr;
+    complete_event(event, result);
+}
+
+void dependency_completed(nn_event *event, NN_API_STATUS dependency_status)
+{
+    if (dependency_status != NN_API_STATUS_OK)
+    {
+        std::lock_guard<std::mutex> lock(event->event_mutex);
+        if (event->status == NN_API_STATUS_OK)
+            event->status = dependency_status;
+    }
+
+    if (--event->pending_dependencies == 0)
+        primitives_dispatcher().push([event]() { run_event(event); });
+}
+
+/* Create event for task and schedule it after all its dependencies complete.
+   Arguments captured by task must be copied - caller arrays may be gone before it runs. */
+nn_event_t schedule_task(size_t dependency_count, nn_event_t dependency_array[], std::function<void()> task)
+{
+    auto event = new nn_event(std::move(task));
+
+    for (size_t index = 0; index < dependency_count; ++index)
+    {
+        auto dependency = dependency_array[index];
+        if (dependency == nullptr)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dependency->event_mutex);
+        if (dependency->completed)
+        {
+            if (dependency->status != NN_API_STATUS_OK && event->status == NN_API_STATUS_OK)
+                event->status = dependency->status;
+        }
+        else
+        {
+            ++event->pending_dependencies;
+            dependency->dependents.push_back(event);
+        }
+    }
+
+    dependency_completed(event, NN_API_STATUS_OK);
+    return event;
+}
+
+template <typename T_destination, typename T_source>
+std::vector<T_destination> copy_array(T_source *const array[], size_t count)
+{
+    std::vector<T_destination> result;
+    for (size_t index = 0; index < count; ++index)
+        result.push_back(reinterpret_cast<T_destination>(array[index]));
+    return result;
+}
+} //namespace
+
 NN_API_STATUS NN_API_CALL_CONVENTION delete_event(nn_event_t event){
+    if (event != nullptr)
+        release_event(event);
     return NN_API_STATUS_OK;
 }
 
 NN_API_STATUS NN_API_CALL_CONVENTION wait(size_t dependencies_count, nn_event_t *dependencies){
-    return NN_API_STATUS_OK;
+    if (dependencies_count != 0 && dependencies == nullptr)
+        return NN_API_STATUS_ERROR_INVALID_POINTER;
+
+    NN_API_STATUS result = NN_API_STATUS_OK;
+    for (size_t index = 0; index < dependencies_count; ++index)
+    {
+        auto event = dependencies[index];
+        if (event == nullptr)
+            continue;
+
+        std::unique_lock<std::mutex> lock(event->event_mutex);
+        event->event_condition.wait(lock, [event]() { return event->completed; });
+        if (result == NN_API_STATUS_OK)
+            result = event->status;
+    }
+
+    return result;
 }
 
 extern nn_primitives_0_t nn_primitives_0;
@@ -375,6 +545,23 @@ void copy_data_or_delta(nn_device_internal *device, nn_workload_data_t *destinat
             return;
         }
         break;
+    case NN_DATATYPE_INT8:
+        switch (destination->parent->tag) {
+        case NN_WORKLOAD_DATA_TAG_I4O32IXYO:
+            if (source->dimension == 4) {
+                nn::data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, int8_t>::copy<copy_deltas>(
+                    device,
+                    reinterpret_cast<nn::workload_data<int8_t> *>(destination),
+                    nn::data_cast<int8_t, 4>(source));
+                return;
+            }
+            nn::data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, int8_t>::copy<copy_deltas>(
+                device,
+                reinterpret_cast<nn::workload_data<int8_t> *>(destination),
+                nn::data_cast<int8_t, 2>(source));
+            return;
+        }
+        break;
     }
 
     throw std::runtime_error("workload data tag support not implemented (" + std::to_string(destination->parent->tag) + ")");
@@ -400,10 +587,12 @@ nn_event_t NN_API_CALL_CONVENTION copy_to_opaque_async(
                                    completed before the copy is started */
     NN_API_STATUS *status          /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    copy_data(static_cast<nn_device_internal *>(device), reinterpret_cast<nn_workload_data_t *>(destination), source);
+    auto event = schedule_task(dependency_count, dependency_array, [device, destination, source]() {
+        copy_data(static_cast<nn_device_internal *>(device), reinterpret_cast<nn_workload_data_t *>(destination), source);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION copy_from_opaque_async(
@@ -415,10 +604,12 @@ nn_event_t NN_API_CALL_CONVENTION copy_from_opaque_async(
                                    completed before the copy is started */
     NN_API_STATUS *status          /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    copy_data(static_cast<nn_device_internal *>(device), destination, reinterpret_cast<nn_workload_data_t *>(source));
+    auto event = schedule_task(dependency_count, dependency_array, [device, destination, source]() {
+        copy_data(static_cast<nn_device_internal *>(device), destination, reinterpret_cast<nn_workload_data_t *>(source));
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION copy_delta_to_opaque_async(
@@ -430,10 +621,12 @@ nn_event_t NN_API_CALL_CONVENTION copy_delta_to_opaque_async(
                                    completed before the copy is started */
     NN_API_STATUS *status          /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    copy_delta(static_cast<nn_device_internal *>(device), reinterpret_cast<nn_workload_data_t *>(destination), source);
+    auto event = schedule_task(dependency_count, dependency_array, [device, destination, source]() {
+        copy_delta(static_cast<nn_device_internal *>(device), reinterpret_cast<nn_workload_data_t *>(destination), source);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION copy_delta_from_opaque_async(
@@ -445,10 +638,12 @@ nn_event_t NN_API_CALL_CONVENTION copy_delta_from_opaque_async(
                                    completed before the copy is started */
     NN_API_STATUS *status          /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    copy_delta(static_cast<nn_device_internal *>(device), destination, reinterpret_cast<nn_workload_data_t *>(source));
+    auto event = schedule_task(dependency_count, dependency_array, [device, destination, source]() {
+        copy_delta(static_cast<nn_device_internal *>(device), destination, reinterpret_cast<nn_workload_data_t *>(source));
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION copy_opaque_to_opaque_async(
@@ -471,20 +666,22 @@ nn_event_t NN_API_CALL_CONVENTION copy_opaque_to_opaque_async(
     assert(src_data->parent->lengths == dst_data->parent->lengths);
     assert(src_data != dst_data);
 
-    auto src_buffer = src_data->parent->data_buffer;
-    auto dst_buffer = dst_data->parent->data_buffer;
+    auto event = schedule_task(dependency_count, dependency_array, [=]() {
+        auto src_buffer = src_data->parent->data_buffer;
+        auto dst_buffer = dst_data->parent->data_buffer;
+
+        if (source_data_or_delta == USE_DELTA)
+            src_buffer = src_data->parent->delta_buffer;
 
-	if (source_data_or_delta == USE_DELTA)
-        src_buffer = src_data->parent->delta_buffer;
-    
-	if (destination_data_or_delta == USE_DELTA)
-        dst_buffer = dst_data->parent->delta_buffer;
+        if (destination_data_or_delta == USE_DELTA)
+            dst_buffer = dst_data->parent->delta_buffer;
 
-    assert(src_buffer != dst_buffer);
-    memcpy(dst_buffer, src_buffer, dst_data->parent->buffer_size);
+        assert(src_buffer != dst_buffer);
+        memcpy(dst_buffer, src_buffer, dst_data->parent->buffer_size);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return{};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION axpby_async(
@@ -506,27 +703,33 @@ nn_event_t NN_API_CALL_CONVENTION axpby_async(
     assert(x_input->parent->layout == y_input->parent->layout);
     assert(x_input->parent->lengths == y_input->parent->lengths);
 
-    nn::workload_data<> x(
-        (X_data_or_delta == USE_DELTA) ? x_input->parent->delta_buffer : x_input->parent->data_buffer,
-        x_input->parent->lengths, x_input->parent->layout);
-    
-    nn::workload_data<> y(
-        (Y_data_or_delta == USE_DELTA) ? y_input->parent->delta_buffer : y_input->parent->data_buffer,
-        y_input->parent->lengths, y_input->parent->layout);
-
-    // TODO: This probably should be optimized.
-    layer::arithmetic_f32 arithmetic(0, 0, 0, // not used internally
-                                     NN_ARITHMETIC_FUNCTION_ADDITION,
-                                     0,       // not used internally
-                                     alpha, beta, 1,
-                                     static_cast<nn_device_internal *>(device));
-
-    arithmetic.forward({ reinterpret_cast<nn_workload_data_t *const >(&x) },
-                       { reinterpret_cast<nn_workload_data_t *const >(&y) }, 
-                       { reinterpret_cast<nn_workload_data_t *>(&y) });
+    auto event = schedule_task(dependency_count, dependency_array, [=]() {
+        // Buffers are processed as single flat image - arithmetic broadcasts its factor (Y) over batch.
+        const nn_workload_data_coords_t flat_lengths(
+            1, static_cast<uint32_t>(y_input->parent->buffer_size / sizeof(float)), 1, 1, 1, 1);
+
+        nn::workload_data<> x(
+            (X_data_or_delta == USE_DELTA) ? x_input->parent->delta_buffer : x_input->parent->data_buffer,
+            flat_lengths, x_input->parent->layout);
+
+        nn::workload_data<> y(
+            (Y_data_or_delta == USE_DELTA) ? y_input->parent->delta_buffer : y_input->parent->data_buffer,
+            flat_lengths, y_input->parent->layout);
+
+        // TODO: This probably should be optimized.
+        layer::arithmetic_f32 arithmetic(0, 0, 0, // not used internally
+                                         NN_ARITHMETIC_FUNCTION_ADDITION,
+                                         0,       // not used internally
+                                         alpha, beta, 1,
+                                         static_cast<nn_device_internal *>(device));
+
+        arithmetic.forward({ reinterpret_cast<nn_workload_data_t *const >(&x) },
+                           { reinterpret_cast<nn_workload_data_t *const >(&y) },
+                           { reinterpret_cast<nn_workload_data_t *>(&y) });
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return{};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION forward_async(
@@ -542,15 +745,16 @@ nn_event_t NN_API_CALL_CONVENTION forward_async(
                                                  completed before the execution is started */
     NN_API_STATUS *status                      /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    handle->forward({reinterpret_cast<nn_workload_data_t *const *>(&input_array[0]),
-                     reinterpret_cast<nn_workload_data_t *const *>(&input_array[input_count])},
-                    {reinterpret_cast<nn_workload_data_t *const *>(&parameter_array[0]),
-                     reinterpret_cast<nn_workload_data_t *const *>(&parameter_array[parameter_count])},
-                    {reinterpret_cast<nn_workload_data_t **>(&output_array[0]),
-                     reinterpret_cast<nn_workload_data_t **>(&output_array[output_count])});
+    auto inputs = copy_array<const nn_workload_data_t *>(input_array, input_count);
+    auto parameters = copy_array<const nn_workload_data_t *>(parameter_array, parameter_count);
+    auto outputs = copy_array<nn_workload_data_t *>(output_array, output_count);
+
+    auto event = schedule_task(dependency_count, dependency_array, [=]() {
+        handle->forward(inputs, parameters, outputs);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION backward_async(
@@ -566,15 +770,16 @@ nn_event_t NN_API_CALL_CONVENTION backward_async(
                                                  completed before the execution is started */
     NN_API_STATUS *status                      /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    handle->backward({reinterpret_cast<nn_workload_data_t **>(&input_array[0]),
-                      reinterpret_cast<nn_workload_data_t **>(&input_array[input_count])},
-                     {reinterpret_cast<nn_workload_data_t *const *>(&parameter_array[0]),
-                      reinterpret_cast<nn_workload_data_t *const *>(&parameter_array[parameter_count])},
-                     {reinterpret_cast<nn_workload_data_t *const *>(&output_array[0]),
-                      reinterpret_cast<nn_workload_data_t *const *>(&output_array[output_count])});
+    auto inputs = copy_array<nn_workload_data_t *>(input_array, input_count);
+    auto parameters = copy_array<const nn_workload_data_t *>(parameter_array, parameter_count);
+    auto outputs = copy_array<const nn_workload_data_t *>(output_array, output_count);
+
+    auto event = schedule_task(dependency_count, dependency_array, [=]() {
+        handle->backward(inputs, parameters, outputs);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 nn_event_t NN_API_CALL_CONVENTION backward_parameter_async(
@@ -591,16 +796,16 @@ nn_event_t NN_API_CALL_CONVENTION backward_parameter_async(
                                                  completed before the execution is started */
     NN_API_STATUS *status                      /* set to NN_API_STATUS_OK on scheduling success */
     ) {
-    handle->backward_parameter(data_index,
-                               {reinterpret_cast<nn_workload_data_t *const *>(&input_array[0]),
-                                reinterpret_cast<nn_workload_data_t *const *>(&input_array[input_count])},
-                               {reinterpret_cast<nn_workload_data_t **>(&parameter_array[0]),
-                                reinterpret_cast<nn_workload_data_t **>(&parameter_array[parameter_count]) },
-                               {reinterpret_cast<nn_workload_data_t *const *>(&output_array[0]),
-                                reinterpret_cast<nn_workload_data_t *const *>(&output_array[output_count])});
+    auto inputs = copy_array<const nn_workload_data_t *>(input_array, input_count);
+    auto parameters = copy_array<nn_workload_data_t *>(parameter_array, parameter_count);
+    auto outputs = copy_array<const nn_workload_data_t *>(output_array, output_count);
+
+    auto event = schedule_task(dependency_count, dependency_array, [=]() {
+        handle->backward_parameter(data_index, inputs, parameters, outputs);
+    });
 
     SET_STATUS(NN_API_STATUS_OK);
-    return {};
+    return event;
 }
 
 
@@ -0,0 +1,568 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "nn_workflow_cost_model.h"
+#include "nn_device_interface_0_internal.h"
+
+#include <immintrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+// Fraction of peak arithmetic throughput reached by kernels of particular kind.
+const double C_efficiency_convolution = 0.6;
+const double C_efficiency_convolution_batch_block = 0.8;
+const double C_efficiency_fully_connected = 0.7;
+const double C_efficiency_int16 = 1.2;           // 16-bit multiply-adds do twice as many operations per instruction
+const double C_efficiency_int8 = 1.8;            // u8 x s8 multiply-adds do four times as many, widening costs extra instruction
+const double C_efficiency_other = 0.25;
+
+// Energy model: active power of each thread plus dynamic energy of operations and memory traffic.
+const double C_watts_per_thread = 3.0;           // nJ per ns
+const double C_nj_per_operation = 0.005;
+const double C_nj_per_byte = 0.1;
+
+// Arithmetic operations per output value of items without weights.
+const uint64_t C_operations_softmax = 25;
+const uint64_t C_operations_normalization = 10;
+
+// Size of buffers used to measure memory bandwidth.
+const size_t C_bandwidth_buffer_size = 16 * 1024 * 1024;
+
+double elapsed_ns(std::chrono::steady_clock::time_point begin)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+
+uint64_t count(const nn_output_format_t &format)
+{
+    uint64_t result = 1;
+    for (auto dimension = 0u; dimension < static_cast<uint32_t>(format.format); ++dimension)
+        result *= format.format_3d.size[dimension];
+    return result;
+}
+
+uint64_t count(const nn_data_t *data)
+{
+    if (data == nullptr)
+        return 0;
+
+    uint64_t result = 1;
+    for (auto dimension = 0u; dimension < data->dimension; ++dimension)
+        result *= data->size[dimension];
+    return result;
+}
+
+uint64_t bytes(const nn_data_t *data)
+{
+    return data ? count(data) * data->sizeof_value : 0;
+}
+
+uint32_t element_size(NN_WORKLOAD_DATA_TYPE type)
+{
+    switch (type)
+    {
+    case NN_WORKLOAD_DATA_TYPE_I16_1D:
+    case NN_WORKLOAD_DATA_TYPE_I16_1D_BATCH:
+    case NN_WORKLOAD_DATA_TYPE_I16_3D:
+    case NN_WORKLOAD_DATA_TYPE_I16_3D_BATCH:
+    case NN_WORKLOAD_DATA_TYPE_I16_ZXY:
+    case NN_WORKLOAD_DATA_TYPE_I16_ZXY_BATCH:
+        return sizeof(int16_t);
+    default:
+        return sizeof(float);
+    }
+}
+
+/* size of values produced by item; inputs take size of format given to workload */
+uint32_t element_size(const nn_workflow_item_t *item)
+{
+    switch (item->type)
+    {
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_INT16_FIXEDPOINT:
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT16_FIXEDPOINT:
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN:
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT:
+        return sizeof(int16_t);
+    case NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8:
+    case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8:
+    case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8:
+    case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8:
+    case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+        return sizeof(uint8_t);
+    default:
+        return sizeof(float);
+    }
+}
+
+/* formats which keep 3D data in layout different than ZXY used by items, so they are converted */
+bool needs_conversion(NN_WORKLOAD_DATA_TYPE type)
+{
+    switch (type)
+    {
+    case NN_WORKLOAD_DATA_TYPE_F32_3D:
+    case NN_WORKLOAD_DATA_TYPE_F32_3D_BATCH:
+    case NN_WORKLOAD_DATA_TYPE_I16_3D:
+    case NN_WORKLOAD_DATA_TYPE_I16_3D_BATCH:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Batch sizes of variants reported by metrics query.
+const uint32_t C_variant_batches[] = {1, 8, 16, 24, 32, 48, 64, 96};
+
+// Count of entries in metric table: time, energy, single thread time, operations, bytes, threads.
+const uint32_t C_metric_count = 6;
+
+// Thread counts of variants: 1 and powers of two below threads of pool, then all of them.
+std::vector<size_t> variant_threads(size_t pool_threads)
+{
+    std::vector<size_t> result;
+    for (size_t threads = 1; threads < pool_threads; threads *= 2)
+        result.push_back(threads);
+    result.push_back(std::max<size_t>(pool_threads, 1));
+    return result;
+}
+
+bool is_int16_item(const nn_workflow_item_t *item)
+{
+    return item->type != NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_INT16_FIXEDPOINT
+           && element_size(item) == sizeof(int16_t);
+}
+
+/* formats in which workload accepts data of workflow input */
+std::vector<NN_WORKLOAD_DATA_TYPE> input_formats(const nn_workflow_item_t *input)
+{
+    bool int16 = false, labels = false;
+    for (auto index = 0u; index < input->use_count; ++index)
+    {
+        auto consumer = input->use[index].item;
+        int16 |= is_int16_item(consumer);
+        labels |= consumer->type == NN_WORK_ITEM_TYPE_SOFTMAX_LOSS
+                  && consumer->input_count > 1 && consumer->input[1].item == input;
+    }
+
+    if (labels)
+        return {NN_WORKLOAD_DATA_TYPE_I32_1D_BATCH};
+
+    switch (input->output_format[0].format)
+    {
+    case NN_DATA_FORMAT_1D:
+        return {int16 ? NN_WORKLOAD_DATA_TYPE_I16_1D_BATCH : NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH};
+    case NN_DATA_FORMAT_2D:
+        return {NN_WORKLOAD_DATA_TYPE_F32_2D_BATCH};
+    default:
+        if (int16)
+            return {NN_WORKLOAD_DATA_TYPE_I16_ZXY_BATCH, NN_WORKLOAD_DATA_TYPE_I16_3D_BATCH};
+        return {NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, NN_WORKLOAD_DATA_TYPE_F32_3D_BATCH};
+    }
+}
+
+/* formats in which workload returns data of workflow output */
+std::vector<NN_WORKLOAD_DATA_TYPE> output_formats(const nn_workflow_item_t *output)
+{
+    auto producer = output->input[0].item;
+    bool int16 = is_int16_item(producer);
+
+    switch (output->output_format[0].format)
+    {
+    case NN_DATA_FORMAT_1D:
+        return {int16 ? NN_WORKLOAD_DATA_TYPE_I16_1D_BATCH : NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH};
+    case NN_DATA_FORMAT_2D:
+        return {NN_WORKLOAD_DATA_TYPE_F32_2D_BATCH};
+    default:
+        if (int16)
+            return {NN_WORKLOAD_DATA_TYPE_I16_ZXY_BATCH, NN_WORKLOAD_DATA_TYPE_I16_3D_BATCH};
+        return {NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, NN_WORKLOAD_DATA_TYPE_F32_3D_BATCH};
+    }
+}
+
+void delete_metrics_entry(nn_workflow_metrics_t *entry)
+{
+    delete[] entry->input_format;
+    delete[] entry->output_format;
+    delete[] reinterpret_cast<char *>(entry);
+}
+
+} //namespace
+
+void nn_machine_model::measure(nn_thread_worker_pool &thread_pool)
+{
+    std::call_once(measured, [&] {
+            threads = thread_pool.get_num_threads();
+
+            // Arithmetic: 8 independent chains of fused multiply-adds hide latency of single instruction.
+            {
+                const uint32_t iterations = 1 << 16;
+                __m256 acc[8];
+                for (auto &value : acc)
+                    value = _mm256_set1_ps(1.0f);
+                const __m256 multiplier = _mm256_set1_ps(0.999999f), addend = _mm256_set1_ps(1e-7f);
+
+                auto begin = std::chrono::steady_clock::now();
+                for (auto iteration = 0u; iteration < iterations; ++iteration)
+                    for (auto &value : acc)
+                        value = _mm256_fmadd_ps(value, multiplier, addend);
+                auto time = elapsed_ns(begin);
+
+                volatile float sink = 0.0f;
+                for (auto &value : acc)
+                    sink += _mm_cvtss_f32(_mm256_castps256_ps128(value));
+
+                flops_per_ns = 2.0 * 8 * 8 * iterations / std::max(time, 1.0);
+            }
+
+            // Memory: copy of buffers exceeding last level cache, first pass touches pages.
+            {
+                std::unique_ptr<char[]> source(new char[C_bandwidth_buffer_size]), destination(new char[C_bandwidth_buffer_size]);
+                memset(source.get(), 1, C_bandwidth_buffer_size);
+                memcpy(destination.get(), source.get(), C_bandwidth_buffer_size);
+
+                auto begin = std::chrono::steady_clock::now();
+                memcpy(destination.get(), source.get(), C_bandwidth_buffer_size);
+                single_bytes_per_ns = 2.0 * C_bandwidth_buffer_size / std::max(elapsed_ns(begin), 1.0);
+
+                const auto chunk = C_bandwidth_buffer_size / threads;
+                std::vector<nn_multithreaded_request> jobs(threads);
+                for (size_t job = 0; job < threads; ++job)
+                    jobs[job] = {[&, job](void *) { memcpy(destination.get() + job * chunk, source.get() + job * chunk, chunk); }, nullptr};
+
+                begin = std::chrono::steady_clock::now();
+                thread_pool.push_job(jobs);
+                bytes_per_ns = std::max(single_bytes_per_ns, 2.0 * chunk * threads / std::max(elapsed_ns(begin), 1.0));
+            }
+
+            // Dispatch: average over several rounds of empty jobs.
+            {
+                const uint32_t rounds = 32;
+                std::vector<nn_multithreaded_request> jobs(threads, {[](void *) {}, nullptr});
+
+                auto begin = std::chrono::steady_clock::now();
+                for (auto round = 0u; round < rounds; ++round)
+                    thread_pool.push_job(jobs);
+                dispatch_ns = elapsed_ns(begin) / rounds;
+            }
+        });
+}
+
+std::vector<nn_workflow_item_cost> nn_workflow_item_costs(nn_workflow_t *workflow,
+                                                          uint32_t batch,
+                                                          const NN_WORKLOAD_DATA_TYPE *input_format,
+                                                          const NN_WORKLOAD_DATA_TYPE *output_format)
+{
+    std::vector<nn_workflow_item_cost> result;
+
+    auto produced_bytes = [&](const nn_workflow_item_t *item, uint32_t index) -> uint64_t {
+            auto size = (item->type == NN_WORK_ITEM_TYPE_INPUT)
+                            ? element_size(input_format[item->arguments.input.index])
+                            : element_size(item);
+            return count(item->output_format[index]) * size * batch;
+        };
+
+    for (auto item : nn_workflow_items_in_execution_order(workflow))
+    {
+        nn_workflow_item_cost cost = {item, 0, 0, C_efficiency_other};
+
+        uint64_t input_bytes = 0;
+        for (auto index = 0u; index < item->input_count; ++index)
+            input_bytes += produced_bytes(item->input[index].item, item->input[index].index);
+
+        uint64_t output_bytes = 0, output_values = 0;
+        for (auto index = 0u; index < item->output_count; ++index)
+        {
+            output_bytes += produced_bytes(item, index);
+            output_values += count(item->output_format[index]) * batch;
+        }
+
+        // Output pixels of convolution, each computed from all weights of filters.
+        auto convolution = [&](const nn_data_t *weights, uint64_t pixels_per_output) {
+                const auto output_maps = weights->size[weights->dimension - 1];
+                cost.operations = 2 * count(weights) * (output_values / output_maps) * pixels_per_output;
+                cost.bytes = input_bytes + output_bytes + bytes(weights);
+            };
+
+        switch (item->type)
+        {
+        case NN_WORK_ITEM_TYPE_INPUT:
+            // Workload copies input given in other layout to ZXY.
+            if (needs_conversion(input_format[item->arguments.input.index]))
+                cost.bytes = 2 * output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_OUTPUT:
+            if (needs_conversion(output_format[item->arguments.output.index]))
+                cost.bytes = 2 * input_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_VIEW:
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION:
+            convolution(item->arguments.forward_convolution.weights, 1);
+            cost.efficiency = nn_workflow_uses_batch_block(batch)
+                                  ? C_efficiency_convolution_batch_block
+                                  : C_efficiency_convolution;
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2:
+            convolution(item->arguments.forward_convolution_pooling_max_2x2_stride_2x2.weights, 4);
+            cost.efficiency = C_efficiency_convolution;
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT:
+            convolution(item->arguments.forward_convolution_int16_fixedpoint.weights, 1);
+            cost.efficiency = C_efficiency_int16;
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION_POOLING_MAX_2x2_STRIDE_2x2_INT16_FIXEDPOINT:
+            convolution(item->arguments.forward_convolution_pooling_fixedpoint.weights, 4);
+            cost.efficiency = C_efficiency_int16;
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION_INT8:
+            convolution(item->arguments.forward_convolution_int8.weights, 1);
+            cost.efficiency = C_efficiency_int8;
+            break;
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED:
+        case NN_WORK_ITEM_TYPE_LOCAL_CONNECTIVITY:
+            cost.operations = 2 * count(item->arguments.forward_fully_connected.weights) * batch;
+            cost.bytes = input_bytes + output_bytes + bytes(item->arguments.forward_fully_connected.weights);
+            cost.efficiency = C_efficiency_fully_connected;
+            break;
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I16QN:
+            cost.operations = 2 * count(item->arguments.fully_connected_forward_i16qn_i16qn.weights) * batch;
+            cost.bytes = input_bytes + output_bytes + bytes(item->arguments.fully_connected_forward_i16qn_i16qn.weights);
+            cost.efficiency = C_efficiency_int16;
+            break;
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN:
+            cost.operations = 2 * count(item->arguments.fully_connected_forward_i16qn_i32qn.weights) * batch;
+            cost.bytes = input_bytes + output_bytes + bytes(item->arguments.fully_connected_forward_i16qn_i32qn.weights);
+            cost.efficiency = C_efficiency_int16;
+            break;
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8:
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32:
+            cost.operations = 2 * count(item->arguments.forward_fully_connected_int8.weights) * batch;
+            cost.bytes = input_bytes + output_bytes + bytes(item->arguments.forward_fully_connected_int8.weights);
+            cost.efficiency = C_efficiency_int8;
+            break;
+        case NN_WORK_ITEM_TYPE_POOLING:
+            cost.operations = output_values * item->arguments.forward_pooling.size[0] * item->arguments.forward_pooling.size[1];
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_MAX_POOLING_INT8:
+            cost.operations = output_values * item->arguments.forward_pooling_fixedpoint.pool_size[0] * item->arguments.forward_pooling_fixedpoint.pool_size[1];
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_MAX_POOLING_INT16_FIXEDPOINT:
+            cost.operations = output_values * item->arguments.forward_pooling_fixedpoint.pool_size[0] * item->arguments.forward_pooling_fixedpoint.pool_size[1];
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_NORMALIZATION:
+            cost.operations = output_values * (2 * item->arguments.forward_normalization.normalization.n + C_operations_normalization);
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_FORWARD_I16QN:
+            cost.operations = output_values * (2 * item->arguments.normalization_response_across_maps_forward_i16qn.n + C_operations_normalization);
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8:
+            cost.operations = output_values * (2 * item->arguments.normalization_response_across_maps_int8.n + C_operations_normalization);
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_SOFTMAX:
+        case NN_WORK_ITEM_TYPE_SOFTMAX_FIXEDPOINT:
+        case NN_WORK_ITEM_TYPE_SOFTMAX_LOSS:
+            cost.operations = output_values * C_operations_softmax;
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        case NN_WORK_ITEM_TYPE_CONVOLUTION_BACKPROP:
+        case NN_WORK_ITEM_TYPE_FULLY_CONNECTED_BACKPROP:
+        {
+            // Gradients of inputs and of weights, each costing as much as forward pass.
+            auto forward = std::find_if(result.begin(), result.end(),
+                                        [item](const nn_workflow_item_cost &other) { return other.item == item->forward_item; });
+            if (forward != result.end())
+            {
+                cost.operations = 2 * forward->operations;
+                cost.bytes = 2 * forward->bytes;
+                cost.efficiency = forward->efficiency;
+                break;
+            }
+        }
+            // fall through
+        default:
+            // Element-wise items: one operation per value.
+            cost.operations = output_values;
+            cost.bytes = input_bytes + output_bytes;
+            break;
+        }
+
+        result.push_back(cost);
+    }
+
+    return result;
+}
+
+nn_workflow_cost nn_workflow_estimate_cost(const std::vector<nn_workflow_item_cost> &items,
+                                           const nn_machine_model &machine,
+                                           size_t threads)
+{
+    double time = 0.0, single_thread_time = 0.0;
+    nn_workflow_cost result = {};
+
+    // Bandwidth grows with threads until it reaches one measured for whole pool. Dispatch is measured
+    // for whole pool too and grows with count of threads woken up, single thread runs jobs by itself.
+    threads = std::max<size_t>(std::min(threads, machine.threads), 1);
+    const double bytes_per_ns = std::min(machine.single_bytes_per_ns * threads,
+                                         std::max(machine.bytes_per_ns, machine.single_bytes_per_ns));
+    const double dispatch_ns = machine.threads > 1 ? machine.dispatch_ns * (threads - 1) / (machine.threads - 1) : 0.0;
+
+    for (auto &item : items)
+    {
+        if (item.operations == 0 && item.bytes == 0)
+            continue;
+
+        const double arithmetic = item.operations / (machine.flops_per_ns * item.efficiency);
+        time += std::max(arithmetic / threads, item.bytes / bytes_per_ns) + dispatch_ns;
+        single_thread_time += std::max(arithmetic, item.bytes / machine.single_bytes_per_ns);
+
+        result.operations += item.operations;
+        result.bytes += item.bytes;
+    }
+
+    result.threads = threads;
+    result.time_ns = static_cast<uint64_t>(time);
+    result.single_thread_time_ns = static_cast<uint64_t>(single_thread_time);
+    result.energy_nj = static_cast<uint64_t>(time * threads * C_watts_per_thread
+                                             + result.operations * C_nj_per_operation
+                                             + result.bytes * C_nj_per_byte);
+    return result;
+}
+
+/* query workflow for metrics of compilation variants
+   Variants cover batch sizes, formats accepted for inputs and outputs and counts of threads up to threads of device;
+   they are sorted by estimated time per image, best first. Array of entries is terminated by null pointer. */
+NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_metrics_query_0_function(
+    nn_workflow_metrics_array_t **array,/* resulting array of variants */
+    nn_device_t        *device,         /* device context */
+    nn_workflow_t      *workflow        /* workflow to be querried */
+    ) {
+    if(!array)    return NN_API_STATUS_ERROR_INVALID_POINTER;
+    if(!device)   return NN_API_STATUS_ERROR_INVALID_POINTER;
+    if(!workflow) return NN_API_STATUS_ERROR_INVALID_POINTER;
+    for(auto index = 0u; index < workflow->input_count; ++index)
+        if(!workflow->input[index]) return NN_API_STATUS_ERROR_INVALID_WORKFLOW;
+    for(auto index = 0u; index < workflow->output_count; ++index)
+        if(!workflow->output[index] || workflow->output[index]->input_count == 0) return NN_API_STATUS_ERROR_INVALID_WORKFLOW;
+
+    std::vector<nn_workflow_metrics_t *> entries;
+    try {
+        auto device_internal = static_cast<nn_device_internal *>(device);
+        device_internal->machine_model.measure(device_internal->thread_pool);
+
+        // Candidate formats of each input followed by each output, enumerated like digits of a number.
+        std::vector<std::vector<NN_WORKLOAD_DATA_TYPE>> candidates;
+        for (auto index = 0u; index < workflow->input_count; ++index)
+            candidates.push_back(input_formats(workflow->input[index]));
+        for (auto index = 0u; index < workflow->output_count; ++index)
+            candidates.push_back(output_formats(workflow->output[index]));
+
+        std::vector<size_t> choice(candidates.size(), 0);
+        do
+        {
+            std::vector<NN_WORKLOAD_DATA_TYPE> formats(candidates.size());
+            for (auto index = 0u; index < candidates.size(); ++index)
+                formats[index] = candidates[index][choice[index]];
+
+            for (auto batch : C_variant_batches)
+            {
+                auto costs = nn_workflow_item_costs(workflow, batch, formats.data(), formats.data() + workflow->input_count);
+                for (auto threads : variant_threads(device_internal->machine_model.threads))
+                {
+                    auto cost = nn_workflow_estimate_cost(costs, device_internal->machine_model, threads);
+
+                    auto input_format = new NN_WORKLOAD_DATA_TYPE[workflow->input_count];
+                    auto output_format = new NN_WORKLOAD_DATA_TYPE[workflow->output_count];
+                    std::copy(formats.begin(), formats.begin() + workflow->input_count, input_format);
+                    std::copy(formats.begin() + workflow->input_count, formats.end(), output_format);
+
+                    auto memory = new char[sizeof(nn_workflow_metrics_t) + (C_metric_count - 1) * sizeof(uint64_t)];
+                    auto entry = new (memory) nn_workflow_metrics_t{input_format, output_format, batch, {cost.time_ns}};
+                    entry->metric[1] = cost.energy_nj;
+                    entry->metric[2] = cost.single_thread_time_ns;
+                    entry->metric[3] = cost.operations;
+                    entry->metric[4] = cost.bytes;
+                    entry->metric[5] = cost.threads;
+                    entries.push_back(entry);
+                }
+            }
+
+            // Next combination of formats.
+            auto index = 0u;
+            for (; index < choice.size(); ++index)
+            {
+                if (++choice[index] < candidates[index].size())
+                    break;
+                choice[index] = 0;
+            }
+            if (index == choice.size())
+                break;
+        } while (true);
+
+        std::stable_sort(entries.begin(), entries.end(), [](const nn_workflow_metrics_t *lhs, const nn_workflow_metrics_t *rhs) {
+                return static_cast<double>(lhs->metric[0]) / lhs->batch < static_cast<double>(rhs->metric[0]) / rhs->batch;
+            });
+
+        auto table = new nn_workflow_metrics_t *[entries.size() + 1];
+        std::copy(entries.begin(), entries.end(), table);
+        table[entries.size()] = nullptr;
+        *array = new nn_workflow_metrics_array_t{workflow->input_count, workflow->output_count, table};
+    }
+    catch (std::bad_alloc &) {
+        for (auto entry : entries)
+            delete_metrics_entry(entry);
+        return NN_API_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    catch(...) {
+        for (auto entry : entries)
+            delete_metrics_entry(entry);
+        return NN_API_STATUS_ERROR_OTHER;
+    }
+    return NN_API_STATUS_OK;
+}
+
+/* delete array of workload metrics */
+NN_API_STATUS NN_API_CALL_CONVENTION nn_workflow_metrics_delete_0_function(
+    nn_workflow_metrics_array_t *array  /* array to delete */
+    ) {
+    if(!array) return NN_API_STATUS_ERROR_INVALID_POINTER;
+    for (auto entry = array->array; *entry != nullptr; ++entry)
+        delete_metrics_entry(*entry);
+    delete[] array->array;
+    delete array;
+    return NN_API_STATUS_OK;
+}
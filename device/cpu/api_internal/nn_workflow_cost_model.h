@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "device/api/nn_device_interface_0.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class nn_thread_worker_pool;
+
+/* throughput of machine the device runs on
+   Measured by short benchmarks on first workflow metrics query, used by cost model of workflows. */
+struct nn_machine_model
+{
+    double flops_per_ns;            // single thread running independent AVX fused multiply-adds
+    double bytes_per_ns;            // memory copy shared by all threads of pool (bytes read and written)
+    double single_bytes_per_ns;     // memory copy run by single thread
+    double dispatch_ns;             // empty jobs pushed to all threads of pool
+    size_t threads;
+
+    void measure(nn_thread_worker_pool &thread_pool);
+
+private:
+    std::once_flag measured;
+};
+
+/* estimated cost of single item of workflow compiled for particular batch and input/output formats */
+struct nn_workflow_item_cost
+{
+    const nn_workflow_item_t *item;
+    uint64_t operations;            // arithmetic operations, multiplication and addition counted separately
+    uint64_t bytes;                 // data, weights and conversions read and written
+    double efficiency;              // fraction of peak arithmetic throughput expected from kernel chosen for item
+};
+
+/* estimated cost of compilation variant of workflow */
+struct nn_workflow_cost
+{
+    uint64_t threads;               // worker threads estimate is made for
+    uint64_t time_ns;
+    uint64_t single_thread_time_ns;
+    uint64_t energy_nj;
+    uint64_t operations;
+    uint64_t bytes;
+};
+
+/* costs of items of workflow in execution order, including conversions of inputs and outputs to given formats */
+std::vector<nn_workflow_item_cost> nn_workflow_item_costs(nn_workflow_t *workflow,
+                                                          uint32_t batch,
+                                                          const NN_WORKLOAD_DATA_TYPE *input_format,
+                                                          const NN_WORKLOAD_DATA_TYPE *output_format);
+
+/* roofline estimate: each item takes longer of its arithmetic and memory time, plus dispatch to pool
+   Made for given count of threads, clamped to threads of measured pool; arithmetic scales linearly with them,
+   memory bandwidth until it reaches bandwidth of whole pool. */
+nn_workflow_cost nn_workflow_estimate_cost(const std::vector<nn_workflow_item_cost> &items,
+                                           const nn_machine_model &machine,
+                                           size_t threads);
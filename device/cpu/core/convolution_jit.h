@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include "device/cpu/api_internal/cpu_device_internal.h"
 
 
 #ifdef __linux__
@@ -20,9 +21,11 @@
 #endif
 
 // interface for convolution variant using JIT
+// job tables keep offsets relative to buffers given to execute, so compiled kernel
+// may be run on any buffers of the same geometry (also by concurrent executions)
 struct jit_convolution
 {
-    std::vector<std::vector<nn_multithreaded_request>> jobs;
+    virtual void execute(nn_thread_worker_pool& thread_pool, float* output, float* input, float* filter, float* bias) const = 0;
 
     virtual ~jit_convolution() {};
 };
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "helper_z_block_xyz_u8.h"
+#include "device/cpu/api_internal/data_helper.h"
+
+namespace int8_fixedpoint {
+namespace helper_z_block_xyz_u8 {
+
+uint32_t select_block_size(uint32_t size_z, const std::vector<uint32_t> &view_offsets_z)
+{
+    uint32_t block_size = C_ofm_block;
+    auto fits = [&](uint32_t block) {
+        if (size_z % block != 0)
+            return false;
+        for (auto offset : view_offsets_z)
+            if (offset % block != 0)
+                return false;
+        return true;
+    };
+
+    while (block_size > 4 && !fits(block_size))
+        block_size /= 2;
+
+    return block_size;
+}
+
+z_block_u8_view::z_block_u8_view(const nn_workload_data_t *data)
+    : buffer(static_cast<uint8_t *>(data->parent->data_buffer) + calculate_idx(data, 0, 0, 0, 0, 0, 0)),
+      block(data->parent->lengths.t[NN_DATA_COORD_p]),
+      stride_x(data->parent->strides[NN_DATA_COORD_x]),
+      stride_y(data->parent->strides[NN_DATA_COORD_y]),
+      stride_block(data->parent->strides[NN_DATA_COORD_z]),
+      stride_n(data->parent->strides[NN_DATA_COORD_n]),
+      size_n(data->view_end.t[NN_DATA_COORD_n] - data->view_begin.t[NN_DATA_COORD_n] + 1),
+      size_x(data->view_end.t[NN_DATA_COORD_x] - data->view_begin.t[NN_DATA_COORD_x] + 1),
+      size_y(data->view_end.t[NN_DATA_COORD_y] - data->view_begin.t[NN_DATA_COORD_y] + 1),
+      size_z((data->view_end.t[NN_DATA_COORD_z] - data->view_begin.t[NN_DATA_COORD_z] + 1) * block)
+{
+    assert(data->parent->data_type_size == sizeof(uint8_t));
+}
+
+bool primitive_z_block_xyz_u8_base::validate_input(size_t index, nn_workload_data_t *data)
+{
+    throw std::logic_error("The method or operation is not implemented.");
+}
+
+std::vector<nn_workload_data_t *> primitive_z_block_xyz_u8_base::create_inputs(bool allocate_delta)
+{
+    return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_ZBLOCKXYZN, uint8_t>::create(
+        device, (uint32_t)get_required_input_w(), (uint32_t)get_required_input_h(), (uint32_t)input_size_z, (uint32_t)batch_size, (uint32_t)output_block_size, 0, 0, 0, 0) };
+}
+
+std::vector<nn_workload_data_t *> primitive_z_block_xyz_u8_base::create_outputs(bool allocate_delta)
+{
+    return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_ZBLOCKXYZN, uint8_t>::create(
+        device,
+        (uint32_t)output_size_x,
+        (uint32_t)output_size_y,
+        (uint32_t)output_size_z,
+        (uint32_t)batch_size,
+        (uint32_t)output_block_size,
+        (uint32_t)output_padding_left,
+        (uint32_t)output_padding_right,
+        (uint32_t)output_padding_top,
+        (uint32_t)output_padding_bottom) };
+}
+
+void compute_requantization(
+    const nn_workload_data_t *weights,
+    const nn_workload_data_t *biases,
+    const nn_workload_data_t *weights_scale,
+    size_t num_output,
+    float input_scale,
+    uint8_t input_zero_point,
+    float output_scale,
+    std::vector<float> &multiplier,
+    std::vector<float> &offset)
+{
+    const size_t padded_output = (num_output + C_ofm_block - 1) / C_ofm_block * C_ofm_block;
+    multiplier.assign(padded_output, 0.0f);
+    offset.assign(padded_output, 0.0f);
+
+    auto scale = static_cast<const float *>(weights_scale->parent->data_buffer);
+    auto bias = biases ? static_cast<const float *>(biases->parent->data_buffer) : nullptr;
+
+    // sum of weights for each output map, needed only to cancel non-zero input zero point
+    std::vector<int32_t> weights_sum(padded_output, 0);
+    if (input_zero_point != 0) {
+        auto weights_buffer = static_cast<const int8_t *>(weights->parent->data_buffer);
+        const auto &lengths = weights->parent->lengths;
+        const size_t block_length = lengths.t[NN_DATA_COORD_x] * lengths.t[NN_DATA_COORD_y] * lengths.t[NN_DATA_COORD_z] * lengths.t[NN_DATA_COORD_p];
+        for (size_t o = 0; o < padded_output; ++o) {
+            auto block = weights_buffer + o / C_ofm_block * block_length;
+            for (size_t i = o % C_ofm_block * 4; i < block_length; i += 4 * C_ofm_block)
+                weights_sum[o] += block[i] + block[i + 1] + block[i + 2] + block[i + 3];
+        }
+    }
+
+    for (size_t o = 0; o < num_output; ++o) {
+        multiplier[o] = output_scale / (input_scale * scale[o]);
+        offset[o] = (bias ? bias[o] * output_scale : 0.0f) - input_zero_point * weights_sum[o] * multiplier[o];
+    }
+}
+
+} // namespace helper_z_block_xyz_u8
+} // namespace int8_fixedpoint
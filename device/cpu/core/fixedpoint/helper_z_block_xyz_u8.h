@@ -0,0 +1,218 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+#include "device/api/nn_primitives_api_0.h"
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+
+namespace int8_fixedpoint {
+
+// tools for int8 layers using ZXYN data layout with uint8 values in z blocks of 4, 8, 16 or 32 lanes
+namespace helper_z_block_xyz_u8 {
+
+// largest z block (up to 32 lanes) dividing number of feature maps and origins of views taken from them
+uint32_t select_block_size(uint32_t size_z, const std::vector<uint32_t> &view_offsets_z);
+
+// pointer & strides of uint8 z-block view, coordinates are relative to view begin
+struct z_block_u8_view
+{
+    uint8_t *buffer;
+    size_t block;
+    ptrdiff_t stride_x;
+    ptrdiff_t stride_y;
+    ptrdiff_t stride_block;
+    ptrdiff_t stride_n;
+    size_t size_n;
+    size_t size_x;
+    size_t size_y;
+    size_t size_z;
+
+    explicit z_block_u8_view(const nn_workload_data_t *data);
+
+    uint8_t *at(size_t n, ptrdiff_t x, ptrdiff_t y, size_t z) const {
+        return buffer + n * stride_n + y * stride_y + x * stride_x + z / block * stride_block + z % block;
+    }
+};
+
+class primitive_z_block_xyz_u8_base : public nn_primitive_t {
+
+ public:
+    virtual ~primitive_z_block_xyz_u8_base() {}
+
+    virtual bool validate_input(size_t index, nn_workload_data_t *data) override;
+
+    virtual std::vector<nn_workload_data_t *> create_inputs(bool allocate_delta) override;
+
+    virtual std::vector<nn_workload_data_t *> create_outputs(bool allocate_delta) override;
+
+  protected:
+      primitive_z_block_xyz_u8_base(
+                            size_t batch_size,
+                            size_t input_size_z,
+                            size_t output_size_x,
+                            size_t output_size_y,
+                            size_t output_size_z,
+                            size_t output_block_size,
+                            size_t output_padding_left,
+                            size_t output_padding_right,
+                            size_t output_padding_top,
+                            size_t output_padding_bottom,
+                            nn_device_internal *device)
+        : batch_size(batch_size),
+          input_size_z(input_size_z),
+          output_size_x(output_size_x),
+          output_size_y(output_size_y),
+          output_size_z(output_size_z),
+          output_block_size(output_block_size),
+          output_padding_left(output_padding_left),
+          output_padding_right(output_padding_right),
+          output_padding_top(output_padding_top),
+          output_padding_bottom(output_padding_bottom),
+          device(device) {}
+
+    virtual size_t get_required_input_w() = 0;
+    virtual size_t get_required_input_h() = 0;
+
+    // pushes jobs to thread pool, runs them in place if there is nothing to split
+    template <typename T_request>
+    void run_jobs(std::vector<T_request> &requests, void (*callback)(void *)) {
+        if (device->thread_pool.get_num_threads() < 2 || requests.size() < 2) {
+            for (auto &request : requests)
+                callback(&request);
+            return;
+        }
+
+        std::vector<nn_multithreaded_request> jobs(requests.size());
+        for (size_t index = 0; index < requests.size(); ++index)
+            jobs[index] = {callback, &requests[index]};
+        device->thread_pool.push_job(jobs);
+    }
+
+    const size_t batch_size;
+    const size_t input_size_z;
+    const size_t output_size_x;
+    const size_t output_size_y;
+    const size_t output_size_z;
+    const size_t output_block_size;
+    const size_t output_padding_left;
+    const size_t output_padding_right;
+    const size_t output_padding_top;
+    const size_t output_padding_bottom;
+
+    nn_device_internal *const device;
+};
+
+// output maps computed at once by int8 kernels, matches output block of int8 weights layout
+const size_t C_ofm_block = 32;
+
+/* Per output map requantization of int32 accumulators: value = acc * multiplier + offset.
+   Accumulators hold sum of (input + zero_point) * weight products, so offset removes zero point contribution
+   and adds bias. Output scale of 1 gives real values. Arrays are padded to whole output blocks. */
+void compute_requantization(
+    const nn_workload_data_t *weights,
+    const nn_workload_data_t *biases,
+    const nn_workload_data_t *weights_scale,
+    size_t num_output,
+    float input_scale,
+    uint8_t input_zero_point,
+    float output_scale,
+    std::vector<float> &multiplier,
+    std::vector<float> &offset);
+
+/* Accumulates 32 output maps of T_tile outputs over kernel window, tile outputs read input 'tile_stride' bytes apart.
+   Each step broadcasts 4 input bytes and multiplies them with 4 weights of 32 output maps: vpmaddubsw sums adjacent
+   u8 x s8 products into int16 (weights limited to [-64, 64] never saturate), vpmaddwd with ones widens to int32. */
+template <int T_tile>
+inline void accumulate_u8s8(
+    __m256i (&acc)[T_tile][4],
+    const uint8_t *input,
+    ptrdiff_t tile_stride,
+    const int8_t *weights,
+    size_t kernel_w,
+    size_t kernel_h,
+    const z_block_u8_view &input_view,
+    size_t input_blocks)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (size_t ky = 0; ky < kernel_h; ++ky)
+        for (size_t kx = 0; kx < kernel_w; ++kx)
+            for (size_t block = 0; block < input_blocks; ++block)
+            {
+                auto input_ptr = input + ky * input_view.stride_y + kx * input_view.stride_x + block * input_view.stride_block;
+                for (size_t group = 0; group < input_view.block; group += 4, weights += 4 * C_ofm_block)
+                {
+                    __m256i vi[T_tile];
+                    for (int tile = 0; tile < T_tile; ++tile)
+                        vi[tile] = _mm256_set1_epi32(*reinterpret_cast<const int32_t *>(input_ptr + tile * tile_stride + group));
+
+                    for (int part = 0; part < 4; ++part)
+                    {
+                        const __m256i vw = _mm256_load_si256(reinterpret_cast<const __m256i *>(weights) + part);
+                        for (int tile = 0; tile < T_tile; ++tile)
+                            acc[tile][part] = _mm256_add_epi32(acc[tile][part], _mm256_madd_epi16(_mm256_maddubs_epi16(vi[tile], vw), ones));
+                    }
+                }
+            }
+}
+
+// requantizes 32 accumulators to uint8 in output map order, negative values saturate to 0 (ReLU)
+inline __m256i requantize_u8(const __m256i (&acc)[4], const float *multiplier, const float *offset)
+{
+    __m256i value[4];
+    for (int part = 0; part < 4; ++part)
+        value[part] = _mm256_cvtps_epi32(_mm256_fmadd_ps(_mm256_cvtepi32_ps(acc[part]),
+                                                         _mm256_loadu_ps(multiplier + 8 * part),
+                                                         _mm256_loadu_ps(offset + 8 * part)));
+
+    // packs interleave 128-bit lanes, permutation restores order of output maps
+    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(value[0], value[1]),
+                                               _mm256_packs_epi32(value[2], value[3]));
+    return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+// stores 32 uint8 output maps beginning at 'output', splitting them between z blocks of output
+inline void store_u8(uint8_t *output, const z_block_u8_view &output_view, size_t count, __m256i value)
+{
+    if (output_view.block == C_ofm_block) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), value);
+        return;
+    }
+
+    alignas(32) uint8_t buffer[C_ofm_block];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(buffer), value);
+    for (size_t position = 0; position < count; position += output_view.block, output += output_view.stride_block)
+        memcpy(output, buffer + position, output_view.block);
+}
+
+} // namespace helper_z_block_xyz_u8
+} // namespace int8_fixedpoint
@@ -33,35 +33,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <immintrin.h>
 #include <string.h>
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 
-// NN_CODE_UNREACHABLE signal to supporting compiler that specific location in code cannot be reached
-#if defined _MSC_VER
-#   define NN_UNREACHABLE_CODE __assume(0)
-#endif
-
-#if defined __GNUC__
-#   if (__GNUC__ * 100 + __GNUC_MINOR__) >= 405
-#       define NN_UNREACHABLE_CODE __builtin_unreachable()
-#   else
-#       define NN_UNREACHABLE_CODE
-#   endif
-#endif
-
-#if defined __clang__
-#   if __has_builtin(__builtin_unreachable)
-#       define NN_UNREACHABLE_CODE __builtin_unreachable()
-#   else
-#       define NN_UNREACHABLE_CODE
-#   endif
-#endif
 // SIMD width for this implementation
 const auto C_simd_width = sizeof(__m256) / sizeof(float);
 
-// SIMD width for this implementation
-static const auto C_max_acc = 12u;
-static const auto C_batch_size = C_simd_width;
-
 namespace int16_fixedpoint
 {
     convert_float_to_int16::convert_float_to_int16(
@@ -251,10 +229,94 @@ namespace int16_fixedpoint
                 device->thread_pool.push_job(jobs);
             }
         }
+        else if (are_coords_equal({ NN_DATA_COORD_z,
+            NN_DATA_COORD_x,
+            NN_DATA_COORD_y,
+            NN_DATA_COORD_n,
+            NN_DATA_COORD_p,
+            NN_DATA_COORD_q },
+            input_view->parent->layout.ordering) &&
+            are_coords_equal({ NN_DATA_COORD_p,
+            NN_DATA_COORD_x,
+            NN_DATA_COORD_y,
+            NN_DATA_COORD_z,
+            NN_DATA_COORD_n,
+            NN_DATA_COORD_q },
+            output_view->parent->layout.ordering) &&
+            output_view->parent->lengths.t[NN_DATA_COORD_p] == block_size &&
+            input_view->get_length(NN_DATA_COORD_z) <= output_view->get_length(NN_DATA_COORD_z) * block_size) {
+
+            // Any number of feature maps and output paddings: quantization and z-blocking in one pass over views,
+            // feature maps missing in last block are zeroed.
+            const size_t batch_window_size = output_view->get_length(NN_DATA_COORD_n);
+            const size_t width = output_view->get_length(NN_DATA_COORD_x);
+            const size_t height = output_view->get_length(NN_DATA_COORD_y);
+
+            const size_t input_stride_x = input_view->parent->lengths.t[NN_DATA_COORD_z],
+                input_stride_y = input_stride_x * input_view->parent->lengths.t[NN_DATA_COORD_x],
+                input_stride_batch = input_stride_y * input_view->parent->lengths.t[NN_DATA_COORD_y];
+            const size_t output_stride_x = block_size,
+                output_stride_y = output_stride_x * output_view->parent->lengths.t[NN_DATA_COORD_x],
+                output_stride_z_block = output_stride_y * output_view->parent->lengths.t[NN_DATA_COORD_y],
+                output_stride_batch = output_stride_z_block * output_view->parent->lengths.t[NN_DATA_COORD_z];
+
+            // Images are split to bands of rows when batch is too small to keep all threads busy.
+            const size_t threadpool_size = device->thread_pool.get_num_threads();
+            const size_t bands = std::max<size_t>(1, std::min(height, (threadpool_size + batch_window_size - 1) / batch_window_size));
+            const size_t band_height = (height + bands - 1) / bands;
+
+            std::vector<convert_float_to_int16_z_block_request_handle> request_handles;
+            for (size_t it_batch = 0; it_batch < batch_window_size; ++it_batch)
+                for (size_t row = 0; row < height; row += band_height)
+                {
+                    const float *input_window = (float *)input_view->parent->data_buffer
+                        + input_view->view_begin.t[NN_DATA_COORD_x] * input_stride_x
+                        + (input_view->view_begin.t[NN_DATA_COORD_y] + row) * input_stride_y
+                        + input_view->view_begin.t[NN_DATA_COORD_z]
+                        + (input_view->view_begin.t[NN_DATA_COORD_n] + it_batch) * input_stride_batch;
+
+                    int16_t *output_window = (int16_t *)output_view->parent->data_buffer
+                        + output_view->view_begin.t[NN_DATA_COORD_x] * output_stride_x
+                        + (output_view->view_begin.t[NN_DATA_COORD_y] + row) * output_stride_y
+                        + output_view->view_begin.t[NN_DATA_COORD_z] * output_stride_z_block
+                        + (output_view->view_begin.t[NN_DATA_COORD_n] + it_batch) * output_stride_batch;
+
+                    request_handles.push_back({
+                        input_window,
+                        output_window,
+                        std::min(band_height, height - row),
+                        width,
+                        input_view->get_length(NN_DATA_COORD_z),
+                        output_view->get_length(NN_DATA_COORD_z),
+                        input_stride_x,
+                        input_stride_y,
+                        output_stride_y,
+                        output_stride_z_block,
+                        out_fraction });
+                }
+
+            if (threadpool_size < 2 || request_handles.size() < 2)
+            {
+                for (auto &handle : request_handles)
+                    unpack_convert_float_to_int16_z_block_callback_handle(&handle);
+            }
+            else
+            {
+                std::vector<nn_multithreaded_request> jobs(request_handles.size());
+                for (size_t it_job = 0; it_job < jobs.size(); ++it_job)
+                {
+                    jobs[it_job].callback = unpack_convert_float_to_int16_z_block_callback_handle;
+                    jobs[it_job].request_handle = &request_handles[it_job];
+                }
+
+                // Wait for all sub threads.
+                device->thread_pool.push_job(jobs);
+            }
+        }
         else
         {
             throw std::invalid_argument(
-                "convert float to int16 only works with contiguous buffer or RGB to RGB0 conversion");
+                "convert float to int16 works only from ZXYN input to output z-blocks of 4");
         }
     }
 
@@ -294,267 +356,27 @@ namespace int16_fixedpoint
             output_padding_bottom) };
     }
 
-#define CONVERT_TO_SAT_INT16(N, V1, V2) \
-    if (T_SIZE < N) \
-    V1 = _mm256_castsi256_ps(_mm256_packs_epi32(_mm256_castps_si256(V1), _mm256_setzero_si256())); \
-else \
-    V1 = _mm256_castsi256_ps(_mm256_packs_epi32(_mm256_castps_si256(V1), _mm256_castps_si256(V2)))
-
-#define PERMUTE_4x64(N, V1) \
-    if (T_SIZE >= 1) \
-    acc0 = _mm256_castsi256_ps(_mm256_permute4x64_epi64(_mm256_castps_si256(acc0), 0xd8))
-
-#define STORE(ADR, N, V1) \
-    if (T_SIZE >= (N + 1)) \
-    { \
-    if (T_SIZE < (N + 2)) \
-    _mm256_maskstore_epi32((int32_t *)ADR + (N / 2) * C_batch_size, _mm256_castps_si256(V1), mask); \
-    else \
-    _mm256_storeu_si256((__m256i *)ADR + (N / 2) * C_batch_size, _mm256_castps_si256(V1)); \
-    }
-
-    template<uint32_t T_SIZE>
-    void convert_float_toint16_compute_block_shiftR(
-        const float* &input_ptr,
-        int16_t* &output_ptr,
-        __m256 &multiplier)
-    {
-        // We are not using table of registers and unroll pragmas
-        // due to compiler which have issues with register allocation
-        // and needs special, obvious treatment. Template immediate
-        // arguments matching will remove all conditions in this code.
-        __m256  acc0, acc1, acc2, acc3, acc4,
-            acc5, acc6, acc7, acc8, acc9,
-            acc10, acc11, acc12, acc13, acc14, acc15;
-
-        // Load inputs and perform e^x
-        if (T_SIZE >= 1)  {
-            acc0 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 0 * C_batch_size), multiplier);
-            acc1 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 1 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 3)  {
-            acc2 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 2 * C_batch_size), multiplier);
-            acc3 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 3 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 5)  {
-            acc4 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 4 * C_batch_size), multiplier);
-            acc5 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 5 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 7)  {
-            acc6 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 6 * C_batch_size), multiplier);
-            acc7 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 7 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 9)  {
-            acc8 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 8 * C_batch_size), multiplier);
-            acc9 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 9 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 11) {
-            acc10 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 10 * C_batch_size), multiplier);
-            acc11 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 11 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 13) {
-            acc12 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 12 * C_batch_size), multiplier);
-            acc13 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 13 * C_batch_size), multiplier);
-        }
-        if (T_SIZE >= 15){
-            acc14 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 14 * C_batch_size), multiplier);
-            acc15 = _mm256_div_ps(_mm256_loadu_ps(input_ptr + 15 * C_batch_size), multiplier);
-        }
-
-        // round results.
-        if (T_SIZE >= 1){
-            acc0 = _mm256_round_ps(acc0, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc1 = _mm256_round_ps(acc1, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 3) {
-            acc2 = _mm256_round_ps(acc2, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc3 = _mm256_round_ps(acc3, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 5) {
-            acc4 = _mm256_round_ps(acc4, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc5 = _mm256_round_ps(acc5, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 7) {
-            acc6 = _mm256_round_ps(acc6, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc7 = _mm256_round_ps(acc7, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 9) {
-            acc8 = _mm256_round_ps(acc8, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc9 = _mm256_round_ps(acc9, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 11) {
-            acc10 = _mm256_round_ps(acc10, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc11 = _mm256_round_ps(acc11, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 13) {
-            acc12 = _mm256_round_ps(acc12, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc13 = _mm256_round_ps(acc13, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-        if (T_SIZE >= 15) {
-            acc14 = _mm256_round_ps(acc14, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-            acc15 = _mm256_round_ps(acc15, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-        }
-
-        // convert to int32
-        if (T_SIZE >= 1) {
-            acc0 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc0));
-            acc1 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc1));
-        }
-        if (T_SIZE >= 3){
-            acc2 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc2));
-            acc3 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc3));
-        }
-        if (T_SIZE >= 5) {
-            acc4 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc4));
-            acc5 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc5));
-        }
-        if (T_SIZE >= 7) {
-            acc6 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc6));
-            acc7 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc7));
-        }
-        if (T_SIZE >= 9) {
-            acc8 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc8));
-            acc9 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc9));
-        }
-        if (T_SIZE >= 11) {
-            acc10 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc10));
-            acc11 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc11));
-        }
-        if (T_SIZE >= 13){
-            acc12 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc12));
-            acc13 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc13));
-        }
-        if (T_SIZE >= 15){
-            acc14 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc14));
-            acc15 = _mm256_castsi256_ps(_mm256_cvttps_epi32(acc15));
-        }
-
-        ////convert to saturated int16
-        if (T_SIZE >= 1)
-        {
-            CONVERT_TO_SAT_INT16(2, acc0, acc1);
-        }
-        if (T_SIZE >= 3)
-        {
-            CONVERT_TO_SAT_INT16(4, acc2, acc3);
-        }
-        if (T_SIZE >= 5)
-        {
-            CONVERT_TO_SAT_INT16(6, acc4, acc5);
-        }
-        if (T_SIZE >= 7)
-        {
-            CONVERT_TO_SAT_INT16(8, acc6, acc7);
-        }
-        if (T_SIZE >= 9)
-        {
-            CONVERT_TO_SAT_INT16(10, acc8, acc9);
-        }
-        if (T_SIZE >= 11)
-        {
-            CONVERT_TO_SAT_INT16(12, acc10, acc11);
-        }
-        if (T_SIZE >= 13)
-        {
-            CONVERT_TO_SAT_INT16(14, acc12, acc13);
-        }
-        if (T_SIZE >= 15)
-        {
-            CONVERT_TO_SAT_INT16(16, acc14, acc15);
-        }
-
-        PERMUTE_4x64(1, acc0);
-        PERMUTE_4x64(3, acc2);
-        PERMUTE_4x64(5, acc4);
-        PERMUTE_4x64(7, acc6);
-        PERMUTE_4x64(9, acc8);
-        PERMUTE_4x64(11, acc10);
-        PERMUTE_4x64(13, acc12);
-        PERMUTE_4x64(15, acc14);
-
-        __m256i mask = _mm256_set_epi32(0, 0, 0, 0, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff);
-        // Store results.
-
-        STORE(output_ptr, 0, acc0);
-        STORE(output_ptr, 2, acc2);
-        STORE(output_ptr, 4, acc4);
-        STORE(output_ptr, 6, acc6);
-        STORE(output_ptr, 8, acc8);
-        STORE(output_ptr, 10, acc10);
-        STORE(output_ptr, 12, acc12);
-        STORE(output_ptr, 14, acc14);
-
-        input_ptr += C_batch_size*T_SIZE;
-        output_ptr += C_batch_size*T_SIZE;
-    }
-
     void convert_float_to_int16::convert_float_to_int16_fixedpoint_contiguous(
         size_t output_width,
         const float *input_ptr,
         std::int16_t *output_ptr)
     {
-        const auto num_full_blocks = output_width / C_max_acc;
-        const auto partial_block_size = output_width % C_max_acc;
-
-        __m256 multiplier;
-        if (out_fraction > 8)
-            multiplier = _mm256_set1_ps((float)(1 << out_fraction));
-        else
-            multiplier = _mm256_set1_ps((float)(1 / (1 << -out_fraction)));
+        const float scale = std::ldexp(1.0f, out_fraction);
+        const __m256 multiplier = _mm256_set1_ps(scale);
 
-        for (auto block = 0u; block < num_full_blocks; ++block) {
-            // Run computation.
-            convert_float_toint16_compute_block_shiftR<C_max_acc>(input_ptr, output_ptr, multiplier);
+        // Two registers of rounded int32 are packed with saturation to one register of int16. Packing works
+        // within 128-bit lanes, permutation restores order of 64-bit quarters.
+        size_t i = 0;
+        for (; i + 2 * C_simd_width <= output_width; i += 2 * C_simd_width)
+        {
+            __m256i low = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(input_ptr + i), multiplier));
+            __m256i high = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(input_ptr + i + C_simd_width), multiplier));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(output_ptr + i),
+                                _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xd8));
         }
 
-        switch (partial_block_size) {
-        case 0:
-            break;
-        case 1:
-            convert_float_toint16_compute_block_shiftR<1>(input_ptr, output_ptr, multiplier);
-            break;
-        case 2:
-            convert_float_toint16_compute_block_shiftR<2>(input_ptr, output_ptr, multiplier);
-            break;
-        case 3:
-            convert_float_toint16_compute_block_shiftR<3>(input_ptr, output_ptr, multiplier);
-            break;
-        case 4:
-            convert_float_toint16_compute_block_shiftR<4>(input_ptr, output_ptr, multiplier);
-            break;
-        case 5:
-            convert_float_toint16_compute_block_shiftR<5>(input_ptr, output_ptr, multiplier);
-            break;
-        case 6:
-            convert_float_toint16_compute_block_shiftR<6>(input_ptr, output_ptr, multiplier);
-            break;
-        case 7:
-            convert_float_toint16_compute_block_shiftR<7>(input_ptr, output_ptr, multiplier);
-            break;
-        case 8:
-            convert_float_toint16_compute_block_shiftR<8>(input_ptr, output_ptr, multiplier);
-            break;
-        case 9:
-            convert_float_toint16_compute_block_shiftR<9>(input_ptr, output_ptr, multiplier);
-            break;
-        case 10:
-            convert_float_toint16_compute_block_shiftR<10>(input_ptr, output_ptr, multiplier);
-            break;
-        case 11:
-            convert_float_toint16_compute_block_shiftR<11>(input_ptr, output_ptr, multiplier);
-            break;
-        case 12:
-            convert_float_toint16_compute_block_shiftR<12>(input_ptr, output_ptr, multiplier);
-            break;
-        case 13:
-            convert_float_toint16_compute_block_shiftR<13>(input_ptr, output_ptr, multiplier);
-            break;
-        case 14:
-            convert_float_toint16_compute_block_shiftR<14>(input_ptr, output_ptr, multiplier);
-            break;
-        default:
-            NN_UNREACHABLE_CODE;
-        }
+        for (; i < output_width; ++i)
+            output_ptr[i] = static_cast<std::int16_t>(std::max(-32768.0f, std::min(32767.0f, std::nearbyint(input_ptr[i] * scale))));
     }
 
     void convert_float_to_int16_fixedpoint_rgb(
@@ -663,6 +485,82 @@ else \
         }
     }
 
+    void convert_float_to_int16_fixedpoint_z_block(
+        const float *const input_ptr,
+        int16_t *const output_ptr,
+        size_t rows,
+        size_t width,
+        size_t input_feature_maps,
+        size_t output_z_blocks,
+        size_t input_stride_x,
+        size_t input_stride_y,
+        size_t output_stride_y,
+        size_t output_stride_z_block,
+        int8_t output_fraction)
+    {
+        const size_t z_block_size = 4;
+        const float scale = std::ldexp(1.0f, output_fraction);
+        const __m256 scaler = _mm256_set1_ps(scale);
+
+        auto convert = [scale](float value) {
+            return static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, std::nearbyint(value * scale))));
+        };
+
+        for (size_t row = 0; row < rows; ++row)
+            for (size_t z_block = 0; z_block < output_z_blocks; ++z_block)
+            {
+                const float *input_row = input_ptr + row * input_stride_y + z_block * z_block_size;
+                int16_t *output_row = output_ptr + row * output_stride_y + z_block * output_stride_z_block;
+                const size_t block_feature_maps =
+                    std::min(z_block_size, input_feature_maps - std::min(input_feature_maps, z_block * z_block_size));
+
+                size_t x = 0;
+                if (block_feature_maps == z_block_size)
+                {
+                    // Four pixels at a time: feature maps of two pixels fill register, packing with saturation
+                    // interleaves 64-bit pixel blocks of both registers within lanes, permutation restores order.
+                    for (; x + 4 <= width; x += 4)
+                    {
+                        const float *input_pixels = input_row + x * input_stride_x;
+                        __m256 pixels01 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(input_pixels)),
+                                                               _mm_loadu_ps(input_pixels + input_stride_x), 1);
+                        __m256 pixels23 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(input_pixels + 2 * input_stride_x)),
+                                                               _mm_loadu_ps(input_pixels + 3 * input_stride_x), 1);
+                        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(pixels01, scaler)),
+                                                            _mm256_cvtps_epi32(_mm256_mul_ps(pixels23, scaler)));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output_row + x * z_block_size),
+                                            _mm256_permute4x64_epi64(packed, 0xd8));
+                    }
+                }
+
+                for (; x < width; ++x)
+                {
+                    for (size_t z = 0; z < block_feature_maps; ++z)
+                        output_row[x * z_block_size + z] = convert(input_row[x * input_stride_x + z]);
+                    for (size_t z = block_feature_maps; z < z_block_size; ++z)
+                        output_row[x * z_block_size + z] = 0;
+                }
+            }
+    }
+
+    void unpack_convert_float_to_int16_z_block_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<convert_float_to_int16::convert_float_to_int16_z_block_request_handle *>(void_handle);
+
+        convert_float_to_int16_fixedpoint_z_block(
+            handle->input_window,
+            handle->output_window,
+            handle->rows,
+            handle->width,
+            handle->input_feature_maps,
+            handle->output_z_blocks,
+            handle->input_stride_x,
+            handle->input_stride_y,
+            handle->output_stride_y,
+            handle->output_stride_z_block,
+            handle->output_fraction);
+    }
+
     void unpack_convert_float_to_int16_callback_handle(void *void_handle)
     {
         convert_float_to_int16::convert_float_to_int16_request_handle* handle = reinterpret_cast<convert_float_to_int16::convert_float_to_int16_request_handle*>(void_handle);
@@ -60,6 +60,8 @@ namespace int16_fixedpoint {
 
         friend void run_convert_float_to_int16_fp_work_item(nn_workload_item *const work_item, nn_device_internal* device);
 
+        friend void unpack_convert_float_to_int16_z_block_callback_handle(void *void_handle);
+
         friend void convert_float_to_int16_fixedpoint_rgb(
             const float *const input_ptr,
             int16_t *const output_ptr,
@@ -111,8 +113,25 @@ namespace int16_fixedpoint {
             size_t output_stride_y;
             int8_t output_fraction;
         };
+
+        struct convert_float_to_int16_z_block_request_handle
+        {
+            const float *input_window;
+            int16_t *output_window;
+            size_t rows;
+            size_t width;
+            size_t input_feature_maps;
+            size_t output_z_blocks;
+            size_t input_stride_x;
+            size_t input_stride_y;
+            size_t output_stride_y;
+            size_t output_stride_z_block;
+            int8_t output_fraction;
+        };
     };
 
+    void unpack_convert_float_to_int16_z_block_callback_handle(void *void_handle);
+
     void unpack_convert_float_to_int16_callback_handle(void *void_handle);
 
     void convert_float_to_int16_fixedpoint_rgb(
@@ -128,5 +147,18 @@ namespace int16_fixedpoint {
         size_t output_stride_y,
         int8_t output_fraction);
 
+    void convert_float_to_int16_fixedpoint_z_block(
+        const float *const input_ptr,
+        int16_t *const output_ptr,
+        size_t rows,
+        size_t width,
+        size_t input_feature_maps,
+        size_t output_z_blocks,
+        size_t input_stride_x,
+        size_t input_stride_y,
+        size_t output_stride_y,
+        size_t output_stride_z_block,
+        int8_t output_fraction);
+
     void run_convert_float_to_int16_fp_work_item(nn_workload_item *const work_item, nn_device_internal* device);
 }
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/api_internal/data_helper.h"
+#include "layer_convert_float_to_uint8_avx2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace int8_fixedpoint
+{
+    using namespace helper_z_block_xyz_u8;
+
+    convert_float_to_uint8::convert_float_to_uint8(
+        size_t num_input,
+        size_t input_w,
+        size_t input_h,
+        size_t batch_size,
+        size_t output_block_size,
+        size_t output_padding_left,
+        size_t output_padding_right,
+        size_t output_padding_top,
+        size_t output_padding_bottom,
+        float output_scale,
+        uint8_t output_zero_point,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_u8_base(
+              batch_size,
+              num_input,
+              input_w,
+              input_h,
+              num_input,
+              output_block_size,
+              output_padding_left,
+              output_padding_right,
+              output_padding_top,
+              output_padding_bottom,
+              device),
+          output_scale(output_scale),
+          output_zero_point(output_zero_point) {}
+
+    void convert_float_to_uint8::convert_rows(const request_handle &request) const
+    {
+        const auto input = request.input;
+        const auto &output = *request.output_view;
+        const auto input_buffer = static_cast<const float *>(input->parent->data_buffer);
+        const size_t size_z = input->view_end.t[NN_DATA_COORD_z] - input->view_begin.t[NN_DATA_COORD_z] + 1;
+        assert(input->parent->strides[NN_DATA_COORD_z] == 1);
+
+        const __m256 scale = _mm256_set1_ps(output_scale);
+        const __m256i zero_point = _mm256_set1_epi32(output_zero_point);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i max_u8 = _mm256_set1_epi32(255);
+        alignas(32) int32_t quantized[8];
+
+        for (size_t y = request.row_begin; y < request.row_end; ++y)
+            for (size_t x = 0; x < output_size_x; ++x)
+            {
+                auto input_ptr = input_buffer + calculate_idx(input, static_cast<uint32_t>(request.batch), static_cast<uint32_t>(x), static_cast<uint32_t>(y), 0, 0, 0);
+                size_t z = 0;
+                for (; z + 8 <= size_z; z += 8)
+                {
+                    const __m256i value = _mm256_add_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(input_ptr + z), scale)), zero_point);
+                    _mm256_store_si256(reinterpret_cast<__m256i *>(quantized), _mm256_min_epi32(_mm256_max_epi32(value, zero), max_u8));
+                    for (size_t item = 0; item < 8; ++item)
+                        *output.at(request.batch, x, y, z + item) = static_cast<uint8_t>(quantized[item]);
+                }
+
+                for (; z < size_z; ++z)
+                {
+                    const auto value = static_cast<int32_t>(std::nearbyint(input_ptr[z] * output_scale)) + output_zero_point;
+                    *output.at(request.batch, x, y, z) = static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+                }
+            }
+    }
+
+    void convert_float_to_uint8::unpack_convert_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<request_handle *>(void_handle);
+        handle->primitive->convert_rows(*handle);
+    }
+
+    void convert_float_to_uint8::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+
+        if (inputs[0]->parent->data_type_size != sizeof(float))
+            throw std::invalid_argument("float to uint8 conversion: input has to be float");
+
+        const z_block_u8_view output_view(outputs[0]);
+
+        // padding around images has to hold zero point (real 0), buffer is zero-filled at creation
+        if (output_zero_point != 0)
+            for (size_t n = 0; n < batch_size; ++n)
+                memset(static_cast<uint8_t *>(outputs[0]->parent->data_buffer) + (outputs[0]->view_begin.t[NN_DATA_COORD_n] + n) * output_view.stride_n,
+                       output_zero_point,
+                       output_view.stride_n);
+
+        const size_t threads = device->thread_pool.get_num_threads();
+        const size_t row_splits = std::min(output_size_y, std::max<size_t>(1, (2 * threads + batch_size - 1) / batch_size));
+        const size_t rows_per_job = (output_size_y + row_splits - 1) / row_splits;
+
+        std::vector<request_handle> requests;
+        for (size_t n = 0; n < batch_size; ++n)
+            for (size_t row = 0; row < output_size_y; row += rows_per_job)
+                requests.push_back({this, inputs[0], &output_view, n, row, std::min(row + rows_per_job, output_size_y)});
+
+        run_jobs(requests, unpack_convert_callback_handle);
+    }
+
+    std::vector<nn_workload_data_t *> convert_float_to_uint8::create_inputs(bool allocate_delta)
+    {
+        return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_ZXYN, nn::layout_zxyn_f32>::create(
+            device, static_cast<uint32_t>(output_size_x), static_cast<uint32_t>(output_size_y), static_cast<uint32_t>(input_size_z), static_cast<uint32_t>(batch_size), 0, 0, 0, 0, allocate_delta) };
+    }
+} // namespace int8_fixedpoint
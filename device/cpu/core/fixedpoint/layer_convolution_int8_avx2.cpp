@@ -0,0 +1,196 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/api_internal/data_helper.h"
+#include "layer_convolution_int8_avx2.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace int8_fixedpoint
+{
+    using namespace helper_z_block_xyz_u8;
+
+    convolution_i8::convolution_i8(
+        const size_t kernel_w,
+        const size_t kernel_h,
+        const size_t num_input,
+        const size_t num_output,
+        const size_t output_w,
+        const size_t output_h,
+        const int32_t center_offset_x,
+        const int32_t center_offset_y,
+        const size_t stride_x,
+        const size_t stride_y,
+        const nn_argument_activation_t &activation,
+        const float input_scale,
+        const uint8_t input_zero_point,
+        const float output_scale,
+        size_t batch_size,
+        size_t output_block_size,
+        const size_t output_padding_left,
+        const size_t output_padding_right,
+        const size_t output_padding_top,
+        const size_t output_padding_bottom,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_u8_base(
+              batch_size,
+              num_input,
+              output_w,
+              output_h,
+              num_output,
+              output_block_size,
+              output_padding_left,
+              output_padding_right,
+              output_padding_top,
+              output_padding_bottom,
+              device),
+          kernel_w(kernel_w),
+          kernel_h(kernel_h),
+          center_offset_x(center_offset_x),
+          center_offset_y(center_offset_y),
+          stride_x(stride_x),
+          stride_y(stride_y),
+          input_scale(input_scale),
+          input_zero_point(input_zero_point),
+          output_scale(output_scale)
+    {
+        // uint8 output cannot hold negative values, ReLU is the only activation that loses nothing
+        if (activation.function != NN_ACTIVATION_FUNCTION_RELU)
+            throw std::invalid_argument("int8 convolution supports only ReLU activation");
+    }
+
+    void convolution_i8::compute_rows(const request_handle &request) const
+    {
+        const auto &input = *request.input_view;
+        const auto &output = *request.output_view;
+        const size_t input_blocks = input.size_z / input.block;
+        const size_t ofm_begin = request.ofm_block * C_ofm_block;
+        const size_t store_count = std::min(C_ofm_block, output.size_z - ofm_begin);
+        const float *multiplier = request.multiplier + ofm_begin;
+        const float *offset = request.offset + ofm_begin;
+        const ptrdiff_t tile_stride = stride_x * input.stride_x;
+
+        for (size_t y = request.row_begin; y < request.row_end; ++y)
+        {
+            const ptrdiff_t input_y = static_cast<ptrdiff_t>(y * stride_y) - center_offset_y;
+            size_t x = 0;
+            for (; x + 2 <= output_size_x; x += 2)
+            {
+                __m256i acc[2][4];
+                for (auto &tile : acc)
+                    for (auto &part : tile)
+                        part = _mm256_setzero_si256();
+
+                accumulate_u8s8<2>(acc,
+                                   input.at(request.batch, static_cast<ptrdiff_t>(x * stride_x) - center_offset_x, input_y, 0),
+                                   tile_stride, request.weights, kernel_w, kernel_h, input, input_blocks);
+
+                for (size_t tile = 0; tile < 2; ++tile)
+                    store_u8(output.at(request.batch, x + tile, y, ofm_begin), output, store_count, requantize_u8(acc[tile], multiplier, offset));
+            }
+
+            for (; x < output_size_x; ++x)
+            {
+                __m256i acc[1][4];
+                for (auto &part : acc[0])
+                    part = _mm256_setzero_si256();
+
+                accumulate_u8s8<1>(acc,
+                                   input.at(request.batch, static_cast<ptrdiff_t>(x * stride_x) - center_offset_x, input_y, 0),
+                                   tile_stride, request.weights, kernel_w, kernel_h, input, input_blocks);
+
+                store_u8(output.at(request.batch, x, y, ofm_begin), output, store_count, requantize_u8(acc[0], multiplier, offset));
+            }
+        }
+    }
+
+    void convolution_i8::unpack_convolution_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<request_handle *>(void_handle);
+        handle->primitive->compute_rows(*handle);
+    }
+
+    void convolution_i8::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+        assert(parameters.size() == 3);
+
+        const z_block_u8_view input_view(inputs[0]);
+        const z_block_u8_view output_view(outputs[0]);
+        const auto weights = parameters[0];
+
+        if (weights->parent->lengths.t[NN_DATA_COORD_z] * 4 != input_view.size_z)
+            throw std::invalid_argument("int8 convolution: number of input feature maps doesn't match weights");
+
+        if (input_view.block % 4 != 0)
+            throw std::invalid_argument("int8 convolution: input z block has to be multiple of 4");
+
+        std::vector<float> multiplier, offset;
+        compute_requantization(weights, parameters[1], parameters[2], output_size_z, input_scale, input_zero_point, output_scale, multiplier, offset);
+
+        const auto &lengths = weights->parent->lengths;
+        const size_t weights_block_length = lengths.t[NN_DATA_COORD_x] * lengths.t[NN_DATA_COORD_y] * lengths.t[NN_DATA_COORD_z] * lengths.t[NN_DATA_COORD_p];
+        const size_t ofm_blocks = (output_size_z + C_ofm_block - 1) / C_ofm_block;
+
+        // rows are split further only when images and output blocks alone don't give each thread a few jobs
+        const size_t threads = device->thread_pool.get_num_threads();
+        const size_t row_splits = std::min(output_size_y, std::max<size_t>(1, (4 * threads + batch_size * ofm_blocks - 1) / (batch_size * ofm_blocks)));
+        const size_t rows_per_job = (output_size_y + row_splits - 1) / row_splits;
+
+        std::vector<request_handle> requests;
+        for (size_t n = 0; n < batch_size; ++n)
+            for (size_t ofm_block = 0; ofm_block < ofm_blocks; ++ofm_block)
+                for (size_t row = 0; row < output_size_y; row += rows_per_job)
+                    requests.push_back({this,
+                                        &input_view,
+                                        &output_view,
+                                        static_cast<const int8_t *>(weights->parent->data_buffer) + ofm_block * weights_block_length,
+                                        multiplier.data(),
+                                        offset.data(),
+                                        n,
+                                        ofm_block,
+                                        row,
+                                        std::min(row + rows_per_job, output_size_y)});
+
+        run_jobs(requests, unpack_convolution_callback_handle);
+    }
+
+    std::vector<nn_workload_data_t *> convolution_i8::create_parameters(bool allocate_delta)
+    {
+        return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, int8_t>::create(device, kernel_w, kernel_h, input_size_z, output_size_z),
+                nn::data_helper<NN_WORKLOAD_DATA_TAG_O, nn::layout_o_f32>::create(device, output_size_z, allocate_delta),
+                nn::data_helper<NN_WORKLOAD_DATA_TAG_O, nn::layout_o_f32>::create(device, output_size_z, allocate_delta) };
+    }
+
+    size_t convolution_i8::get_required_input_w() { return (output_size_x - 1) * stride_x + kernel_w; }
+    size_t convolution_i8::get_required_input_h() { return (output_size_y - 1) * stride_y + kernel_h; }
+} // namespace int8_fixedpoint
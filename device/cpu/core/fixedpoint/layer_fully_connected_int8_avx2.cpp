@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/api_internal/data_helper.h"
+#include "layer_fully_connected_int8_avx2.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace int8_fixedpoint
+{
+    using namespace helper_z_block_xyz_u8;
+
+    template <typename T_output>
+    fully_connected_i8<T_output>::fully_connected_i8(
+        size_t input_w,
+        size_t input_h,
+        size_t num_input,
+        size_t num_output,
+        const nn_argument_activation_t &activation,
+        float input_scale,
+        uint8_t input_zero_point,
+        float output_scale,
+        size_t batch_size,
+        size_t output_block_size,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_u8_base(batch_size, num_input, 1, 1, num_output, output_block_size, 0, 0, 0, 0, device),
+          input_w(input_w),
+          input_h(input_h),
+          activation(activation.function),
+          input_scale(input_scale),
+          input_zero_point(input_zero_point),
+          output_scale(output_scale)
+    {
+        if (activation.function != NN_ACTIVATION_FUNCTION_RELU &&
+            (activation.function != NN_ACTIVATION_FUNCTION_NONE || std::is_same<T_output, uint8_t>::value))
+            throw std::invalid_argument("int8 fully connected supports ReLU, or no activation with float output");
+    }
+
+    template <>
+    void fully_connected_i8<uint8_t>::store_output(const request_handle &request, size_t batch, const __m256i (&acc)[4]) const
+    {
+        const z_block_u8_view output_view(request.output);
+        const size_t ofm_begin = request.ofm_block * C_ofm_block;
+        store_u8(output_view.at(batch, 0, 0, ofm_begin),
+                 output_view,
+                 std::min(C_ofm_block, output_view.size_z - ofm_begin),
+                 requantize_u8(acc, request.multiplier + ofm_begin, request.offset + ofm_begin));
+    }
+
+    template <>
+    void fully_connected_i8<float>::store_output(const request_handle &request, size_t batch, const __m256i (&acc)[4]) const
+    {
+        // NX layout: x (output map) major, n minor
+        auto output = static_cast<float *>(request.output->parent->data_buffer);
+        const size_t ofm_begin = request.ofm_block * C_ofm_block;
+
+        alignas(32) float values[C_ofm_block];
+        for (int part = 0; part < 4; ++part) {
+            auto value = _mm256_fmadd_ps(_mm256_cvtepi32_ps(acc[part]),
+                                         _mm256_loadu_ps(request.multiplier + ofm_begin + 8 * part),
+                                         _mm256_loadu_ps(request.offset + ofm_begin + 8 * part));
+            if (activation == NN_ACTIVATION_FUNCTION_RELU)
+                value = _mm256_max_ps(value, _mm256_setzero_ps());
+            _mm256_store_ps(values + 8 * part, value);
+        }
+
+        for (size_t o = 0; o < C_ofm_block && ofm_begin + o < output_size_z; ++o)
+            output[batch + batch_size * (ofm_begin + o)] = values[o];
+    }
+
+    template <typename T_output>
+    void fully_connected_i8<T_output>::compute_batch(const request_handle &request) const
+    {
+        const auto &input = *request.input_view;
+        const size_t input_blocks = input.size_z / input.block;
+
+        size_t batch = request.batch_begin;
+        for (; batch + 2 <= request.batch_end; batch += 2)
+        {
+            __m256i acc[2][4];
+            for (auto &tile : acc)
+                for (auto &part : tile)
+                    part = _mm256_setzero_si256();
+
+            accumulate_u8s8<2>(acc, input.at(batch, 0, 0, 0), input.stride_n, request.weights, input.size_x, input.size_y, input, input_blocks);
+
+            store_output(request, batch, acc[0]);
+            store_output(request, batch + 1, acc[1]);
+        }
+
+        for (; batch < request.batch_end; ++batch)
+        {
+            __m256i acc[1][4];
+            for (auto &part : acc[0])
+                part = _mm256_setzero_si256();
+
+            accumulate_u8s8<1>(acc, input.at(batch, 0, 0, 0), input.stride_n, request.weights, input.size_x, input.size_y, input, input_blocks);
+
+            store_output(request, batch, acc[0]);
+        }
+    }
+
+    template <typename T_output>
+    void fully_connected_i8<T_output>::unpack_fully_connected_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<request_handle *>(void_handle);
+        handle->primitive->compute_batch(*handle);
+    }
+
+    template <typename T_output>
+    void fully_connected_i8<T_output>::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+        assert(parameters.size() == 3);
+
+        const z_block_u8_view input_view(inputs[0]);
+        const auto weights = parameters[0];
+        const auto &lengths = weights->parent->lengths;
+
+        if (lengths.t[NN_DATA_COORD_x] != input_view.size_x || lengths.t[NN_DATA_COORD_y] != input_view.size_y ||
+            lengths.t[NN_DATA_COORD_z] * 4 != input_view.size_z)
+            throw std::invalid_argument("int8 fully connected: input size doesn't match weights");
+
+        if (input_view.block % 4 != 0)
+            throw std::invalid_argument("int8 fully connected: input z block has to be multiple of 4");
+
+        std::vector<float> multiplier, offset;
+        compute_requantization(weights,
+                               parameters[1],
+                               parameters[2],
+                               output_size_z,
+                               input_scale,
+                               input_zero_point,
+                               std::is_same<T_output, float>::value ? 1.0f : output_scale,
+                               multiplier,
+                               offset);
+
+        const size_t weights_block_length = lengths.t[NN_DATA_COORD_x] * lengths.t[NN_DATA_COORD_y] * lengths.t[NN_DATA_COORD_z] * lengths.t[NN_DATA_COORD_p];
+        const size_t ofm_blocks = (output_size_z + C_ofm_block - 1) / C_ofm_block;
+
+        // each job streams weights of one output block once for its whole slice of the batch
+        const size_t threads = device->thread_pool.get_num_threads();
+        const size_t batch_splits = std::min((batch_size + 1) / 2, std::max<size_t>(1, (2 * threads + ofm_blocks - 1) / ofm_blocks));
+        const size_t batch_per_job = ((batch_size + batch_splits - 1) / batch_splits + 1) / 2 * 2;
+
+        std::vector<request_handle> requests;
+        for (size_t ofm_block = 0; ofm_block < ofm_blocks; ++ofm_block)
+            for (size_t batch = 0; batch < batch_size; batch += batch_per_job)
+                requests.push_back({this,
+                                    &input_view,
+                                    outputs[0],
+                                    static_cast<const int8_t *>(weights->parent->data_buffer) + ofm_block * weights_block_length,
+                                    multiplier.data(),
+                                    offset.data(),
+                                    ofm_block,
+                                    batch,
+                                    std::min(batch + batch_per_job, batch_size)});
+
+        run_jobs(requests, unpack_fully_connected_callback_handle);
+    }
+
+    template <typename T_output>
+    std::vector<nn_workload_data_t *> fully_connected_i8<T_output>::create_parameters(bool allocate_delta)
+    {
+        return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_I4O32IXYO, int8_t>::create(device, input_w, input_h, input_size_z, output_size_z),
+                nn::data_helper<NN_WORKLOAD_DATA_TAG_O, nn::layout_o_f32>::create(device, output_size_z, allocate_delta),
+                nn::data_helper<NN_WORKLOAD_DATA_TAG_O, nn::layout_o_f32>::create(device, output_size_z, allocate_delta) };
+    }
+
+    template <>
+    std::vector<nn_workload_data_t *> fully_connected_i8<uint8_t>::create_outputs(bool allocate_delta)
+    {
+        return primitive_z_block_xyz_u8_base::create_outputs(allocate_delta);
+    }
+
+    template <>
+    std::vector<nn_workload_data_t *> fully_connected_i8<float>::create_outputs(bool allocate_delta)
+    {
+        return{ nn::data_helper<NN_WORKLOAD_DATA_TAG_NX, nn::layout_nx_f32>::create(device, output_size_z, batch_size, allocate_delta) };
+    }
+
+    template class fully_connected_i8<uint8_t>;
+    template class fully_connected_i8<float>;
+} // namespace int8_fixedpoint
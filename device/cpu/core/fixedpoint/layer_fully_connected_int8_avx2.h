@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+#include <cstdint>
+#include "device/api/nn_device_interface_0.h"
+#include "helper_z_block_xyz_u8.h"
+
+struct nn_device_internal;
+
+namespace int8_fixedpoint
+{
+    /* Fully connected layer reading uint8 z-block input of any width & height directly (weights hold x & y).
+       T_output is uint8_t for z-block output with ReLU or float for NX output of real values. */
+    template <typename T_output>
+    class fully_connected_i8 : public helper_z_block_xyz_u8::primitive_z_block_xyz_u8_base
+    {
+    public:
+        fully_connected_i8(
+            size_t input_w,
+            size_t input_h,
+            size_t num_input,
+            size_t num_output,
+            const nn_argument_activation_t &activation,
+            float input_scale,
+            uint8_t input_zero_point,
+            float output_scale,
+            size_t batch_size,
+            size_t output_block_size,
+            nn_device_internal *device);
+
+        virtual ~fully_connected_i8() {}
+
+        /* parameters: weights (I4O32IXYO int8), biases (float, may be null), weights scales (float, one per output map) */
+        virtual void forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs) override;
+
+        virtual std::vector<nn_workload_data_t *> create_parameters(bool allocate_delta) override;
+
+        virtual std::vector<nn_workload_data_t *> create_outputs(bool allocate_delta) override;
+
+    protected:
+        virtual size_t get_required_input_w() override { return input_w; }
+        virtual size_t get_required_input_h() override { return input_h; }
+
+        const size_t input_w;
+        const size_t input_h;
+        const NN_ACTIVATION_FUNCTION activation;
+        const float input_scale;
+        const uint8_t input_zero_point;
+        const float output_scale;
+
+        struct request_handle
+        {
+            const fully_connected_i8 *primitive;
+            const helper_z_block_xyz_u8::z_block_u8_view *input_view;
+            nn_workload_data_t *output;
+            const int8_t *weights;
+            const float *multiplier;
+            const float *offset;
+            size_t ofm_block;
+            size_t batch_begin;
+            size_t batch_end;
+        };
+
+        void compute_batch(const request_handle &request) const;
+
+        void store_output(const request_handle &request, size_t batch, const __m256i (&acc)[4]) const;
+
+        static void unpack_fully_connected_callback_handle(void *void_handle);
+    };
+} // namespace int8_fixedpoint
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/common/nn_workload_data.h"
 #include "device/cpu/api_internal/data_helper.h"
 #include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/nn_intrinsic_power.h"
 #include "layer_normalization_response_across_maps_int16_avx2.h"
 
 #include <immintrin.h>
@@ -40,229 +41,41 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace int16_fixedpoint {
 
-    static inline __m256 _inner_mm256_invpow075_ps(__m256 arg)
-    {
-        __m256i e = _mm256_slli_epi32(
-            _mm256_sub_epi32(
-            _mm256_and_si256(
-            _mm256_castps_si256(arg),
-            _mm256_set1_epi32(0x7f800000)),
-            _mm256_set1_epi32(0x3f800000)),
-            1);
-
-        __m256 p0 = _mm256_castsi256_ps(
-            _mm256_srli_epi32(
-            _mm256_add_epi32(
-            _mm256_mullo_epi32(
-            _mm256_srai_epi32(
-            _mm256_and_si256(
-            e,
-            _mm256_set1_epi32(0xfc000000)),
-            2),
-            _mm256_set1_epi32(-3)),
-            _mm256_set1_epi32(0x7f000000)),
-            1));
-
-        __m256 p1 = _mm256_blendv_ps(
-            _mm256_set1_ps(0.59460355750136053335874998528f),
-            _mm256_set1_ps(1.0f),
-            _mm256_castsi256_ps(
-            _mm256_cmpeq_epi32(
-            _mm256_and_si256(
-            e,
-            _mm256_set1_epi32(1 << 24)),
-            _mm256_set1_epi32(0))));
-
-        __m256 p2 = _mm256_blendv_ps(
-            _mm256_set1_ps(0.35355339059327376220042218105f),
-            _mm256_set1_ps(1.0f),
-            _mm256_castsi256_ps(
-            _mm256_cmpeq_epi32(
-            _mm256_and_si256(
-            e,
-            _mm256_set1_epi32(2 << 24)),
-            _mm256_set1_epi32(0))));
-
-        arg = _mm256_castsi256_ps(
-            _mm256_or_si256(
-            _mm256_and_si256(
-            _mm256_castps_si256(arg),
-            _mm256_set1_epi32(0x007fffff)),
-            _mm256_set1_epi32(0x3f800000)));
-
-        __m256 intermediate_result;
-        intermediate_result = _mm256_fmadd_ps(arg, _mm256_set1_ps(-0.06251362156237f), _mm256_set1_ps(0.56657226995864f));
-        intermediate_result = _mm256_fmadd_ps(arg, intermediate_result, _mm256_set1_ps(-2.12314847503624f));
-        intermediate_result = _mm256_fmadd_ps(arg, intermediate_result, _mm256_set1_ps(4.22879355263332f));
-        intermediate_result = _mm256_fmadd_ps(arg, intermediate_result, _mm256_set1_ps(-4.79039952143706f));
-        intermediate_result = _mm256_fmadd_ps(arg, intermediate_result, _mm256_set1_ps(3.18069569544757f));
-
-        intermediate_result =
-            _mm256_mul_ps(
-            _mm256_mul_ps(
-            p0,
-            p1),
-            _mm256_mul_ps(
-            p2,
-            intermediate_result));
-
-        return intermediate_result;
-    }
-
-    static inline __m256 finalize_lrn_computation_p075(__m256 acc,
-                                                       const float alpha,
-                                                       const float k,
-                                                       __m256 source_raw) {
+    template <nn::intrinsics::invpow_kind T_kind>
+    static inline __m256 finalize_lrn_computation(__m256 acc,
+                                                  const float alpha,
+                                                  const float k,
+                                                  const float beta,
+                                                  __m256 source_raw) {
         // Do k + alpha * acc.
         __m256 result = _mm256_fmadd_ps(acc, _mm256_set1_ps(alpha), _mm256_set1_ps(k));
 
-        // Magic happens here. (acc^-0.75)
-        result = _inner_mm256_invpow075_ps(result);
+        // Magic happens here. (acc^-beta)
+        result = nn::intrinsics::invpow_ps<T_kind>(result, _mm256_set1_ps(beta));
 
         // Multiply with input data.
         result = _mm256_mul_ps(result, source_raw);
         return result;
     }
 
-    struct lrn_fixedpoint_request_handle_p075 {
+    struct lrn_fixedpoint_request_handle {
         const nn::workload_data<int16_t> *input_view;
         nn::workload_data<int16_t> *output_view;
         float k;
         float alpha;
+        float beta;
         float scale_in;
         float scale_out;
     };
 
-    normalization_response_across_maps_i16::normalization_response_across_maps_i16(
-        uint32_t k,
-        uint32_t n,
-        float alpha,
-        float beta,
-        float scale_in,
-        float scale_out,
-        size_t image_size_x,
-        size_t image_size_y,
-        size_t image_size_z,
-        size_t batch_size,
-        size_t output_padding_left,
-        size_t output_padding_right,
-        size_t output_padding_top,
-        size_t output_padding_bottom,
-        nn_device_internal *device)
-        : primitive_z_block_xyz_i16_base(
-            batch_size,
-            image_size_z,
-            image_size_x,
-            image_size_y,
-            image_size_z,
-            output_padding_left,
-            output_padding_right,
-            output_padding_top,
-            output_padding_bottom,
-            device),
-        k(k),
-        n(n),
-        alpha(alpha),
-        beta(beta),
-        scale_in(scale_in),
-        scale_out(scale_out),
-        image_size_x(image_size_x),
-        image_size_y(image_size_y),
-        image_size_z(image_size_z),
-        batch_size(batch_size),
-        output_padding_left(output_padding_left),
-        output_padding_right(output_padding_right),
-        output_padding_top(output_padding_top),
-        output_padding_bottom(output_padding_bottom),
-        device(device),
-        in_out_layout(nn::layout_t<nn::layout_pxyznq_i16>::layout)
-    {}
-
-    void normalization_response_across_maps_i16::forward(
-        const nn::workload_data<int16_t> *input,
-        nn::workload_data<int16_t> *output)
-    {
-        assert(n == 5);
-        assert(beta == 0.75f);
-
-        if (device == nullptr || device->thread_pool.get_num_threads() == 1) {
-            process_lrn_p075<5>(input, output, alpha, k, scale_in, scale_out);
-            return;
-        }
-
-        const auto size_y = input->get_length(NN_DATA_COORD_y);
-
-        const size_t num_work_chunks = size_y;
-        std::vector<lrn_fixedpoint_request_handle_p075> request_handles(num_work_chunks);
-        std::vector<nn_multithreaded_request> jobs(num_work_chunks);
-
-        nn_workload_data_coords_t view_begin( 0, 0, 0, 0, 0, 0 );
-        nn_workload_data_coords_t view_end(input->get_length(NN_DATA_COORD_n) - 1,
-            input->get_length(NN_DATA_COORD_x) - 1,
-            0,
-            input->get_length(NN_DATA_COORD_z) - 1,
-            input->get_length(NN_DATA_COORD_p) - 1,
-            input->get_length(NN_DATA_COORD_q) - 1 );
-
-        for (size_t y = 0; y < size_y; ++y){
-            const size_t thread_id = y;
-
-            //view_begin.t[NN_DATA_COORD_x] = view_end.t[NN_DATA_COORD_x] = static_cast<uint32_t>(x);
-            view_begin.t[NN_DATA_COORD_y] = view_end.t[NN_DATA_COORD_y] = static_cast<uint32_t>(y);
-
-            auto &request_handle = request_handles[thread_id];
-
-            request_handle.input_view = new nn::workload_data<int16_t>(*input, view_begin, view_end);
-            request_handle.output_view = new nn::workload_data<int16_t>(*output, view_begin, view_end);
-
-            request_handle.alpha = alpha;
-            request_handle.k = k;
-            request_handle.scale_in = scale_in;
-            request_handle.scale_out = scale_out;
-
-            auto &job = jobs[thread_id];
-            job.request_handle = &request_handle;
-            job.callback = unpack<5>;
-        }
-
-        device->thread_pool.push_job(jobs);
-
-        // cleanup
-        for (auto &request_handle : request_handles)
-        {
-            delete request_handle.input_view;
-            delete request_handle.output_view;
-        }
-    }
-
-    void normalization_response_across_maps_i16::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
-    {
-        assert(inputs.size() == 1);
-        assert(outputs.size() == 1);
-
-        forward(reinterpret_cast<const nn::workload_data<int16_t> *>(inputs[0]),
-            reinterpret_cast<nn::workload_data<int16_t> *>(outputs[0]));
-    }
-
-    bool normalization_response_across_maps_i16::validate_input(size_t index, nn_workload_data_t *data)
-    {
-        throw std::logic_error("The method or operation is not implemented.");
-    }
-
-    template <uint32_t T_n> void unpack(void *void_handle) {
-        auto handle = reinterpret_cast<lrn_fixedpoint_request_handle_p075 *>(void_handle);
-        process_lrn_p075<T_n>(
-            handle->input_view, handle->output_view, handle->alpha, handle->k, handle->scale_in, handle->scale_out);
-    }
-
-    template <uint32_t T_n>
-    void process_lrn_p075(const nn::workload_data<int16_t> *input_view,
-                          nn::workload_data<int16_t> *output_view,
-                          // const uint32_t n,
-                          const float alpha,
-                          const float k,
-                          const float scale_in,
-                          const float scale_out) {
+    template <uint32_t T_n, nn::intrinsics::invpow_kind T_kind>
+    void process_lrn(const nn::workload_data<int16_t> *input_view,
+                     nn::workload_data<int16_t> *output_view,
+                     const float alpha,
+                     const float k,
+                     const float beta,
+                     const float scale_in,
+                     const float scale_out) {
         const size_t size_z_block = 16;
         const size_t storage_simd_width = 16;
         const size_t compute_simd_width = 8;
@@ -385,7 +198,7 @@ namespace int16_fixedpoint {
                                     _mm256_blend_ps(source_first_squared, source_second_squared, 0x80);
                             }
 
-                            __m256 result = finalize_lrn_computation_p075(acc, alpha, k, source_raw);
+                            __m256 result = finalize_lrn_computation<T_kind>(acc, alpha, k, beta, source_raw);
                             __m256i result32 = _mm256_cvttps_epi32(_mm256_mul_ps(output_scaler, result));
                             __m256i result32swizzle = _mm256_permute4x64_epi64(result32, 0x0e);
                             _mm_store_si128((__m128i *)(output_z_block_start + z),
@@ -422,7 +235,7 @@ namespace int16_fixedpoint {
                         source_first_squared = _mm256_blend_ps(source_first_squared, source_second_squared, 0x80);
                     }
 
-                    __m256 result = finalize_lrn_computation_p075(acc, alpha, k, source_raw);
+                    __m256 result = finalize_lrn_computation<T_kind>(acc, alpha, k, beta, source_raw);
                     __m256i result32 = _mm256_cvttps_epi32(_mm256_mul_ps(output_scaler, result));
                     __m256i result32swizzle = _mm256_permute4x64_epi64(result32, 0x0e);
                     _mm_store_si128((__m128i *)(output_z_block_start + z),
@@ -432,6 +245,143 @@ namespace int16_fixedpoint {
         }
     }
 
+    template <uint32_t T_n, nn::intrinsics::invpow_kind T_kind> void unpack(void *void_handle) {
+        auto handle = reinterpret_cast<lrn_fixedpoint_request_handle *>(void_handle);
+        process_lrn<T_n, T_kind>(handle->input_view,
+                                 handle->output_view,
+                                 handle->alpha,
+                                 handle->k,
+                                 handle->beta,
+                                 handle->scale_in,
+                                 handle->scale_out);
+    }
+
+    normalization_response_across_maps_i16::normalization_response_across_maps_i16(
+        uint32_t k,
+        uint32_t n,
+        float alpha,
+        float beta,
+        float scale_in,
+        float scale_out,
+        size_t image_size_x,
+        size_t image_size_y,
+        size_t image_size_z,
+        size_t batch_size,
+        size_t output_padding_left,
+        size_t output_padding_right,
+        size_t output_padding_top,
+        size_t output_padding_bottom,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_i16_base(
+            batch_size,
+            image_size_z,
+            image_size_x,
+            image_size_y,
+            image_size_z,
+            output_padding_left,
+            output_padding_right,
+            output_padding_top,
+            output_padding_bottom,
+            device),
+        k(k),
+        n(n),
+        alpha(alpha),
+        beta(beta),
+        scale_in(scale_in),
+        scale_out(scale_out),
+        image_size_x(image_size_x),
+        image_size_y(image_size_y),
+        image_size_z(image_size_z),
+        batch_size(batch_size),
+        output_padding_left(output_padding_left),
+        output_padding_right(output_padding_right),
+        output_padding_top(output_padding_top),
+        output_padding_bottom(output_padding_bottom),
+        device(device),
+        in_out_layout(nn::layout_t<nn::layout_pxyznq_i16>::layout)
+    {}
+
+    void normalization_response_across_maps_i16::forward(
+        const nn::workload_data<int16_t> *input,
+        nn::workload_data<int16_t> *output)
+    {
+        assert(n == 5);
+
+        // Exponents -0.75, -0.5 and -1.0 have dedicated forms, others use vectorized logarithm and exponent.
+        void (*callback)(void *) = unpack<5, nn::intrinsics::invpow_kind::any>;
+        switch (nn::intrinsics::invpow_kind_for(beta)) {
+        case nn::intrinsics::invpow_kind::beta_075: callback = unpack<5, nn::intrinsics::invpow_kind::beta_075>; break;
+        case nn::intrinsics::invpow_kind::beta_05:  callback = unpack<5, nn::intrinsics::invpow_kind::beta_05>; break;
+        case nn::intrinsics::invpow_kind::beta_1:   callback = unpack<5, nn::intrinsics::invpow_kind::beta_1>; break;
+        default: break;
+        }
+
+        if (device == nullptr || device->thread_pool.get_num_threads() == 1) {
+            lrn_fixedpoint_request_handle request_handle = { input, output, static_cast<float>(k), alpha, beta, scale_in, scale_out };
+            callback(&request_handle);
+            return;
+        }
+
+        const auto size_y = input->get_length(NN_DATA_COORD_y);
+
+        const size_t num_work_chunks = size_y;
+        std::vector<lrn_fixedpoint_request_handle> request_handles(num_work_chunks);
+        std::vector<nn_multithreaded_request> jobs(num_work_chunks);
+
+        nn_workload_data_coords_t view_begin( 0, 0, 0, 0, 0, 0 );
+        nn_workload_data_coords_t view_end(input->get_length(NN_DATA_COORD_n) - 1,
+            input->get_length(NN_DATA_COORD_x) - 1,
+            0,
+            input->get_length(NN_DATA_COORD_z) - 1,
+            input->get_length(NN_DATA_COORD_p) - 1,
+            input->get_length(NN_DATA_COORD_q) - 1 );
+
+        for (size_t y = 0; y < size_y; ++y){
+            const size_t thread_id = y;
+
+            //view_begin.t[NN_DATA_COORD_x] = view_end.t[NN_DATA_COORD_x] = static_cast<uint32_t>(x);
+            view_begin.t[NN_DATA_COORD_y] = view_end.t[NN_DATA_COORD_y] = static_cast<uint32_t>(y);
+
+            auto &request_handle = request_handles[thread_id];
+
+            request_handle.input_view = new nn::workload_data<int16_t>(*input, view_begin, view_end);
+            request_handle.output_view = new nn::workload_data<int16_t>(*output, view_begin, view_end);
+
+            request_handle.alpha = alpha;
+            request_handle.k = k;
+            request_handle.beta = beta;
+            request_handle.scale_in = scale_in;
+            request_handle.scale_out = scale_out;
+
+            auto &job = jobs[thread_id];
+            job.request_handle = &request_handle;
+            job.callback = callback;
+        }
+
+        device->thread_pool.push_job(jobs);
+
+        // cleanup
+        for (auto &request_handle : request_handles)
+        {
+            delete request_handle.input_view;
+            delete request_handle.output_view;
+        }
+    }
+
+    void normalization_response_across_maps_i16::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+
+        forward(reinterpret_cast<const nn::workload_data<int16_t> *>(inputs[0]),
+            reinterpret_cast<nn::workload_data<int16_t> *>(outputs[0]));
+    }
+
+    bool normalization_response_across_maps_i16::validate_input(size_t index, nn_workload_data_t *data)
+    {
+        throw std::logic_error("The method or operation is not implemented.");
+    }
+
     void wrapper_lrn_fixedpoint_work_item(nn_workload_item *const work_item, nn_device_internal *device)
     {
 
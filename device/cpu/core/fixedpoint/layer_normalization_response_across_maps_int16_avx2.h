@@ -58,8 +58,6 @@ namespace int16_fixedpoint {
 
         virtual bool validate_input(size_t index, nn_workload_data_t *data) override;
 
-        template <uint32_t T_n> friend void unpack(void *void_handle);
-
         friend void wrapper_lrn_fixedpoint_work_item(nn_workload_item *const work_item, nn_device_internal *device);
 
     protected:
@@ -67,15 +65,6 @@ namespace int16_fixedpoint {
         virtual size_t get_required_input_w() override;
         virtual size_t get_required_input_h() override;
 
-        template <uint32_t T_n>
-        friend void process_lrn_p075(const nn::workload_data<int16_t> *input_view,
-            nn::workload_data<int16_t> *output_view,
-            // const uint32_t n,
-            const float alpha,
-            const float k,
-            const float scale_in,
-            const float scale_out);
-
         float alpha;
         float beta;
         uint32_t k;
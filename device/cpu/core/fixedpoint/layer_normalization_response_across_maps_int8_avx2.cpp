@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "layer_normalization_response_across_maps_int8_avx2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace int8_fixedpoint
+{
+    using namespace helper_z_block_xyz_u8;
+
+    normalization_response_across_maps_i8::normalization_response_across_maps_i8(
+        uint32_t k,
+        uint32_t n,
+        float alpha,
+        float beta,
+        float input_scale,
+        float output_scale,
+        size_t image_size_x,
+        size_t image_size_y,
+        size_t image_size_z,
+        size_t batch_size,
+        size_t output_block_size,
+        size_t output_padding_left,
+        size_t output_padding_right,
+        size_t output_padding_top,
+        size_t output_padding_bottom,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_u8_base(
+              batch_size,
+              image_size_z,
+              image_size_x,
+              image_size_y,
+              image_size_z,
+              output_block_size,
+              output_padding_left,
+              output_padding_right,
+              output_padding_top,
+              output_padding_bottom,
+              device),
+          k(static_cast<float>(k)),
+          n(n),
+          alpha(alpha),
+          beta(beta),
+          input_scale(input_scale),
+          output_scale(output_scale) {}
+
+    /* Maps of a pixel are dequantized to float, normalized with sliding window sum of squares and requantized.
+       Input zero point is 0, as produced by int8 layers with ReLU. */
+    void normalization_response_across_maps_i8::compute_rows(const request_handle &request) const
+    {
+        const auto &input = *request.input_view;
+        const auto &output = *request.output_view;
+        const size_t size_z = std::max(input.size_z, output.size_z);
+        const size_t padded_z = (size_z + 7) / 8 * 8;
+        const ptrdiff_t half_window = n / 2;
+
+        std::vector<float> values(padded_z + n, 0.0f);
+        std::vector<float> sums(padded_z, 0.0f);
+        std::vector<float> squares(padded_z + n, 0.0f);
+        alignas(32) int32_t quantized[8];
+
+        const __m256 requantize = _mm256_set1_ps(output_scale);
+        const __m256 alpha_vec = _mm256_set1_ps(alpha);
+        const __m256 k_vec = _mm256_set1_ps(k);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i max_u8 = _mm256_set1_epi32(255);
+
+        for (size_t y = request.row_begin; y < request.row_end; ++y)
+            for (size_t x = 0; x < output_size_x; ++x)
+            {
+                // values & squares are stored with n/2 leading zeros so that window never leaves the arrays
+                for (size_t z = 0; z < input.size_z; ++z)
+                {
+                    const float value = *input.at(request.batch, x, y, z) / input_scale;
+                    values[z] = value;
+                    squares[z + half_window] = value * value;
+                }
+
+                float sum = 0.0f;
+                for (size_t z = 0; z < n; ++z)
+                    sum += squares[z];
+                for (size_t z = 0; z < size_z; ++z)
+                {
+                    sums[z] = sum;
+                    sum += squares[z + n] - squares[z];
+                }
+
+                for (size_t z = 0; z < output.size_z; z += 8)
+                {
+                    const __m256 scale = _mm256_fmadd_ps(alpha_vec, _mm256_loadu_ps(&sums[z]), k_vec);
+                    __m256 factor;
+                    if (beta == 0.75f) {
+                        // scale^-0.75 = 1 / sqrt(scale * sqrt(scale))
+                        factor = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_mul_ps(scale, _mm256_sqrt_ps(scale))));
+                    } else {
+                        alignas(32) float scales[8];
+                        _mm256_store_ps(scales, scale);
+                        for (auto &item : scales)
+                            item = std::pow(item, -beta);
+                        factor = _mm256_load_ps(scales);
+                    }
+
+                    const __m256 result = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&values[z]), factor), requantize);
+                    _mm256_store_si256(reinterpret_cast<__m256i *>(quantized),
+                                       _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(result), zero), max_u8));
+
+                    for (size_t item = 0; item < 8 && z + item < output.size_z; ++item)
+                        *output.at(request.batch, x, y, z + item) = static_cast<uint8_t>(quantized[item]);
+                }
+            }
+    }
+
+    void normalization_response_across_maps_i8::unpack_normalization_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<request_handle *>(void_handle);
+        handle->primitive->compute_rows(*handle);
+    }
+
+    void normalization_response_across_maps_i8::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+
+        const z_block_u8_view input_view(inputs[0]);
+        const z_block_u8_view output_view(outputs[0]);
+
+        const size_t threads = device->thread_pool.get_num_threads();
+        const size_t row_splits = std::min(output_size_y, std::max<size_t>(1, (2 * threads + batch_size - 1) / batch_size));
+        const size_t rows_per_job = (output_size_y + row_splits - 1) / row_splits;
+
+        std::vector<request_handle> requests;
+        for (size_t batch = 0; batch < batch_size; ++batch)
+            for (size_t row = 0; row < output_size_y; row += rows_per_job)
+                requests.push_back({this, &input_view, &output_view, batch, row, std::min(row + rows_per_job, output_size_y)});
+
+        run_jobs(requests, unpack_normalization_callback_handle);
+    }
+
+    size_t normalization_response_across_maps_i8::get_required_input_w() { return output_size_x; }
+    size_t normalization_response_across_maps_i8::get_required_input_h() { return output_size_y; }
+} // namespace int8_fixedpoint
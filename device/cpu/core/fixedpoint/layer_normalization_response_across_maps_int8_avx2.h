@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+#include <cstdint>
+#include "device/api/nn_device_interface_0.h"
+#include "helper_z_block_xyz_u8.h"
+
+struct nn_device_internal;
+
+namespace int8_fixedpoint
+{
+    class normalization_response_across_maps_i8 : public helper_z_block_xyz_u8::primitive_z_block_xyz_u8_base
+    {
+    public:
+        normalization_response_across_maps_i8(
+            uint32_t k,
+            uint32_t n,
+            float alpha,
+            float beta,
+            float input_scale,
+            float output_scale,
+            size_t image_size_x,
+            size_t image_size_y,
+            size_t image_size_z,
+            size_t batch_size,
+            size_t output_block_size,
+            size_t output_padding_left,
+            size_t output_padding_right,
+            size_t output_padding_top,
+            size_t output_padding_bottom,
+            nn_device_internal *device);
+
+        virtual ~normalization_response_across_maps_i8() {}
+
+        virtual void forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs) override;
+
+        virtual std::vector<nn_workload_data_t *> create_parameters(bool allocate_delta) override { return{}; }
+
+    protected:
+        virtual size_t get_required_input_w() override;
+        virtual size_t get_required_input_h() override;
+
+        const float k;
+        const uint32_t n;
+        const float alpha;
+        const float beta;
+        const float input_scale;
+        const float output_scale;
+
+        struct request_handle
+        {
+            const normalization_response_across_maps_i8 *primitive;
+            const helper_z_block_xyz_u8::z_block_u8_view *input_view;
+            const helper_z_block_xyz_u8::z_block_u8_view *output_view;
+            size_t batch;
+            size_t row_begin;
+            size_t row_end;
+        };
+
+        void compute_rows(const request_handle &request) const;
+
+        static void unpack_normalization_callback_handle(void *void_handle);
+    };
+} // namespace int8_fixedpoint
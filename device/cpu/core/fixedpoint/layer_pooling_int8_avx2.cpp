@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "layer_pooling_int8_avx2.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace int8_fixedpoint
+{
+    using namespace helper_z_block_xyz_u8;
+
+    namespace
+    {
+        // loads, maximum & store of T_size consecutive uint8 values
+        template <size_t T_size> struct u8_chunk;
+
+        template <> struct u8_chunk<32>
+        {
+            typedef __m256i type;
+            static type load(const uint8_t *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+            static type max(type a, type b) { return _mm256_max_epu8(a, b); }
+            static void store(uint8_t *ptr, type value) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value); }
+        };
+
+        template <> struct u8_chunk<16>
+        {
+            typedef __m128i type;
+            static type load(const uint8_t *ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+            static type max(type a, type b) { return _mm_max_epu8(a, b); }
+            static void store(uint8_t *ptr, type value) { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), value); }
+        };
+
+        template <> struct u8_chunk<8>
+        {
+            typedef __m128i type;
+            static type load(const uint8_t *ptr) { return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr)); }
+            static type max(type a, type b) { return _mm_max_epu8(a, b); }
+            static void store(uint8_t *ptr, type value) { _mm_storel_epi64(reinterpret_cast<__m128i *>(ptr), value); }
+        };
+
+        template <> struct u8_chunk<4>
+        {
+            typedef __m128i type;
+            static type load(const uint8_t *ptr) { int32_t value; memcpy(&value, ptr, sizeof(value)); return _mm_cvtsi32_si128(value); }
+            static type max(type a, type b) { return _mm_max_epu8(a, b); }
+            static void store(uint8_t *ptr, type value) { int32_t result = _mm_cvtsi128_si32(value); memcpy(ptr, &result, sizeof(result)); }
+        };
+    } // namespace
+
+    pooling_i8::pooling_i8(
+        NN_POOLING_MODE pooling_mode,
+        const size_t num_output,
+        size_t output_w,
+        size_t output_h,
+        size_t pool_size_x,
+        size_t pool_size_y,
+        size_t pool_stride_x,
+        size_t pool_stride_y,
+        const int32_t center_offset_x,
+        const int32_t center_offset_y,
+        size_t batch_size,
+        size_t output_block_size,
+        size_t output_padding_left,
+        size_t output_padding_right,
+        size_t output_padding_top,
+        size_t output_padding_bottom,
+        nn_device_internal *device)
+        : primitive_z_block_xyz_u8_base(
+              batch_size,
+              num_output,
+              output_w,
+              output_h,
+              num_output,
+              output_block_size,
+              output_padding_left,
+              output_padding_right,
+              output_padding_top,
+              output_padding_bottom,
+              device),
+          pool_size_x(pool_size_x),
+          pool_size_y(pool_size_y),
+          pool_stride_x(pool_stride_x),
+          pool_stride_y(pool_stride_y),
+          center_offset_x(center_offset_x),
+          center_offset_y(center_offset_y)
+    {
+        if (pooling_mode != NN_POOLING_MODE_MAX)
+            throw std::invalid_argument("int8 pooling supports only max pooling");
+    }
+
+    template <size_t T_chunk>
+    void pooling_i8::compute_rows(const request_handle &request) const
+    {
+        typedef u8_chunk<T_chunk> chunk;
+        const auto &input = *request.input_view;
+        const auto &output = *request.output_view;
+
+        for (size_t y = request.row_begin; y < request.row_end; ++y)
+            for (size_t x = 0; x < output_size_x; ++x)
+            {
+                const ptrdiff_t input_x = static_cast<ptrdiff_t>(x * pool_stride_x) - center_offset_x;
+                const ptrdiff_t input_y = static_cast<ptrdiff_t>(y * pool_stride_y) - center_offset_y;
+                for (size_t z = 0; z < output.size_z; z += T_chunk)
+                {
+                    auto result = chunk::load(input.at(request.batch, input_x, input_y, z));
+                    for (size_t pool_y = 0; pool_y < pool_size_y; ++pool_y)
+                        for (size_t pool_x = 0; pool_x < pool_size_x; ++pool_x)
+                            result = chunk::max(result, chunk::load(input.at(request.batch, input_x + pool_x, input_y + pool_y, z)));
+
+                    chunk::store(output.at(request.batch, x, y, z), result);
+                }
+            }
+    }
+
+    template <size_t T_chunk>
+    void pooling_i8::unpack_pooling_callback_handle(void *void_handle)
+    {
+        auto handle = reinterpret_cast<request_handle *>(void_handle);
+        handle->primitive->compute_rows<T_chunk>(*handle);
+    }
+
+    void pooling_i8::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
+    {
+        assert(inputs.size() == 1);
+        assert(outputs.size() == 1);
+
+        const z_block_u8_view input_view(inputs[0]);
+        const z_block_u8_view output_view(outputs[0]);
+
+        if (input_view.size_z != output_view.size_z)
+            throw std::invalid_argument("int8 pooling: number of input and output feature maps doesn't match");
+
+        // runs of maps contiguous in both input & output
+        const size_t chunk_size = std::min(input_view.block, output_view.block);
+
+        const size_t threads = device->thread_pool.get_num_threads();
+        const size_t row_splits = std::min(output_size_y, std::max<size_t>(1, (2 * threads + batch_size - 1) / batch_size));
+        const size_t rows_per_job = (output_size_y + row_splits - 1) / row_splits;
+
+        std::vector<request_handle> requests;
+        for (size_t n = 0; n < batch_size; ++n)
+            for (size_t row = 0; row < output_size_y; row += rows_per_job)
+                requests.push_back({this, &input_view, &output_view, n, row, std::min(row + rows_per_job, output_size_y)});
+
+        switch (chunk_size)
+        {
+        case 32: run_jobs(requests, unpack_pooling_callback_handle<32>); break;
+        case 16: run_jobs(requests, unpack_pooling_callback_handle<16>); break;
+        case 8:  run_jobs(requests, unpack_pooling_callback_handle<8>); break;
+        case 4:  run_jobs(requests, unpack_pooling_callback_handle<4>); break;
+        default: throw std::invalid_argument("int8 pooling: unsupported z block size");
+        }
+    }
+
+    size_t pooling_i8::get_required_input_w() { return (output_size_x - 1) * pool_stride_x + pool_size_x; }
+    size_t pooling_i8::get_required_input_h() { return (output_size_y - 1) * pool_stride_y + pool_size_y; }
+} // namespace int8_fixedpoint
@@ -60,13 +60,5 @@ namespace int16_fixedpoint {
         int8_t input_fraction;
         nn_device_internal *const device;
         const size_t num_features, batch_size;
-
-    private:
-        void run_softmax_int32_float_work_item_batch8(const nn::workload_data<int32_t> *input_view,
-            nn::workload_data<> *output_view);
-        void run_softmax_int32_float_work_item_batch8x(const nn::workload_data<int32_t> *input_view,
-            nn::workload_data<> *output_view, uint16_t NoBatch8);
-        void run_softmax_int32_float_work_item_latency(const nn::workload_data<int32_t> *input_view,
-            nn::workload_data<> *output_view);
     };
 } //namespace device_int16
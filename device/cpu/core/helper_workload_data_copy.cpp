@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "helper_workload_data_copy.h"
+
+#include <algorithm>
+
+namespace layer {
+
+namespace {
+// Copies smaller than this are done on calling thread, waking up workers would cost more than the copy.
+const uint64_t parallel_copy_min_size = 256 * 1024;
+
+// Minimal amount of data copied by single job.
+const uint64_t parallel_copy_job_size = 64 * 1024;
+} //namespace
+
+NN_DATA_STATUS workload_data_copy(nn_thread_worker_pool &thread_pool,
+                                  nn_workload_data_t *destination,
+                                  const nn_workload_data_t *source,
+                                  bool copy_delta)
+{
+    nn_workload_copy_plan_t plan;
+    auto status = nn_workload_copy_plan(&plan, destination, source, copy_delta);
+    if (status != NN_DATA_STATUS_OK)
+        return status;
+
+    const uint64_t size = plan.elements * plan.element_size;
+    // Copying is memory bound, so it is also run on hyperthread siblings when pool has them enabled.
+    const uint64_t job_count = std::min<uint64_t>({ static_cast<uint64_t>(thread_pool.get_num_threads_with_siblings()),
+                                                    plan.rows,
+                                                    size / parallel_copy_job_size });
+
+    if (size < parallel_copy_min_size || job_count < 2)
+    {
+        nn_workload_copy_rows(&plan, 0, plan.rows);
+    }
+    else
+    {
+        std::vector<nn_multithreaded_request> jobs(job_count);
+        for (uint64_t job = 0; job < job_count; ++job)
+        {
+            const uint64_t row_begin = plan.rows * job / job_count;
+            const uint64_t row_end = plan.rows * (job + 1) / job_count;
+            jobs[job].callback = [&plan, row_begin, row_end](void *) { nn_workload_copy_rows(&plan, row_begin, row_end); };
+            jobs[job].request_handle = nullptr;
+        }
+        thread_pool.push_job_with_siblings(jobs);
+    }
+
+    destination->parent->tag = source->parent->tag;
+
+    return NN_DATA_STATUS_OK;
+}
+
+} //namespace layer
@@ -84,5 +84,41 @@ class primitive_zxyn_f32_base : public nn_primitive_t {
 
     nn_device_internal *const device;
 };
+
+// Single image of buffer seen as buffer of its own, with view of source restricted to it.
+// Kernels index input and output buffers with the same image number, so image of one can be
+// computed against buffer that holds just this image.
+struct image_of_buffer {
+    nn::workload_data<> buffer;
+    nn::workload_data<> view;
+
+    image_of_buffer(const nn::workload_data<> *source, uint32_t image)
+        : buffer(source->parent->tag,
+                 static_cast<float *>(source->parent->data_buffer) +
+                     static_cast<size_t>(source->view_begin.t[NN_DATA_COORD_n] + image) *
+                     source->parent->lengths.t[NN_DATA_COORD_x] *
+                     source->parent->lengths.t[NN_DATA_COORD_y] *
+                     source->parent->lengths.t[NN_DATA_COORD_z],
+                 nn_workload_data_coords_t(1,
+                                           source->parent->lengths.t[NN_DATA_COORD_x],
+                                           source->parent->lengths.t[NN_DATA_COORD_y],
+                                           source->parent->lengths.t[NN_DATA_COORD_z],
+                                           1,
+                                           1),
+                 source->parent->layout),
+          view(buffer,
+               nn_workload_data_coords_t(0,
+                                         source->view_begin.t[NN_DATA_COORD_x],
+                                         source->view_begin.t[NN_DATA_COORD_y],
+                                         source->view_begin.t[NN_DATA_COORD_z],
+                                         0,
+                                         0),
+               nn_workload_data_coords_t(0,
+                                         source->view_end.t[NN_DATA_COORD_x],
+                                         source->view_end.t[NN_DATA_COORD_y],
+                                         source->view_end.t[NN_DATA_COORD_z],
+                                         0,
+                                         0)) {}
+};
 }
 }
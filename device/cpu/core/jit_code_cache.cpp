@@ -0,0 +1,238 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of Intel Corporation nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "jit_code_cache.h"
+#include "xbyak/xbyak_util.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const char C_magic[8] = {'N', 'N', 'J', 'I', 'T', 'C', '0', '1'};
+const uint64_t C_code_alignment = 64;
+
+// file: header, table of entries with keys, code of entries aligned to C_code_alignment
+struct file_header
+{
+    char magic[8];
+    uint64_t cpu_features;
+    uint64_t entries;
+};
+
+struct entry_header
+{
+    uint64_t key_size;
+    uint64_t code_size;
+    uint64_t code_offset; // from beginning of file
+};
+
+// instruction set extensions which generated code may depend on
+uint64_t cpu_features()
+{
+    static const uint64_t features = []() {
+        using Xbyak::util::Cpu;
+        Cpu cpu;
+        uint64_t result = 0;
+        for (auto type : {Cpu::tAVX, Cpu::tFMA, Cpu::tAVX2, Cpu::tF16C, Cpu::tBMI2})
+            if (cpu.has(type))
+                result |= type;
+        return result;
+    }();
+    return features;
+}
+
+uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} //namespace
+
+jit_code_cache::~jit_code_cache()
+{
+#ifdef __linux__
+    for (auto &mapping : mappings)
+        munmap(mapping.first, mapping.second);
+#endif
+}
+
+void jit_code_cache::set_path(const std::string &new_path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (new_path == path)
+        return;
+    path = new_path;
+    loaded = false;
+    entries.clear();
+    pending.clear();
+}
+
+std::string jit_code_cache::get_path()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+void jit_code_cache::load()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path.empty() or loaded)
+        return;
+    map_file();
+    loaded = true;
+}
+
+void jit_code_cache::map_file()
+{
+    entries.clear();
+#ifdef __linux__
+    auto file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+
+    struct stat file_stat;
+    void *data = MAP_FAILED;
+    if (fstat(file, &file_stat) == 0 and static_cast<uint64_t>(file_stat.st_size) >= sizeof(file_header))
+        data = mmap(nullptr, file_stat.st_size, PROT_READ | PROT_EXEC, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+        return;
+
+    const uint64_t size = file_stat.st_size;
+    auto bytes = static_cast<const char *>(data);
+    auto header = reinterpret_cast<const file_header *>(bytes);
+    if (std::memcmp(header->magic, C_magic, sizeof(C_magic)) != 0 or header->cpu_features != cpu_features())
+    {
+        munmap(data, size);
+        return;
+    }
+
+    std::map<std::string, std::pair<const void *, size_t>> file_entries;
+    uint64_t offset = sizeof(file_header);
+    for (auto i = 0u; i < header->entries; ++i)
+    {
+        if (offset + sizeof(entry_header) > size)
+            break;
+        auto entry = reinterpret_cast<const entry_header *>(bytes + offset);
+        offset += sizeof(entry_header);
+        if (entry->key_size > size - offset or entry->code_offset > size or entry->code_size > size - entry->code_offset)
+            break;
+        file_entries[std::string(bytes + offset, entry->key_size)] =
+            std::make_pair(static_cast<const void *>(bytes + entry->code_offset), entry->code_size);
+        offset += entry->key_size;
+    }
+    if (file_entries.size() != header->entries)
+    {
+        // truncated or damaged file is ignored
+        munmap(data, size);
+        return;
+    }
+
+    mappings.push_back(std::make_pair(data, size));
+    entries.swap(file_entries);
+#endif
+}
+
+void jit_code_cache::save()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path.empty() or pending.empty())
+        return;
+
+#ifdef __linux__
+    std::map<std::string, std::pair<const void *, size_t>> all_entries(entries);
+    for (auto &entry : pending)
+        all_entries[entry.first] = std::make_pair(static_cast<const void *>(entry.second.data()), entry.second.size());
+
+    uint64_t table_size = sizeof(file_header);
+    for (auto &entry : all_entries)
+        table_size += sizeof(entry_header) + entry.first.size();
+
+    std::vector<char> file_data(align_up(table_size, C_code_alignment));
+    file_header header;
+    std::memcpy(header.magic, C_magic, sizeof(C_magic));
+    header.cpu_features = cpu_features();
+    header.entries = all_entries.size();
+    std::memcpy(file_data.data(), &header, sizeof(header));
+
+    uint64_t offset = sizeof(file_header);
+    for (auto &entry : all_entries)
+    {
+        entry_header descriptor = {entry.first.size(), entry.second.second, file_data.size()};
+        std::memcpy(file_data.data() + offset, &descriptor, sizeof(descriptor));
+        offset += sizeof(descriptor);
+        std::memcpy(file_data.data() + offset, entry.first.data(), entry.first.size());
+        offset += entry.first.size();
+
+        auto code = static_cast<const char *>(entry.second.first);
+        file_data.insert(file_data.end(), code, code + entry.second.second);
+        file_data.resize(align_up(file_data.size(), C_code_alignment));
+    }
+
+    // file is replaced atomically, so other processes never map partially written one
+    const auto temporary_path = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write(file_data.data(), file_data.size());
+        if (not file)
+        {
+            std::remove(temporary_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+        return;
+    }
+
+    map_file();
+    pending.clear();
+#endif
+}
+
+const void *jit_code_cache::find(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto entry = entries.find(key);
+    return (entry == entries.end()) ? nullptr : entry->second.first;
+}
+
+void jit_code_cache::insert(const std::string &key, const void *code, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path.empty() or entries.count(key) != 0)
+        return;
+    auto bytes = static_cast<const uint8_t *>(code);
+    pending[key].assign(bytes, bytes + size);
+}
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of Intel Corporation nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Cache of JIT generated code shared between processes through a file.
+   File is mapped as executable memory when loaded, so cached kernels are used without generation and copying.
+   Only position independent code (without absolute addresses) may be cached. File made on CPU with different
+   instruction set extensions is ignored and overwritten by next save. Cache is disabled until path is set. */
+class jit_code_cache
+{
+public:
+    jit_code_cache() : loaded(false) {}
+    ~jit_code_cache();
+
+    // sets file used by cache, empty path disables cache; file is read by next load
+    void set_path(const std::string &path);
+    std::string get_path();
+
+    // maps file (once per path), called when workload is compiled
+    void load();
+
+    // writes file with loaded and newly generated entries if any entry was added since load
+    void save();
+
+    // returns code for key or nullptr if it is not cached
+    const void *find(const std::string &key);
+
+    // adds copy of generated code to be written by next save
+    void insert(const std::string &key, const void *code, size_t size);
+
+private:
+    jit_code_cache(const jit_code_cache &) = delete;
+    jit_code_cache &operator=(const jit_code_cache &) = delete;
+
+    void map_file();
+
+    std::mutex mutex;
+    std::string path;
+    bool loaded;
+    std::map<std::string, std::pair<const void *, size_t>> entries;
+    std::map<std::string, std::vector<uint8_t>> pending;
+    // all mappings are kept until cache is destroyed, since kernels may still use code from older ones
+    std::vector<std::pair<void *, size_t>> mappings;
+};
+
+typedef void (*jit_code_entry)(void *);
+
+/* Returns entry point of code made by generator T_code constructed from arguments. Code is taken from cache when
+   it holds entry for name and arguments, otherwise it is generated, owned by 'generated' and added to cache.
+   Name should be changed whenever generator starts to emit different code for the same arguments. */
+template <typename T_code, typename... T_args>
+jit_code_entry jit_cached_code(jit_code_cache *cache, std::unique_ptr<T_code> &generated, const char *name, T_args... args)
+{
+    std::string key = name;
+    for (auto arg : {static_cast<uint64_t>(args)...})
+        key += "," + std::to_string(arg);
+
+    if (cache)
+        if (auto code = cache->find(key))
+            return reinterpret_cast<jit_code_entry>(const_cast<void *>(code));
+
+    generated.reset(new T_code(args...));
+    if (cache)
+        cache->insert(key, generated->getCode(), generated->getSize());
+    return reinterpret_cast<jit_code_entry>(const_cast<uint8_t *>(generated->getCode()));
+}
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <algorithm>
 #include "convolution_jit.h"
+#include "jit_code_cache.h"
 #include "device/common/nn_allocate.h"
 #include "xbyak/xbyak.h"
 #undef max
@@ -171,65 +172,83 @@ struct jit_convolution_zxyn : public jit_convolution
             mov(bias,   ptr [nn_jit_param_reg + offsetof(op_data_t, bias)]);
             prepare_input_ptr();
 
-            mov(left_out_rows, output_height);
-            L("output_row");
+            if (output_width / 6 > 0)
             {
-                mov(aux_input_outer, input);
-                mov(aux_output, output);
-
-                mov(left_out_blocks, output_width / 6);
-                L("output_block");
+                mov(left_out_rows, output_height);
+                L("output_row");
                 {
-                    generate_for_single_output_block("horizontal_full", 6, false);
+                    mov(aux_input_outer, input);
+                    mov(aux_output, output);
 
-                    add(aux_output, 6 * output_feats * sizeof(float));
-                    add(aux_input_outer, 6 * input_feats * stride_x * sizeof(float));
-                }
-                dec(left_out_blocks);
-                jnz("output_block");
+                    mov(left_out_blocks, output_width / 6);
+                    L("output_block");
+                    {
+                        generate_for_single_output_block("horizontal_full", 6, false);
 
-                add(input, input_feats * input_width * stride_y * sizeof(float));
-                add(output, output_feats * output_width * sizeof(float));
+                        add(aux_output, 6 * output_feats * sizeof(float));
+                        add(aux_input_outer, 6 * input_feats * stride_x * sizeof(float));
+                    }
+                    dec(left_out_blocks);
+                    jnz("output_block");
 
+                    add(input, input_feats * input_width * stride_y * sizeof(float));
+                    add(output, output_feats * output_width * sizeof(float));
+
+                }
+                dec(left_out_rows);
+                jnz("output_row");
             }
-            dec(left_out_rows);
-            jnz("output_row");
 
+            // columns left after horizontal blocks: vertical blocks of 6 rows, then single row leftovers
+            const auto first_partial_column = output_width / 6 * 6;
+            if (first_partial_column == output_width)
+            {
+                postamble();
+                return;
+            }
             mov(output, ptr [nn_jit_param_reg + offsetof(op_data_t, output)]);
             prepare_input_ptr();
             for (auto i = 0u; i < output_height / 6; ++i)
             {
-                mov(aux_input_outer, input);
-                mov(aux_output, output);
-                add(aux_output, (i * output_width + output_width / 6) * 6 * output_feats * sizeof(float));
-                add(aux_input_outer, (i * input_width * stride_y + output_width / 6 * stride_x) * 6 * input_feats * sizeof(float));
-                for (auto j = 0u; j < output_height % 6; ++j)
+                for (auto j = first_partial_column; j < output_width; ++j)
                 {
-                    generate_for_single_output_block("vertical_full_" + std::to_string(i), 6, true);
-                    add(aux_output, output_feats * sizeof(float));
+                    mov(aux_input_outer, input);
+                    mov(aux_output, output);
+                    add(aux_output, (i * 6 * output_width + j) * output_feats * sizeof(float));
+                    add(aux_input_outer, (i * 6 * input_width * stride_y + j * stride_x) * input_feats * sizeof(float));
+                    generate_for_single_output_block("vertical_full_" + std::to_string(i) + "_" + std::to_string(j), 6, true);
                 }
             }
             for (auto i = output_height / 6 * 6; i < output_height; ++i)
             {
                 mov(aux_input_outer, input);
                 mov(aux_output, output);
-                add(aux_output, (i * output_width + output_width / 6 * 6) * output_feats * sizeof(float));
-                add(aux_input_outer, (i * input_width * stride_y + output_width / 6 * stride_x * 6) * input_feats * sizeof(float));
-                generate_for_single_output_block("horizontal_partial", output_width % 6, false);
+                add(aux_output, (i * output_width + first_partial_column) * output_feats * sizeof(float));
+                add(aux_input_outer, (i * input_width * stride_y + first_partial_column * stride_x) * input_feats * sizeof(float));
+                generate_for_single_output_block("horizontal_partial_" + std::to_string(i), output_width % 6, false);
             }
 
             postamble();
         }
     };
 
-    std::vector<op_data_t> op_data;
-    jit_code code;
+    // offsets in bytes of buffers given to execute
+    struct op_offsets_t
+    {
+        uint64_t output;
+        uint64_t input;
+        uint64_t filter;
+        uint64_t bias;
+    };
+
+    std::vector<op_offsets_t> op_offsets;
+    std::unique_ptr<jit_code> generated_code;   // empty if code was taken from cache
+    jit_code_entry code;
 
     jit_convolution_zxyn(
         uint64_t batch,
         bool apply_relu,
-        
-        float*   output,
+
         uint64_t output_width,
         uint64_t output_height,
         uint64_t output_feature_maps,
@@ -241,16 +260,15 @@ struct jit_convolution_zxyn : public jit_convolution
         uint64_t stride_width,
         uint64_t stride_height,
 
-        float *  filter,
         uint64_t filter_width,
         uint64_t filter_height,
-        
-        float*   bias)
-            : code(output_width, output_height, output_feature_maps,
-                   input_width, input_feature_maps,
-                   filter_height, filter_width,
-                   stride_width, stride_height,
-                   apply_relu)
+        jit_code_cache* code_cache = nullptr)
+            : code(jit_cached_code(code_cache, generated_code, "jit_convolution_zxyn/2",
+                                   output_width, output_height, output_feature_maps,
+                                   input_width, input_feature_maps,
+                                   filter_height, filter_width,
+                                   stride_width, stride_height,
+                                   apply_relu))
     {
         assert(output_feature_maps % output_features_per_iteration == 0);
 
@@ -262,18 +280,18 @@ struct jit_convolution_zxyn : public jit_convolution
             {
                 for (auto b = bblock * batch_block_size; b < (bblock + 1) * batch_block_size; ++b)
                 {
-                    auto output_shifted = output
-                        + b * output_width * output_height * output_feature_maps
+                    auto output_shifted =
+                        b * output_width * output_height * output_feature_maps
                         + z_block * output_features_per_iteration;
-                    auto bias_shifted = bias + z_block * output_features_per_iteration;
-                    auto filter_shifted = filter
-                        + z_block * output_features_per_iteration * input_feature_maps * filter_width * filter_height;
+                    auto bias_shifted = z_block * output_features_per_iteration;
+                    auto filter_shifted =
+                        z_block * output_features_per_iteration * input_feature_maps * filter_width * filter_height;
                     auto input_shifted = b * input_width * input_height * input_feature_maps;
 
-                    op_data.push_back({ output_shifted,
+                    op_offsets.push_back({ output_shifted * sizeof(float),
                         input_shifted * sizeof(float),
-                        filter_shifted,
-                        bias_shifted });
+                        filter_shifted * sizeof(float),
+                        bias_shifted * sizeof(float) });
                 }
             }
         }
@@ -281,25 +299,39 @@ struct jit_convolution_zxyn : public jit_convolution
         {
             for (auto b = batch / batch_block_size * batch_block_size; b < batch; ++b)
             {
-                auto output_shifted = output
-                    + b * output_width * output_height * output_feature_maps
+                auto output_shifted =
+                    b * output_width * output_height * output_feature_maps
                     + z_block * output_features_per_iteration;
-                auto bias_shifted = bias + z_block * output_features_per_iteration;
-                auto filter_shifted = filter
-                    + z_block * output_features_per_iteration * input_feature_maps * filter_width * filter_height;
+                auto bias_shifted = z_block * output_features_per_iteration;
+                auto filter_shifted =
+                    z_block * output_features_per_iteration * input_feature_maps * filter_width * filter_height;
                 auto input_shifted = b * input_width * input_height * input_feature_maps;
 
-                op_data.push_back({ output_shifted,
+                op_offsets.push_back({ output_shifted * sizeof(float),
                     input_shifted * sizeof(float),
-                    filter_shifted,
-                    bias_shifted });
+                    filter_shifted * sizeof(float),
+                    bias_shifted * sizeof(float) });
             }
         }
+    }
 
-        jobs.resize(1);
-        jobs[0].resize(op_data.size());
-        for (auto i = 0u; i < jobs[0].size(); ++i)
-            jobs[0][i] = {reinterpret_cast<void(*)(void*)>(code.getCode()), &op_data[i]};
+    void execute(nn_thread_worker_pool& thread_pool, float* output, float* input, float* filter, float* bias) const override
+    {
+        auto base = [](float* buffer, uint64_t offset) {
+                return reinterpret_cast<float*>(reinterpret_cast<char*>(buffer) + offset);
+            };
+        std::vector<op_data_t> op_data(op_offsets.size());
+        std::vector<nn_multithreaded_request> jobs(op_offsets.size());
+        for (auto i = 0u; i < op_offsets.size(); ++i)
+        {
+            op_data[i] = { base(output, op_offsets[i].output),
+                           op_offsets[i].input,
+                           base(filter, op_offsets[i].filter),
+                           base(bias, op_offsets[i].bias),
+                           input };
+            jobs[i] = {code, &op_data[i]};
+        }
+        thread_pool.push_job(jobs);
     }
 };
 
@@ -8,15 +8,34 @@
 #include <cstdlib>
 #include <iostream>
 #include <algorithm>
+#include <mutex>
 #include "convolution_jit.h"
+#include "jit_code_cache.h"
 #include "device/common/nn_allocate.h"
 #include "xbyak/xbyak.h"
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 // job set of jit convolutions ////////////////////////////////////////////////
 
 namespace detail
 {
 
+// size of L2 cache in bytes, 256KB when it cannot be queried
+inline uint64_t l2_cache_size()
+{
+    static const uint64_t size = []() -> uint64_t {
+#ifdef __linux__
+        auto result = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (result > 0)
+            return static_cast<uint64_t>(result);
+#endif
+        return 256 * 1024;
+    }();
+    return size;
+}
+
 struct FinishJob
 {
     float* output_dest;
@@ -32,6 +51,14 @@ inline void finish_with_relu(void* ptr)
 
     auto job = static_cast<FinishJob*>(ptr);
     auto dest = job->output_dest;
+    auto zero = _mm256_setzero_ps();
+    if (job->outputs.empty())
+    {
+        for (auto i = 0u; i < job->ofeats * registers_in_batch; ++i)
+            _mm256_store_ps(dest + i * register_width_in_float,
+                            _mm256_max_ps(_mm256_load_ps(dest + i * register_width_in_float), zero));
+        return;
+    }
     for (auto j = 0u; j < job->outputs.size() - 1; ++j)
     {
         auto curr_src = job->outputs[j];
@@ -50,7 +77,6 @@ inline void finish_with_relu(void* ptr)
     }
     auto curr_src = job->outputs[job->outputs.size() - 1];
     auto curr_dest = dest;
-    auto zero = _mm256_setzero_ps();
     for (auto i = 0u; i < job->ofeats; ++i)
     {
         for (auto j = 0u; j < registers_in_batch; ++j)
@@ -96,12 +122,13 @@ inline void finish_without_relu(void* ptr)
 struct jit_convolution_generic : public jit_convolution
 {
 #pragma pack(push, 1)
+    // offsets in bytes from buffers of op_array_t
     struct op_data_t
     {
-        float *output;
-        float *input;
-        float *filter;
-        float *bias;
+        uint64_t output;
+        uint64_t input;
+        uint64_t filter;
+        uint64_t bias;
         int8_t type; // 0:init, 1:normal, 2:finalize
     };
 
@@ -109,6 +136,10 @@ struct jit_convolution_generic : public jit_convolution
     {
         uint64_t count; 
         op_data_t *array;
+        float *output;
+        float *input;
+        float *filter;
+        float *bias;
     };
 #pragma pack(pop)
 
@@ -275,6 +306,10 @@ struct jit_convolution_generic : public jit_convolution
                 mov(input,  ptr [job + offsetof(op_data_t, input)]);
                 mov(filter, ptr [job + offsetof(op_data_t, filter)]);
                 mov(bias,   ptr [job + offsetof(op_data_t, bias)]);
+                add(output, ptr [nn_jit_param_reg + offsetof(op_array_t, output)]);
+                add(input,  ptr [nn_jit_param_reg + offsetof(op_array_t, input)]);
+                add(filter, ptr [nn_jit_param_reg + offsetof(op_array_t, filter)]);
+                add(bias,   ptr [nn_jit_param_reg + offsetof(op_array_t, bias)]);
 
                 if (generate_load_and_store
                     and generate_bias_and_store
@@ -325,16 +360,85 @@ struct jit_convolution_generic : public jit_convolution
         };
     };
 
+    struct finish_part_t
+    {
+        uint64_t offset;
+        uint64_t ofeats;
+    };
+
     std::vector<std::vector<op_data_t>> op_data;
     std::vector<op_array_t> op_array;
-    jit_code code;
+    std::vector<jit_code_entry> op_code;
+    std::vector<uint64_t> op_column;    // buffer with partial sums: 0 is output, others are auxiliary
+    uint64_t aux_buffers = 0;
+    uint64_t aux_buffer_size = 0;
+
+    // sets of auxiliary partial sums buffers reused by calls of execute, each running call holds its own set
+    typedef std::vector<std::unique_ptr<float, decltype(&nn_delete_aligned)>> aux_set_t;
+    mutable std::mutex aux_mutex;
+    mutable std::vector<aux_set_t> free_aux_sets;
+
+    // takes free set of auxiliary buffers (allocating it only if all are in use) and gives it back at end of scope
+    class aux_set_lease
+    {
+        const jit_convolution_generic& owner;
+        aux_set_t set;
+
+        aux_set_lease(const aux_set_lease&) = delete;
+        aux_set_lease& operator=(const aux_set_lease&) = delete;
+
+    public:
+        explicit aux_set_lease(const jit_convolution_generic& owner)
+            : owner(owner)
+        {
+            if (owner.aux_buffers == 0)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(owner.aux_mutex);
+                if (!owner.free_aux_sets.empty())
+                {
+                    set = std::move(owner.free_aux_sets.back());
+                    owner.free_aux_sets.pop_back();
+                }
+            }
+            if (set.empty())
+                set = owner.allocate_aux_set();
+        }
+
+        ~aux_set_lease()
+        {
+            if (set.empty())
+                return;
+            std::lock_guard<std::mutex> lock(owner.aux_mutex);
+            owner.free_aux_sets.push_back(std::move(set));
+        }
+
+        float* operator[](size_t index) const
+        {
+            return set[index].get();
+        }
+    };
+
+    // throws std::bad_alloc if any buffer can't be allocated
+    aux_set_t allocate_aux_set() const
+    {
+        aux_set_t set;
+        for (auto i = 0u; i < aux_buffers; ++i)
+            set.push_back(nn_make_unique_aligned<float>(aux_buffer_size / sizeof(float)));
+        return set;
+    }
+    std::vector<finish_part_t> finish_parts;
+    bool finish_with_relu = false;
+    std::unique_ptr<jit_code> generated_code;       // empty if code was taken from cache
+    std::unique_ptr<jit_code> generated_code_bias;
+    jit_code_entry code = nullptr;
+    jit_code_entry code_bias = nullptr;
 
     jit_convolution_generic(
         uint64_t batch_iterations,
         bool apply_relu,
         uint64_t num_of_threads,
-        
-        float*   output,
+
         uint64_t full_output_width,
         uint64_t full_output_height,
         uint64_t full_output_feature_maps,
@@ -343,7 +447,6 @@ struct jit_convolution_generic : public jit_convolution
         uint64_t output_feature_maps,
         uint64_t output_begin_z,
 
-        float*   input,
         uint64_t full_input_width,
         uint64_t full_input_height,
         uint64_t full_input_feature_maps,
@@ -355,38 +458,34 @@ struct jit_convolution_generic : public jit_convolution
         uint64_t stride_width,
         uint64_t stride_height,
 
-        float *  filter,
         uint64_t filter_width,
         uint64_t filter_height,
         uint64_t filter_offset_x,
         uint64_t filter_offset_y,
-        
-        float*   bias,
 
         uint64_t block_width,
-        uint64_t block_height)
-            : code(input_feature_maps, output_feature_maps)
-            , code_bias(input_feature_maps, output_feature_maps)
+        uint64_t block_height,
+        jit_code_cache* code_cache = nullptr)
     {
+        code = jit_cached_code(code_cache, generated_code, "jit_convolution_generic/1",
+                               input_feature_maps, output_feature_maps, true, true, true, false, false);
+
         assert(input_feature_maps%input_features_per_iteration==0 && "input feature map count is not a multiple of features-per-iteration");
         assert(output_feature_maps%output_features_per_iteration==0 && "output feature map count is not a multiple of features-per-iteration");
 
         auto get_output_block = [&](uint64_t b, uint64_t x, uint64_t y) {
-                return output
-                    + (((b * full_output_height + y) * full_output_width + x)
-                        * full_output_feature_maps + output_begin_z) * BATCH_ACCEPTED_BLOCK;
+                return (((b * full_output_height + y) * full_output_width + x)
+                        * full_output_feature_maps + output_begin_z) * BATCH_ACCEPTED_BLOCK * sizeof(float);
             };
         auto get_input_block = [&](uint64_t b, uint64_t x, uint64_t y) {
-                return input
-                    + (((b * full_input_height + y) * full_input_width + x)
-                        * full_input_feature_maps + input_begin_z) * BATCH_ACCEPTED_BLOCK;
+                return (((b * full_input_height + y) * full_input_width + x)
+                        * full_input_feature_maps + input_begin_z) * BATCH_ACCEPTED_BLOCK * sizeof(float);
             };
         auto get_filter_block = [&](uint64_t x, uint64_t y) {
                 auto output_feature_maps_in_filter =
                     ((output_feature_maps + output_features_per_iteration - 1)
                         / output_features_per_iteration) * output_features_per_iteration;
-                return filter
-                    + (y * filter_width + x) * output_feature_maps_in_filter * input_feature_maps; 
+                return (y * filter_width + x) * output_feature_maps_in_filter * input_feature_maps * sizeof(float);
             };
 
         typedef std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t> JobDescription;
@@ -445,7 +544,7 @@ struct jit_convolution_generic : public jit_convolution
                                    curr_output,
                                    curr_input,
                                    curr_weights,
-                                   bias,
+                                   0,
                                    1
                                 };
                             ++num_of_jobs;
@@ -466,9 +565,9 @@ struct jit_convolution_generic : public jit_convolution
 
         op_data.resize(jobs_per_thread.size());
         op_array.resize(jobs_per_thread.size());
-        jobs.resize(1);
-        jobs[0].resize(op_array.size());
-        for (auto i = 0u; i < jobs[0].size(); ++i)
+        op_code.resize(jobs_per_thread.size(), code);
+        op_column.resize(jobs_per_thread.size(), 0);
+        for (auto i = 0u; i < op_array.size(); ++i)
         {
             {
                 std::set<std::tuple<uint64_t, uint64_t, uint64_t>> outputs;
@@ -494,33 +593,27 @@ struct jit_convolution_generic : public jit_convolution
 
             for (auto& job : jobs_per_thread[i])
                 op_data[i].push_back(job.second);
-            op_array[i] = {op_data[i].size(), &op_data[i].front()};
-            jobs[0][i] = {reinterpret_cast<void(*)(void*)>(code.getCode()), &op_array[i]};
+            op_array[i] = {op_data[i].size(), &op_data[i].front(), nullptr, nullptr, nullptr, nullptr};
         }
     }
 
-    std::vector<float*> aux_buffer;
-
-    jit_code code_bias;
-
-    std::vector<detail::FinishJob> finish_data;
-
     //fully connected version
     jit_convolution_generic(
         uint64_t batch_iterations,
         bool apply_relu,
         uint64_t num_of_threads,
-        float*   output, uint64_t output_feature_maps,
-        float*   input, uint64_t input_feature_maps,
-        float *  filter,
-        float*   bias,
+        uint64_t output_feature_maps,
+        uint64_t input_feature_maps,
+        float *  filter, // converted in place to layout of blocks
         uint64_t input_feats_in_block,
-        uint64_t output_feats_in_block)
-            : code(input_feats_in_block, output_feats_in_block,
-                false, true, false, false, true)
-            , code_bias(input_feats_in_block, output_feats_in_block,
-                true, true, false, false, false)
+        uint64_t output_feats_in_block,
+        jit_code_cache* code_cache = nullptr)
     {
+        code = jit_cached_code(code_cache, generated_code, "jit_convolution_generic/1",
+                               input_feats_in_block, output_feats_in_block, false, true, false, false, true);
+        code_bias = jit_cached_code(code_cache, generated_code_bias, "jit_convolution_generic/1",
+                                    input_feats_in_block, output_feats_in_block, true, true, false, false, false);
+
         if (output_feature_maps % output_feats_in_block != 0)
             throw std::runtime_error("output_feature_maps % output_feats_in_block != 0");
         if (input_feature_maps % input_feats_in_block != 0)
@@ -566,21 +659,31 @@ struct jit_convolution_generic : public jit_convolution
             std::memcpy(filter, &converted_weights.front(), converted_weights.size() * sizeof(float));
         }
 
-        auto threads_cols = 4;
-        auto threads_rows = 9;
-        if (output_feature_maps == 1000)
-            threads_cols = 2;
+        // thread grid: rows split output feature blocks, columns split input feature blocks;
+        // every column but the first one needs partial sums buffer and reduction, so input feature
+        // blocks are split only when there is not enough output feature blocks for all threads
+        auto ceil_div = [](uint64_t arg, uint64_t div) { return (arg + div - 1) / div; };
+        num_of_threads = std::max<uint64_t>(num_of_threads, 1u);
+
+        // partial sums of a row are reloaded for every input block, so they should fit in half of L2
+        const auto outblock_sums_size = output_feats_in_block * batch_size * batch_iterations * sizeof(float);
+        const auto outblocks_in_cache = std::max<uint64_t>(detail::l2_cache_size() / 2 / outblock_sums_size, 1u);
+
+        auto threads_rows = std::max(std::min<uint64_t>(outfeats_blocks, num_of_threads),
+                                     ceil_div(outfeats_blocks, outblocks_in_cache));
+        const auto outblocks_per_thread = ceil_div(outfeats_blocks, threads_rows);
+        threads_rows = ceil_div(outfeats_blocks, outblocks_per_thread);
+
+        auto threads_cols = std::max<uint64_t>(std::min<uint64_t>(infeats_blocks, num_of_threads / threads_rows), 1u);
+        const auto inblocks_per_thread = ceil_div(infeats_blocks, threads_cols);
+        threads_cols = ceil_div(infeats_blocks, inblocks_per_thread);
 
-        const auto outblocks_per_thread = (outfeats_blocks + threads_rows - 1) / threads_rows;
-        const auto inblocks_per_thread = (infeats_blocks + threads_cols - 1) / threads_cols;
-        
-        const auto output_buffer_size =
+        aux_buffers = threads_cols - 1;
+        aux_buffer_size =
             output_feature_maps
             * batch_size * batch_iterations * sizeof(float);
-        aux_buffer.push_back(output);
-        for (auto i = 1u; i < threads_cols; ++i)
-            aux_buffer.push_back(
-                static_cast<float*>(nn_allocate_aligned(output_buffer_size)));
+        if (aux_buffers != 0)
+            free_aux_sets.push_back(allocate_aux_set());
 
         op_data.resize(threads_cols * threads_rows);
         for (auto iblock = 0u; iblock < infeats_blocks; ++iblock)
@@ -594,61 +697,76 @@ struct jit_convolution_generic : public jit_convolution
                         oblock / outblocks_per_thread * threads_cols
                         + infeats_thread_col;
                     op_data_t job = {
-                        aux_buffer[infeats_thread_col]
-                            + (b * outfeats_blocks + oblock) * output_feats_in_block * batch_size,
-                        input
-                            + b * input_feature_maps * batch_size
-                            + iblock * input_feats_in_block * batch_size,
-                        filter
-                            + (iblock * outfeats_blocks + oblock)
-                            * output_feats_in_block * input_feats_in_block,
-                        bias + oblock * output_feats_in_block,
+                        (b * outfeats_blocks + oblock) * output_feats_in_block * batch_size * sizeof(float),
+                        (b * input_feature_maps * batch_size
+                            + iblock * input_feats_in_block * batch_size) * sizeof(float),
+                        (iblock * outfeats_blocks + oblock)
+                            * output_feats_in_block * input_feats_in_block * sizeof(float),
+                        oblock * output_feats_in_block * sizeof(float),
                         ((iblock % inblocks_per_thread == 0) ? '\0' : '\1')};
 
                     op_data[index].push_back(job);
                 }
             }
         }
-        op_array.resize(op_data.size());
-        jobs.resize(2);
-        jobs[0].resize(op_array.size());
         for (auto i = 0u; i < op_data.size(); ++i)
         {
-            op_array[i] = {op_data[i].size(), &op_data[i].front()};
-
-            auto func = reinterpret_cast<void(*)(void*)>(
-                (i % threads_cols == 0) ? code_bias.getCode() : code.getCode());
-            jobs[0][i] = {func, &op_array[i] };
+            if (op_data[i].empty())
+                continue;
+            op_array.push_back({op_data[i].size(), &op_data[i].front(), nullptr, nullptr, nullptr, nullptr});
+            op_code.push_back((i % threads_cols == 0) ? code_bias : code);
+            op_column.push_back(i % threads_cols);
         }
 
-        num_of_threads = 6;
-        finish_data.resize(batch_iterations * num_of_threads);
-        jobs[1].resize(batch_iterations * num_of_threads);
-        auto outputs_per_thread =
-            (output_feature_maps + num_of_threads - 1) / num_of_threads;
+        // reduction of partial sums and activation, split between all threads
+        if (threads_cols == 1 and not apply_relu)
+            return;
 
+        const auto finish_parts_count = std::min<uint64_t>(ceil_div(num_of_threads, batch_iterations), output_feature_maps);
+        const auto outputs_per_part = ceil_div(output_feature_maps, finish_parts_count);
+        finish_with_relu = apply_relu;
         for (auto b = 0u; b < batch_iterations; ++b)
+            for (auto i = 0u; i * outputs_per_part < output_feature_maps; ++i)
+                finish_parts.push_back({
+                    b * output_feature_maps * batch_size + i * outputs_per_part * batch_size,
+                    std::min(outputs_per_part, output_feature_maps - i * outputs_per_part)});
+    }
+
+    void execute(nn_thread_worker_pool& thread_pool, float* output, float* input, float* filter, float* bias) const override
+    {
+        // partial sums of input feature columns other than the first one are private to this call,
+        // so the same kernel may run concurrently on different buffers
+        std::vector<float*> outputs(1, output);
+        aux_set_lease aux(*this);
+        for (auto i = 0u; i < aux_buffers; ++i)
+            outputs.push_back(aux[i]);
+
+        std::vector<op_array_t> arrays(op_array);
+        std::vector<nn_multithreaded_request> ops(arrays.size());
+        for (auto i = 0u; i < arrays.size(); ++i)
+        {
+            arrays[i].output = outputs[op_column[i]];
+            arrays[i].input = input;
+            arrays[i].filter = filter;
+            arrays[i].bias = bias;
+            ops[i] = {op_code[i], &arrays[i]};
+        }
+        thread_pool.push_job(ops);
+
+        if (not finish_parts.empty())
         {
-            for (auto i = 0u; i < num_of_threads; ++i)
+            std::vector<detail::FinishJob> finish_data(finish_parts.size());
+            std::vector<nn_multithreaded_request> finish_jobs(finish_parts.size());
+            for (auto i = 0u; i < finish_parts.size(); ++i)
             {
-                auto job = b * num_of_threads + i;
-                auto curr_offset = b * output_feature_maps * batch_size
-                    + i * outputs_per_thread * batch_size;
-                auto curr_outfeats = (i + 1) * outputs_per_thread;
-                if (curr_outfeats > output_feature_maps)
-                    curr_outfeats = output_feature_maps;
-                curr_outfeats -= i * outputs_per_thread;
-
-                finish_data[job].output_dest = output + curr_offset;
-                for (auto j = 1u; j < threads_cols; ++j)
-                    finish_data[job].outputs.push_back(aux_buffer[j] + curr_offset);
-                finish_data[job].ofeats = curr_outfeats;
-
-                if (apply_relu)
-                    jobs[1][job] = { detail::finish_with_relu, &finish_data[job] };
-                else
-                    jobs[1][job] = { detail::finish_without_relu, &finish_data[job] };
+                finish_data[i].output_dest = output + finish_parts[i].offset;
+                for (auto j = 1u; j < outputs.size(); ++j)
+                    finish_data[i].outputs.push_back(outputs[j] + finish_parts[i].offset);
+                finish_data[i].ofeats = finish_parts[i].ofeats;
+                finish_jobs[i] = {finish_with_relu ? detail::finish_with_relu : detail::finish_without_relu,
+                                  &finish_data[i]};
             }
+            thread_pool.push_job(finish_jobs);
         }
     }
 };
@@ -344,7 +344,7 @@ namespace layer
             }
             for (auto& j : job)
                 j.request_handle = input->parent->data_buffer;
-            device->thread_pool.push_job_on_physical_cores(job);
+            device->thread_pool.push_job(job);
             return;
         }
 
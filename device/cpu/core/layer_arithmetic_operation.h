@@ -80,6 +80,9 @@ class arithmetic_f32 : public helper_zxyn_f32::primitive_zxyn_f32_base {
                          const std::vector<const nn_workload_data_t *> &parameters,
                          const std::vector<nn_workload_data_t *> &outputs) override;
 
+    // Prepared job is bound to output & factor buffers and takes input through shared request handles.
+    bool forward_bound_to_prepared_buffers() const override { return not job.empty(); }
+
     std::vector<float> get_input_feat_periodic(const std::vector<const nn_workload_data_t *> &parameters) const;
     bool is_linear() const { return (arithmetic_function == NN_ARITHMETIC_FUNCTION_SUBTRACTION)
                                     or (arithmetic_function == NN_ARITHMETIC_FUNCTION_ADDITION); }
@@ -26,10 +26,54 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "layer_average_delta.h"
+#include "helper_workload_data_copy.h"
+
+#include <algorithm>
 
 namespace layer
 {
-    void run_average_delta(nn_workload_item *const item)
+    namespace
+    {
+        // Output elements averaged by single job.
+        const uint64_t average_job_size = 16 * 1024;
+
+        /* averages part [block_begin, block_end) of blocks
+           Coordinates preceding N in layout form blocks of block_size elements, same in input and output,
+           input holds batch such blocks for every block of output. */
+        void average_blocks(float *output, const float *input, uint64_t block_size, uint64_t batch, uint64_t block_begin, uint64_t block_end)
+        {
+            const float scale = 1.0f / static_cast<float>(batch);
+
+            if (block_size == 1)
+            {
+                // N is innermost coordinate - sum contiguous values.
+                for (auto block = block_begin; block < block_end; ++block)
+                {
+                    float acc = 0.0f;
+                    for (uint64_t n = 0; n < batch; ++n)
+                        acc += input[block * batch + n];
+                    output[block] = acc * scale;
+                }
+                return;
+            }
+
+            for (auto block = block_begin; block < block_end; ++block)
+            {
+                auto out = output + block * block_size;
+                auto in = input + block * block_size * batch;
+
+                for (uint64_t i = 0; i < block_size; ++i)
+                    out[i] = in[i];
+                for (uint64_t n = 1; n < batch; ++n)
+                    for (uint64_t i = 0; i < block_size; ++i)
+                        out[i] += in[n * block_size + i];
+                for (uint64_t i = 0; i < block_size; ++i)
+                    out[i] *= scale;
+            }
+        }
+    } //namespace
+
+    void run_average_delta(nn_workload_item *const item, nn_device_internal *device)
     {
         assert(item->input.size() == item->output.size());
 
@@ -42,24 +86,32 @@ namespace layer
             auto output_batch = output->parent->lengths.t[NN_DATA_COORD_n];
 
             if (input_batch == output_batch)
-                nn_workload_data_copy(output, input);
+                workload_data_copy(device->thread_pool, output, input);
             else
             {
-                for (uint32_t x = 0; x < output->parent->lengths.t[NN_DATA_COORD_x]; ++x)
-                    for (uint32_t y = 0; y < output->parent->lengths.t[NN_DATA_COORD_y]; ++y)
-                        for (uint32_t z = 0; z < output->parent->lengths.t[NN_DATA_COORD_z]; ++z)
-                            for (uint32_t p = 0; p < output->parent->lengths.t[NN_DATA_COORD_p]; ++p)
-                                for (uint32_t q = 0; q < output->parent->lengths.t[NN_DATA_COORD_q]; ++q)
-                                {
-                                    float acc = 0.0f;
-                                    for (uint32_t n = 0; n < input_batch; ++n)
-                                        acc += input->at(n, x, y, z, p, q);
-
-                                    acc /= static_cast<float>(input_batch);
-
-                                    (*output)(0, x, y, z, p, q) = acc;
-                                }
+                assert(output_batch == 1);
+                assert(memcmp(&input->parent->layout, &output->parent->layout, sizeof(nn_workload_data_layout_t)) == 0);
+
+                const uint64_t block_size = input->parent->strides[NN_DATA_COORD_n];
+                const uint64_t blocks = output->parent->buffer_size / sizeof(float) / block_size;
+                auto output_buffer = static_cast<float *>(output->parent->data_buffer);
+                auto input_buffer = static_cast<const float *>(input->parent->data_buffer);
+
+                const uint64_t job_count = std::max<uint64_t>(
+                    std::min<uint64_t>({ device->thread_pool.get_num_threads(), blocks, blocks * block_size / average_job_size }), 1);
+
+                std::vector<nn_multithreaded_request> jobs(job_count);
+                for (uint64_t job = 0; job < job_count; ++job)
+                {
+                    const uint64_t block_begin = blocks * job / job_count;
+                    const uint64_t block_end = blocks * (job + 1) / job_count;
+                    jobs[job].callback = [=](void *) {
+                        average_blocks(output_buffer, input_buffer, block_size, input_batch, block_begin, block_end);
+                    };
+                    jobs[job].request_handle = nullptr;
+                }
+                device->thread_pool.push_job(jobs);
             }
         }
     }
-}
\ No newline at end of file
+}
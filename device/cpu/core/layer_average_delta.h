@@ -31,5 +31,5 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace layer
 {
-    void run_average_delta(nn_workload_item *const work_item);
+    void run_average_delta(nn_workload_item *const work_item, nn_device_internal *device);
 }
\ No newline at end of file
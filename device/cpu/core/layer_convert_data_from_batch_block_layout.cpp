@@ -63,8 +63,8 @@ void convert_from_batch_block_format_to_zxyn::forward(
         assert(input->get_length(NN_DATA_COORD_y) == output->get_length(NN_DATA_COORD_y));
         assert(input->get_length(NN_DATA_COORD_x) == output->get_length(NN_DATA_COORD_x));
         assert(input->get_length(NN_DATA_COORD_z) == output->get_length(NN_DATA_COORD_z));
-        assert(input->get_length(NN_DATA_COORD_n) * input->get_length(NN_DATA_COORD_p)
-                == output->get_length(NN_DATA_COORD_n));
+        assert((output->get_length(NN_DATA_COORD_n) + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK
+                == input->get_length(NN_DATA_COORD_n));
         assert(input->get_length(NN_DATA_COORD_q) == 1);
         assert(output->get_length(NN_DATA_COORD_p) == 1);
         assert(output->get_length(NN_DATA_COORD_q) == 1);
@@ -85,18 +85,36 @@ void convert_from_batch_block_format_to_zxyn::forward(
 
         auto input_buffer = reinterpret_cast<float*>(input->parent->data_buffer);
         auto output_buffer = reinterpret_cast<float*>(output->parent->data_buffer);
+        const uint32_t batch = output->get_length(NN_DATA_COORD_n);
+
+        // batch interleaved output (nx): each value of block is followed by the same value of next pictures
+        if (output->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout)
+        {
+            for (uint32_t i = 0u; i < input->get_length(NN_DATA_COORD_n); ++i)
+            {
+                const uint32_t pics_in_block = std::min<uint32_t>(BATCH_ACCEPTED_BLOCK, batch - i * BATCH_ACCEPTED_BLOCK);
+                for (uint64_t j = 0u; j < pic_size; ++j)
+                    std::copy(input_buffer + j * BATCH_ACCEPTED_BLOCK,
+                              input_buffer + j * BATCH_ACCEPTED_BLOCK + pics_in_block,
+                              output_buffer + j * batch + i * BATCH_ACCEPTED_BLOCK);
+                input_buffer += pic_size * BATCH_ACCEPTED_BLOCK;
+            }
+            continue;
+        }
         for (uint32_t i = 0u; i < input->get_length(NN_DATA_COORD_n); ++i)
         {
+            // padding pictures of last block are not copied out
+            const uint32_t pics_in_block = std::min<uint32_t>(BATCH_ACCEPTED_BLOCK, batch - i * BATCH_ACCEPTED_BLOCK);
             for (uint32_t j = 0u; j < pic_size / 8; ++j)
             {
-                for (uint32_t b = 0u; b < BATCH_ACCEPTED_BLOCK; ++b)
+                for (uint32_t b = 0u; b < pics_in_block; ++b)
                 {
                     auto acc = _mm256_i32gather_ps(input_buffer + j * 8 * BATCH_ACCEPTED_BLOCK + b, offset_reg, 4);
-                    _mm256_store_ps(output_buffer + b * pic_size + j * 8, acc);
+                    _mm256_storeu_ps(output_buffer + b * pic_size + j * 8, acc);
                 }
             }
             for (uint32_t j = (pic_size / 8) * 8; j < pic_size; ++j)
-                for (uint32_t b = 0u; b < BATCH_ACCEPTED_BLOCK; ++b)
+                for (uint32_t b = 0u; b < pics_in_block; ++b)
                     output_buffer[b * pic_size + j] = input_buffer[j * BATCH_ACCEPTED_BLOCK + b];
 
             output_buffer += pic_size * BATCH_ACCEPTED_BLOCK;
@@ -34,188 +34,146 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace
 {
-uint32_t C_simd_size = sizeof(__m256) / sizeof(float);
-} //namespace
+// Side of square tile of matrix transposed at once, tile of input and output fit in L1 cache together.
+const size_t transpose_tile_size = 32;
 
-namespace layer
+// Matrices smaller than this are transposed on calling thread.
+const size_t parallel_transpose_min_size = 64 * 1024;
+
+// Transposes 8x8 block of floats in registers.
+inline void transpose_8x8(const float *input, size_t input_stride, float *output, size_t output_stride)
 {
+    __m256 row0 = _mm256_loadu_ps(input + 0 * input_stride);
+    __m256 row1 = _mm256_loadu_ps(input + 1 * input_stride);
+    __m256 row2 = _mm256_loadu_ps(input + 2 * input_stride);
+    __m256 row3 = _mm256_loadu_ps(input + 3 * input_stride);
+    __m256 row4 = _mm256_loadu_ps(input + 4 * input_stride);
+    __m256 row5 = _mm256_loadu_ps(input + 5 * input_stride);
+    __m256 row6 = _mm256_loadu_ps(input + 6 * input_stride);
+    __m256 row7 = _mm256_loadu_ps(input + 7 * input_stride);
+
+    // interleave pairs of rows
+    __m256 pair0 = _mm256_unpacklo_ps(row0, row1);
+    __m256 pair1 = _mm256_unpackhi_ps(row0, row1);
+    __m256 pair2 = _mm256_unpacklo_ps(row2, row3);
+    __m256 pair3 = _mm256_unpackhi_ps(row2, row3);
+    __m256 pair4 = _mm256_unpacklo_ps(row4, row5);
+    __m256 pair5 = _mm256_unpackhi_ps(row4, row5);
+    __m256 pair6 = _mm256_unpacklo_ps(row6, row7);
+    __m256 pair7 = _mm256_unpackhi_ps(row6, row7);
+
+    // columns of 4 rows in each 128-bit lane
+    __m256 quad0 = _mm256_shuffle_ps(pair0, pair2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 quad1 = _mm256_shuffle_ps(pair0, pair2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 quad2 = _mm256_shuffle_ps(pair1, pair3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 quad3 = _mm256_shuffle_ps(pair1, pair3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 quad4 = _mm256_shuffle_ps(pair4, pair6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 quad5 = _mm256_shuffle_ps(pair4, pair6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 quad6 = _mm256_shuffle_ps(pair5, pair7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 quad7 = _mm256_shuffle_ps(pair5, pair7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    // join lanes of upper and lower 4 rows
+    _mm256_storeu_ps(output + 0 * output_stride, _mm256_permute2f128_ps(quad0, quad4, 0x20));
+    _mm256_storeu_ps(output + 1 * output_stride, _mm256_permute2f128_ps(quad1, quad5, 0x20));
+    _mm256_storeu_ps(output + 2 * output_stride, _mm256_permute2f128_ps(quad2, quad6, 0x20));
+    _mm256_storeu_ps(output + 3 * output_stride, _mm256_permute2f128_ps(quad3, quad7, 0x20));
+    _mm256_storeu_ps(output + 4 * output_stride, _mm256_permute2f128_ps(quad0, quad4, 0x31));
+    _mm256_storeu_ps(output + 5 * output_stride, _mm256_permute2f128_ps(quad1, quad5, 0x31));
+    _mm256_storeu_ps(output + 6 * output_stride, _mm256_permute2f128_ps(quad2, quad6, 0x31));
+    _mm256_storeu_ps(output + 7 * output_stride, _mm256_permute2f128_ps(quad3, quad7, 0x31));
+}
 
-    template<
-        bool T_fully_optimized,
-        uint32_t T_batch = 0,
-        uint32_t T_image_size = 0>
-    void batching_conversion(
-        const nn_workload_data_t* input_view,
-        nn_workload_data_t* output_view)
+// Transposes part [row_begin, row_end) x [column_begin, column_end) of rows x columns matrix.
+void transpose_part(const float *input, float *output, size_t rows, size_t columns,
+                    size_t row_begin, size_t row_end, size_t column_begin, size_t column_end)
+{
+    const size_t block = 8;
+    auto row = row_begin;
+    for (; row + block <= row_end; row += block)
     {
-        if (T_fully_optimized)
-        {
-            const __m256i offset_reg = _mm256_set_epi32(
-                                            T_image_size * 7,
-                                            T_image_size * 6,
-                                            T_image_size * 5,
-                                            T_image_size * 4,
-                                            T_image_size * 3,
-                                            T_image_size * 2,
-                                            T_image_size * 1,
-                                            T_image_size * 0);
-
-            float* in_data_ptr = reinterpret_cast<float*>(input_view->parent->data_buffer);
-            float* out_data_ptr = reinterpret_cast<float*>(output_view->parent->data_buffer);
-
-            if (T_batch == 8)
-            {
-                const uint32_t num_full_passes = T_image_size / 12;
-                const uint32_t num_part_passes = T_image_size % 12;
-
-                for (uint32_t pass = 0; pass < num_full_passes; ++pass)
-                {
-                    __m256 data_reg0  = _mm256_i32gather_ps(in_data_ptr +  0, offset_reg, 4);
-                    __m256 data_reg1  = _mm256_i32gather_ps(in_data_ptr +  1, offset_reg, 4);
-                    __m256 data_reg2  = _mm256_i32gather_ps(in_data_ptr +  2, offset_reg, 4);
-                    __m256 data_reg3  = _mm256_i32gather_ps(in_data_ptr +  3, offset_reg, 4);
-                    __m256 data_reg4  = _mm256_i32gather_ps(in_data_ptr +  4, offset_reg, 4);
-                    __m256 data_reg5  = _mm256_i32gather_ps(in_data_ptr +  5, offset_reg, 4);
-                    __m256 data_reg6  = _mm256_i32gather_ps(in_data_ptr +  6, offset_reg, 4);
-                    __m256 data_reg7  = _mm256_i32gather_ps(in_data_ptr +  7, offset_reg, 4);
-                    __m256 data_reg8  = _mm256_i32gather_ps(in_data_ptr +  8, offset_reg, 4);
-                    __m256 data_reg9  = _mm256_i32gather_ps(in_data_ptr +  9, offset_reg, 4);
-                    __m256 data_reg10 = _mm256_i32gather_ps(in_data_ptr + 10, offset_reg, 4);
-                    __m256 data_reg11 = _mm256_i32gather_ps(in_data_ptr + 11, offset_reg, 4);
-
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  0,  data_reg0);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  1,  data_reg1);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  2,  data_reg2);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  3,  data_reg3);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  4,  data_reg4);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  5,  data_reg5);
-
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  6,  data_reg6);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  7,  data_reg7);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  8,  data_reg8);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  9,  data_reg9);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 10, data_reg10);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 11, data_reg11);
-
-                    in_data_ptr += 12;
-                    out_data_ptr += C_simd_size * 12;
-                }
-
-                for (uint32_t pass = 0; pass < num_part_passes; ++pass)
-                {
-                    __m256 data_reg0  = _mm256_i32gather_ps(in_data_ptr, offset_reg, 1);
+        auto column = column_begin;
+        for (; column + block <= column_end; column += block)
+            transpose_8x8(input + row * columns + column, columns, output + column * rows + row, rows);
+        for (; column < column_end; ++column)
+            for (auto in_block = row; in_block < row + block; ++in_block)
+                output[column * rows + in_block] = input[in_block * columns + column];
+    }
+    for (; row < row_end; ++row)
+        for (auto column = column_begin; column < column_end; ++column)
+            output[column * rows + row] = input[row * columns + column];
+}
 
-                    _mm256_store_ps(out_data_ptr, data_reg0);
+// Transposes rows x columns matrix; tiles of it are split between threads of pool.
+void transpose(nn_thread_worker_pool &thread_pool, const float *input, float *output, size_t rows, size_t columns)
+{
+    const auto row_tiles = (rows + transpose_tile_size - 1) / transpose_tile_size;
+    const auto column_tiles = (columns + transpose_tile_size - 1) / transpose_tile_size;
+    const auto tiles = row_tiles * column_tiles;
 
-                    in_data_ptr += 1;
-                    out_data_ptr += C_simd_size;
-                }
-            }
-            else if (T_batch == 48)
-            {
-                const uint32_t num_full_passes = T_image_size / 2;
-                const uint32_t num_part_passes = T_image_size % 2;
+    auto transpose_tiles = [=](size_t tile_begin, size_t tile_end) {
+        for (auto tile = tile_begin; tile < tile_end; ++tile)
+        {
+            auto row = tile / column_tiles * transpose_tile_size;
+            auto column = tile % column_tiles * transpose_tile_size;
+            transpose_part(input, output, rows, columns,
+                           row, std::min(row + transpose_tile_size, rows),
+                           column, std::min(column + transpose_tile_size, columns));
+        }
+    };
 
-                for (uint32_t pass = 0; pass < num_full_passes; ++pass)
-                {
-                    __m256 data_reg0  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 0, offset_reg, 4);
-                    __m256 data_reg1  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 1, offset_reg, 4);
-                    __m256 data_reg2  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 2, offset_reg, 4);
-                    __m256 data_reg3  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 3, offset_reg, 4);
-                    __m256 data_reg4  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 4, offset_reg, 4);
-                    __m256 data_reg5  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 5, offset_reg, 4);
-
-                    __m256 data_reg6  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 0 + 1, offset_reg, 4);
-                    __m256 data_reg7  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 1 + 1, offset_reg, 4);
-                    __m256 data_reg8  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 2 + 1, offset_reg, 4);
-                    __m256 data_reg9  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 3 + 1, offset_reg, 4);
-                    __m256 data_reg10 = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 4 + 1, offset_reg, 4);
-                    __m256 data_reg11 = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 5 + 1, offset_reg, 4);
-
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  0,  data_reg0);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  1,  data_reg1);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  2,  data_reg2);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  3,  data_reg3);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  4,  data_reg4);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  5,  data_reg5);
-
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  6,  data_reg6);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  7,  data_reg7);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  8,  data_reg8);
-                    _mm256_store_ps(out_data_ptr + C_simd_size *  9,  data_reg9);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 10, data_reg10);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 11, data_reg11);
-
-                    in_data_ptr += 2;
-                    out_data_ptr += C_simd_size * 12;
-                }
+    const auto job_count = std::min<size_t>(thread_pool.get_num_threads(), tiles);
+    if (rows * columns < parallel_transpose_min_size || job_count < 2)
+    {
+        transpose_tiles(0, tiles);
+        return;
+    }
 
-                for (uint32_t pass = 0; pass < num_part_passes; ++pass)
-                {
-                    __m256 data_reg0  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 0, offset_reg, 4);
-                    __m256 data_reg1  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 1, offset_reg, 4);
-                    __m256 data_reg2  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 2, offset_reg, 4);
-                    __m256 data_reg3  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 3, offset_reg, 4);
-                    __m256 data_reg4  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 4, offset_reg, 4);
-                    __m256 data_reg5  = _mm256_i32gather_ps(in_data_ptr + T_image_size * C_simd_size * 5, offset_reg, 4);
-
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 0, data_reg0);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 1, data_reg1);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 2, data_reg2);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 3, data_reg3);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 4, data_reg4);
-                    _mm256_store_ps(out_data_ptr + C_simd_size * 5, data_reg5);
-                }
-            }
-        }
-        else
-        {
-            const auto input_buffer = static_cast<float*>(input_view->parent->data_buffer);
-            const auto output_buffer = static_cast<float*>(output_view->parent->data_buffer);
+    std::vector<nn_multithreaded_request> jobs(job_count);
+    for (size_t job = 0; job < job_count; ++job)
+    {
+        const auto tile_begin = tiles * job / job_count;
+        const auto tile_end = tiles * (job + 1) / job_count;
+        jobs[job] = {[=](void *) { transpose_tiles(tile_begin, tile_end); }, nullptr};
+    }
+    thread_pool.push_job(jobs);
+}
+} //namespace
 
-            const auto input_squashed_x_length = input_view->parent->buffer_size / sizeof(float) / input_view->parent->lengths.t[NN_DATA_COORD_n];
-            const auto output_squashed_x_length = output_view->parent->buffer_size / sizeof(float) / output_view->parent->lengths.t[NN_DATA_COORD_n];
+namespace layer
+{
+    // Converts between layout with batch as slowest dimension and layout with batch as fastest one
+    // (conv -> fc interleaving batches and back), for any batch and image size.
+    void batching_conversion(
+        nn_thread_worker_pool &thread_pool,
+        const nn_workload_data_t* input_view,
+        nn_workload_data_t* output_view)
+    {
+        const auto input_buffer = static_cast<float*>(input_view->parent->data_buffer);
+        const auto output_buffer = static_cast<float*>(output_view->parent->data_buffer);
 
-            if(input_squashed_x_length != output_squashed_x_length)
-                throw std::runtime_error("batching conversion: different data sizes");
+        const size_t batch = input_view->parent->lengths.t[NN_DATA_COORD_n];
+        const auto input_squashed_x_length = input_view->parent->buffer_size / sizeof(float) / batch;
+        const auto output_squashed_x_length = output_view->parent->buffer_size / sizeof(float) / output_view->parent->lengths.t[NN_DATA_COORD_n];
 
-            if((input_view->parent->layout == nn::layout_t<nn::layout_nzxypq_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_zxynpq_f32>::layout) || // N-ZXY -> ZXY-N
-               (input_view->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_zxynpq_f32>::layout) || // N-X   -> ZXY-N
-               (input_view->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_xyzpqn_f32>::layout))   // N-XYZ -> XYZ-N
-            {
-                // N.. to ..N
-                const auto load_data_stride = T_batch;
-                const auto store_data_stride = output_squashed_x_length;
+        if(input_squashed_x_length != output_squashed_x_length)
+            throw std::runtime_error("batching conversion: different data sizes");
 
-                for(uint32_t x = 0; x < input_squashed_x_length; ++x)
-                {
-                    #pragma unroll (T_batch)
-                    for(uint32_t n = 0; n < T_batch; ++n)
-                        *(output_buffer + n * store_data_stride + x) = *(input_buffer + x * load_data_stride + n);
-                }
-            }
-            else if((input_view->parent->layout == nn::layout_t<nn::layout_zxynpq_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_nzxypq_f32>::layout) || // ZXY-N -> N-ZXY
-                    (input_view->parent->layout == nn::layout_t<nn::layout_zxynpq_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout) || // ZXY-N -> N-X
-                    (input_view->parent->layout == nn::layout_t<nn::layout_xyzpqn_f32>::layout && output_view->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout))   // XYZ-N -> N-XYZ
-            {
-                // ..N to N..
-                const auto load_data_stride = input_squashed_x_length;
-                const auto store_data_stride = T_batch;
+        const bool input_batch_fastest = input_view->parent->layout.ordering.t[0] == NN_DATA_COORD_n;
+        const bool output_batch_fastest = output_view->parent->layout.ordering.t[0] == NN_DATA_COORD_n;
 
-                for(uint32_t x = 0; x < input_squashed_x_length; ++x)
-                {
-                    #pragma unroll (T_batch)
-                    for(uint32_t n = 0; n < T_batch; ++n)
-                        *(output_buffer + x * store_data_stride + n) = *(input_buffer + n * load_data_stride + x);
-                }
-            }
-        }
+        if(input_batch_fastest && !output_batch_fastest)        // N.. to ..N
+            transpose(thread_pool, input_buffer, output_buffer, input_squashed_x_length, batch);
+        else if(!input_batch_fastest && output_batch_fastest)   // ..N to N..
+            transpose(thread_pool, input_buffer, output_buffer, batch, input_squashed_x_length);
+        else
+            throw std::runtime_error("batching conversion: unsupported layouts");
     }
 
-    void run_convert_to_data_layout_work_item(nn_workload_item *const work_item) {
+    void run_convert_to_data_layout_work_item(nn_workload_item *const work_item,
+                                              nn_workload_data_t *const input_view,
+                                              nn_workload_data_t *const output_view,
+                                              nn_device_internal *const device) {
         const auto &master_arguments = work_item->arguments.convert_data_layout;
-        const auto &input_view = work_item->input[0].get_data_view();
-        const auto &output_view = work_item->output[0];
         const auto &type = master_arguments.type;
 
         auto batchsize = output_view->parent->lengths.t[NN_DATA_COORD_n];
@@ -310,23 +268,13 @@ namespace layer
                                 }*/
         } break;
 
-        case 4: // conv->fc in float batch8/48
-        case 7: // fc->conv in backward batch8/48
+        case 4: // conv->fc in float
+        case 7: // fc->conv in backward
         {
             // It won't change anything if batch == 1.
             if(batchsize != 1)
             {
-                auto image_size = input_view->parent->lengths.t[NN_DATA_COORD_x] * input_view->parent->lengths.t[NN_DATA_COORD_y] * input_view->parent->lengths.t[NN_DATA_COORD_z];
-
-                if      (batchsize ==  8 && image_size ==  9216 && type == 4) batching_conversion< true,  8,  9216>(input_view, output_view);
-                else if (batchsize == 48 && image_size ==  9216 && type == 4) batching_conversion< true, 48,  9216>(input_view, output_view);
-                else if (batchsize ==  8 && image_size == 36864 && type == 4) batching_conversion< true,  8, 36864>(input_view, output_view);
-                else if (batchsize == 48 && image_size == 36864 && type == 4) batching_conversion< true, 48, 36864>(input_view, output_view);
-                else if (batchsize ==  8)                                     batching_conversion<false,  8       >(input_view, output_view);
-                else if (batchsize == 32)                                     batching_conversion<false, 32       >(input_view, output_view);
-                else if (batchsize == 48)                                     batching_conversion<false, 48       >(input_view, output_view);
-                else
-                    throw std::runtime_error("batch_conversion: unknown batch");
+                batching_conversion(device->thread_pool, input_view, output_view);
             }
             else
             {
@@ -412,21 +360,8 @@ namespace layer
         if(batch_size == 1)
             // no batching, interleaving batches does no change to the data layout
             memcpy(output->parent->data_buffer, input->parent->data_buffer, output->parent->buffer_size);
-        else if (batch_size == 8 && output_size == 9216)
-            batching_conversion<true, 8, 9216>(input, output);
-        else if (batch_size == 48 && output_size == 9216)
-            batching_conversion<true, 48, 9216>(input, output);
-        else if (batch_size == 8 && output_size == 36864)
-            batching_conversion<true, 8, 36864>(input, output);
-        else if (batch_size == 48 && output_size == 36864)
-            batching_conversion<true, 48, 36864>(input, output);
-        else{
-            // reinterpret output as nzxy to interleave batches and produce single dimensional output correctly
-            nn_workload_data_layout_t nzxy_layout = nn::layout_t<nn::layout_nzxypq_f32>::layout;
-            nn::workload_data<nn::layout_f32> tmp_output(
-                NN_WORKLOAD_DATA_TAG_UNKNOWN, output->parent->data_buffer, input->parent->lengths, nzxy_layout);
-            batching_conversion<false>(input, &tmp_output);
-        }
+        else
+            batching_conversion(device->thread_pool, input, output);
     }
 
     void convert_zxyn_nx_f32::forward(const std::vector<const nn_workload_data_t *> &inputs,
@@ -463,16 +398,9 @@ namespace layer
         if (batch_size == 1)
             // no batching, interleaving batches does no change to the data layout
             memcpy(output.parent->data_buffer, input.parent->data_buffer, output.parent->buffer_size);
-        else if (batch_size == 8)
-            batching_conversion<false,  8>(&input, &output);
-        else if (batch_size == 32)
-            batching_conversion<false, 32>(&input, &output);
-        else if (batch_size == 48)
-            batching_conversion<false, 48>(&input, &output);
-        else{
-            throw std::runtime_error("batch size not supported");
-        }
-        
+        else
+            batching_conversion(device->thread_pool, &input, &output);
+
     }
 
     std::vector<nn_workload_data_t *> convert_zxyn_nx_f32::create_inputs(bool allocate_delta) {
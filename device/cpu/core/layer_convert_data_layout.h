@@ -36,7 +36,10 @@ struct nn_workload_item;
 struct nn_device_internal;
 
 namespace layer {
-void run_convert_to_data_layout_work_item(nn_workload_item *const work_item);
+void run_convert_to_data_layout_work_item(nn_workload_item *const work_item,
+                                          nn_workload_data_t *const input_view,
+                                          nn_workload_data_t *const output_view,
+                                          nn_device_internal *const device);
 
 class convert_zxyn_nx_f32 : public nn_primitive_t {
   public:
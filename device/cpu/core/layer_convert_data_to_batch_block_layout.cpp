@@ -82,6 +82,33 @@ void convert_from_zxyn_to_batch_block_format_nzxyn::forward(
     {
         auto input = nn::workload_data_cast<>(inputs[k]);
         auto output = nn::workload_data_cast<>(outputs[k]);
+
+        // batch interleaved input (nx): each block gathers consecutive pictures of every value
+        if (input->parent->layout == nn::layout_t<nn::layout_nxyzpq_f32>::layout)
+        {
+            if (input->get_length() != input->parent->lengths)
+                throw std::runtime_error("view on input in convert_from_zxyn_to_batch_block_format_nzxyn");
+            assert(output->get_length() == output->parent->lengths);
+
+            const uint64_t pic_size = input_size_x * input_size_y * input_size_z;
+            auto input_buffer = reinterpret_cast<float*>(input->parent->data_buffer);
+            auto output_buffer = reinterpret_cast<float*>(output->parent->data_buffer);
+            for (auto b = 0u; b < output->get_length(NN_DATA_COORD_n); ++b)
+            {
+                const uint32_t pics_in_block = std::min<uint32_t>(BATCH_ACCEPTED_BLOCK, batch_size - b * BATCH_ACCEPTED_BLOCK);
+                for (uint64_t j = 0u; j < pic_size; ++j)
+                {
+                    auto block_values = output_buffer + j * BATCH_ACCEPTED_BLOCK;
+                    std::copy(input_buffer + j * batch_size + b * BATCH_ACCEPTED_BLOCK,
+                              input_buffer + j * batch_size + b * BATCH_ACCEPTED_BLOCK + pics_in_block,
+                              block_values);
+                    std::fill(block_values + pics_in_block, block_values + BATCH_ACCEPTED_BLOCK, 0.0f);
+                }
+                output_buffer += pic_size * BATCH_ACCEPTED_BLOCK;
+            }
+            continue;
+        }
+
         assert(input->get_length(NN_DATA_COORD_p) == 1);
         assert(input->get_length(NN_DATA_COORD_q) == 1);
         assert(output->get_length(NN_DATA_COORD_q) == 1);
@@ -89,8 +116,8 @@ void convert_from_zxyn_to_batch_block_format_nzxyn::forward(
         assert(input->get_length(NN_DATA_COORD_x) == output->get_length(NN_DATA_COORD_x));
         assert(input->get_length(NN_DATA_COORD_z) == output->get_length(NN_DATA_COORD_z));
         assert(output->get_length(NN_DATA_COORD_p) == BATCH_ACCEPTED_BLOCK);
-        assert(input->get_length(NN_DATA_COORD_n) ==
-            output->get_length(NN_DATA_COORD_n) * output->get_length(NN_DATA_COORD_p));
+        assert((input->get_length(NN_DATA_COORD_n) + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK ==
+            output->get_length(NN_DATA_COORD_n));
         assert(input->get_length(NN_DATA_COORD_n) == batch_size);
 
         assert(output->get_length() == output->parent->lengths);
@@ -123,6 +150,8 @@ void convert_from_zxyn_to_batch_block_format_nzxyn::forward(
 
         for (auto b = 0u; b < output->get_length(NN_DATA_COORD_n); ++b)
         {
+            // last block may be partially filled, pictures missing in it are padded with zeros
+            const uint32_t pics_in_block = std::min<uint32_t>(BATCH_ACCEPTED_BLOCK, batch_size - b * BATCH_ACCEPTED_BLOCK);
             std::atomic<uint32_t> job_number(0u);
             auto partial_convert = [&](float* aux_buffer){
                     auto curr_job = std::atomic_fetch_add(&job_number, 1u);
@@ -137,6 +166,11 @@ void convert_from_zxyn_to_batch_block_format_nzxyn::forward(
                     for (auto i = 0u; i < BATCH_ACCEPTED_BLOCK; ++i)
                     {
                         auto curr_aux_buffer = aux_buffer + i * curr_block_size;
+                        if (i >= pics_in_block)
+                        {
+                            std::memset(curr_aux_buffer, 0, curr_block_size * sizeof(float));
+                            continue;
+                        }
                         auto curr_input = input_buffer + i * parent_pic_size
                                 + ((view_begin_y + begin_y) * parent_width + view_begin_x + begin_x) * parent_feats
                                 + view_begin_z;
@@ -524,6 +524,114 @@ void run_convolution(const nn::workload_data<> *input_view,
     }
 }
 
+float *border_staging::get(size_t required_size)
+{
+    if (required_size > size)
+    {
+        buffer = nn_make_unique_aligned<float>(required_size);
+        size = required_size;
+    }
+    return buffer.get();
+}
+
+/* Computes part [begin_x..end_x] x [begin_y..end_y] of output view (coordinates relative to the view)
+   which reads input out of its buffer. Input read by this part is copied to staging buffer with zeros
+   in place of missing data, so the part runs through run_convolution like the inner part of view.
+   Images are staged one by one, each computed against output buffer of its own image. */
+template <NN_ACTIVATION_FUNCTION T_activation>
+void run_convolution_zero_padded(const nn::workload_data<> *input,
+                                 const uint32_t begin_x,
+                                 const uint32_t begin_y,
+                                 const uint32_t end_x,
+                                 const uint32_t end_y,
+                                 const int32_t center_offset_x,
+                                 const int32_t center_offset_y,
+                                 const size_t stride_x,
+                                 const size_t stride_y,
+                                 const nn::workload_data<> *weights,
+                                 const nn::workload_data<> *bias,
+                                 nn::workload_data<> *output,
+                                 border_staging &staging)
+{
+    const int32_t kernel_width = weights->parent->lengths.t[NN_DATA_COORD_x];
+    const int32_t kernel_height = weights->parent->lengths.t[NN_DATA_COORD_y];
+
+    const uint32_t num_ifm = input->parent->lengths.t[NN_DATA_COORD_z];
+    const int32_t ifm_width = input->parent->lengths.t[NN_DATA_COORD_x];
+    const int32_t ifm_height = input->parent->lengths.t[NN_DATA_COORD_y];
+
+    const auto output_image_view_start = output->view_begin.t[NN_DATA_COORD_n];
+
+    // Input position of left-upper corner of filter for first output of the part.
+    const int32_t input_start_x = static_cast<int32_t>(input->view_begin.t[NN_DATA_COORD_x] + begin_x * stride_x) - center_offset_x;
+    const int32_t input_start_y = static_cast<int32_t>(input->view_begin.t[NN_DATA_COORD_y] + begin_y * stride_y) - center_offset_y;
+
+    const int32_t staging_width = static_cast<int32_t>((end_x - begin_x) * stride_x) + kernel_width;
+    const int32_t staging_height = static_cast<int32_t>((end_y - begin_y) * stride_y) + kernel_height;
+    const size_t staging_image_size = static_cast<size_t>(staging_width) * staging_height * num_ifm;
+
+    nn::workload_data<> staging_image(
+        staging.get(staging_image_size),
+        nn_workload_data_coords_t(1, staging_width, staging_height, num_ifm, 1, 1),
+        input->parent->layout);
+
+    nn::workload_data<> staging_view(
+        staging_image,
+        nn_workload_data_coords_t(
+            0,
+            center_offset_x,
+            center_offset_y,
+            input->view_begin.t[NN_DATA_COORD_z],
+            0,
+            0),
+        nn_workload_data_coords_t(
+            0,
+            center_offset_x + (end_x - begin_x) * stride_x,
+            center_offset_y + (end_y - begin_y) * stride_y,
+            input->view_end.t[NN_DATA_COORD_z],
+            0,
+            0));
+
+    const auto source = static_cast<const float *>(input->parent->data_buffer);
+    const auto destination = static_cast<float *>(staging_image.parent->data_buffer);
+
+    const int32_t valid_begin_x = std::max(-input_start_x, 0);
+    const int32_t valid_end_x = std::min(ifm_width - input_start_x, staging_width);
+
+    // Missing data is at the same place for every image, copied rows overwrite only valid one.
+    memset(destination, 0, staging_image_size * sizeof(float));
+
+    for (auto image = 0u; image < output->get_length(NN_DATA_COORD_n); ++image)
+    {
+        auto input_image = source + static_cast<size_t>(output_image_view_start + image) * ifm_width * ifm_height * num_ifm;
+
+        for (int32_t row = 0; row < staging_height && valid_begin_x < valid_end_x; ++row)
+        {
+            const auto input_row = input_start_y + row;
+            if (input_row < 0 || input_row >= ifm_height)
+                continue;
+
+            memcpy(destination + (static_cast<size_t>(row) * staging_width + valid_begin_x) * num_ifm,
+                   input_image + (static_cast<size_t>(input_row) * ifm_width + input_start_x + valid_begin_x) * num_ifm,
+                   static_cast<size_t>(valid_end_x - valid_begin_x) * num_ifm * sizeof(float));
+        }
+
+        helper_zxyn_f32::image_of_buffer output_image(output, image);
+        nn::workload_data<> output_part(
+            output_image.view,
+            nn_workload_data_coords_t(0, begin_x, begin_y, 0, 0, 0),
+            nn_workload_data_coords_t(
+                0,
+                end_x,
+                end_y,
+                output->get_length(NN_DATA_COORD_z) - 1,
+                0,
+                0));
+
+        run_convolution<T_activation>(&staging_view, NN_PADDING_MODE_DATA_OR_ZERO, center_offset_x, center_offset_y, stride_x, stride_y, weights, bias, &output_part);
+    }
+}
+
 void choose_convolution_padding_mode_and_activation(const nn::workload_data<> *input,
                                                     const NN_PADDING_MODE padding,
                                                     const int32_t center_offset_x,
@@ -533,36 +641,20 @@ void choose_convolution_padding_mode_and_activation(const nn::workload_data<> *i
                                                     const nn_argument_activation_t &activation,
                                                     const nn::workload_data<> *weights,
                                                     const nn::workload_data<> *bias,
-                                                    nn::workload_data<> *output) {
+                                                    nn::workload_data<> *output,
+                                                    border_staging &staging) {
 
     switch (padding)
     {
     case NN_PADDING_MODE_DATA_OR_ZERO:
         {
             // Get basic data about convolution.
-
-            const int32_t  kernel_width = weights->parent->lengths.t[NN_DATA_COORD_x];
-            const int32_t  kernel_height = weights->parent->lengths.t[NN_DATA_COORD_y];
-            const uint32_t kernel_depth = weights->parent->lengths.t[NN_DATA_COORD_z];
-
-            const uint32_t num_ofm = output->parent->lengths.t[NN_DATA_COORD_z];
-            const uint32_t ofm_width = output->parent->lengths.t[NN_DATA_COORD_x];
-            const uint32_t ofm_height = output->parent->lengths.t[NN_DATA_COORD_y];
-
-            const uint32_t num_ifm = input->parent->lengths.t[NN_DATA_COORD_z];
             const int32_t  ifm_width = input->parent->lengths.t[NN_DATA_COORD_x];
             const int32_t  ifm_height = input->parent->lengths.t[NN_DATA_COORD_y];
 
-            const uint32_t output_fm_view_start = output->view_begin.t[NN_DATA_COORD_z];
-            const uint32_t output_fm_view_end = output->view_end.t[NN_DATA_COORD_z];
-
             // Get data about base view.
             const int32_t input_base_view_start_x = input->view_begin.t[NN_DATA_COORD_x];
             const int32_t input_base_view_start_y = input->view_begin.t[NN_DATA_COORD_y];
-            const int32_t output_base_view_start_x = output->view_begin.t[NN_DATA_COORD_x];
-            const int32_t output_base_view_start_y = output->view_begin.t[NN_DATA_COORD_y];
-            const int32_t output_base_view_end_x = output->view_end.t[NN_DATA_COORD_x];
-            const int32_t output_base_view_end_y = output->view_end.t[NN_DATA_COORD_y];
 
             // Get offsets of convolution central point.
             const int32_t required_center_offset_from_left = center_offset_x;
@@ -658,120 +750,33 @@ void choose_convolution_padding_mode_and_activation(const nn::workload_data<> *i
             }
 
             // Process cropped items - if there are any.
-            if (output_crop_from_left > 0 ||
-                output_crop_from_up > 0 ||
-                output_crop_from_right > 0 ||
-                output_crop_from_down > 0 )
-            {
-                // Naive implementation for the rest of view.
-                const auto output_image_view_start = output->view_begin.t[NN_DATA_COORD_n];
-                const auto output_image_view_end = output->view_end.t[NN_DATA_COORD_n];
-                const auto kernel_out_fmap_view_start = weights->view_begin.t[NN_DATA_COORD_q] * C_slice_size;
-                const auto bias_view_start = bias->view_begin.t[NN_DATA_COORD_x];
-
-                for (int32_t output_y = output_base_view_start_y;
-                      output_y <= output_base_view_end_y;
-                      ++output_y)
-                {
-                    for (int32_t output_x = output_base_view_start_x;
-                          output_x <= output_base_view_end_x;
-                          ++output_x)
-                    {
-                        if (valid_optimized_view &&
-                            output_x >= output_subview->view_begin.t[NN_DATA_COORD_x] && output_x <= output_subview->view_end.t[NN_DATA_COORD_x] &&
-                            output_y >= output_subview->view_begin.t[NN_DATA_COORD_y] && output_y <= output_subview->view_end.t[NN_DATA_COORD_y])
-                        {
-                            // Already processed by optimized code..
-                            continue;
-                        }
-
-                        for (auto out_image = output_image_view_start;
-                            out_image <= output_image_view_end;
-                            ++out_image)
-                        {
-                            const auto input_image_offset = num_ifm * ifm_width * ifm_height * out_image;
-                            const auto output_image_offset = num_ofm * ofm_width * ofm_height * out_image;
-                            for (auto out_feature_map = output_fm_view_start, kernel_feature_map = kernel_out_fmap_view_start, bias_feature_map = bias_view_start;
-                                out_feature_map <= output_fm_view_end;
-                                out_feature_map += C_simd_width, kernel_feature_map += C_simd_width, bias_feature_map += C_simd_width)
-                            {
-
-                                // Input reading offset for left-upper corner.
-                                int32_t left_up_read_offset_x = static_cast<int32_t>((output_x - output_base_view_start_x)*stride_x - required_center_offset_from_left + input_base_view_start_x);
-                                int32_t left_up_read_offset_y = static_cast<int32_t>((output_y - output_base_view_start_y)*stride_y - required_center_offset_from_up + input_base_view_start_y);
-
-                                // Input reading offset for right-bottom corner.
-                                int32_t right_down_read_offset_x = left_up_read_offset_x + kernel_width;
-                                int32_t right_down_read_offset_y = left_up_read_offset_y + kernel_height;
-
-                                // Compute which part of kernel should be used from(if input reading offset was negative we must crop filter).
-                                uint32_t kernel_start_offset_x = std::max(-left_up_read_offset_x, 0);
-                                uint32_t kernel_start_offset_y = std::max(-left_up_read_offset_y, 0);
-
-                                // Compute which part of kernel should be used to(if input reading end offset goes out-of-data we must crop the filter).
-                                uint32_t kernel_end_offset_x = kernel_width + std::min(ifm_width - right_down_read_offset_x, 0);
-                                uint32_t kernel_end_offset_y = kernel_height + std::min(ifm_height - right_down_read_offset_y, 0);
-
-                                // Get starting point for input.
-                                uint32_t input_start_offset_x = std::max(left_up_read_offset_x, 0);
-                                uint32_t input_start_offset_y = std::max(left_up_read_offset_y, 0);
-
-                                // Compute data buffer offsets for input, output and weights.
-                                uint32_t output_element = num_ofm * output_x + num_ofm * ofm_width * output_y + out_feature_map + output_image_offset;
-                                uint32_t input_element = num_ifm * input_start_offset_x + num_ifm * ifm_width * input_start_offset_y + input_image_offset;
-
-                                uint32_t weight_slice_id = kernel_feature_map / C_slice_size;
-                                uint32_t weight_slice_element = kernel_feature_map % C_slice_size;
-
-                                uint32_t input_fmap_view_start = input->view_begin.t[NN_DATA_COORD_z];
-                                uint32_t input_fmap_view_length = input->view_end.t[NN_DATA_COORD_z] - input_fmap_view_start + 1;
-                                uint32_t kernel_input_fmap_view_start = weights->view_begin.t[NN_DATA_COORD_z];
-
-                                uint32_t kernel_depth_size = input_fmap_view_length * C_slice_size;
-                                uint32_t kernel_depth_offset = kernel_input_fmap_view_start * C_slice_size;
-
-                                uint32_t weight_element =
-                                    weight_slice_element
-                                    + kernel_start_offset_y * C_slice_size * kernel_depth * kernel_width
-                                    + kernel_width*kernel_height*kernel_depth*weight_slice_id*C_slice_size
-                                    + kernel_start_offset_x * C_slice_size * kernel_depth;
-
-                                // Read from bias.
-                                __m256 acc0 = _mm256_load_ps(reinterpret_cast<float*>(bias->parent->data_buffer) + bias_feature_map);
-
-                                // Run convolution.
-                                for (uint32_t kernel_y = kernel_start_offset_y; kernel_y < kernel_end_offset_y; ++kernel_y)
-                                {
-                                    uint32_t input_y_offset = input_element + (kernel_y - kernel_start_offset_y)*num_ifm*ifm_width;
-                                    for (uint32_t kernel_x = kernel_start_offset_x; kernel_x < kernel_end_offset_x; ++kernel_x)
-                                    {
-                                        uint32_t weight_ptr_offset = weight_element + kernel_depth_offset;
-                                        uint32_t input_ptr_offset = input_y_offset + input_fmap_view_start;
-                                        for (uint32_t kernel_z = 0u; kernel_z < input_fmap_view_length; ++kernel_z)
-                                        {
-                                            __m256 weight0 = _mm256_load_ps(reinterpret_cast<float*>(weights->parent->data_buffer) + weight_ptr_offset);
-                                            __m256 inp = _mm256_broadcast_ss(reinterpret_cast<float*>(input->parent->data_buffer) + input_ptr_offset);
-
-                                            acc0 = _mm256_fmadd_ps(weight0, inp, acc0);
-
-                                            weight_ptr_offset += C_slice_size;
-                                            ++input_ptr_offset;
-                                        }
-                                        input_y_offset += num_ifm;
-                                        weight_element += kernel_depth*C_slice_size;
-                                    }
-                                }
-
-                                if (activation.function == NN_ACTIVATION_FUNCTION_RELU)
-                                {
-                                    acc0 = _mm256_max_ps(_mm256_setzero_ps(), acc0);
-                                }
-
-                                _mm256_store_ps(reinterpret_cast<float*>(output->parent->data_buffer) + output_element, acc0);
-                            }
-                        }
+            // Border is computed by the same vectorized code, on zero-padded copies of input strips it reads.
+            const uint32_t output_view_width = output->get_length(NN_DATA_COORD_x);
+            const uint32_t output_view_height = output->get_length(NN_DATA_COORD_y);
+
+            auto run_border = [&](uint32_t begin_x, uint32_t begin_y, uint32_t end_x, uint32_t end_y) {
+                    switch (activation.function) {
+                    case NN_ACTIVATION_FUNCTION_NONE: run_convolution_zero_padded<NN_ACTIVATION_FUNCTION_NONE>(input, begin_x, begin_y, end_x, end_y, center_offset_x, center_offset_y, stride_x, stride_y, weights, bias, output, staging); break;
+                    case NN_ACTIVATION_FUNCTION_RELU: run_convolution_zero_padded<NN_ACTIVATION_FUNCTION_RELU>(input, begin_x, begin_y, end_x, end_y, center_offset_x, center_offset_y, stride_x, stride_y, weights, bias, output, staging); break;
                     }
-                }
+                };
+
+            if (!valid_optimized_view)
+            {
+                run_border(0, 0, output_view_width - 1, output_view_height - 1);
+            }
+            else
+            {
+                const uint32_t inner_end_y = output_view_height - 1 - output_crop_from_down;
+
+                if (output_crop_from_up > 0)
+                    run_border(0, 0, output_view_width - 1, output_crop_from_up - 1);
+                if (output_crop_from_down > 0)
+                    run_border(0, inner_end_y + 1, output_view_width - 1, output_view_height - 1);
+                if (output_crop_from_left > 0)
+                    run_border(0, output_crop_from_up, output_crop_from_left - 1, inner_end_y);
+                if (output_crop_from_right > 0)
+                    run_border(output_view_width - output_crop_from_right, output_crop_from_up, output_view_width - 1, inner_end_y);
             }
 
             // Cleanup dynamic data.
@@ -1171,7 +1176,8 @@ using parameters_convolution_f32_avx2 = std::tuple<nn::workload_data<> *,
                                                    const nn_argument_activation_t *,
                                                    nn::workload_data<> *,
                                                    nn::workload_data<> *,
-                                                   nn::workload_data<> *>;
+                                                   nn::workload_data<> *,
+                                                   border_staging *>;
 
 using parameters_convolution_backprop_error_f32_avx2 = std::tuple<
                                                    const nn::workload_data<> *,
@@ -1208,7 +1214,8 @@ void unpack_convolve_callback_handle(
                                                    *std::get<6>(handle),
                                                    std::get<7>(handle),
                                                    std::get<8>(handle),
-                                                   std::get<9>(handle));
+                                                   std::get<9>(handle),
+                                                   *std::get<10>(handle));
 }
 
 void unpack_convolve_callback_handle_backward_error(
@@ -1257,25 +1264,19 @@ void convolution_f32::forward(const nn::workload_data<> *input_buffer,
                               const nn::workload_data<> *bias_buffer,
                               nn::workload_data<> *output_buffer)
 {
+    // compiled kernel works on any buffers of geometry it was prepared for
+    if (compiled
+        and (input_buffer->get_length() == compiled_input_lengths)
+        and (input_buffer->parent->lengths == compiled_input_lengths)
+        and (output_buffer->get_length() == compiled_output_lengths)
+        and (output_buffer->parent->lengths == compiled_output_lengths))
     {
-        auto input = reinterpret_cast<float*>(input_buffer->parent->data_buffer);
-        auto output = reinterpret_cast<float*>(output_buffer->parent->data_buffer);
-        auto weights = reinterpret_cast<float*>(weights_buffer->parent->data_buffer);
-        auto bias = reinterpret_cast<float*>(bias_buffer->parent->data_buffer);
-
-        if (prepared_for == std::make_tuple(input, output, weights, bias)
-            or ((prepared_for == std::make_tuple(nullptr, output, weights, bias))
-                and (input_buffer->get_length() == input_buffer->parent->lengths)))
-        {
-            if (std::get<0>(prepared_for) == nullptr)
-                for (auto& job : compiled->jobs)
-                    for (auto& task : job)
-                        static_cast<jit_convolution_zxyn::op_data_t*>(task.request_handle)
-                            ->input = input;
-            for (auto job : compiled->jobs)
-                device->thread_pool.push_job(job);
-            return;
-        }
+        compiled->execute(device->thread_pool,
+                          reinterpret_cast<float*>(output_buffer->parent->data_buffer),
+                          reinterpret_cast<float*>(input_buffer->parent->data_buffer),
+                          reinterpret_cast<float*>(weights_buffer->parent->data_buffer),
+                          reinterpret_cast<float*>(bias_buffer->parent->data_buffer));
+        return;
     }
     auto num_output_fm_items =
         (output_buffer->view_end.t[NN_DATA_COORD_z] - output_buffer->view_begin.t[NN_DATA_COORD_z] + 1) /
@@ -1295,7 +1296,8 @@ void convolution_f32::forward(const nn::workload_data<> *input_buffer,
     if (device->thread_pool.get_num_threads() < 2 || total_workers < 2)
     {
         // Its tiny data or there is only one thread available - just do it singlethreaded way.
-        convolution_f32_impl::choose_convolution_padding_mode_and_activation(input_buffer, padding, center_offset_x, center_offset_y, stride_x, stride_y, activation, weights_buffer, bias_buffer, output_buffer);
+        convolution_f32_impl::scratch_pool<convolution_f32_impl::border_staging>::lease call_staging(staging, 1);
+        convolution_f32_impl::choose_convolution_padding_mode_and_activation(input_buffer, padding, center_offset_x, center_offset_y, stride_x, stride_y, activation, weights_buffer, bias_buffer, output_buffer, call_staging[0]);
     }
     else
     {
@@ -1423,6 +1425,7 @@ void convolution_f32::forward(const nn::workload_data<> *input_buffer,
         // Run threads.
         std::vector<nn_multithreaded_request> job(total_workers);
         std::vector<convolution_f32_impl::parameters_convolution_f32_avx2> request_handles(total_workers);
+        convolution_f32_impl::scratch_pool<convolution_f32_impl::border_staging>::lease work_item_staging(staging, total_workers);
 
         for (auto item_in_pool = 0u; item_in_pool < total_workers; ++item_in_pool)
         {
@@ -1435,7 +1438,8 @@ void convolution_f32::forward(const nn::workload_data<> *input_buffer,
                                                             &activation,
                                                             weight_views[item_in_pool],
                                                             bias_views[item_in_pool],
-                                                            output_views[item_in_pool]);
+                                                            output_views[item_in_pool],
+                                                            &work_item_staging[item_in_pool]);
 
             job[item_in_pool].callback = convolution_f32_impl::unpack_convolve_callback_handle;
             job[item_in_pool].request_handle = &request_handles[item_in_pool];
@@ -1461,7 +1465,7 @@ void convolution_f32::prepare_forward(
     const nn::workload_data<> *bias_buffer,
     nn::workload_data<> *output_buffer)
 {
-    prepared_for = std::make_tuple(nullptr, nullptr, nullptr, nullptr);
+    compiled.reset();
     if (output_buffer->get_length(NN_DATA_COORD_z) % 16 != 0) return;
     if (input_buffer->get_length() != input_buffer->parent->lengths) return;
     if (output_buffer->get_length() != output_buffer->parent->lengths) return;
@@ -1469,14 +1473,9 @@ void convolution_f32::prepare_forward(
     if (center_offset_y != 0) return;
     if (batch_size % 24 != 0) return;
 
-    auto input = reinterpret_cast<float*>(input_buffer->parent->data_buffer);
-    auto output = reinterpret_cast<float*>(output_buffer->parent->data_buffer);
-    auto weights = reinterpret_cast<float*>(weights_buffer->parent->data_buffer);
-    auto bias = reinterpret_cast<float*>(bias_buffer->parent->data_buffer);
     compiled.reset(new jit_convolution_zxyn(
             batch_size,
             activation.function == NN_ACTIVATION_FUNCTION_RELU,
-            output,
             output_size_x,
             output_size_y,
             output_size_z,
@@ -1485,11 +1484,11 @@ void convolution_f32::prepare_forward(
             input_size_z,
             stride_x,
             stride_y,
-            weights,
             kernel_w,
             kernel_h,
-            bias));
-    prepared_for = std::make_tuple(input, output, weights, bias);
+            &device->jit_cache));
+    compiled_input_lengths = input_buffer->get_length();
+    compiled_output_lengths = output_buffer->get_length();
 }
 
 void convolution_f32::update_bias_by_linear_factors(
@@ -29,11 +29,72 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "device/cpu/api_internal/nn_device_interface_0_internal.h"
 #include "device/api/nn_primitives_api_0.h"
+#include "device/common/nn_allocate.h"
 #include "helper_zxyn_f32.h"
 #include "convolution_jit.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace layer {
 
+namespace convolution_f32_impl {
+// Memory for zero-padded copies of input strips read by borders of output view. It grows to the largest
+// strip and is kept for later calls, so every caller running at the same time needs its own.
+class border_staging {
+  public:
+    border_staging() : buffer(nullptr, nn_delete_aligned), size(0) {}
+
+    // throws std::bad_alloc if buffer can't be grown
+    float *get(size_t required_size);
+
+  private:
+    std::unique_ptr<float, decltype(&nn_delete_aligned)> buffer;
+    size_t size;
+};
+
+// Sets of scratch objects kept for later calls of primitive. Each running call leases set of its own, so calls
+// running at the same time (several execution contexts of workload, forward_async) never share one.
+template <typename T_scratch>
+class scratch_pool {
+  public:
+    // takes free set (growing it to required count) and gives it back at end of scope
+    class lease {
+      public:
+        lease(scratch_pool &owner, size_t count) : owner(owner) {
+            {
+                std::lock_guard<std::mutex> lock(owner.mutex);
+                if (!owner.free_sets.empty()) {
+                    set = std::move(owner.free_sets.back());
+                    owner.free_sets.pop_back();
+                }
+            }
+            if (set.size() < count)
+                set.resize(count);
+        }
+
+        ~lease() {
+            std::lock_guard<std::mutex> lock(owner.mutex);
+            owner.free_sets.push_back(std::move(set));
+        }
+
+        T_scratch &operator[](size_t index) { return set[index]; }
+
+      private:
+        lease(const lease &) = delete;
+        lease &operator=(const lease &) = delete;
+
+        scratch_pool &owner;
+        std::vector<T_scratch> set;
+    };
+
+  private:
+    std::mutex mutex;
+    std::vector<std::vector<T_scratch>> free_sets;
+};
+}
+
 class convolution_f32 : public helper_zxyn_f32::primitive_zxyn_f32_base {
   public:
     convolution_f32(const size_t kernel_w,
@@ -135,8 +196,29 @@ class convolution_f32 : public helper_zxyn_f32::primitive_zxyn_f32_base {
     const nn_argument_activation_t activation;
 
     std::shared_ptr<jit_convolution> compiled;
-    std::tuple<float*, float*, float*, float*> prepared_for;
+    nn_workload_data_coords_t compiled_input_lengths;
+    nn_workload_data_coords_t compiled_output_lengths;
+
+    // staging of single threaded forward or of each work item of multithreaded one, leased by every call
+    convolution_f32_impl::scratch_pool<convolution_f32_impl::border_staging> staging;
+
+    friend class convolution_normalization_pooling_f32;
 };
 
 void run_multithreaded_convolve_work_item_backward(nn_workload_item *const work_item);
+
+namespace convolution_f32_impl {
+// single threaded convolution of output view, borders are computed on zero-padded copies of input
+void choose_convolution_padding_mode_and_activation(const nn::workload_data<> *input,
+                                                    const NN_PADDING_MODE padding,
+                                                    const int32_t center_offset_x,
+                                                    const int32_t center_offset_y,
+                                                    const size_t stride_x,
+                                                    const size_t stride_y,
+                                                    const nn_argument_activation_t &activation,
+                                                    const nn::workload_data<> *weights,
+                                                    const nn::workload_data<> *bias,
+                                                    nn::workload_data<> *output,
+                                                    border_staging &staging);
+}
 }
@@ -67,12 +67,6 @@ void convolution_f32_batch24n::forward(const nn::workload_data<> *input_buffer,
                               const nn::workload_data<> *bias_buffer,
                               nn::workload_data<> *output_buffer)
 {
-    if (prepared_for != std::make_tuple((float*)input_buffer->parent->data_buffer,
-                                        (float*)output_buffer->parent->data_buffer,
-                                        (float*)weights_buffer->parent->data_buffer,
-                                        (float*)bias_buffer->parent->data_buffer))
-        throw std::runtime_error("convolution forward called on different buffers than prepared for");
-
     convolution::forward::convolve_fst_threaded_batch(
         const_cast<nn_device_internal*>(device)->thread_pool,
         compiled_convolution,
@@ -80,7 +74,7 @@ void convolution_f32_batch24n::forward(const nn::workload_data<> *input_buffer,
         (float*)output_buffer->parent->data_buffer,
         (float*)weights_buffer->parent->data_buffer,
         (float*)bias_buffer->parent->data_buffer,
-        batch_size,
+        make<Batch>(output_buffer->get_length(NN_DATA_COORD_n) * BATCH_BLOCK_LENGTH),
         kernel_info,
         in_full_dims,
         out_full_dims,
@@ -197,12 +191,7 @@ void convolution_f32_batch24n::prepare_forward(
              make<OutputFeats>(output_buffer->get_length(NN_DATA_COORD_z)),
             {make<Rows>((uint64_t)kernel_info.center.row), make<Cols>((uint64_t)kernel_info.center.col)},
             stride_info.stride};
-    
-    prepared_for = std::make_tuple(
-        (float*)input_buffer->parent->data_buffer,
-        (float*)output_buffer->parent->data_buffer,
-        (float*)weights_buffer->parent->data_buffer,
-        (float*)bias_buffer->parent->data_buffer);
+
 
     compiled_convolution = compileConvolution(
         device->thread_pool.get_num_threads(),
@@ -215,11 +204,8 @@ void convolution_f32_batch24n::prepare_forward(
         make<InputFeatsStart>(input_buffer->view_begin.t[NN_DATA_COORD_z]),
         make<OutputFeatsStart>(output_buffer->view_begin.t[NN_DATA_COORD_z]),
         output_buffer->get_length(NN_DATA_COORD_n),
-        std::get<0>(prepared_for),
-        std::get<1>(prepared_for),
-        std::get<2>(prepared_for),
-        std::get<3>(prepared_for),
-        (activation.function == NN_ACTIVATION_FUNCTION_RELU));
+        (activation.function == NN_ACTIVATION_FUNCTION_RELU),
+        &device->jit_cache);
 }
 
 convolution_f32_batch24n::convolution_f32_batch24n(ValueU64<Batch> batch_size,
@@ -232,7 +218,6 @@ convolution_f32_batch24n::convolution_f32_batch24n(ValueU64<Batch> batch_size,
     , kernel_info(kernel_info)
     , activation(activation)
     , device(device)
-    , prepared_for(std::make_tuple(nullptr, nullptr, nullptr, nullptr))
     , in_full_dims(make<InputHeight>(0u), make<InputWidth>(0u), make<InputFeats>(0u))
     , out_full_dims(make<OutputHeight>(0u), make<OutputWidth>(0u), make<OutputFeats>(0u))
     , stride_info(StrideInfo{{make<Rows>(0u), make<Cols>(0u)},
@@ -283,7 +268,18 @@ bool convolution_f32_batch24n::validate_input(size_t index, nn_workload_data_t *
 
 std::vector<nn_workload_data_t *> convolution_f32_batch24n::create_inputs(bool allocate_delta)
 {
-    throw std::logic_error("unimplemented");
+    // input of "same" size, kernel reads zeros where it crosses borders (as on buffers converted to batch block)
+    auto input_size = [](uint64_t output, uint64_t stride, uint64_t kernel, uint64_t center) {
+            return static_cast<uint32_t>(std::max<int64_t>(
+                static_cast<int64_t>((output - 1) * stride + kernel) - 2 * static_cast<int64_t>(center), 1));
+        };
+    return {nn::data_helper<NN_WORKLOAD_DATA_TAG_NBLOCKZXYN, nn::layout_nblockzxyn_f32>::create(
+                batch_size,
+                input_size(out_dims.width, kernel_info.stride.cols, kernel_info.dims.width, kernel_info.center.col),
+                input_size(out_dims.height, kernel_info.stride.rows, kernel_info.dims.height, kernel_info.center.row),
+                kernel_info.dims.feats,
+                BATCH_ACCEPTED_BLOCK,
+                allocate_delta)};
 }
 
 std::vector<nn_workload_data_t *> convolution_f32_batch24n::create_parameters(bool allocate_delta)
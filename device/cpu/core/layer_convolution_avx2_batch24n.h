@@ -82,7 +82,6 @@ protected:
     const nn_argument_activation_t activation;
     nn_device_internal *const device;
 
-    std::tuple<float*, float*, float*, float*> prepared_for;
     InputDimensions in_full_dims;
     OutputDimensions out_full_dims;
     StrideInfo stride_info;
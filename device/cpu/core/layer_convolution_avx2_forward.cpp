@@ -471,11 +471,8 @@ CompiledKernelConvolution* compileConvolution(
     ValueU64<InputFeatsStart> infeats_window_start,
     ValueU64<OutputFeatsStart> outfeats_window_start,
     uint64_t batch_iterations,
-    float* input,
-    float* output,
-    float* weights,
-    float* bias,
-    bool apply_relu)
+    bool apply_relu,
+    jit_code_cache* code_cache)
 {
 
     if ((kernel_info.dims.width == kernel_info.dims.height)
@@ -489,7 +486,6 @@ CompiledKernelConvolution* compileConvolution(
                 apply_relu,
                 num_of_threads,
 
-                output,
                 full_output_dimensions.width,
                 full_output_dimensions.height,
                 full_output_dimensions.feats,
@@ -497,8 +493,7 @@ CompiledKernelConvolution* compileConvolution(
                 output_dimensions.height,
                 output_dimensions.feats,
                 outfeats_window_start,
-                
-                input,
+
                 full_input_dimensions.width,
                 full_input_dimensions.height,
                 full_input_dimensions.feats,
@@ -509,16 +504,15 @@ CompiledKernelConvolution* compileConvolution(
 
                 stride.stride.cols,
                 stride.stride.rows,
-                
-                weights,
+
                 kernel_info.dims.width,
                 kernel_info.dims.height,
                 kernel_info.center.col,
                 kernel_info.center.row,
 
-                bias,
                 1,
-                1)};
+                1,
+                code_cache)};
     }
     else
     {
@@ -552,8 +546,7 @@ void convolve_fst_threaded_batch(
 
     if (func->xbyak_conv)
     {
-        for (auto job : func->xbyak_conv->jobs)
-            thread_pool.push_job(job);
+        func->xbyak_conv->execute(thread_pool, output, input, kernel, bias);
     }
     else
     {
@@ -600,9 +593,9 @@ void convolve_fst_single_threaded(
     assert(batch % BATCH == 0);
     if (func->xbyak_conv)
     {
-        for (auto job : func->xbyak_conv->jobs)
-            for (auto task : job)
-                task.callback(task.request_handle);
+        // pool without worker threads runs all jobs on the calling thread
+        nn_thread_worker_pool single_thread(1);
+        func->xbyak_conv->execute(single_thread, output, input, kernel, bias);
     }
     else
     {
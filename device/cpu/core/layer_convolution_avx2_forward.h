@@ -59,11 +59,8 @@ CompiledKernelConvolution* compileConvolution(
     ValueU64<InputFeatsStart> infeats_window_start,
     ValueU64<OutputFeatsStart> outfeats_window_start,
     uint64_t batch_iterations,
-    float* input,
-    float* output,
-    float* weights,
-    float* bias,
-    bool apply_relu = false);
+    bool apply_relu = false,
+    jit_code_cache* code_cache = nullptr);
 
 void convolve_fst_threaded_batch(
     nn_thread_worker_pool& thread_pool,
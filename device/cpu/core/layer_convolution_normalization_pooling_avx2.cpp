@@ -0,0 +1,300 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "layer_convolution_normalization_pooling_avx2.h"
+
+#include <immintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "device/cpu/api_internal/data_helper.h"
+
+namespace layer {
+namespace {
+// SIMD width of normalization kernel, it processes feature maps in such chunks
+const auto C_simd_width = sizeof(__m256) / sizeof(float);
+
+// Convolution rows of single job are kept within this size, so normalization and pooling read them from L2.
+const size_t C_tile_size = 256 * 1024;
+}
+
+convolution_normalization_pooling_f32::convolution_normalization_pooling_f32(
+    std::unique_ptr<convolution_f32> convolution,
+    std::unique_ptr<normalization_response_across_maps_f32> normalization,
+    std::unique_ptr<pooling_f32> pooling)
+    : primitive_zxyn_f32_base(convolution->batch_size,
+                              convolution->input_size_z,
+                              pooling->output_size_x,
+                              pooling->output_size_y,
+                              pooling->output_size_z,
+                              pooling->output_padding_left,
+                              pooling->output_padding_right,
+                              pooling->output_padding_top,
+                              pooling->output_padding_bottom,
+                              convolution->device),
+      convolution(std::move(convolution)),
+      normalization(std::move(normalization)),
+      pooling(std::move(pooling)) {}
+
+bool convolution_normalization_pooling_f32::can_fuse(const convolution_f32 *convolution,
+                                                     const normalization_response_across_maps_f32 *normalization,
+                                                     const pooling_f32 *pooling)
+{
+    if (convolution->padding != NN_PADDING_MODE_DATA_OR_ZERO)
+        return false;
+
+    if (normalization->batch_size != convolution->batch_size ||
+        normalization->output_size_x != convolution->output_size_x ||
+        normalization->output_size_y != convolution->output_size_y ||
+        normalization->output_size_z != convolution->output_size_z)
+        return false;
+
+    // Normalization is computed in place, every chunk of maps reads neighbours of the next one before it is stored.
+    if (convolution->output_size_z % C_simd_width != 0 || normalization->n / 2 > C_simd_width)
+        return false;
+
+    if (pooling->pooling_mode != NN_POOLING_MODE_MAX ||
+        pooling->center_offset_x != 0 ||
+        pooling->center_offset_y != 0 ||
+        pooling->batch_size != convolution->batch_size ||
+        pooling->output_size_z != convolution->output_size_z)
+        return false;
+
+    // Windows of pooling have to stay within convolution output, rows of each band are computed only once.
+    return (pooling->output_size_x - 1) * pooling->pool_stride_x + pooling->pool_size_x <= convolution->output_size_x &&
+           (pooling->output_size_y - 1) * pooling->pool_stride_y + pooling->pool_size_y <= convolution->output_size_y;
+}
+
+void convolution_normalization_pooling_f32::run_band(const nn::workload_data<> *input,
+                                                     const nn::workload_data<> *weights,
+                                                     const nn::workload_data<> *bias,
+                                                     nn::workload_data<> *output,
+                                                     uint32_t image,
+                                                     uint32_t first_row,
+                                                     uint32_t last_row,
+                                                     job_scratch &scratch)
+{
+    const auto convolution_first_row = static_cast<uint32_t>(first_row * pooling->pool_stride_y);
+    const auto convolution_rows = static_cast<uint32_t>((last_row - first_row) * pooling->pool_stride_y + pooling->pool_size_y);
+
+    // Convolution rows of band, normalized in place.
+    nn::workload_data<> tile(
+        NN_WORKLOAD_DATA_TAG_ZXYN,
+        scratch.tile.get(),
+        nn_workload_data_coords_t(1,
+                                  static_cast<uint32_t>(convolution->output_size_x),
+                                  convolution_rows,
+                                  static_cast<uint32_t>(convolution->output_size_z),
+                                  1,
+                                  1),
+        nn::data_helper<NN_WORKLOAD_DATA_TAG_ZXYN, nn::layout_zxyn_f32>::layout);
+
+    helper_zxyn_f32::image_of_buffer input_image(input, image);
+    const auto input_first_row = input_image.view.view_begin.t[NN_DATA_COORD_y] + convolution_first_row * convolution->stride_y;
+    nn::workload_data<> input_band(
+        input_image.buffer,
+        nn_workload_data_coords_t(0,
+                                  input_image.view.view_begin.t[NN_DATA_COORD_x],
+                                  static_cast<uint32_t>(input_first_row),
+                                  input_image.view.view_begin.t[NN_DATA_COORD_z],
+                                  0,
+                                  0),
+        nn_workload_data_coords_t(0,
+                                  input_image.view.view_end.t[NN_DATA_COORD_x],
+                                  std::min(static_cast<uint32_t>(input_first_row + (convolution_rows - 1) * convolution->stride_y),
+                                           input_image.buffer.parent->lengths.t[NN_DATA_COORD_y] - 1),
+                                  input_image.view.view_end.t[NN_DATA_COORD_z],
+                                  0,
+                                  0));
+
+    convolution_f32_impl::choose_convolution_padding_mode_and_activation(&input_band,
+                                                                        convolution->padding,
+                                                                        convolution->center_offset_x,
+                                                                        convolution->center_offset_y,
+                                                                        convolution->stride_x,
+                                                                        convolution->stride_y,
+                                                                        convolution->activation,
+                                                                        weights,
+                                                                        bias,
+                                                                        &tile,
+                                                                        scratch.staging);
+
+    normalization->run_3d_normalization_work_item(&tile, &tile, nullptr);
+
+    helper_zxyn_f32::image_of_buffer output_image(output, image);
+    nn::workload_data<> output_band(
+        output_image.view,
+        nn_workload_data_coords_t(0, 0, first_row, 0, 0, 0),
+        nn_workload_data_coords_t(0,
+                                  output_image.view.get_length(NN_DATA_COORD_x) - 1,
+                                  last_row,
+                                  output_image.view.get_length(NN_DATA_COORD_z) - 1,
+                                  0,
+                                  0));
+
+    pooling->run_pooling(&tile, nullptr, &output_band);
+}
+
+struct convolution_normalization_pooling_f32_request_handle {
+    convolution_normalization_pooling_f32 *primitive;
+    const nn::workload_data<> *input;
+    const nn::workload_data<> *weights;
+    const nn::workload_data<> *bias;
+    nn::workload_data<> *output;
+    uint32_t num_rows;
+    uint32_t band_rows;
+    uint32_t bands_per_image;
+    uint32_t total_bands;
+    std::atomic<uint32_t> *next_band;
+    convolution_normalization_pooling_f32::job_scratch *scratch;
+};
+
+void unpack_convolution_normalization_pooling_callback_handle(void *void_handle)
+{
+    auto handle = reinterpret_cast<convolution_normalization_pooling_f32_request_handle *>(void_handle);
+    for (auto band = handle->next_band->fetch_add(1); band < handle->total_bands; band = handle->next_band->fetch_add(1))
+    {
+        const auto first_row = band % handle->bands_per_image * handle->band_rows;
+        handle->primitive->run_band(handle->input,
+                                    handle->weights,
+                                    handle->bias,
+                                    handle->output,
+                                    band / handle->bands_per_image,
+                                    first_row,
+                                    std::min(first_row + handle->band_rows, handle->num_rows) - 1,
+                                    *handle->scratch);
+    }
+}
+
+void convolution_normalization_pooling_f32::forward(const nn::workload_data<> *input,
+                                                    const nn::workload_data<> *weights,
+                                                    const nn::workload_data<> *bias,
+                                                    nn::workload_data<> *output)
+{
+    const auto num_images = output->get_length(NN_DATA_COORD_n);
+    const auto num_rows = output->get_length(NN_DATA_COORD_y);
+    const auto num_threads = device->thread_pool.get_num_threads();
+
+    // Bands are as high as tile size allows, but lowered until there is band for every thread.
+    const auto convolution_row_size = convolution->output_size_x * convolution->output_size_z * sizeof(float);
+    const auto tile_rows = std::max(C_tile_size / convolution_row_size, pooling->pool_size_y);
+    const auto rows_in_tile = (tile_rows - pooling->pool_size_y) / pooling->pool_stride_y + 1;
+    const auto bands_per_image = (num_threads + num_images - 1) / num_images;
+    const auto rows_per_thread = (num_rows + bands_per_image - 1) / bands_per_image;
+    const auto band_rows = static_cast<uint32_t>(std::max<size_t>(std::min<size_t>(rows_in_tile, rows_per_thread), 1));
+    const auto num_bands = (num_rows + band_rows - 1) / band_rows;
+
+    // Jobs take bands of all images from shared counter, tiles of jobs are leased for this call.
+    const auto total_bands = static_cast<uint32_t>(num_images * num_bands);
+    const auto num_jobs = std::min<size_t>(std::max<size_t>(num_threads, 1), total_bands);
+    const auto tile_size = ((band_rows - 1) * pooling->pool_stride_y + pooling->pool_size_y) *
+                           convolution->output_size_x * convolution->output_size_z;
+    convolution_f32_impl::scratch_pool<job_scratch>::lease job_scratches(scratch, num_jobs);
+    for (auto job = 0u; job < num_jobs; ++job)
+        if (job_scratches[job].tile_size < tile_size)
+        {
+            job_scratches[job].tile = nn_make_unique_aligned<float>(tile_size);
+            job_scratches[job].tile_size = tile_size;
+        }
+
+    std::atomic<uint32_t> next_band(0);
+
+    std::vector<convolution_normalization_pooling_f32_request_handle> request_handles;
+    for (auto job = 0u; job < num_jobs; ++job)
+        request_handles.push_back({this,
+                                   input,
+                                   weights,
+                                   bias,
+                                   output,
+                                   num_rows,
+                                   band_rows,
+                                   static_cast<uint32_t>(num_bands),
+                                   total_bands,
+                                   &next_band,
+                                   &job_scratches[job]});
+
+    if (request_handles.size() < 2)
+    {
+        // Its tiny data or there is only one thread available - just do it singlethreaded way.
+        for (auto &handle : request_handles)
+            unpack_convolution_normalization_pooling_callback_handle(&handle);
+    }
+    else
+    {
+        std::vector<nn_multithreaded_request> job(request_handles.size());
+        for (auto item_in_pool = 0u; item_in_pool < request_handles.size(); ++item_in_pool)
+        {
+            job[item_in_pool].callback = unpack_convolution_normalization_pooling_callback_handle;
+            job[item_in_pool].request_handle = &request_handles[item_in_pool];
+        }
+
+        // Wait for all sub threads.
+        device->thread_pool.push_job(job);
+    }
+}
+
+void convolution_normalization_pooling_f32::forward(const std::vector<const nn_workload_data_t *> &inputs,
+                                                    const std::vector<const nn_workload_data_t *> &parameters,
+                                                    const std::vector<nn_workload_data_t *> &outputs)
+{
+    assert(inputs.size() == 1);
+    assert(parameters.size() == 2);
+    assert(outputs.size() == 1);
+
+    forward(reinterpret_cast<const nn::workload_data<> *>(inputs[0]),
+            reinterpret_cast<const nn::workload_data<> *>(parameters[0]),
+            reinterpret_cast<const nn::workload_data<> *>(parameters[1]),
+            nn::workload_data_cast<>(outputs[0]));
+}
+
+std::vector<nn_workload_data_t *> convolution_normalization_pooling_f32::create_inputs(bool allocate_delta)
+{
+    return convolution->create_inputs(allocate_delta);
+}
+
+std::vector<nn_workload_data_t *> convolution_normalization_pooling_f32::create_parameters(bool allocate_delta)
+{
+    return convolution->create_parameters(allocate_delta);
+}
+
+bool convolution_normalization_pooling_f32::validate_input(size_t index, nn_workload_data_t *data)
+{
+    return convolution->validate_input(index, data);
+}
+
+size_t convolution_normalization_pooling_f32::get_required_input_w()
+{
+    return convolution->get_required_input_w();
+}
+
+size_t convolution_normalization_pooling_f32::get_required_input_h()
+{
+    return convolution->get_required_input_h();
+}
+} // namespace layer
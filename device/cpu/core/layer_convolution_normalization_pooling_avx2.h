@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/api/nn_primitives_api_0.h"
+#include "helper_zxyn_f32.h"
+#include "layer_convolution_avx2.h"
+#include "layer_normalization_avx2.h"
+#include "layer_pooling_avx2.h"
+
+#include <memory>
+#include <vector>
+
+namespace layer {
+struct convolution_normalization_pooling_f32_request_handle;
+
+// Convolution followed by response normalization across maps and max pooling, computed in tiles.
+// Band of rows needed by band of pooled rows of one image is convolved into tile, normalized in place
+// and pooled, so activations are reused while they are still in cache. There is one job per thread; jobs
+// take next band of any image from shared counter until all are done, so thread finishing early takes
+// over remaining bands. Each job computes in its own tile, tiles are leased by every call and kept.
+// Kernels of primitives merged by compiler are reused, fused primitive owns them.
+class convolution_normalization_pooling_f32 : public helper_zxyn_f32::primitive_zxyn_f32_base {
+  public:
+    convolution_normalization_pooling_f32(std::unique_ptr<convolution_f32> convolution,
+                                          std::unique_ptr<normalization_response_across_maps_f32> normalization,
+                                          std::unique_ptr<pooling_f32> pooling);
+
+    virtual ~convolution_normalization_pooling_f32() {}
+
+    // true if primitives are chained on equal shapes in way fused forward supports
+    static bool can_fuse(const convolution_f32 *convolution,
+                         const normalization_response_across_maps_f32 *normalization,
+                         const pooling_f32 *pooling);
+
+    virtual std::vector<nn_workload_data_t *> create_inputs(bool allocate_delta = false) override;
+
+    virtual std::vector<nn_workload_data_t *> create_parameters(bool allocate_delta = false) override;
+
+    virtual bool validate_input(size_t index, nn_workload_data_t *data) override;
+
+    void forward(const std::vector<const nn_workload_data_t *> &inputs,
+                 const std::vector<const nn_workload_data_t *> &parameters,
+                 const std::vector<nn_workload_data_t *> &outputs) override;
+
+  protected:
+    virtual size_t get_required_input_w() override;
+    virtual size_t get_required_input_h() override;
+
+  private:
+    // memory of single job: tile of convolution rows and staging of convolution borders
+    struct job_scratch {
+        job_scratch() : tile(nullptr, nn_delete_aligned), tile_size(0) {}
+
+        std::unique_ptr<float, decltype(&nn_delete_aligned)> tile;
+        size_t tile_size;
+        convolution_f32_impl::border_staging staging;
+    };
+
+    void forward(const nn::workload_data<> *input,
+                 const nn::workload_data<> *weights,
+                 const nn::workload_data<> *bias,
+                 nn::workload_data<> *output);
+
+    void run_band(const nn::workload_data<> *input,
+                  const nn::workload_data<> *weights,
+                  const nn::workload_data<> *bias,
+                  nn::workload_data<> *output,
+                  uint32_t image,
+                  uint32_t first_row,
+                  uint32_t last_row,
+                  job_scratch &scratch);
+
+    friend struct convolution_normalization_pooling_f32_request_handle;
+    friend void unpack_convolution_normalization_pooling_callback_handle(void *void_handle);
+
+    std::unique_ptr<convolution_f32> convolution;
+    std::unique_ptr<normalization_response_across_maps_f32> normalization;
+    std::unique_ptr<pooling_f32> pooling;
+
+    convolution_f32_impl::scratch_pool<job_scratch> scratch;
+};
+}
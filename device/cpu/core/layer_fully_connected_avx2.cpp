@@ -1399,7 +1399,7 @@ void fully_connected_f32::forward(const nn::workload_data<> *input,
                                   const nn::workload_data<> *weights,
                                   const nn::workload_data<> *bias,
                                   nn::workload_data<> *output) {
-    auto num_hardware_threads = std::min(device->thread_pool.get_num_threads(), max_threads);
+    auto num_hardware_threads = std::min(device->thread_pool.get_num_threads(), thread_limit);
 
     nn_workload_data_coords_t input_view_coords(
         input->parent->lengths.t[NN_DATA_COORD_n],
@@ -1608,8 +1608,7 @@ void fully_connected_f32::forward(const nn::workload_data<> *input,
         }
 
         // Wait for all sub threads.
-        // It can be affordable ( in terms of performance)
-        device->thread_pool.push_job_on_physical_cores_if_beneficial(job);
+        device->thread_pool.push_job(job);
 
         // Cleanup dynamic memory.
         for (auto thread_id = 0u; thread_id < num_hardware_threads; ++thread_id)
@@ -2075,7 +2074,8 @@ fully_connected_f32::fully_connected_f32(size_t num_input,
       num_output(num_output),
       activation(activation),
       batch_size(batch_size),
-      device(device) {
+      device(device),
+      thread_limit(max_threads) {
     assert(batch_size == 1 || batch_size == 8 || batch_size == 48);
 }
 
@@ -2094,7 +2094,8 @@ fully_connected_f32::fully_connected_f32(size_t input_size_x,
       num_output(num_output),
       activation(activation),
       batch_size(batch_size),
-      device(device) {
+      device(device),
+      thread_limit(max_threads) {
     assert(batch_size == 1 || batch_size == 8 || batch_size == 48);
 }
 bool fully_connected_f32::validate_input(size_t index, nn_workload_data_t *data)
@@ -93,6 +93,9 @@ class fully_connected_f32 : public nn_primitive_t {
     uint32_t get_input_size() {return num_input;}
     uint32_t get_output_size() {return num_output;}
 
+    // limits threads forward pass is split over (at most max_threads)
+    void set_thread_limit(size_t limit) {thread_limit = std::max(std::min(limit, max_threads), size_t(1));}
+
   private:
     virtual void forward(const nn::workload_data<> *input,
                          const nn::workload_data<> *weights,
@@ -140,6 +143,7 @@ class fully_connected_f32 : public nn_primitive_t {
     const size_t num_input, num_output, batch_size;
     const nn_argument_activation_t activation;
     nn_device_internal *device;
+    size_t thread_limit;
 
     static const nn_workload_data_layout_t& in_out_layout;
 };
@@ -250,15 +250,12 @@ void fully_connected_f32_batch24n::forward(const nn::workload_data<> *input_buff
                                            const nn::workload_data<> *bias_buffer,
                                            nn::workload_data<> *output_buffer)
 {
-    if (prepared_for != std::make_tuple((float*)input_buffer->parent->data_buffer,
-                                        (float*)output_buffer->parent->data_buffer,
-                                        (float*)weights_buffer->parent->data_buffer,
-                                        (float*)bias_buffer->parent->data_buffer))
-        throw std::runtime_error("fully connected forward called on different buffers than prepared for");
-
-    for (auto job : compiled->jobs)
-        device->thread_pool.push_job(job);
-
+    // weights are expected in layout converted by prepare_forward
+    compiled->execute(device->thread_pool,
+                      (float*)output_buffer->parent->data_buffer,
+                      (float*)input_buffer->parent->data_buffer,
+                      (float*)weights_buffer->parent->data_buffer,
+                      (float*)bias_buffer->parent->data_buffer);
 }
 
 void fully_connected_f32_batch24n::prepare_forward(
@@ -307,12 +304,10 @@ void fully_connected_f32_batch24n::prepare_forward(
             input_buffer->get_length(NN_DATA_COORD_n),
             apply_relu,
             num_of_threads,
-            output, output_feats, input, input_feats, weights, bias,
+            output_feats, input_feats, weights,
             128u,
-            outfeats_block_size));
-
-
-    prepared_for = std::make_tuple(input, output, weights, bias);
+            outfeats_block_size,
+            &device->jit_cache));
 }
 
 fully_connected_f32_batch24n::fully_connected_f32_batch24n(
@@ -366,7 +361,13 @@ bool fully_connected_f32_batch24n::validate_input(size_t index, nn_workload_data
 
 std::vector<nn_workload_data_t *> fully_connected_f32_batch24n::create_inputs(bool allocate_delta)
 {
-    throw std::logic_error("unimplemented");
+    return {nn::data_helper<NN_WORKLOAD_DATA_TAG_NBLOCKZXYN, nn::layout_nblockzxyn_f32>::create(
+                batch_size,
+                1,
+                1,
+                num_input,
+                BATCH_FC_ACCEPTED_BLOCK,
+                allocate_delta)};
 }
 
 std::vector<nn_workload_data_t *> fully_connected_f32_batch24n::create_parameters(bool allocate_delta)
@@ -76,7 +76,6 @@ private:
     const uint32_t batch_size;
     nn_device_internal* device;
 
-    std::tuple<float*, float*, float*, float*> prepared_for;
     std::shared_ptr<jit_convolution> compiled;
 };
 
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/common/nn_workload_data.h"
 #include "device/cpu/api_internal/nn_device_interface_0_internal.h"
 #include "layer_normalization_avx2.h"
+#include "nn_intrinsic_power.h"
 
 #include <immintrin.h>
 #include <string.h>
@@ -569,10 +570,27 @@ __m256 _inner_mm256_invpow075_ps(__m256 arg)
 enum EXP_APPROX
 {
     APPROX_NEGATIVE_0_75,
+    APPROX_NEGATIVE_0_5,
+    APPROX_NEGATIVE_1_0,
+    APPROX_ANY
 };
 
 template<EXP_APPROX T_approx> __m256 _internal_mm256_pow_ps                (__m256 base, __m256 exponent);
 template<>                    __m256 _internal_mm256_pow_ps<APPROX_NEGATIVE_0_75>   (__m256 base, __m256 exponent) {return _inner_mm256_invpow075_ps(base);}
+template<>                    __m256 _internal_mm256_pow_ps<APPROX_NEGATIVE_0_5>    (__m256 base, __m256 exponent) {return nn::intrinsics::invpow_ps<nn::intrinsics::invpow_kind::beta_05>(base, exponent);}
+template<>                    __m256 _internal_mm256_pow_ps<APPROX_NEGATIVE_1_0>    (__m256 base, __m256 exponent) {return nn::intrinsics::invpow_ps<nn::intrinsics::invpow_kind::beta_1>(base, exponent);}
+template<>                    __m256 _internal_mm256_pow_ps<APPROX_ANY>             (__m256 base, __m256 exponent) {return nn::intrinsics::pow_ps<nn::intrinsics::exp_accuracy::precise>(base, exponent);}
+
+static EXP_APPROX exp_approx_for_beta(float beta)
+{
+    switch(nn::intrinsics::invpow_kind_for(beta))
+    {
+    case nn::intrinsics::invpow_kind::beta_075: return APPROX_NEGATIVE_0_75;
+    case nn::intrinsics::invpow_kind::beta_05:  return APPROX_NEGATIVE_0_5;
+    case nn::intrinsics::invpow_kind::beta_1:   return APPROX_NEGATIVE_1_0;
+    default:                                    return APPROX_ANY;
+    }
+}
 
 template<EXP_APPROX T_approx, bool T_emit_intermediates>
 void run_3d_normalization_work_item_template(
@@ -690,41 +708,42 @@ void run_3d_normalization_work_item_template(
     }
 }
 
+template<EXP_APPROX T_approx>
+void run_3d_normalization_work_item_approx(
+    const nn::workload_data<> *input_view,
+    nn::workload_data<> *intermediate_output,
+    nn::workload_data<> *output_view,
+    uint32_t n,
+    float alpha,
+    uint32_t k,
+    float beta)
+{
+    if(intermediate_output != nullptr)
+        run_3d_normalization_work_item_template<T_approx, true>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+    else
+        run_3d_normalization_work_item_template<T_approx, false>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+}
+
 void normalization_response_across_maps_f32::run_3d_normalization_work_item(
     const nn::workload_data<> *input_view,
     nn::workload_data<> *output_view,
     nn::workload_data<> *intermediate_output)
 {
-    if(beta == 0.75f)
-    {
-        // Fast approximated exponent = -0.75.
-
-        if(intermediate_output != nullptr)
-        {
-            run_3d_normalization_work_item_template<APPROX_NEGATIVE_0_75, true>(
-                    input_view,
-                    intermediate_output,
-                    output_view,
-                    n,
-                    alpha,
-                    k,
-                    beta);
-        }
-        else
-        {
-            run_3d_normalization_work_item_template<APPROX_NEGATIVE_0_75, false>(
-                    input_view,
-                    intermediate_output,
-                    output_view,
-                    n,
-                    alpha,
-                    k,
-                    beta);
-        }
-    }
-    else
+    // Exponents -0.75, -0.5 and -1.0 have dedicated forms, others use vectorized logarithm and exponent.
+    switch(exp_approx_for_beta(beta))
     {
-        assert(0); // TODO
+    case APPROX_NEGATIVE_0_75:
+        run_3d_normalization_work_item_approx<APPROX_NEGATIVE_0_75>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+        break;
+    case APPROX_NEGATIVE_0_5:
+        run_3d_normalization_work_item_approx<APPROX_NEGATIVE_0_5>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+        break;
+    case APPROX_NEGATIVE_1_0:
+        run_3d_normalization_work_item_approx<APPROX_NEGATIVE_1_0>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+        break;
+    default:
+        run_3d_normalization_work_item_approx<APPROX_ANY>(input_view, intermediate_output, output_view, n, alpha, k, beta);
+        break;
     }
 }
 
@@ -1127,22 +1146,24 @@ void normalization_response_across_maps_f32::backward(
     const nn::workload_data<> *backward_input,
     nn::workload_data<> *backward_output)
 {
-    if(beta == 0.75f)
+    switch(exp_approx_for_beta(beta))
     {
-        // Fast approximated exponent = -0.75.
+    case APPROX_NEGATIVE_0_75:
         backward_inner_template<APPROX_NEGATIVE_0_75>(
-                forward_input,
-                forward_intermediate_data,
-                forward_output,
-                backward_input,
-                backward_output,
-                n,
-                alpha,
-                beta);
-    }
-    else
-    {
-        assert(0);
+            forward_input, forward_intermediate_data, forward_output, backward_input, backward_output, n, alpha, beta);
+        break;
+    case APPROX_NEGATIVE_0_5:
+        backward_inner_template<APPROX_NEGATIVE_0_5>(
+            forward_input, forward_intermediate_data, forward_output, backward_input, backward_output, n, alpha, beta);
+        break;
+    case APPROX_NEGATIVE_1_0:
+        backward_inner_template<APPROX_NEGATIVE_1_0>(
+            forward_input, forward_intermediate_data, forward_output, backward_input, backward_output, n, alpha, beta);
+        break;
+    default:
+        backward_inner_template<APPROX_ANY>(
+            forward_input, forward_intermediate_data, forward_output, backward_input, backward_output, n, alpha, beta);
+        break;
     }
 }
 
@@ -134,6 +134,7 @@ class normalization_response_across_maps_f32 : public helper_zxyn_f32::primitive
         nn::workload_data<> *intermediate_output);
 
     friend void unpack_3d_normalization_callback_handle(void *void_handle);
+    friend class convolution_normalization_pooling_f32;
 
     void run_multithreaded_3d_normalization_work_item(
         const nn::workload_data<> *input,
@@ -99,8 +99,9 @@ struct InputData
     {}
 };
 
-//for beta == 0.75f
-void intrinsic_version_for_0_75(InputData* args)
+//x^-beta of 0.75, 0.5 and 1.0 have dedicated forms, any other beta is computed from logarithm and exponent
+template <nn::intrinsics::invpow_kind T_kind>
+void intrinsic_version(InputData* args)
 {
     float* input = args->input;
     float* output = args->output;
@@ -114,6 +115,7 @@ void intrinsic_version_for_0_75(InputData* args)
     uint64_t n_shift = n_param / 2;
     __m256 alpha_mm = _mm256_set1_ps(alpha);
     __m256 k_mm = _mm256_set1_ps(k_param);
+    __m256 beta_mm = _mm256_set1_ps(beta);
 
     const uint64_t BATCH_BLOCKS = BATCH_ACCEPTED_BLOCK / BATCH_SHIFT;
 
@@ -125,7 +127,7 @@ void intrinsic_version_for_0_75(InputData* args)
             for (uint64_t j = 0; j < BATCH_BLOCKS; ++j)
             {
                 auto temp = _mm256_fmadd_ps(accs[j], alpha_mm, k_mm);
-                temp = nn::intrinsics::invpow_075(temp);
+                temp = nn::intrinsics::invpow_ps<T_kind>(temp, beta_mm);
                 auto src = _mm256_load_ps(input + i * BATCH_ACCEPTED_BLOCK + j * BATCH_SHIFT);
                 auto dest = output + i * BATCH_ACCEPTED_BLOCK + j * BATCH_SHIFT;
                 _mm256_storeu_ps(dest, _mm256_mul_ps(temp, src));
@@ -177,49 +179,10 @@ void intrinsic_version_for_0_75(InputData* args)
     }
 }
 
-//for any beta
-void naive(InputData* args)
+template <nn::intrinsics::invpow_kind T_kind>
+void intrinsic_wrapper(void* data_ptr)
 {
-    float* input = args->input;
-    float* output = args->output;
-    uint64_t feats = args->feats;
-    uint64_t n_param = args->n;
-    uint64_t k_param = args->k;
-    float alpha = args->alpha;// / (float)n_param;
-    float beta = args->beta;
-    float accs[BATCH_ACCEPTED_BLOCK] = {};
-
-    uint64_t n_shift = n_param / 2;
-
-    auto calc = [&](uint64_t i) {
-            for (uint64_t b = 0; b < BATCH_ACCEPTED_BLOCK; ++b)
-                output[i * BATCH_ACCEPTED_BLOCK + b] =
-                    input[i * BATCH_ACCEPTED_BLOCK + b] * std::pow(accs[b] * alpha + k_param, -beta);
-        };
-    auto add_top = [&](uint64_t i) {
-            for (uint64_t b = 0; b < BATCH_ACCEPTED_BLOCK; ++b)
-                accs[b] += input[i * BATCH_ACCEPTED_BLOCK + b] * input[i * BATCH_ACCEPTED_BLOCK + b];
-        };
-    auto sub_bottom = [&](uint64_t i) {
-            for (uint64_t b = 0; b < BATCH_ACCEPTED_BLOCK; ++b)
-                accs[b] -= input[i * BATCH_ACCEPTED_BLOCK + b] * input[i * BATCH_ACCEPTED_BLOCK + b];
-        };
-    for (uint64_t i = 0; i < n_shift; ++i) {
-        add_top(i);
-    }
-    for (uint64_t i = n_shift; i < n_param; ++i) {
-        add_top(i);
-        calc(i - n_shift);
-    }
-    for (uint64_t i = n_param; i < feats; ++i) {
-        add_top(i);
-        sub_bottom(i - n_param);
-        calc(i - n_shift);
-    }
-    for (uint64_t i = feats; i < feats + n_shift; ++i) {
-        sub_bottom(i - n_param);
-        calc(i - n_shift);
-    }
+    intrinsic_version<T_kind>(static_cast<InputData*>(data_ptr));
 }
 
 } // namespace
@@ -248,14 +211,14 @@ void normalization_response_across_maps_f32_batch24n::forward(
 {
     assert(input);
     assert(output);
-    static const auto naive_wrapper = [](void* data_ptr) {
-        auto data = static_cast<InputData*>(data_ptr);
-        naive(data);
-    };
-    static const auto intrinsic_wrapper = [](void* data_ptr) {
-        auto data = static_cast<InputData*>(data_ptr);
-        intrinsic_version_for_0_75(data);
-    };
+    void (*callback)(void*) = intrinsic_wrapper<nn::intrinsics::invpow_kind::any>;
+    switch (nn::intrinsics::invpow_kind_for(beta))
+    {
+    case nn::intrinsics::invpow_kind::beta_075: callback = intrinsic_wrapper<nn::intrinsics::invpow_kind::beta_075>; break;
+    case nn::intrinsics::invpow_kind::beta_05:  callback = intrinsic_wrapper<nn::intrinsics::invpow_kind::beta_05>; break;
+    case nn::intrinsics::invpow_kind::beta_1:   callback = intrinsic_wrapper<nn::intrinsics::invpow_kind::beta_1>; break;
+    default: break;
+    }
 
     assert(input->get_length() == output->get_length());
     assert(input->parent->layout == output->parent->layout);
@@ -298,10 +261,7 @@ void normalization_response_across_maps_f32_batch24n::forward(
                                          make<NParam>(norm_points),
                                          make<Width>(width));
 
-            if (beta == 0.75f)
-                jobs[job_index] = nn_multithreaded_request{intrinsic_wrapper, (void*)&jobs_args[job_index]};
-            else
-                jobs[job_index] = nn_multithreaded_request{naive_wrapper, (void*)&jobs_args[job_index]};
+            jobs[job_index] = nn_multithreaded_request{callback, (void*)&jobs_args[job_index]};
         }
     }
     const_cast<nn_device_internal*>(device)->thread_pool.push_job(jobs);
@@ -327,14 +287,14 @@ bool normalization_response_across_maps_f32_batch24n::validate_input(size_t, nn_
     throw std::logic_error("unimplemented");
 }
 
-std::vector<nn_workload_data_t *> normalization_response_across_maps_f32_batch24n::create_inputs(bool)
+std::vector<nn_workload_data_t *> normalization_response_across_maps_f32_batch24n::create_inputs(bool allocate_delta)
 {
-    throw std::logic_error("unimplemented");
+    return create_outputs(allocate_delta);
 }
 
 std::vector<nn_workload_data_t *> normalization_response_across_maps_f32_batch24n::create_parameters(bool)
 {
-    throw std::logic_error("unimplemented");
+    return {};
 }
 
 std::vector<nn_workload_data_t *> normalization_response_across_maps_f32_batch24n::create_outputs(bool allocate_delta)
@@ -97,6 +97,7 @@ protected:
     friend void unpack_pooling_callback_handle(void *void_handle);
     friend void wrapper_pooling_work_item(nn_workload_item *const work_item);
     friend void wrapper_pooling_work_item_backward(nn_workload_item *const work_item);
+    friend class convolution_normalization_pooling_f32;
 
     virtual bool validate_input(size_t index, nn_workload_data_t *data) override;
 
@@ -34,533 +34,234 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <immintrin.h>
 #include <string.h>
 #include <algorithm>
-
-// NN_CODE_UNREACHABLE signal to supporting compiler that specific location in code cannot be reached
-#if defined _MSC_VER
-#   define NN_UNREACHABLE_CODE __assume(0)
-#endif
-
-#if defined __GNUC__
-#   if (__GNUC__ * 100 + __GNUC_MINOR__) >= 405
-#       define NN_UNREACHABLE_CODE __builtin_unreachable()
-#   else
-#       define NN_UNREACHABLE_CODE
-#   endif
-#endif
-
-#if defined __clang__
-#   if __has_builtin(__builtin_unreachable)
-#       define NN_UNREACHABLE_CODE __builtin_unreachable()
-#   else
-#       define NN_UNREACHABLE_CODE
-#   endif
-#endif
+#include <cfloat>
+#include <cmath>
+#include <functional>
 
 // SIMD width for this implementation
 const auto C_simd_width = sizeof(__m256) / sizeof(float);
 
-static const auto C_max_acc_batch1 = 12u;
-static const auto C_max_acc_batch8 = 12u;
-static const auto C_max_acc_batch48 = 12u;
-
-static const auto C_batch8_size = C_simd_width;
-static const auto C_batch48_size = 6 * C_simd_width;
+// Minimal number of values processed by single job of softmax shared by threads.
+static const auto C_softmax_job_size = 8 * 1024u;
 
-static const auto C_data_stride_batch1 = C_simd_width * C_max_acc_batch1;
+// Vectors processed between updates of running maximum.
+static const auto C_softmax_max_block = 8u;
 
 namespace layer {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // forward implementation
 
-template<uint32_t T_SIZE, uint32_t T_batch_width>
-void softmax_finalize_block(
-    float* &output_ptr,
-    __m256 &acc_sum)
+namespace {
+
+/* part of softmax run by single job
+   Job sweeps count vectors placed stride floats apart. Vectors hold lanes valid values; the last
+   one holds last_lanes. Results of the first sweep are combined over jobs of the same group. */
+struct softmax_job
 {
-    // We are not using table of registers and unroll pragmas
-    // due to compiler which have issues with register allocation
-    // and needs special, obvious treatment. Template immediate
-    // arguments matching will remove all conditions in this code.
-    __m256  acc0, acc1, acc2, acc3, acc4,
-        acc5, acc6, acc7, acc8, acc9,
-        acc10, acc11, acc12, acc13, acc14;
-
-    // Load outputs and perform multiplication.
-    if (T_SIZE >=  1)  acc0 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  0 * T_batch_width), acc_sum);
-    if (T_SIZE >=  2)  acc1 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  1 * T_batch_width), acc_sum);
-    if (T_SIZE >=  3)  acc2 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  2 * T_batch_width), acc_sum);
-    if (T_SIZE >=  4)  acc3 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  3 * T_batch_width), acc_sum);
-    if (T_SIZE >=  5)  acc4 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  4 * T_batch_width), acc_sum);
-    if (T_SIZE >=  6)  acc5 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  5 * T_batch_width), acc_sum);
-    if (T_SIZE >=  7)  acc6 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  6 * T_batch_width), acc_sum);
-    if (T_SIZE >=  8)  acc7 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  7 * T_batch_width), acc_sum);
-    if (T_SIZE >=  9)  acc8 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  8 * T_batch_width), acc_sum);
-    if (T_SIZE >= 10)  acc9 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr +  9 * T_batch_width), acc_sum);
-    if (T_SIZE >= 11) acc10 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr + 10 * T_batch_width), acc_sum);
-    if (T_SIZE >= 12) acc11 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr + 11 * T_batch_width), acc_sum);
-    if (T_SIZE >= 13) acc12 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr + 12 * T_batch_width), acc_sum);
-    if (T_SIZE >= 14) acc13 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr + 13 * T_batch_width), acc_sum);
-    if (T_SIZE >= 15) acc14 = _mm256_mul_ps(_mm256_loadu_ps(output_ptr + 14 * T_batch_width), acc_sum);
-
-    // Store results.
-    if (T_SIZE >=  1) _mm256_storeu_ps(output_ptr +  0 * T_batch_width,  acc0);
-    if (T_SIZE >=  2) _mm256_storeu_ps(output_ptr +  1 * T_batch_width,  acc1);
-    if (T_SIZE >=  3) _mm256_storeu_ps(output_ptr +  2 * T_batch_width,  acc2);
-    if (T_SIZE >=  4) _mm256_storeu_ps(output_ptr +  3 * T_batch_width,  acc3);
-    if (T_SIZE >=  5) _mm256_storeu_ps(output_ptr +  4 * T_batch_width,  acc4);
-    if (T_SIZE >=  6) _mm256_storeu_ps(output_ptr +  5 * T_batch_width,  acc5);
-    if (T_SIZE >=  7) _mm256_storeu_ps(output_ptr +  6 * T_batch_width,  acc6);
-    if (T_SIZE >=  8) _mm256_storeu_ps(output_ptr +  7 * T_batch_width,  acc7);
-    if (T_SIZE >=  9) _mm256_storeu_ps(output_ptr +  8 * T_batch_width,  acc8);
-    if (T_SIZE >= 10) _mm256_storeu_ps(output_ptr +  9 * T_batch_width,  acc9);
-    if (T_SIZE >= 11) _mm256_storeu_ps(output_ptr + 10 * T_batch_width, acc10);
-    if (T_SIZE >= 12) _mm256_storeu_ps(output_ptr + 11 * T_batch_width, acc11);
-    if (T_SIZE >= 13) _mm256_storeu_ps(output_ptr + 12 * T_batch_width, acc12);
-    if (T_SIZE >= 14) _mm256_storeu_ps(output_ptr + 13 * T_batch_width, acc13);
-    if (T_SIZE >= 15) _mm256_storeu_ps(output_ptr + 14 * T_batch_width, acc14);
-
-    output_ptr += T_batch_width*T_SIZE;
+    size_t offset;
+    size_t stride;
+    size_t count;
+    uint32_t lanes;
+    uint32_t last_lanes;
+    size_t group;
+
+    float max[C_simd_width];
+    float sum[C_simd_width];
+};
+
+inline __m256i softmax_lane_mask(uint32_t lanes)
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
 }
 
-template<uint32_t T_SIZE, uint32_t T_batch_width>
-void softmax_compute_block(
-    float* &output_ptr,
-    __m256 &acc_sum)
+/* first sweep: running maximum and sum of exponents relative to it, separately for each lane */
+template <nn::intrinsics::exp_accuracy T_accuracy>
+void softmax_max_and_sum(softmax_job &job, const float *input)
 {
-    // We are not using table of registers and unroll pragmas
-    // due to compiler which have issues with register allocation
-    // and needs special, obvious treatment. Template immediate
-    // arguments matching will remove all conditions in this code.
-    __m256  acc0, acc1, acc2, acc3, acc4,
-            acc5, acc6, acc7, acc8, acc9,
-            acc10, acc11, acc12, acc13, acc14;
-
     using namespace nn::intrinsics;
-    // Load inputs and perform e^x
-    if (T_SIZE >=  1)  acc0 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  0 * T_batch_width));
-    if (T_SIZE >=  2)  acc1 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  1 * T_batch_width));
-    if (T_SIZE >=  3)  acc2 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  2 * T_batch_width));
-    if (T_SIZE >=  4)  acc3 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  3 * T_batch_width));
-    if (T_SIZE >=  5)  acc4 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  4 * T_batch_width));
-    if (T_SIZE >=  6)  acc5 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  5 * T_batch_width));
-    if (T_SIZE >=  7)  acc6 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  6 * T_batch_width));
-    if (T_SIZE >=  8)  acc7 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  7 * T_batch_width));
-    if (T_SIZE >=  9)  acc8 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  8 * T_batch_width));
-    if (T_SIZE >= 10)  acc9 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr +  9 * T_batch_width));
-    if (T_SIZE >= 11) acc10 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr + 10 * T_batch_width));
-    if (T_SIZE >= 12) acc11 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr + 11 * T_batch_width));
-    if (T_SIZE >= 13) acc12 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr + 12 * T_batch_width));
-    if (T_SIZE >= 14) acc13 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr + 13 * T_batch_width));
-    if (T_SIZE >= 15) acc14 = _inner_mm256_exp_ps(_mm256_loadu_ps(output_ptr + 14 * T_batch_width));
-
-    // Store results.
-    if (T_SIZE >=  1) _mm256_storeu_ps(output_ptr +  0 * T_batch_width,  acc0);
-    if (T_SIZE >=  2) _mm256_storeu_ps(output_ptr +  1 * T_batch_width,  acc1);
-    if (T_SIZE >=  3) _mm256_storeu_ps(output_ptr +  2 * T_batch_width,  acc2);
-    if (T_SIZE >=  4) _mm256_storeu_ps(output_ptr +  3 * T_batch_width,  acc3);
-    if (T_SIZE >=  5) _mm256_storeu_ps(output_ptr +  4 * T_batch_width,  acc4);
-    if (T_SIZE >=  6) _mm256_storeu_ps(output_ptr +  5 * T_batch_width,  acc5);
-    if (T_SIZE >=  7) _mm256_storeu_ps(output_ptr +  6 * T_batch_width,  acc6);
-    if (T_SIZE >=  8) _mm256_storeu_ps(output_ptr +  7 * T_batch_width,  acc7);
-    if (T_SIZE >=  9) _mm256_storeu_ps(output_ptr +  8 * T_batch_width,  acc8);
-    if (T_SIZE >= 10) _mm256_storeu_ps(output_ptr +  9 * T_batch_width,  acc9);
-    if (T_SIZE >= 11) _mm256_storeu_ps(output_ptr + 10 * T_batch_width, acc10);
-    if (T_SIZE >= 12) _mm256_storeu_ps(output_ptr + 11 * T_batch_width, acc11);
-    if (T_SIZE >= 13) _mm256_storeu_ps(output_ptr + 12 * T_batch_width, acc12);
-    if (T_SIZE >= 14) _mm256_storeu_ps(output_ptr + 13 * T_batch_width, acc13);
-    if (T_SIZE >= 15) _mm256_storeu_ps(output_ptr + 14 * T_batch_width, acc14);
-
-    // Sum up accumulators.
-    if (T_SIZE >=  1) acc_sum = _mm256_add_ps(acc0,  acc_sum);
-    if (T_SIZE >=  2) acc_sum = _mm256_add_ps(acc1,  acc_sum);
-    if (T_SIZE >=  3) acc_sum = _mm256_add_ps(acc2,  acc_sum);
-    if (T_SIZE >=  4) acc_sum = _mm256_add_ps(acc3,  acc_sum);
-    if (T_SIZE >=  5) acc_sum = _mm256_add_ps(acc4,  acc_sum);
-    if (T_SIZE >=  6) acc_sum = _mm256_add_ps(acc5,  acc_sum);
-    if (T_SIZE >=  7) acc_sum = _mm256_add_ps(acc6,  acc_sum);
-    if (T_SIZE >=  8) acc_sum = _mm256_add_ps(acc7,  acc_sum);
-    if (T_SIZE >=  9) acc_sum = _mm256_add_ps(acc8,  acc_sum);
-    if (T_SIZE >= 10) acc_sum = _mm256_add_ps(acc9,  acc_sum);
-    if (T_SIZE >= 11) acc_sum = _mm256_add_ps(acc10, acc_sum);
-    if (T_SIZE >= 12) acc_sum = _mm256_add_ps(acc11, acc_sum);
-    if (T_SIZE >= 13) acc_sum = _mm256_add_ps(acc12, acc_sum);
-    if (T_SIZE >= 14) acc_sum = _mm256_add_ps(acc13, acc_sum);
-    if (T_SIZE >= 15) acc_sum = _mm256_add_ps(acc14, acc_sum);
-
-    output_ptr += T_batch_width*T_SIZE;
-}
 
-void softmax_f32::run_softmax_work_item_batch8(const nn::workload_data<nn::layout_f32> *input_view,
-    nn::workload_data<nn::layout_f32> *output_view) {
-    const auto input_width = input_view->view_end.t[NN_DATA_COORD_x] - input_view->view_begin.t[NN_DATA_COORD_x] + 1;
-    const auto output_width = output_view->view_end.t[NN_DATA_COORD_x] - output_view->view_begin.t[NN_DATA_COORD_x] + 1;
+    __m256 max_values = _mm256_set1_ps(-FLT_MAX);
+    __m256 sums = _mm256_setzero_ps();
 
-    const auto num_full_blocks = output_width / C_max_acc_batch8;
-    const auto partial_block_size = output_width % C_max_acc_batch8;
+    auto load = [&](size_t vector) {
+            auto ptr = input + job.offset + vector * job.stride;
+            auto lanes = (vector + 1 == job.count) ? job.last_lanes : job.lanes;
+            if (lanes == C_simd_width)
+                return _mm256_loadu_ps(ptr);
 
-    const auto output_view_start = output_view->view_begin.t[NN_DATA_COORD_x] * C_batch8_size;
-    const auto input_view_start = input_view->view_begin.t[NN_DATA_COORD_x] * C_batch8_size;
+            // Missing lanes are set to lowest value, so they do not change maximum.
+            auto mask = softmax_lane_mask(lanes);
+            return _mm256_blendv_ps(_mm256_set1_ps(-FLT_MAX), _mm256_maskload_ps(ptr, mask), _mm256_castsi256_ps(mask));
+        };
 
-    // Find max value for each image. We will use 1 accumulator (1*8=8) so each image has its own avx component.
+    for (size_t block = 0; block < job.count; block += C_softmax_max_block)
     {
-        auto input_buffer = &static_cast<float*>(input_view->parent->data_buffer)[input_view_start];
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-        __m256 max_values;
-        uint32_t input = 0;
-        max_values = _mm256_load_ps(input_buffer + (input++) * C_batch8_size);
-
-        while(input < input_width)
-            max_values = _mm256_max_ps(max_values, _mm256_load_ps(input_buffer + (input++) * C_batch8_size));
-
-        for(uint32_t output = 0; output < output_width; ++output)
-        {
-                _mm256_store_ps(
-                    output_buffer + output * C_batch8_size,
-                    _mm256_sub_ps(
-                        _mm256_load_ps(input_buffer + output * C_batch8_size),
-                        max_values));
-        }
+        const auto block_end = std::min<size_t>(job.count, block + C_softmax_max_block);
+
+        __m256 block_max = max_values;
+        for (auto vector = block; vector < block_end; ++vector)
+            block_max = _mm256_max_ps(block_max, load(vector));
+
+        // Block is summed separately to limit rounding errors of long sums.
+        __m256 block_sum = _mm256_setzero_ps();
+        for (auto vector = block; vector < block_end; ++vector)
+            block_sum = _mm256_add_ps(block_sum, exp_ps<T_accuracy>(_mm256_sub_ps(load(vector), block_max)));
+
+        // Sum accumulated so far is rescaled to new maximum. Lanes with unchanged maximum are skipped,
+        // so errors of approximated e^0 do not build up.
+        auto rescale = _mm256_blendv_ps(exp_ps<T_accuracy>(_mm256_sub_ps(max_values, block_max)),
+                                        _mm256_set1_ps(1.0f),
+                                        _mm256_cmp_ps(max_values, block_max, _CMP_EQ_OQ));
+        sums = _mm256_fmadd_ps(sums, rescale, block_sum);
+        max_values = block_max;
     }
 
-    __m256 acc_sum = _mm256_setzero_ps();
-
-    {
-        auto input_buffer = &static_cast<float*>(input_view->parent->data_buffer)[input_view_start];
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
+    // Lanes without any value would hold e^0 for each of missing values.
+    if (job.count == 1 && job.last_lanes != C_simd_width)
+        sums = _mm256_and_ps(sums, _mm256_castsi256_ps(softmax_lane_mask(job.last_lanes)));
+    if (job.lanes != C_simd_width)
+        sums = _mm256_and_ps(sums, _mm256_castsi256_ps(softmax_lane_mask(job.lanes)));
 
-        for (auto block = 0u; block < num_full_blocks; ++block)
-        {
-            // Run computation.
-            softmax_compute_block<C_max_acc_batch8, C_batch8_size>(output_buffer, acc_sum);
-        }
+    _mm256_storeu_ps(job.max, max_values);
+    _mm256_storeu_ps(job.sum, sums);
+}
 
-        switch (partial_block_size)
-        {
-        case  0: break;
-        case  1: softmax_compute_block< 1, C_batch8_size>(output_buffer, acc_sum); break;
-        case  2: softmax_compute_block< 2, C_batch8_size>(output_buffer, acc_sum); break;
-        case  3: softmax_compute_block< 3, C_batch8_size>(output_buffer, acc_sum); break;
-        case  4: softmax_compute_block< 4, C_batch8_size>(output_buffer, acc_sum); break;
-        case  5: softmax_compute_block< 5, C_batch8_size>(output_buffer, acc_sum); break;
-        case  6: softmax_compute_block< 6, C_batch8_size>(output_buffer, acc_sum); break;
-        case  7: softmax_compute_block< 7, C_batch8_size>(output_buffer, acc_sum); break;
-        case  8: softmax_compute_block< 8, C_batch8_size>(output_buffer, acc_sum); break;
-        case  9: softmax_compute_block< 9, C_batch8_size>(output_buffer, acc_sum); break;
-        case 10: softmax_compute_block<10, C_batch8_size>(output_buffer, acc_sum); break;
-        case 11: softmax_compute_block<11, C_batch8_size>(output_buffer, acc_sum); break;
-        case 12: softmax_compute_block<12, C_batch8_size>(output_buffer, acc_sum); break;
-        case 13: softmax_compute_block<13, C_batch8_size>(output_buffer, acc_sum); break;
-        case 14: softmax_compute_block<14, C_batch8_size>(output_buffer, acc_sum); break;
-        default: NN_UNREACHABLE_CODE;
-        }
-    }
+/* second sweep: output = e^(input - max) / sum */
+template <nn::intrinsics::exp_accuracy T_accuracy>
+void softmax_normalize(const softmax_job &job, const float *input, float *output, const float *max, const float *inverted_sum)
+{
+    using namespace nn::intrinsics;
 
-    acc_sum = _mm256_div_ps(_mm256_set1_ps(1.0f), acc_sum);
+    const __m256 max_values = _mm256_loadu_ps(max);
+    const __m256 scale = _mm256_loadu_ps(inverted_sum);
 
+    for (size_t vector = 0; vector < job.count; ++vector)
     {
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
+        auto in_ptr = input + job.offset + vector * job.stride;
+        auto out_ptr = output + job.offset + vector * job.stride;
+        auto lanes = (vector + 1 == job.count) ? job.last_lanes : job.lanes;
 
-        for (auto block = 0u; block < num_full_blocks; ++block)
+        if (lanes == C_simd_width)
         {
-            // Run computation.
-            softmax_finalize_block<C_max_acc_batch8, C_batch8_size>(output_buffer, acc_sum);
+            _mm256_storeu_ps(out_ptr, _mm256_mul_ps(exp_ps<T_accuracy>(_mm256_sub_ps(_mm256_loadu_ps(in_ptr), max_values)), scale));
         }
-
-        switch (partial_block_size)
+        else
         {
-        case  0: break;
-        case  1: softmax_finalize_block< 1, C_batch8_size>(output_buffer, acc_sum); break;
-        case  2: softmax_finalize_block< 2, C_batch8_size>(output_buffer, acc_sum); break;
-        case  3: softmax_finalize_block< 3, C_batch8_size>(output_buffer, acc_sum); break;
-        case  4: softmax_finalize_block< 4, C_batch8_size>(output_buffer, acc_sum); break;
-        case  5: softmax_finalize_block< 5, C_batch8_size>(output_buffer, acc_sum); break;
-        case  6: softmax_finalize_block< 6, C_batch8_size>(output_buffer, acc_sum); break;
-        case  7: softmax_finalize_block< 7, C_batch8_size>(output_buffer, acc_sum); break;
-        case  8: softmax_finalize_block< 8, C_batch8_size>(output_buffer, acc_sum); break;
-        case  9: softmax_finalize_block< 9, C_batch8_size>(output_buffer, acc_sum); break;
-        case 10: softmax_finalize_block<10, C_batch8_size>(output_buffer, acc_sum); break;
-        case 11: softmax_finalize_block<11, C_batch8_size>(output_buffer, acc_sum); break;
-        case 12: softmax_finalize_block<12, C_batch8_size>(output_buffer, acc_sum); break;
-        case 13: softmax_finalize_block<13, C_batch8_size>(output_buffer, acc_sum); break;
-        case 14: softmax_finalize_block<14, C_batch8_size>(output_buffer, acc_sum); break;
-        default: NN_UNREACHABLE_CODE;
+            auto mask = softmax_lane_mask(lanes);
+            auto result = _mm256_mul_ps(exp_ps<T_accuracy>(_mm256_sub_ps(_mm256_maskload_ps(in_ptr, mask), max_values)), scale);
+            _mm256_maskstore_ps(out_ptr, mask, result);
         }
     }
 }
 
-template<uint32_t T_NUM_ITERATIONS>
-void softmax_compute_subsimd(
-    float* &output_ptr,
-    float &acc_sum)
-{
-    for (auto iteration = 0u; iteration < T_NUM_ITERATIONS; ++iteration)
-    {
-        float acc0 = std::exp(*output_ptr);
-        *output_ptr = acc0;
-        acc_sum += acc0;
-
-        ++output_ptr;
-    }
-}
-
-template<uint32_t T_NUM_ITERATIONS>
-void softmax_finalize_subsimd(
-    float* &output_ptr,
-    float &acc_sum)
+template <nn::intrinsics::exp_accuracy T_accuracy>
+void softmax_nx_f32(nn_thread_worker_pool &thread_pool, const float *input, float *output, size_t classes, size_t batch)
 {
-    for (auto iteration = 0u; iteration < T_NUM_ITERATIONS; ++iteration)
-    {
-        float acc0 = *output_ptr;
-        acc0 *= acc_sum;
-        *output_ptr = acc0;
-
-        ++output_ptr;
-    }
-}
-
-void softmax_f32::run_softmax_work_item_latency(const nn::workload_data<nn::layout_f32> *input_view,
-                                                nn::workload_data<nn::layout_f32> *output_view) {
-    const auto input_width = input_view->view_end.t[NN_DATA_COORD_x] - input_view->view_begin.t[NN_DATA_COORD_x] + 1;
-    const auto output_width = output_view->view_end.t[NN_DATA_COORD_x] - output_view->view_begin.t[NN_DATA_COORD_x] + 1;
+    const auto threads = thread_pool.get_num_threads();
+    std::vector<softmax_job> jobs;
+    size_t groups;
 
-    const auto num_full_blocks = output_width / C_data_stride_batch1;
-    const auto partial_block_size = (output_width / C_simd_width) % C_max_acc_batch1;
-    const auto subsimd_block_size = output_width % C_simd_width;
-
-    const auto output_view_start = output_view->view_begin.t[NN_DATA_COORD_x];
-    const auto input_view_start = input_view->view_begin.t[NN_DATA_COORD_x];
-
-    // Find max value for each image. We will use 1 scalar accumulator (semi-naive way).
+    if (batch == 1)
     {
-        auto input_buffer = &static_cast<float*>(input_view->parent->data_buffer)[input_view_start];
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-        float max_value;
-        uint32_t input = 0;
-        max_value = *(input_buffer + (input++));
+        // Single image: vectors hold consecutive classes, lanes are reduced at the end.
+        const auto vectors = (classes + C_simd_width - 1) / C_simd_width;
+        const auto tail = static_cast<uint32_t>(classes - (vectors - 1) * C_simd_width);
+        const auto job_count = std::max<size_t>(std::min<size_t>(threads, classes / C_softmax_job_size), 1);
 
-        while(input < input_width)
-            max_value = std::max(max_value, *(input_buffer + (input++)));
-
-        for(uint32_t output = 0; output < output_width; ++output)
+        groups = 1;
+        for (size_t job = 0; job < job_count; ++job)
         {
-            *(output_buffer + output) = *(input_buffer + output) - max_value;
+            const auto begin = vectors * job / job_count, end = vectors * (job + 1) / job_count;
+            jobs.push_back({begin * C_simd_width, C_simd_width, end - begin, C_simd_width,
+                            (end == vectors) ? tail : static_cast<uint32_t>(C_simd_width), 0});
         }
     }
-
-    __m256 acc_sum = _mm256_setzero_ps();
-    float subsimd_sum = 0.0f;
-
+    else
     {
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-        for (auto block = 0u; block < num_full_blocks; ++block)
-        {
-            // Run computation.
-            softmax_compute_block<C_max_acc_batch1, C_simd_width>(output_buffer, acc_sum);
-        }
-
-        switch (partial_block_size)
-        {
-        case  0: break;
-        case  1: softmax_compute_block< 1, C_simd_width>(output_buffer, acc_sum); break;
-        case  2: softmax_compute_block< 2, C_simd_width>(output_buffer, acc_sum); break;
-        case  3: softmax_compute_block< 3, C_simd_width>(output_buffer, acc_sum); break;
-        case  4: softmax_compute_block< 4, C_simd_width>(output_buffer, acc_sum); break;
-        case  5: softmax_compute_block< 5, C_simd_width>(output_buffer, acc_sum); break;
-        case  6: softmax_compute_block< 6, C_simd_width>(output_buffer, acc_sum); break;
-        case  7: softmax_compute_block< 7, C_simd_width>(output_buffer, acc_sum); break;
-        case  8: softmax_compute_block< 8, C_simd_width>(output_buffer, acc_sum); break;
-        case  9: softmax_compute_block< 9, C_simd_width>(output_buffer, acc_sum); break;
-        case 10: softmax_compute_block<10, C_simd_width>(output_buffer, acc_sum); break;
-        case 11: softmax_compute_block<11, C_simd_width>(output_buffer, acc_sum); break;
-        case 12: softmax_compute_block<12, C_simd_width>(output_buffer, acc_sum); break;
-        case 13: softmax_compute_block<13, C_simd_width>(output_buffer, acc_sum); break;
-        case 14: softmax_compute_block<14, C_simd_width>(output_buffer, acc_sum); break;
-        default: NN_UNREACHABLE_CODE;
-        }
+        // Vectors hold values of single class for group of images, groups are independent.
+        groups = (batch + C_simd_width - 1) / C_simd_width;
+        const auto splits = std::max<size_t>(std::min<size_t>((threads + groups - 1) / groups,
+                                                              classes * C_simd_width / C_softmax_job_size), 1);
 
-        switch (subsimd_block_size)
+        for (size_t group = 0; group < groups; ++group)
         {
-        case 0: break;
-        case 1: softmax_compute_subsimd<1>(output_buffer, subsimd_sum); break;
-        case 2: softmax_compute_subsimd<2>(output_buffer, subsimd_sum); break;
-        case 3: softmax_compute_subsimd<3>(output_buffer, subsimd_sum); break;
-        case 4: softmax_compute_subsimd<4>(output_buffer, subsimd_sum); break;
-        case 5: softmax_compute_subsimd<5>(output_buffer, subsimd_sum); break;
-        case 6: softmax_compute_subsimd<6>(output_buffer, subsimd_sum); break;
-        case 7: softmax_compute_subsimd<7>(output_buffer, subsimd_sum); break;
-        default: NN_UNREACHABLE_CODE;
+            const auto lanes = static_cast<uint32_t>(std::min<size_t>(batch - group * C_simd_width, C_simd_width));
+            for (size_t split = 0; split < splits; ++split)
+            {
+                const auto begin = classes * split / splits, end = classes * (split + 1) / splits;
+                if (begin == end) continue;
+                jobs.push_back({begin * batch + group * C_simd_width, batch, end - begin, lanes, lanes, group});
+            }
         }
     }
 
-    {
-        __m256 intermediate_sum = _mm256_hadd_ps(acc_sum, acc_sum);
-        intermediate_sum = _mm256_permutevar8x32_ps(intermediate_sum, _mm256_set_epi32(0, 1, 4, 5, 2, 3, 6, 7));
-        intermediate_sum = _mm256_hadd_ps(intermediate_sum, intermediate_sum);
-        intermediate_sum = _mm256_hadd_ps(intermediate_sum, intermediate_sum);
-
-        acc_sum = _mm256_add_ps(intermediate_sum, _mm256_set1_ps(subsimd_sum));
-        subsimd_sum = _mm_cvtss_f32(_mm256_extractf128_ps(acc_sum, 0));
+    auto run = [&](const std::function<void(size_t)> &function) {
+            if (jobs.size() == 1)
+            {
+                function(0);
+                return;
+            }
 
-        acc_sum = _mm256_div_ps(_mm256_set1_ps(1.0f), acc_sum);
-        subsimd_sum = 1.0f / subsimd_sum;
-    }
+            std::vector<nn_multithreaded_request> requests(jobs.size());
+            for (size_t job = 0; job < jobs.size(); ++job)
+                requests[job] = {[&function, job](void *) { function(job); }, nullptr};
+            thread_pool.push_job(requests);
+        };
 
-    {
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
+    run([&](size_t job) { softmax_max_and_sum<T_accuracy>(jobs[job], input); });
 
-        for (auto block = 0u; block < num_full_blocks; ++block)
-        {
-            // Run computation.
-            softmax_finalize_block<C_max_acc_batch1, C_simd_width>(output_buffer, acc_sum);
-        }
+    // Combine partial results: maxima of jobs and lanes are aligned to common maximum before summation.
+    std::vector<float> max(groups * C_simd_width, -FLT_MAX), inverted_sum(groups * C_simd_width, 0.0f);
+    const auto reduce_lanes = (batch == 1);
 
-        switch (partial_block_size)
+    for (auto &job : jobs)
+        for (uint32_t lane = 0; lane < C_simd_width; ++lane)
         {
-        case  0: break;
-        case  1: softmax_finalize_block< 1, C_simd_width>(output_buffer, acc_sum); break;
-        case  2: softmax_finalize_block< 2, C_simd_width>(output_buffer, acc_sum); break;
-        case  3: softmax_finalize_block< 3, C_simd_width>(output_buffer, acc_sum); break;
-        case  4: softmax_finalize_block< 4, C_simd_width>(output_buffer, acc_sum); break;
-        case  5: softmax_finalize_block< 5, C_simd_width>(output_buffer, acc_sum); break;
-        case  6: softmax_finalize_block< 6, C_simd_width>(output_buffer, acc_sum); break;
-        case  7: softmax_finalize_block< 7, C_simd_width>(output_buffer, acc_sum); break;
-        case  8: softmax_finalize_block< 8, C_simd_width>(output_buffer, acc_sum); break;
-        case  9: softmax_finalize_block< 9, C_simd_width>(output_buffer, acc_sum); break;
-        case 10: softmax_finalize_block<10, C_simd_width>(output_buffer, acc_sum); break;
-        case 11: softmax_finalize_block<11, C_simd_width>(output_buffer, acc_sum); break;
-        case 12: softmax_finalize_block<12, C_simd_width>(output_buffer, acc_sum); break;
-        case 13: softmax_finalize_block<13, C_simd_width>(output_buffer, acc_sum); break;
-        case 14: softmax_finalize_block<14, C_simd_width>(output_buffer, acc_sum); break;
-        default: NN_UNREACHABLE_CODE;
+            auto &group_max = max[job.group * C_simd_width + (reduce_lanes ? 0 : lane)];
+            group_max = std::max(group_max, job.max[lane]);
         }
+    if (reduce_lanes)
+        std::fill(max.begin(), max.end(), max[0]);
 
-        switch (subsimd_block_size)
+    for (auto &job : jobs)
+        for (uint32_t lane = 0; lane < C_simd_width; ++lane)
         {
-        case 0: break;
-        case 1: softmax_finalize_subsimd<1>(output_buffer, subsimd_sum); break;
-        case 2: softmax_finalize_subsimd<2>(output_buffer, subsimd_sum); break;
-        case 3: softmax_finalize_subsimd<3>(output_buffer, subsimd_sum); break;
-        case 4: softmax_finalize_subsimd<4>(output_buffer, subsimd_sum); break;
-        case 5: softmax_finalize_subsimd<5>(output_buffer, subsimd_sum); break;
-        case 6: softmax_finalize_subsimd<6>(output_buffer, subsimd_sum); break;
-        case 7: softmax_finalize_subsimd<7>(output_buffer, subsimd_sum); break;
-        default: NN_UNREACHABLE_CODE;
+            auto index = job.group * C_simd_width + (reduce_lanes ? 0 : lane);
+            if (job.sum[lane] != 0.0f)
+                inverted_sum[index] += job.sum[lane] * std::exp(job.max[lane] - max[index]);
         }
-    }
-}
-
-void softmax_f32::run_softmax_work_item_batch48(const nn::workload_data<nn::layout_f32> *input_view,
-                                                nn::workload_data<nn::layout_f32> *output_view) {
-    const auto input_width = input_view->view_end.t[NN_DATA_COORD_x] - input_view->view_begin.t[NN_DATA_COORD_x] + 1;
-    const auto output_width = output_view->view_end.t[NN_DATA_COORD_x] - output_view->view_begin.t[NN_DATA_COORD_x] + 1;
-
-    const auto num_full_blocks = output_width / C_max_acc_batch48;
-    const auto partial_block_size = output_width % C_max_acc_batch48;
-    const auto num_batch_packages = 6;
+    if (reduce_lanes)
+        std::fill(inverted_sum.begin(), inverted_sum.end(), inverted_sum[0]);
 
-    // Find max value for each image. We will use 6 accumulators (6*8=48) so each image has its own avx component.
-    {
-        const auto output_view_start = output_view->view_begin.t[NN_DATA_COORD_x] * C_batch48_size;
-        const auto input_view_start = input_view->view_begin.t[NN_DATA_COORD_x] * C_batch48_size;
-        auto input_buffer = &static_cast<float*>(input_view->parent->data_buffer)[input_view_start];
-        auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-        __m256 max_values[num_batch_packages];
-        uint32_t input = 0;
-
-        #pragma unroll(num_batch_packages)
-        for(auto acc = 0u; acc < num_batch_packages; ++acc)
-            max_values[acc] = _mm256_load_ps(input_buffer + input * C_batch48_size + acc * C_simd_width);
+    for (auto &value : inverted_sum)
+        value = (value != 0.0f) ? 1.0f / value : 0.0f;
 
-        ++input;
+    run([&](size_t job) {
+            auto group = jobs[job].group * C_simd_width;
+            softmax_normalize<T_accuracy>(jobs[job], input, output, &max[group], &inverted_sum[group]);
+        });
+}
 
-        for(;input < input_width; ++input)
-            #pragma unroll(num_batch_packages)
-            for(auto acc = 0u; acc < num_batch_packages; ++acc)
-                max_values[acc] = _mm256_max_ps(max_values[acc], _mm256_load_ps(input_buffer + input * C_batch48_size + acc * C_simd_width));
+} //namespace
 
-        for(uint32_t output = 0; output < output_width; ++output)
-        {
-            #pragma unroll(num_batch_packages)
-            for(auto acc = 0u; acc < num_batch_packages; ++acc)
-                _mm256_store_ps(
-                    output_buffer + output * C_batch48_size + acc * C_simd_width,
-                    _mm256_sub_ps(
-                        _mm256_load_ps(input_buffer + output * C_batch48_size + acc * C_simd_width),
-                        max_values[acc]));
-        }
-    }
+void softmax_nx_f32(nn_thread_worker_pool &thread_pool,
+                    const float *input,
+                    float *output,
+                    size_t classes,
+                    size_t batch,
+                    nn::intrinsics::exp_accuracy accuracy)
+{
+    if (classes == 0 || batch == 0)
+        return;
 
-    for (uint32_t batch_package = 0; batch_package < num_batch_packages; ++batch_package)
+    switch (accuracy)
     {
-        const auto output_view_start = output_view->view_begin.t[NN_DATA_COORD_x] * C_batch48_size + batch_package * C_batch8_size;
-
-        __m256 acc_sum = _mm256_setzero_ps();
-
-        {
-            auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-            for (auto block = 0u; block < num_full_blocks; ++block)
-            {
-                // Run computation.
-                softmax_compute_block<C_max_acc_batch48, C_batch48_size>(output_buffer, acc_sum);
-            }
-
-            switch (partial_block_size)
-            {
-            case  0: break;
-            case  1: softmax_compute_block< 1, C_batch48_size>(output_buffer, acc_sum); break;
-            case  2: softmax_compute_block< 2, C_batch48_size>(output_buffer, acc_sum); break;
-            case  3: softmax_compute_block< 3, C_batch48_size>(output_buffer, acc_sum); break;
-            case  4: softmax_compute_block< 4, C_batch48_size>(output_buffer, acc_sum); break;
-            case  5: softmax_compute_block< 5, C_batch48_size>(output_buffer, acc_sum); break;
-            case  6: softmax_compute_block< 6, C_batch48_size>(output_buffer, acc_sum); break;
-            case  7: softmax_compute_block< 7, C_batch48_size>(output_buffer, acc_sum); break;
-            case  8: softmax_compute_block< 8, C_batch48_size>(output_buffer, acc_sum); break;
-            case  9: softmax_compute_block< 9, C_batch48_size>(output_buffer, acc_sum); break;
-            case 10: softmax_compute_block<10, C_batch48_size>(output_buffer, acc_sum); break;
-            case 11: softmax_compute_block<11, C_batch48_size>(output_buffer, acc_sum); break;
-            case 12: softmax_compute_block<12, C_batch48_size>(output_buffer, acc_sum); break;
-            case 13: softmax_compute_block<13, C_batch48_size>(output_buffer, acc_sum); break;
-            case 14: softmax_compute_block<14, C_batch48_size>(output_buffer, acc_sum); break;
-            default: NN_UNREACHABLE_CODE;
-            }
-        }
-
-        acc_sum = _mm256_div_ps(_mm256_set1_ps(1.0f), acc_sum);
-
-        {
-            auto output_buffer = &static_cast<float*>(output_view->parent->data_buffer)[output_view_start];
-
-            for (auto block = 0u; block < num_full_blocks; ++block)
-            {
-                // Run computation.
-                softmax_finalize_block<C_max_acc_batch48, C_batch48_size>(output_buffer, acc_sum);
-            }
-
-            switch (partial_block_size)
-            {
-            case  0: break;
-            case  1: softmax_finalize_block< 1, C_batch48_size>(output_buffer, acc_sum); break;
-            case  2: softmax_finalize_block< 2, C_batch48_size>(output_buffer, acc_sum); break;
-            case  3: softmax_finalize_block< 3, C_batch48_size>(output_buffer, acc_sum); break;
-            case  4: softmax_finalize_block< 4, C_batch48_size>(output_buffer, acc_sum); break;
-            case  5: softmax_finalize_block< 5, C_batch48_size>(output_buffer, acc_sum); break;
-            case  6: softmax_finalize_block< 6, C_batch48_size>(output_buffer, acc_sum); break;
-            case  7: softmax_finalize_block< 7, C_batch48_size>(output_buffer, acc_sum); break;
-            case  8: softmax_finalize_block< 8, C_batch48_size>(output_buffer, acc_sum); break;
-            case  9: softmax_finalize_block< 9, C_batch48_size>(output_buffer, acc_sum); break;
-            case 10: softmax_finalize_block<10, C_batch48_size>(output_buffer, acc_sum); break;
-            case 11: softmax_finalize_block<11, C_batch48_size>(output_buffer, acc_sum); break;
-            case 12: softmax_finalize_block<12, C_batch48_size>(output_buffer, acc_sum); break;
-            case 13: softmax_finalize_block<13, C_batch48_size>(output_buffer, acc_sum); break;
-            case 14: softmax_finalize_block<14, C_batch48_size>(output_buffer, acc_sum); break;
-            default: NN_UNREACHABLE_CODE;
-            }
-        }
+    case nn::intrinsics::exp_accuracy::fast:
+        softmax_nx_f32<nn::intrinsics::exp_accuracy::fast>(thread_pool, input, output, classes, batch);
+        break;
+    case nn::intrinsics::exp_accuracy::precise:
+        softmax_nx_f32<nn::intrinsics::exp_accuracy::precise>(thread_pool, input, output, classes, batch);
+        break;
     }
 }
 
@@ -580,21 +281,14 @@ void softmax_f32::backward(const std::vector<nn_workload_data_t *> &inputs,
 }
 
 void softmax_f32::forward(const nn::workload_data<nn::layout_f32> *input, nn::workload_data<nn::layout_f32> *output) {
-    auto batch_size = input->parent->lengths.t[NN_DATA_COORD_n];
-    switch (batch_size)
-    {
-    case 1:
-        run_softmax_work_item_latency(input, output);
-        break;
-    case 8:
-        run_softmax_work_item_batch8(input, output);
-        break;
-    case 48:
-        run_softmax_work_item_batch48(input, output);
-        break;
-    default:
-        break;
-    }
+    const auto batch = input->parent->lengths.t[NN_DATA_COORD_n];
+    const auto width = output->view_end.t[NN_DATA_COORD_x] - output->view_begin.t[NN_DATA_COORD_x] + 1;
+
+    softmax_nx_f32(device->thread_pool,
+                   static_cast<float *>(input->parent->data_buffer) + input->view_begin.t[NN_DATA_COORD_x] * batch,
+                   static_cast<float *>(output->parent->data_buffer) + output->view_begin.t[NN_DATA_COORD_x] * batch,
+                   width,
+                   batch);
 }
 
 void softmax_f32::forward(const std::vector<const nn_workload_data_t *> &inputs, const std::vector<const nn_workload_data_t *> &parameters, const std::vector<nn_workload_data_t *> &outputs)
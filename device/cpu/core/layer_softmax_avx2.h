@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 #include "device/cpu/api_internal/nn_device_interface_0_internal.h"
 #include "device/api/nn_primitives_api_0.h"
+#include "nn_intrinsic_power.h"
 
 namespace layer {
 class softmax_f32 : public nn_primitive_t {
@@ -57,13 +58,6 @@ class softmax_f32 : public nn_primitive_t {
     virtual bool validate_input(size_t index, nn_workload_data_t *data) override;
 
 private:
-    void run_softmax_work_item_batch8(const nn::workload_data<nn::layout_f32> *input_view,
-                                      nn::workload_data<nn::layout_f32> *output_view);
-    void run_softmax_work_item_latency(const nn::workload_data<nn::layout_f32> *input_view,
-                                       nn::workload_data<nn::layout_f32> *output_view);
-    void run_softmax_work_item_batch48(const nn::workload_data<nn::layout_f32> *input_view,
-                                       nn::workload_data<nn::layout_f32> *output_view);
-
     void forward(const nn::workload_data<nn::layout_f32> *input, nn::workload_data<nn::layout_f32> *output);
 
 protected:
@@ -74,4 +68,14 @@ protected:
 };
 
 void wrapper_softmax_work_item_backward(nn_workload_item *const work_item);
+
+/* softmax over classes of each image of batch stored in NX layout (images of batch are innermost)
+   Maxima and sums of exponents are found in one sweep over input, second sweep writes normalized
+   output. Both are shared by threads of pool along classes and groups of images. Output may be input. */
+void softmax_nx_f32(nn_thread_worker_pool &thread_pool,
+                    const float *input,
+                    float *output,
+                    size_t classes,
+                    size_t batch,
+                    nn::intrinsics::exp_accuracy accuracy = nn::intrinsics::exp_accuracy::precise);
 }
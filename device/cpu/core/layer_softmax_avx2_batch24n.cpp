@@ -57,7 +57,7 @@ void softmax_f32_batch24n::forward(const nn::workload_data<nn::layout_f32> *inpu
     const auto input_view_start = input->view_begin.t[NN_DATA_COORD_z] * BATCH_ACCEPTED_BLOCK;
     const auto width = input_width;
 
-    const auto batches = batch_size / BATCH_ACCEPTED_BLOCK;
+    const auto batches = (batch_size + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK;
 
     __m256 maxes[BATCH_BLOCKS];
     __m256 sums[BATCH_BLOCKS];
@@ -143,7 +143,7 @@ void softmax_f32_batch24n::forward(const std::vector<const nn_workload_data_t *>
 
 std::vector<nn_workload_data_t *> softmax_f32_batch24n::create_inputs(bool allocate_delta)
 {
-    throw std::logic_error("unimplemented");
+    return create_outputs(allocate_delta);
 }
 
 std::vector<nn_workload_data_t *> softmax_f32_batch24n::create_outputs(bool allocate_delta)
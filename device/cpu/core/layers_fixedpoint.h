@@ -33,3 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fixedpoint/layer_softmax_int32_float_avx2.h"
 #include "fixedpoint/layer_pooling_int16_fixedpoint_avx2.h"
 #include "fixedpoint/layer_normalization_response_across_maps_int16_avx2.h"
+#include "fixedpoint/layer_convert_float_to_uint8_avx2.h"
+#include "fixedpoint/layer_convolution_int8_avx2.h"
+#include "fixedpoint/layer_pooling_int8_avx2.h"
+#include "fixedpoint/layer_normalization_response_across_maps_int8_avx2.h"
+#include "fixedpoint/layer_fully_connected_int8_avx2.h"
@@ -132,6 +132,134 @@ inline __m256 _inner_mm256_exp_ps(__m256 arg)
     return _mm256_and_ps(res, mask);
 }
 
+/* accuracy of vectorized exponent
+   fast    - 2^fraction from polynomial of 4th degree, relative error below 1e-5
+   precise - Cody-Waite range reduction and polynomial of 6th degree, error within 2 ulp */
+enum class exp_accuracy { fast, precise };
+
+/* e^arg for each element; arguments below -87.336 (including -infinity) give 0, results saturate at e^88 */
+template <exp_accuracy T_accuracy>
+inline __m256 exp_ps(__m256 arg);
+
+template <>
+inline __m256 exp_ps<exp_accuracy::fast>(__m256 arg)
+{
+    return _inner_mm256_exp_ps(_mm256_min_ps(arg, _mm256_set1_ps(88.0f)));
+}
+
+template <>
+inline __m256 exp_ps<exp_accuracy::precise>(__m256 arg)
+{
+    __m256 mask = _mm256_cmp_ps(arg, _mm256_set1_ps(-87.336f), _CMP_GT_OQ);
+
+    arg = _mm256_min_ps(arg, _mm256_set1_ps(88.0f));
+
+    // arg = n * ln(2) + r, where |r| <= ln(2)/2; ln(2) is split in two parts so n * ln(2) is exact
+    __m256 n = _mm256_round_ps(
+        _mm256_mul_ps(arg, _mm256_set1_ps(1.4426950408889634073599246810018921374266459541529859f)),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), arg);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+
+    __m256 intermediate_result;
+    intermediate_result = _mm256_fmadd_ps(_mm256_set1_ps(1.9875691500e-4f), r, _mm256_set1_ps(1.3981999507e-3f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, r, _mm256_set1_ps(8.3334519073e-3f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, r, _mm256_set1_ps(4.1665795894e-2f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, r, _mm256_set1_ps(1.6666665459e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, r, _mm256_set1_ps(5.0000001201e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+
+    __m256 res = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23));
+
+    res = _mm256_mul_ps(res, intermediate_result);
+
+    return _mm256_and_ps(res, mask);
+}
+
+/* natural logarithm for each element (Cephes logf polynomial); arguments below smallest normal float, including 0,
+   are treated as smallest normal float */
+inline __m256 log_ps(__m256 arg)
+{
+    arg = _mm256_max_ps(arg, _mm256_set1_ps(1.17549435e-38f));
+
+    // arg = m * 2^e, where m is in [sqrt(1/2), sqrt(2))
+    __m256i bits = _mm256_castps_si256(arg);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                                   _mm256_set1_epi32(0x3f000000)));
+
+    __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(small, _mm256_set1_ps(1.0f)));
+    m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), _mm256_set1_ps(1.0f));
+
+    __m256 m2 = _mm256_mul_ps(m, m);
+
+    __m256 intermediate_result;
+    intermediate_result = _mm256_fmadd_ps(_mm256_set1_ps(7.0376836292e-2f), m, _mm256_set1_ps(-1.1514610310e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(1.1676998740e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(-1.2420140846e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(1.4249322787e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(-1.6668057665e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(2.0000714765e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(-2.4999993993e-1f));
+    intermediate_result = _mm256_fmadd_ps(intermediate_result, m, _mm256_set1_ps(3.3333331174e-1f));
+    intermediate_result = _mm256_mul_ps(intermediate_result, _mm256_mul_ps(m, m2));
+
+    // ln(2) is split in two parts, as in exponent
+    intermediate_result = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), intermediate_result);
+    intermediate_result = _mm256_fnmadd_ps(m2, _mm256_set1_ps(0.5f), intermediate_result);
+    m = _mm256_add_ps(m, intermediate_result);
+
+    return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), m);
+}
+
+/* base^exponent for each element as e^(exponent * ln(base)); accuracy is the one of exponent, domain of base as in log_ps */
+template <exp_accuracy T_accuracy>
+inline __m256 pow_ps(__m256 base, __m256 exponent)
+{
+    return exp_ps<T_accuracy>(_mm256_mul_ps(exponent, log_ps(base)));
+}
+
+/* forms of arg^-beta used by local response normalization - beta of 0.75, 0.5 and 1.0 have cheaper exact or
+   approximated forms than logarithm and exponent used for any other beta */
+enum class invpow_kind { beta_075, beta_05, beta_1, any };
+
+inline invpow_kind invpow_kind_for(float beta)
+{
+    if (beta == 0.75f) return invpow_kind::beta_075;
+    if (beta == 0.5f)  return invpow_kind::beta_05;
+    if (beta == 1.0f)  return invpow_kind::beta_1;
+    return invpow_kind::any;
+}
+
+/* arg^-beta for each element; domain is numbers greater than 0, for 0 result is large value, but not infinity */
+template <invpow_kind T_kind>
+inline __m256 invpow_ps(__m256 arg, __m256 beta);
+
+template <>
+inline __m256 invpow_ps<invpow_kind::beta_075>(__m256 arg, __m256)
+{
+    return invpow_075(arg);
+}
+
+template <>
+inline __m256 invpow_ps<invpow_kind::beta_05>(__m256 arg, __m256)
+{
+    return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(arg, _mm256_set1_ps(1.17549435e-38f))));
+}
+
+template <>
+inline __m256 invpow_ps<invpow_kind::beta_1>(__m256 arg, __m256)
+{
+    return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(arg, _mm256_set1_ps(1.17549435e-38f)));
+}
+
+template <>
+inline __m256 invpow_ps<invpow_kind::any>(__m256 arg, __m256 beta)
+{
+    return pow_ps<exp_accuracy::precise>(arg, _mm256_sub_ps(_mm256_setzero_ps(), beta));
+}
+
 } //namespace intrinsics
 } //namespace nn
 
@@ -132,11 +132,7 @@ void runConvolveBatched(
         stride_info,
         make<InputFeatsStart>(0u),
         make<OutputFeatsStart>(0u),
-        1u,
-        alignedInput.get(),
-        alignedOutput.get(),
-        alignedKernel.get(),
-        bias_ref);
+        1u);
 
     convolve_fst_single_threaded(func,
         alignedInput.get(), alignedOutput.get(), alignedKernel.get(), bias_ref,
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2014, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+* Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "gtest/gtest.h"
+#include "device/api/nn_primitives_api_0.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace
+{
+nn::data<float, 4> create_input(size_t data_x, size_t data_y, size_t data_z, size_t batch_size, float sign)
+{
+    nn::data<float, 4> input(data_z, data_x, data_y, batch_size);
+    for (size_t i = 0; i < input.count(); ++i)
+        ((float *)(input.buffer))[i] = sign * (i % 7) * (i % 2 == 0 ? -1.0f : 1.0f);
+
+    return input;
+}
+
+// Two independent relu branches are joined by axpby: Y_b = alpha * relu(a) + beta * relu(b).
+// Calls are scheduled without intermediate waits and intermediate events are deleted before
+// they complete, so result is correct only if dependencies are honoured.
+bool ult_perform_test(size_t data_x, size_t data_y, size_t data_z, size_t batch_size)
+{
+    nn_primitives_0_t primitives;
+    nn_device_get_primitives(0, &primitives);
+    nn_device_t *device = primitives.create_device_with_thread_count(0, nullptr);
+
+    const float alpha = 2.0f, beta = 0.5f;
+    auto input_a = create_input(data_x, data_y, data_z, batch_size, 1.0f);
+    auto input_b = create_input(data_x, data_y, data_z, batch_size, -1.0f);
+    nn::data<float, 4> output(data_z, data_x, data_y, batch_size);
+
+    nn_primitive_handle_t primitive =
+        primitives.create_handle.relu_f32(device, data_x, data_y, data_z, batch_size, nullptr, nullptr);
+
+    nn_opaque_data_t *inputs[2], *outputs[2];
+    for (size_t branch = 0; branch < 2; ++branch)
+    {
+        primitives.create_inputs(primitive, 1, &inputs[branch], 0, nullptr);
+        primitives.create_outputs(primitive, 1, &outputs[branch], 0, nullptr);
+    }
+
+    nn_event_t relu[2];
+    for (size_t branch = 0; branch < 2; ++branch)
+    {
+        nn_event_t input_ready = primitives.copy_to_opaque_async(
+            device, inputs[branch], branch == 0 ? &input_a : &input_b, 0, nullptr, nullptr);
+        relu[branch] = primitives.forward_async(
+            primitive, 1, &inputs[branch], 0, nullptr, 1, &outputs[branch], 1, &input_ready, nullptr);
+        primitives.delete_event(input_ready);
+    }
+
+    nn_event_t axpby = primitives.axpby_async(
+        device, USE_DATA, alpha, outputs[0], USE_DATA, beta, outputs[1], 2, relu, nullptr);
+    primitives.delete_event(relu[0]);
+    primitives.delete_event(relu[1]);
+
+    nn_event_t output_ready = primitives.copy_from_opaque_async(device, &output, outputs[1], 1, &axpby, nullptr);
+    primitives.delete_event(axpby);
+
+    bool passed = primitives.wait(1, &output_ready) == NN_API_STATUS_OK;
+    primitives.delete_event(output_ready);
+
+    for (size_t i = 0; i < output.count(); ++i)
+    {
+        auto reference = alpha * std::max(0.0f, ((float *)(input_a.buffer))[i]) +
+                         beta * std::max(0.0f, ((float *)(input_b.buffer))[i]);
+        if (fabs(((float *)(output.buffer))[i] - reference) > 1e-5f)
+            passed = false;
+    }
+
+    for (size_t branch = 0; branch < 2; ++branch)
+    {
+        primitives.delete_opaque_data(inputs[branch]);
+        primitives.delete_opaque_data(outputs[branch]);
+    }
+    primitives.delete_primitive(primitive);
+    primitives.delete_device(device);
+
+    return passed;
+}
+} //namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests.
+TEST(api_primitives_events, dependencies_are_honoured)
+{
+    for (auto batch : { 1, 8, 48 })
+        for (auto fmaps : { 8, 32 })
+            for (auto repeat = 0; repeat < 4; ++repeat)
+                EXPECT_EQ(true, ult_perform_test(13, 11, fmaps, batch));
+}
+
+TEST(api_primitives_events, null_events_are_completed)
+{
+    nn_primitives_0_t primitives;
+    nn_device_get_primitives(0, &primitives);
+
+    nn_event_t events[2] = { nullptr, nullptr };
+    EXPECT_EQ(NN_API_STATUS_OK, primitives.wait(2, events));
+    EXPECT_EQ(NN_API_STATUS_OK, primitives.delete_event(nullptr));
+}
@@ -30,10 +30,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/api/nn_device_api.h"
 #include "device/common/nn_workload_data.h"
 #include "device/api/nn_device_interface_0.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/layer_convolution_normalization_pooling_avx2.h"
 
 #include <random>
+#include <memory>
 #include <cstdint>
 #include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -52,6 +61,61 @@ namespace {
         // unload device
         EXPECT_EQ(0, nn_device_unload());
     }
+
+    // Executes workload with ZXY input and output from several threads at once, every thread with its own inputs.
+    // Returns count of failed executions and output values that differ from the same inputs executed one by one.
+    uint32_t concurrent_execution_mismatches(nn_device_interface_0_t &di,
+                                             nn_workload_t *workload,
+                                             const uint32_t (&input_size)[3],
+                                             const uint32_t (&output_size)[3],
+                                             uint32_t number_of_threads,
+                                             uint32_t number_of_runs) {
+        auto execute = [&](nn::data<float, 3> *in_ptr, nn::data<float, 3> *out_ptr) {
+            NN_API_STATUS status;
+            return NN_API_STATUS_OK == di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status) &&
+                   NN_API_WORK_FINISHED == status;
+        };
+
+        // inputs of all runs and their outputs computed sequentially
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::vector<std::unique_ptr<nn::data<float, 3>>> inputs, expected;
+        uint32_t mismatches = 0;
+        for (auto run = 0u; run < number_of_threads * number_of_runs; ++run) {
+            inputs.emplace_back(new nn::data<float, 3>(input_size[0], input_size[1], input_size[2]));
+            for (auto index = 0u; index < inputs.back()->count(); ++index)
+                static_cast<float *>(inputs.back()->buffer)[index] = distribution(generator);
+            expected.emplace_back(new nn::data<float, 3>(output_size[0], output_size[1], output_size[2]));
+            if (!execute(inputs.back().get(), expected.back().get()))
+                ++mismatches;
+        }
+
+        std::vector<uint32_t> thread_mismatches(number_of_threads, 0);
+        std::vector<std::thread> threads;
+        std::atomic<uint32_t> threads_ready(0);
+        for (auto thread = 0u; thread < number_of_threads; ++thread)
+            threads.push_back(std::thread([&, thread]() {
+                for (++threads_ready; threads_ready < number_of_threads;)
+                    std::this_thread::yield();
+
+                for (auto run = thread * number_of_runs; run < (thread + 1) * number_of_runs; ++run) {
+                    nn::data<float, 3> out(output_size[0], output_size[1], output_size[2]);
+                    if (!execute(inputs[run].get(), &out))
+                        ++thread_mismatches[thread];
+
+                    for (auto index = 0u; index < out.count(); ++index)
+                        if (static_cast<float *>(out.buffer)[index] != static_cast<float *>(expected[run]->buffer)[index])
+                            ++thread_mismatches[thread];
+                }
+            }));
+
+        for (auto &thread : threads)
+            thread.join();
+
+        for (auto count : thread_mismatches)
+            mismatches += count;
+        return mismatches;
+    }
 } //namespace
 
 
@@ -390,6 +454,1298 @@ TEST(api_workloads, workflow_in_pooling_out_compilation)
     test_teardown(device_description, device_interface_0);
 }
 
+TEST(api_workloads, workflow_in_pooling_out_asynchronous_execution)
+{
+    // test configuration
+    const uint32_t size_x = 8, size_y = 8, size_z = 16;
+    const uint32_t number_of_requests = 4;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+    ASSERT_NE(nullptr, di.workload_wait_function);
+
+    // create workflow with 1 input, 2x2 max pooling and 1 output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t  *input = nullptr
+        , *pooling = nullptr
+        , *output = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc0 = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc0, 1));
+    pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+    pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+        NN_PADDING_MODE_DATA_OR_ZERO,
+        {0, 0},             /* center offset */
+        {2, 2},             /* stride during filtering operation */
+        {2, 2},             /* pooling area size */
+        NN_POOLING_MODE_MAX /* pooling mode */
+    };
+    pooling->output_format[0] = nn::output_format{ size_x / 2, size_y / 2, size_z };
+
+    nn_workflow_use_descriptor_t desc1 = { pooling, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc1, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ size_x / 2, size_y / 2, size_z };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    // enable asynchronous execution
+    uint32_t asynchronous = 1, asynchronous_check = 0;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_ASYNCHRONOUS_EXECUTION, &asynchronous, sizeof(asynchronous)));
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_get_function(di.device, NN_PARAMETER_ASYNCHRONOUS_EXECUTION, &asynchronous_check, sizeof(asynchronous_check)));
+    EXPECT_EQ(asynchronous, asynchronous_check);
+
+    // several requests in flight, each with its own buffers
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<nn::data<float, 3> *> input_datas, output_datas;
+    std::vector<NN_API_STATUS> statuses(number_of_requests);
+    for (auto request = 0u; request < number_of_requests; ++request) {
+        input_datas.push_back(new nn::data<float, 3>(size_z, size_x, size_y));
+        output_datas.push_back(new nn::data<float, 3>(size_z, size_x / 2, size_y / 2));
+        for (auto index = 0u; index < input_datas.back()->count(); ++index)
+            static_cast<float *>(input_datas.back()->buffer)[index] = distribution(generator);
+
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&input_datas[request], (void **)&output_datas[request], &statuses[request]));
+    }
+
+    for (auto request = 0u; request < number_of_requests; ++request) {
+        EXPECT_EQ(NN_API_WORK_FINISHED, di.workload_wait_function(workload, &statuses[request], NN_WAIT_INFINITE));
+        EXPECT_EQ(NN_API_WORK_FINISHED, statuses[request]);
+
+        auto &in = *input_datas[request];
+        auto &out = *output_datas[request];
+        for (auto y = 0u; y < size_y / 2; ++y)
+            for (auto x = 0u; x < size_x / 2; ++x)
+                for (auto z = 0u; z < size_z; ++z) {
+                    auto expected = std::max(std::max(in(z, 2 * x, 2 * y), in(z, 2 * x + 1, 2 * y)),
+                                             std::max(in(z, 2 * x, 2 * y + 1), in(z, 2 * x + 1, 2 * y + 1)));
+                    EXPECT_EQ(expected, out(z, x, y));
+                }
+
+        // polling finished request returns immediately
+        EXPECT_EQ(NN_API_WORK_FINISHED, di.workload_wait_function(workload, &statuses[request], 0));
+
+        delete input_datas[request];
+        delete output_datas[request];
+    }
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(pooling));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_pooling_out_zero_copy_output)
+{
+    const uint32_t size_x = 8, size_y = 8, size_z = 16;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    nn_device_interface_0_t &di = device_interface_0;
+
+    // create workflow with 1 input, 2x2 max pooling and 1 output of the same layout as pooling
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t  *input = nullptr
+        , *pooling = nullptr
+        , *output = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc0 = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc0, 1));
+    pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+    pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+        NN_PADDING_MODE_DATA_OR_ZERO,
+        {0, 0},             /* center offset */
+        {2, 2},             /* stride during filtering operation */
+        {2, 2},             /* pooling area size */
+        NN_POOLING_MODE_MAX /* pooling mode */
+    };
+    pooling->output_format[0] = nn::output_format{ size_x / 2, size_y / 2, size_z };
+
+    nn_workflow_use_descriptor_t desc1 = { pooling, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc1, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ size_x / 2, size_y / 2, size_z };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    // pooling writes directly to buffer passed as output
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+    ASSERT_EQ(1u, workload_opaque->output.size());
+    EXPECT_TRUE(workload_opaque->output[0]->arguments.output.aliased);
+
+    // every execution writes to buffer passed to it
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (auto execution = 0u; execution < 3; ++execution) {
+        nn::data<float, 3> in(size_z, size_x, size_y);
+        nn::data<float, 3> out(size_z, size_x / 2, size_y / 2);
+        for (auto index = 0u; index < in.count(); ++index)
+            static_cast<float *>(in.buffer)[index] = distribution(generator);
+        std::fill_n(static_cast<float *>(out.buffer), out.count(), 0.0f);
+
+        nn::data<float, 3> *in_ptr = &in, *out_ptr = &out;
+        NN_API_STATUS status;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+
+        for (auto y = 0u; y < size_y / 2; ++y)
+            for (auto x = 0u; x < size_x / 2; ++x)
+                for (auto z = 0u; z < size_z; ++z) {
+                    auto expected = std::max(std::max(in(z, 2 * x, 2 * y), in(z, 2 * x + 1, 2 * y)),
+                                             std::max(in(z, 2 * x, 2 * y + 1), in(z, 2 * x + 1, 2 * y + 1)));
+                    EXPECT_EQ(expected, out(z, x, y));
+                }
+    }
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(pooling));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_pooling_chain_out_memory_planning)
+{
+    // test configuration
+    const uint32_t size_x = 32, size_y = 32, size_z = 16;
+    const uint32_t number_of_poolings = 3, number_of_runs = 2;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    // create workflow with 1 input, chain of 2x2 max poolings and 1 output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *output = nullptr;
+    std::vector<nn_workflow_item_t *> poolings(number_of_poolings, nullptr);
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    auto previous = input;
+    uint32_t pooled_x = size_x, pooled_y = size_y;
+    for (auto &pooling : poolings) {
+        nn_workflow_use_descriptor_t desc = { previous, 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc, 1));
+        pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+        pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+            NN_PADDING_MODE_DATA_OR_ZERO,
+            {0, 0},             /* center offset */
+            {2, 2},             /* stride during filtering operation */
+            {2, 2},             /* pooling area size */
+            NN_POOLING_MODE_MAX /* pooling mode */
+        };
+        pooled_x /= 2;
+        pooled_y /= 2;
+        pooling->output_format[0] = nn::output_format{ pooled_x, pooled_y, size_z };
+        previous = pooling;
+    }
+
+    nn_workflow_use_descriptor_t desc_out = { previous, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ pooled_x, pooled_y, size_z };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    // first and last pooling outputs are never live together, so they share memory
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+    size_t separate_size = 0;
+    for (auto item : workload_opaque->order_of_execution)
+        if (item->type == NN_WORK_ITEM_TYPE_POOLING)
+            separate_size += nn_aligned_size(item->output[0]->parent->buffer_size);
+    EXPECT_NE(nullptr, workload_opaque->activation_arena);
+    EXPECT_LT(workload_opaque->activation_arena_size, separate_size);
+
+    const uint32_t window = size_x / pooled_x;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (auto run = 0u; run < number_of_runs; ++run) {
+        nn::data<float, 3> in(size_z, size_x, size_y), out(size_z, pooled_x, pooled_y);
+        for (auto index = 0u; index < in.count(); ++index)
+            static_cast<float *>(in.buffer)[index] = distribution(generator);
+
+        NN_API_STATUS status;
+        nn::data<float, 3> *in_ptr = &in, *out_ptr = &out;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+
+        // chain of 2x2 max poolings is max over whole window
+        for (auto y = 0u; y < pooled_y; ++y)
+            for (auto x = 0u; x < pooled_x; ++x)
+                for (auto z = 0u; z < size_z; ++z) {
+                    auto expected = in(z, window * x, window * y);
+                    for (auto wy = 0u; wy < window; ++wy)
+                        for (auto wx = 0u; wx < window; ++wx)
+                            expected = std::max(expected, in(z, window * x + wx, window * y + wy));
+                    EXPECT_EQ(expected, out(z, x, y));
+                }
+    }
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    for (auto it = poolings.rbegin(); it != poolings.rend(); ++it)
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(*it));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_pooling_branches_out_parallel_execution)
+{
+    // test configuration
+    const uint32_t size_x = 16, size_y = 16, size_z = 8;
+    const uint32_t number_of_branches = 3;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    // create workflow with 1 input and independent branches of max pooling with 2x2, 4x4 and 8x8 windows,
+    // each with own output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, number_of_branches));
+
+    nn_workflow_item_t *input = nullptr;
+    std::vector<nn_workflow_item_t *> poolings(number_of_branches, nullptr), outputs(number_of_branches, nullptr);
+    std::vector<uint32_t> windows;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+    workflow->input[0] = input;
+
+    for (auto branch = 0u; branch < number_of_branches; ++branch) {
+        const uint32_t window = 2u << branch;
+        windows.push_back(window);
+
+        nn_workflow_use_descriptor_t desc = { input, 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&poolings[branch], 1, &desc, 1));
+        poolings[branch]->type = NN_WORK_ITEM_TYPE_POOLING;
+        poolings[branch]->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+            NN_PADDING_MODE_DATA_OR_ZERO,
+            {0, 0},             /* center offset */
+            {window, window},   /* stride during filtering operation */
+            {window, window},   /* pooling area size */
+            NN_POOLING_MODE_MAX /* pooling mode */
+        };
+        poolings[branch]->output_format[0] = nn::output_format{ size_x / window, size_y / window, size_z };
+
+        nn_workflow_use_descriptor_t desc_out = { poolings[branch], 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&outputs[branch], 1, &desc_out, 1));
+        outputs[branch]->type = NN_WORK_ITEM_TYPE_OUTPUT;
+        outputs[branch]->arguments.output.index = branch;
+        outputs[branch]->output_format[0] = poolings[branch]->output_format[0];
+        workflow->output[branch] = outputs[branch];
+    }
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format[number_of_branches] = {
+        NN_WORKLOAD_DATA_TYPE_F32_ZXY, NN_WORKLOAD_DATA_TYPE_F32_ZXY, NN_WORKLOAD_DATA_TYPE_F32_ZXY };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, io_format, io_format, 1));
+
+    // branches do not depend on each other
+    EXPECT_TRUE(static_cast<nn_workload_opaque_t *>(workload)->parallel_execution);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    nn::data<float, 3> in(size_z, size_x, size_y);
+    for (auto index = 0u; index < in.count(); ++index)
+        static_cast<float *>(in.buffer)[index] = distribution(generator);
+
+    std::vector<nn::data<float, 3> *> output_datas;
+    for (auto window : windows)
+        output_datas.push_back(new nn::data<float, 3>(size_z, size_x / window, size_y / window));
+
+    NN_API_STATUS status;
+    nn::data<float, 3> *in_ptr = &in;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)output_datas.data(), &status));
+    EXPECT_EQ(NN_API_WORK_FINISHED, status);
+
+    for (auto branch = 0u; branch < number_of_branches; ++branch) {
+        const auto window = windows[branch];
+        auto &out = *output_datas[branch];
+        for (auto y = 0u; y < size_y / window; ++y)
+            for (auto x = 0u; x < size_x / window; ++x)
+                for (auto z = 0u; z < size_z; ++z) {
+                    auto expected = in(z, window * x, window * y);
+                    for (auto wy = 0u; wy < window; ++wy)
+                        for (auto wx = 0u; wx < window; ++wx)
+                            expected = std::max(expected, in(z, window * x + wx, window * y + wy));
+                    EXPECT_EQ(expected, out(z, x, y));
+                }
+        delete output_datas[branch];
+    }
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    for (auto branch = 0u; branch < number_of_branches; ++branch) {
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(outputs[branch]));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(poolings[branch]));
+    }
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_pooling_chain_out_concurrent_execution)
+{
+    // test configuration
+    const uint32_t size_x = 128, size_y = 128, size_z = 32;
+    const uint32_t number_of_poolings = 3, number_of_threads = 4, number_of_runs = 8;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    // create workflow with 1 input, chain of 2x2 max poolings and 1 output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *output = nullptr;
+    std::vector<nn_workflow_item_t *> poolings(number_of_poolings, nullptr);
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    auto previous = input;
+    uint32_t pooled_x = size_x, pooled_y = size_y;
+    for (auto &pooling : poolings) {
+        nn_workflow_use_descriptor_t desc = { previous, 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc, 1));
+        pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+        pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+            NN_PADDING_MODE_DATA_OR_ZERO,
+            {0, 0},             /* center offset */
+            {2, 2},             /* stride during filtering operation */
+            {2, 2},             /* pooling area size */
+            NN_POOLING_MODE_MAX /* pooling mode */
+        };
+        pooled_x /= 2;
+        pooled_y /= 2;
+        pooling->output_format[0] = nn::output_format{ pooled_x, pooled_y, size_z };
+        previous = pooling;
+    }
+
+    nn_workflow_use_descriptor_t desc_out = { previous, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ pooled_x, pooled_y, size_z };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+    EXPECT_TRUE(workload_opaque->concurrent_execution);
+
+    // every thread executes the same workload with its own data, threads start together
+    const uint32_t window = size_x / pooled_x;
+    std::vector<uint32_t> mismatches(number_of_threads, 0);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> threads_ready(0);
+    for (auto thread = 0u; thread < number_of_threads; ++thread)
+        threads.push_back(std::thread([&, thread]() {
+            std::mt19937 generator(thread);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+            for (auto run = 0u; run < number_of_runs; ++run) {
+                nn::data<float, 3> in(size_z, size_x, size_y), out(size_z, pooled_x, pooled_y);
+                for (auto index = 0u; index < in.count(); ++index)
+                    static_cast<float *>(in.buffer)[index] = distribution(generator);
+
+                if (run == 0)
+                    for (++threads_ready; threads_ready < number_of_threads;)
+                        std::this_thread::yield();
+
+                NN_API_STATUS status;
+                nn::data<float, 3> *in_ptr = &in, *out_ptr = &out;
+                if (NN_API_STATUS_OK != di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status) ||
+                    NN_API_WORK_FINISHED != status)
+                    ++mismatches[thread];
+
+                // chain of 2x2 max poolings is max over whole window
+                for (auto y = 0u; y < pooled_y; ++y)
+                    for (auto x = 0u; x < pooled_x; ++x)
+                        for (auto z = 0u; z < size_z; ++z) {
+                            auto expected = in(z, window * x, window * y);
+                            for (auto wy = 0u; wy < window; ++wy)
+                                for (auto wx = 0u; wx < window; ++wx)
+                                    expected = std::max(expected, in(z, window * x + wx, window * y + wy));
+                            if (expected != out(z, x, y))
+                                ++mismatches[thread];
+                        }
+            }
+        }));
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (auto thread = 0u; thread < number_of_threads; ++thread)
+        EXPECT_EQ(0u, mismatches[thread]);
+
+    // all contexts, including primary one, are returned after executions
+    EXPECT_EQ(workload_opaque->contexts.size() + 1, workload_opaque->idle_contexts.size());
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    for (auto it = poolings.rbegin(); it != poolings.rend(); ++it)
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(*it));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_padded_convolution_out_concurrent_execution)
+{
+    // test configuration
+    const uint32_t size_x = 32, size_y = 32, size_z = 16, conv_feats = 32;
+    const uint32_t number_of_threads = 4, number_of_runs = 16;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    nn::data<float, 4> front_weights(3, 3, size_z, size_z);
+    nn::data<float, 1> front_biases(size_z);
+    for (auto index = 0u; index < front_weights.count(); ++index)
+        static_cast<float *>(front_weights.buffer)[index] = distribution(generator);
+    for (auto index = 0u; index < front_biases.count(); ++index)
+        static_cast<float *>(front_biases.buffer)[index] = distribution(generator);
+    nn::data<float, 4> conv_weights(5, 5, size_z, conv_feats);
+    nn::data<float, 1> conv_biases(conv_feats);
+    for (auto index = 0u; index < conv_weights.count(); ++index)
+        static_cast<float *>(conv_weights.buffer)[index] = distribution(generator);
+    for (auto index = 0u; index < conv_biases.count(); ++index)
+        static_cast<float *>(conv_biases.buffer)[index] = distribution(generator);
+
+    // create workflow: input, convolution 3x3, convolution 5x5 keeping size (borders read zero padding), output;
+    // first convolution makes compiler pad buffer read by second one instead of input given by caller
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *front = nullptr, *conv = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x + 2, size_y + 2, size_z };
+
+    nn_workflow_use_descriptor_t desc_front = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&front, 1, &desc_front, 1));
+    front->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    front->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    front->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    front->arguments.forward_convolution.weights = &front_weights;
+    front->arguments.forward_convolution.biases = &front_biases;
+    front->arguments.forward_convolution.center_offset[0] = 0;
+    front->arguments.forward_convolution.center_offset[1] = 0;
+    front->arguments.forward_convolution.stride[0] = 1;
+    front->arguments.forward_convolution.stride[1] = 1;
+    front->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { front, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 2;
+    conv->arguments.forward_convolution.center_offset[1] = 2;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ size_x, size_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ size_x, size_y, conv_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+    EXPECT_TRUE(workload_opaque->concurrent_execution);
+
+    // convolution keeping size is not sharing state between executions running at the same time
+    EXPECT_EQ(0u, concurrent_execution_mismatches(di, workload, {size_z, size_x + 2, size_y + 2}, {conv_feats, size_x, size_y},
+                                                  number_of_threads, number_of_runs));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(front));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_in_fused_convolution_normalization_pooling_out_concurrent_execution)
+{
+    // test configuration
+    const uint32_t size_x = 32, size_y = 32, size_z = 16, conv_feats = 32, pooled_x = size_x / 2, pooled_y = size_y / 2;
+    const uint32_t number_of_threads = 4, number_of_runs = 16;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    nn::data<float, 4> front_weights(3, 3, size_z, size_z);
+    nn::data<float, 1> front_biases(size_z);
+    for (auto index = 0u; index < front_weights.count(); ++index)
+        static_cast<float *>(front_weights.buffer)[index] = distribution(generator);
+    for (auto index = 0u; index < front_biases.count(); ++index)
+        static_cast<float *>(front_biases.buffer)[index] = distribution(generator);
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats);
+    nn::data<float, 1> conv_biases(conv_feats);
+    for (auto index = 0u; index < conv_weights.count(); ++index)
+        static_cast<float *>(conv_weights.buffer)[index] = distribution(generator);
+    for (auto index = 0u; index < conv_biases.count(); ++index)
+        static_cast<float *>(conv_biases.buffer)[index] = distribution(generator);
+
+    // create workflow: input, convolution 3x3, padded convolution 3x3 with ReLU, LRN, 2x2 max pooling, output;
+    // first convolution makes compiler pad buffer read by fused stage instead of input given by caller
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *front = nullptr, *conv = nullptr, *norm = nullptr, *pooling = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x + 2, size_y + 2, size_z };
+
+    nn_workflow_use_descriptor_t desc_front = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&front, 1, &desc_front, 1));
+    front->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    front->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    front->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    front->arguments.forward_convolution.weights = &front_weights;
+    front->arguments.forward_convolution.biases = &front_biases;
+    front->arguments.forward_convolution.center_offset[0] = 0;
+    front->arguments.forward_convolution.center_offset[1] = 0;
+    front->arguments.forward_convolution.stride[0] = 1;
+    front->arguments.forward_convolution.stride[1] = 1;
+    front->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { front, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 1;
+    conv->arguments.forward_convolution.center_offset[1] = 1;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ size_x, size_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_norm = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&norm, 1, &desc_norm, 1));
+    norm->type = NN_WORK_ITEM_TYPE_NORMALIZATION;
+    norm->arguments.forward_normalization.normalization.mode = NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS;
+    norm->arguments.forward_normalization.normalization.k = 1;
+    norm->arguments.forward_normalization.normalization.n = 5;
+    norm->arguments.forward_normalization.normalization.alpha = 0.0001f / 5;
+    norm->arguments.forward_normalization.normalization.beta = 0.75f;
+    norm->output_format[0] = nn::output_format{ size_x, size_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_pooling = { norm, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc_pooling, 1));
+    pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+    pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+        NN_PADDING_MODE_DATA_OR_ZERO,
+        {0, 0},             /* center offset */
+        {2, 2},             /* stride during filtering operation */
+        {2, 2},             /* pooling area size */
+        NN_POOLING_MODE_MAX /* pooling mode */
+    };
+    pooling->output_format[0] = nn::output_format{ pooled_x, pooled_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { pooling, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ pooled_x, pooled_y, conv_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    nn_workload_t *workload;
+    NN_WORKLOAD_DATA_TYPE io_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &io_format, &io_format, 1));
+
+    auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+    EXPECT_TRUE(workload_opaque->concurrent_execution);
+    EXPECT_TRUE(std::any_of(workload_opaque->order_of_execution.begin(), workload_opaque->order_of_execution.end(),
+        [](nn_workload_item *item) {
+            return dynamic_cast<layer::convolution_normalization_pooling_f32 *>(item->primitive) != nullptr;
+        }));
+
+    // tiles of fused stage are not shared by executions running at the same time
+    EXPECT_EQ(0u, concurrent_execution_mismatches(di, workload, {size_z, size_x + 2, size_y + 2}, {conv_feats, pooled_x, pooled_y},
+                                                  number_of_threads, number_of_runs));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(pooling));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(norm));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(front));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_convolution_chain_jit_primitives_any_batch)
+{
+    // test configuration
+    const uint32_t size_x = 10, size_y = 10, size_z = 8, conv_feats = 32, fc_feats = 36;
+    const uint32_t conv_x = size_x - 2, conv_y = size_y - 2, pooled_x = conv_x / 2, pooled_y = conv_y / 2;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator);
+    };
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats), fc_weights(pooled_x, pooled_y, conv_feats, fc_feats);
+    nn::data<float, 1> conv_biases(conv_feats), fc_biases(fc_feats);
+    randomize(conv_weights);
+    randomize(conv_biases);
+    randomize(fc_weights);
+    randomize(fc_biases);
+
+    // create workflow: input, convolution 3x3 with ReLU, LRN, 2x2 max pooling, fully connected, softmax, output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *conv = nullptr, *norm = nullptr, *pooling = nullptr, *fc = nullptr,
+                       *softmax = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 0;
+    conv->arguments.forward_convolution.center_offset[1] = 0;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_norm = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&norm, 1, &desc_norm, 1));
+    norm->type = NN_WORK_ITEM_TYPE_NORMALIZATION;
+    norm->arguments.forward_normalization.normalization.mode = NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS;
+    norm->arguments.forward_normalization.normalization.k = 1;
+    norm->arguments.forward_normalization.normalization.n = 5;
+    norm->arguments.forward_normalization.normalization.alpha = 0.0001f / 5;
+    norm->arguments.forward_normalization.normalization.beta = 0.75f;
+    norm->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_pooling = { norm, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc_pooling, 1));
+    pooling->type = NN_WORK_ITEM_TYPE_POOLING;
+    pooling->arguments.forward_pooling = nn_arguments_forward_pooling_t{
+        NN_PADDING_MODE_DATA_OR_ZERO,
+        {0, 0},             /* center offset */
+        {2, 2},             /* stride during filtering operation */
+        {2, 2},             /* pooling area size */
+        NN_POOLING_MODE_MAX /* pooling mode */
+    };
+    pooling->output_format[0] = nn::output_format{ pooled_x, pooled_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_fc = { pooling, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fc, 1, &desc_fc, 1));
+    fc->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED;
+    fc->arguments.forward_fully_connected.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc->arguments.forward_fully_connected.weights = &fc_weights;
+    fc->arguments.forward_fully_connected.biases = &fc_biases;
+    fc->output_format[0] = nn::output_format{ fc_feats };
+
+    nn_workflow_use_descriptor_t desc_softmax = { fc, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&softmax, 1, &desc_softmax, 1));
+    softmax->type = NN_WORK_ITEM_TYPE_SOFTMAX;
+    softmax->output_format[0] = nn::output_format{ fc_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { softmax, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ fc_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    // results of batch with padded tail block match results of the same pictures in batch of full blocks
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH;
+    EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(1));
+    auto execute = [&](uint32_t batch, nn::data<float, 4> &in, nn::data<float, 2> &out) {
+        nn_workload_t *workload = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+        auto workload_opaque = static_cast<nn_workload_opaque_t *>(workload);
+        EXPECT_TRUE(std::any_of(workload_opaque->order_of_execution.begin(), workload_opaque->order_of_execution.end(),
+            [](nn_workload_item *item) {
+                return !item->output.empty() && item->output[0]->parent->tag == NN_WORKLOAD_DATA_TAG_NBLOCKZXYN;
+            })) << "batch: " << batch;
+
+        NN_API_STATUS status;
+        nn::data<float, 4> *in_ptr = &in;
+        nn::data<float, 2> *out_ptr = &out;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+    };
+    for (uint32_t batch : { 13u, 17u, 30u }) {
+        const uint32_t full_batch = (batch + 23) / 24 * 24;
+        nn::data<float, 4> in_full(size_z, size_x, size_y, full_batch), in(size_z, size_x, size_y, batch);
+        randomize(in_full);
+        std::copy(static_cast<float *>(in_full.buffer), static_cast<float *>(in_full.buffer) + in.count(),
+                  static_cast<float *>(in.buffer));
+
+        nn::data<float, 2> out_full(fc_feats, full_batch), out(fc_feats, batch);
+        execute(full_batch, in_full, out_full);
+        execute(batch, in, out);
+
+        uint32_t mismatches = 0;
+        for (auto n = 0u; n < batch; ++n)
+            for (auto i = 0u; i < fc_feats; ++i)
+                if (std::abs(out_full(i, n) - out(i, n)) > 1e-5f)
+                    ++mismatches;
+        EXPECT_EQ(0u, mismatches) << "batch: " << batch;
+    }
+    EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(0));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(softmax));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fc));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(pooling));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(norm));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_convolution_chain_auto_tuned)
+{
+    // test configuration
+    const uint32_t size_x = 10, size_y = 10, size_z = 8, conv_feats = 32, fc_feats = 36, batch = 48;
+    const uint32_t conv_x = size_x - 2, conv_y = size_y - 2;
+    const char tuning_file[] = "api_workloads_tuning.txt";
+    std::remove(tuning_file);
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator);
+    };
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats), fc_weights(conv_x, conv_y, conv_feats, fc_feats);
+    nn::data<float, 1> conv_biases(conv_feats), fc_biases(fc_feats);
+    randomize(conv_weights);
+    randomize(conv_biases);
+    randomize(fc_weights);
+    randomize(fc_biases);
+
+    // create workflow: input, convolution 3x3 with ReLU, LRN, fully connected, softmax, output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *conv = nullptr, *norm = nullptr, *fc = nullptr, *softmax = nullptr,
+                       *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 0;
+    conv->arguments.forward_convolution.center_offset[1] = 0;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_norm = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&norm, 1, &desc_norm, 1));
+    norm->type = NN_WORK_ITEM_TYPE_NORMALIZATION;
+    norm->arguments.forward_normalization.normalization.mode = NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS;
+    norm->arguments.forward_normalization.normalization.k = 1;
+    norm->arguments.forward_normalization.normalization.n = 5;
+    norm->arguments.forward_normalization.normalization.alpha = 0.0001f / 5;
+    norm->arguments.forward_normalization.normalization.beta = 0.75f;
+    norm->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_fc = { norm, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fc, 1, &desc_fc, 1));
+    fc->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED;
+    fc->arguments.forward_fully_connected.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc->arguments.forward_fully_connected.weights = &fc_weights;
+    fc->arguments.forward_fully_connected.biases = &fc_biases;
+    fc->output_format[0] = nn::output_format{ fc_feats };
+
+    nn_workflow_use_descriptor_t desc_softmax = { fc, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&softmax, 1, &desc_softmax, 1));
+    softmax->type = NN_WORK_ITEM_TYPE_SOFTMAX;
+    softmax->output_format[0] = nn::output_format{ fc_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { softmax, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ fc_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH;
+    nn::data<float, 4> in(size_z, size_x, size_y, batch);
+    randomize(in);
+    auto execute = [&](nn::data<float, 2> &out) {
+        nn_workload_t *workload = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+        NN_API_STATUS status;
+        nn::data<float, 4> *in_ptr = &in;
+        nn::data<float, 2> *out_ptr = &out;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+    };
+    auto count_mismatches = [&](nn::data<float, 2> &lhs, nn::data<float, 2> &rhs) {
+        uint32_t mismatches = 0;
+        for (auto n = 0u; n < batch; ++n)
+            for (auto i = 0u; i < fc_feats; ++i)
+                if (std::abs(lhs(i, n) - rhs(i, n)) > 1e-5f)
+                    ++mismatches;
+        return mismatches;
+    };
+
+    // implementations chosen by tuning compute the same results as ones chosen by heuristics
+    EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(1));
+    nn::data<float, 2> out_heuristic(fc_feats, batch), out_tuned(fc_feats, batch), out_from_file(fc_feats, batch);
+    execute(out_heuristic);
+
+    uint32_t tuning = 1;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_TUNING_FILE, (void *)tuning_file, sizeof(tuning_file)));
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_AUTO_TUNING, &tuning, sizeof(tuning)));
+    execute(out_tuned);
+    EXPECT_EQ(0u, count_mismatches(out_heuristic, out_tuned));
+
+    // decisions of each tunable layer are saved
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(tuning_file);
+        for (std::string line; std::getline(file, line);)
+            lines.push_back(line);
+    }
+    for (auto layer : { "convolution,", "normalization_response_across_maps,", "fully_connected,", "softmax," })
+        EXPECT_EQ(1, std::count_if(lines.begin(), lines.end(), [&](const std::string &line) { return line.find(layer) == 0; }))
+            << "layer: " << layer;
+
+    // later compiles reuse decisions without tuning
+    tuning = 0;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_AUTO_TUNING, &tuning, sizeof(tuning)));
+    execute(out_from_file);
+    EXPECT_EQ(0u, count_mismatches(out_tuned, out_from_file));
+    EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(0));
+
+    char path[64];
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_get_function(di.device, NN_PARAMETER_TUNING_FILE, path, sizeof(path)));
+    EXPECT_STREQ(tuning_file, path);
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_TUNING_FILE, (void *)"", 1));
+    std::remove(tuning_file);
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(softmax));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fc));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(norm));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_convolution_chain_numa_groups)
+{
+    // test configuration
+    const uint32_t size_x = 10, size_y = 10, size_z = 8, conv_feats = 32;
+    const uint32_t conv_x = size_x - 2, conv_y = size_y - 2;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator);
+    };
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats);
+    nn::data<float, 1> conv_biases(conv_feats);
+    randomize(conv_weights);
+    randomize(conv_biases);
+
+    // create workflow: input, convolution 3x3 with ReLU, LRN, output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *conv = nullptr, *norm = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 0;
+    conv->arguments.forward_convolution.center_offset[1] = 0;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_norm = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&norm, 1, &desc_norm, 1));
+    norm->type = NN_WORK_ITEM_TYPE_NORMALIZATION;
+    norm->arguments.forward_normalization.normalization.mode = NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS;
+    norm->arguments.forward_normalization.normalization.k = 1;
+    norm->arguments.forward_normalization.normalization.n = 5;
+    norm->arguments.forward_normalization.normalization.alpha = 0.0001f / 5;
+    norm->arguments.forward_normalization.normalization.beta = 0.75f;
+    norm->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { norm, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    auto execute = [&](uint32_t batch, nn::data<float, 4> &in, nn::data<float, 4> &out) {
+        nn_workload_t *workload = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+        NN_API_STATUS status;
+        nn::data<float, 4> *in_ptr = &in;
+        nn::data<float, 4> *out_ptr = &out;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+    };
+
+    uint32_t groups = 0;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_get_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+    EXPECT_EQ(0u, groups);
+
+    // results of batch split between worker groups are the same as of whole batch on device threads,
+    // also when batch is not multiple of batch block or is smaller than number of groups
+    for (auto jit : { 0, 1 })
+        for (auto batch : { 48u, 10u, 1u })
+        {
+            nn::data<float, 4> in(size_z, size_x, size_y, batch);
+            randomize(in);
+            nn::data<float, 4> out_device(conv_feats, conv_x, conv_y, batch), out_groups(conv_feats, conv_x, conv_y, batch);
+
+            EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(jit));
+            groups = 0;
+            EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+            execute(batch, in, out_device);
+
+            groups = 2;
+            EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+            groups = 0;
+            EXPECT_EQ(NN_API_STATUS_OK, di.parameter_get_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+            EXPECT_EQ(2u, groups);
+            execute(batch, in, out_groups);
+
+            uint32_t mismatches = 0;
+            nn_data_t &lhs = out_device, &rhs = out_groups;
+            for (auto index = 0u; index < nn_data_buffer_size_ptr(1, lhs.dimension, lhs.size); ++index)
+                if (std::abs(static_cast<float *>(lhs.buffer)[index] - static_cast<float *>(rhs.buffer)[index]) > 1e-5f)
+                    ++mismatches;
+            EXPECT_EQ(0u, mismatches) << "jit: " << jit << " batch: " << batch;
+        }
+    EXPECT_EQ(NN_API_STATUS_OK, di.use_jit_primitives(0));
+
+    // group per NUMA node, there is at least one
+    groups = 1;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_get_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+    EXPECT_LE(1u, groups);
+    groups = 0;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_NUMA_EXECUTION, &groups, sizeof(groups)));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(norm));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(api_workloads, workflow_convolution_fully_connected_batch_conversion)
+{
+    // test configuration
+    const uint32_t size_x = 7, size_y = 7, size_z = 8, conv_feats = 16, fc_feats = 20;
+    const uint32_t conv_x = size_x - 2, conv_y = size_y - 2;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator);
+    };
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats), fc_weights(conv_x, conv_y, conv_feats, fc_feats);
+    nn::data<float, 1> conv_biases(conv_feats), fc_biases(fc_feats);
+    randomize(conv_weights);
+    randomize(conv_biases);
+    randomize(fc_weights);
+    randomize(fc_biases);
+
+    // create workflow: input, convolution 3x3 with ReLU, fully connected, output
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *conv = nullptr, *fc = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+    conv->arguments.forward_convolution.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv->arguments.forward_convolution.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv->arguments.forward_convolution.weights = &conv_weights;
+    conv->arguments.forward_convolution.biases = &conv_biases;
+    conv->arguments.forward_convolution.center_offset[0] = 0;
+    conv->arguments.forward_convolution.center_offset[1] = 0;
+    conv->arguments.forward_convolution.stride[0] = 1;
+    conv->arguments.forward_convolution.stride[1] = 1;
+    conv->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_fc = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fc, 1, &desc_fc, 1));
+    fc->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED;
+    fc->arguments.forward_fully_connected.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc->arguments.forward_fully_connected.weights = &fc_weights;
+    fc->arguments.forward_fully_connected.biases = &fc_biases;
+    fc->output_format[0] = nn::output_format{ fc_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { fc, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ fc_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH;
+    auto execute = [&](uint32_t batch, nn::data<float, 4> &in, nn::data<float, 2> &out) {
+        nn_workload_t *workload = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+        NN_API_STATUS status;
+        nn::data<float, 4> *in_ptr = &in;
+        nn::data<float, 2> *out_ptr = &out;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+    };
+
+    // batches are interleaved before fully connected layer and back after it, each picture
+    // of batch gives the same result as when processed alone (where conversion is just a view)
+    for (uint32_t batch : { 8u, 48u }) {
+        nn::data<float, 4> in(size_z, size_x, size_y, batch);
+        randomize(in);
+        nn::data<float, 2> out(fc_feats, batch);
+        execute(batch, in, out);
+
+        uint32_t mismatches = 0;
+        for (auto n = 0u; n < batch; ++n) {
+            nn::data<float, 4> in_single(size_z, size_x, size_y, 1);
+            nn::data<float, 2> out_single(fc_feats, 1);
+            const auto image_size = size_z * size_x * size_y;
+            std::copy(static_cast<float *>(in.buffer) + n * image_size, static_cast<float *>(in.buffer) + (n + 1) * image_size,
+                      static_cast<float *>(in_single.buffer));
+            execute(1, in_single, out_single);
+
+            for (auto i = 0u; i < fc_feats; ++i)
+                if (std::abs(out_single(i, 0) - out(i, n)) > 1e-3f * std::max(1.0f, std::abs(out_single(i, 0))))
+                    ++mismatches;
+        }
+        EXPECT_EQ(0u, mismatches) << "batch: " << batch;
+    }
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fc));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
+
 //TEST(api_workloads, workflow_in_convolve_int16_out_compilation)
 //{
 //    // test configuration
@@ -119,5 +119,36 @@ TEST_F(AsmjitModulesTest, power075_small_values)
     check_pow_075(some_values);
 }
 
+template <nn::intrinsics::invpow_kind T_kind>
+void check_invpow(float beta, std::vector<float> values)
+{
+    ASSERT_EQ(0, values.size() % 8);
+    for (auto i = 0u; i < values.size(); i += 8)
+    {
+        float output[8];
+        _mm256_storeu_ps(output, nn::intrinsics::invpow_ps<T_kind>(_mm256_loadu_ps(&values[i]), _mm256_set1_ps(beta)));
+        for (auto j = 0u; j < 8; ++j)
+        {
+            auto expected = std::pow(static_cast<double>(values[i + j]), -static_cast<double>(beta));
+            ASSERT_NEAR(expected, output[j], expected * 2e-5) << values[i + j] << "^-" << beta;
+        }
+    }
+}
+
+TEST(IntrinsicPowerTest, invpow_any_beta)
+{
+    std::vector<float> some_values(1024);
+    randomizeWithAny(some_values.begin(), some_values.end(), 0.001, 10000.0);
+    some_values[0] = 1.0f;
+    some_values[1] = 2.0f;
+    some_values[2] = 0.5f;
+    some_values[3] = 3.14159265358979f;
+
+    check_invpow<nn::intrinsics::invpow_kind::beta_05>(0.5f, some_values);
+    check_invpow<nn::intrinsics::invpow_kind::beta_1>(1.0f, some_values);
+    for (auto beta : { 0.6f, 0.75f, 1.5f, 2.0f })
+        check_invpow<nn::intrinsics::invpow_kind::any>(beta, some_values);
+}
+
 } //namespace
 
@@ -73,6 +73,7 @@ TEST( cpu_device_load_and_unload, callbacks_test )
             EXPECT_NE(nullptr, di.workflow_metrics_delete_function);    // non-null function pointer returned
             EXPECT_NE(nullptr, di.workflow_compile_function);           // non-null function pointer returned
             EXPECT_NE(nullptr, di.workload_execute_function);           // non-null function pointer returned
+            EXPECT_NE(nullptr, di.workload_wait_function);              // non-null function pointer returned
             EXPECT_NE(nullptr, di.workload_delete_function);            // non-null function pointer returned
             EXPECT_NE(nullptr, di.workflow_item_create_function);       // non-null function pointer returned
             EXPECT_NE(nullptr, di.workflow_item_validate_function);     // non-null function pointer returned
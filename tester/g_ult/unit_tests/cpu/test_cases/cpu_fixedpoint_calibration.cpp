@@ -0,0 +1,329 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "device/api/nn_device_api.h"
+#include "device/api/nn_device_interface_0.h"
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_fixedpoint_calibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char C_configuration_path[] = "cpu_fixedpoint_calibration_test.txt";
+
+void test_setup(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+    // load device & validate it has 0 as a startin interface version
+    nn_device_load(&device_description);
+    EXPECT_EQ(device_description.version_first, 0);
+    // open interface 0
+    EXPECT_EQ(0, nn_device_interface_open(0, &device_interface_0));
+}
+
+void test_teardown(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+    // close interface 0
+    EXPECT_EQ(0, nn_device_interface_close(&device_interface_0));
+    // unload device
+    EXPECT_EQ(0, nn_device_unload());
+}
+
+float max_abs(const nn_data_t &data) {
+    float range = 0.0f;
+    for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+        range = std::max(range, std::abs(static_cast<const float *>(data.buffer)[index]));
+    return range;
+}
+
+template <typename T_int>
+void quantize(const nn_data_t &data, nn_data_t &quantized, uint32_t fraction) {
+    for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+        static_cast<T_int *>(quantized.buffer)[index] =
+            static_cast<T_int>(std::lround(static_cast<const float *>(data.buffer)[index] * (1 << fraction)));
+}
+} //namespace
+
+TEST(cpu_fixedpoint_calibration, fraction_keeps_range_with_margin_in_int16)
+{
+    for (auto range : { 0.001f, 0.3f, 1.0f, 7.5f, 200.0f, 20000.0f })
+    {
+        auto fraction = fixedpoint_calibration::fraction(range);
+        EXPECT_LE(range * fixedpoint_calibration::saturation_margin * (1 << fraction), 32767.0f) << "range: " << range;
+        if (fraction > 0)
+        {
+            EXPECT_GT(range * fixedpoint_calibration::saturation_margin * (2 << fraction), 32767.0f) << "range: " << range;
+        }
+    }
+    EXPECT_EQ(14, fixedpoint_calibration::fraction(1.0f));
+    EXPECT_EQ(15, fixedpoint_calibration::fraction(0.0f));
+    EXPECT_EQ(0, fixedpoint_calibration::fraction(1e6f));
+}
+
+TEST(cpu_fixedpoint_calibration, ranges_saved_and_loaded)
+{
+    std::remove(C_configuration_path);
+    {
+        nn::workload_data<nn::layout_f32> output({ 2, 3, 3, 4, 1, 1 }, nn::layout_t<nn::layout_nxyzpq_f32>::layout);
+        for (uint32_t n = 0; n < 2; ++n)
+            for (uint32_t x = 0; x < 3; ++x)
+                for (uint32_t y = 0; y < 3; ++y)
+                    for (uint32_t z = 0; z < 4; ++z)
+                        nn_workload_data_get<float>(&output, n, x, y, z, 0, 0) = 0.5f;
+        nn_workload_data_get<float>(&output, 1, 1, 2, 3, 0, 0) = -3.0f;
+        nn_workload_data_get<float>(&output, 0, 0, 0, 0, 0, 0) = 100.0f;
+
+        // element outside of view is not recorded
+        nn::workload_data<nn::layout_f32> view(output, { 0, 1, 0, 0, 0, 0 }, { 1, 2, 2, 3, 0, 0 });
+
+        nn::data<float, 1> weights(4);
+        weights(0) = 0.25f; weights(1) = -0.5f; weights(2) = 0.0f; weights(3) = 0.125f;
+
+        fixedpoint_calibration calibration;
+        calibration.set_path(C_configuration_path);
+        calibration.load();
+        EXPECT_TRUE(calibration.empty());
+        calibration.record_output("conv", &view);
+        calibration.record_weights("conv", &weights);
+        calibration.save();
+    }
+
+    fixedpoint_calibration calibration;
+    calibration.set_path(C_configuration_path);
+    calibration.load();
+
+    fixedpoint_calibration::layer_format format;
+    ASSERT_TRUE(calibration.find("conv", format));
+    EXPECT_FLOAT_EQ(3.0f, format.output_range);
+    EXPECT_FLOAT_EQ(0.5f, format.weights_range);
+    EXPECT_EQ(fixedpoint_calibration::fraction(3.0f), format.output_fraction);
+    EXPECT_EQ(fixedpoint_calibration::fraction(0.5f), format.weights_fraction);
+    EXPECT_FALSE(calibration.find("fc", format));
+    std::remove(C_configuration_path);
+}
+
+// float workflow input -> convolution 3x3 with ReLU (c1) -> fully connected (fc1) -> output records ranges of its layers;
+// int16 workflow with the same names and wrong fractions in arguments followed by softmax matches float probabilities
+// with calibrated ones;
+// weights are quantized with more fractional bits than accumulator of convolution can hold for calibrated range
+TEST(cpu_fixedpoint_calibration, float_ranges_configure_int16_workflow)
+{
+    const uint32_t batch = 8, size_x = 6, size_y = 6, size_z = 4;
+    const uint32_t conv_feats = 32, conv_x = size_x - 2, conv_y = size_y - 2;
+    const uint32_t fc_feats = 16;
+    const uint32_t weights_fraction = 15;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data, float range) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator) * range;
+    };
+
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats), fc_weights(conv_x, conv_y, conv_feats, fc_feats);
+    nn::data<float, 1> conv_biases(conv_feats), fc_biases(fc_feats);
+    randomize(conv_weights, 0.5f);
+    randomize(conv_biases, 1.0f);
+    randomize(fc_weights, 0.05f);
+    randomize(fc_biases, 1.0f);
+
+    nn::data<float, 4> in(size_z, size_x, size_y, batch);
+    randomize(in, 20.0f);
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::vector<nn_workflow_item_t *> items;
+    auto create_item = [&](nn_workflow_item_t *input_item, NN_WORK_ITEM_TYPE type, const char *name, nn_output_format format) {
+        nn_workflow_item_t *item = nullptr;
+        nn_workflow_use_descriptor_t descriptor = { input_item, 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&item, input_item ? 1 : 0, input_item ? &descriptor : nullptr, 1));
+        item->type = type;
+        if (name)
+            item->name = name;
+        item->output_format[0] = format;
+        items.push_back(item);
+        return item;
+    };
+    auto execute = [&](nn_workflow_item_t *input, nn_workflow_item_t *output, NN_WORKLOAD_DATA_TYPE output_format, nn_data_t *out) {
+        nn_workflow_t *workflow = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+        workflow->input[0] = input;
+        workflow->output[0] = output;
+
+        NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+        nn_workload_t *workload = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+        NN_API_STATUS status;
+        nn_data_t *in_ptr = &in;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out, &status));
+        EXPECT_EQ(NN_API_WORK_FINISHED, status);
+        EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+    };
+
+    // float workflow
+    auto input = create_item(nullptr, NN_WORK_ITEM_TYPE_INPUT, nullptr, nn::output_format{ size_x, size_y, size_z });
+    input->arguments.input.index = 0;
+
+    auto conv = create_item(input, NN_WORK_ITEM_TYPE_CONVOLUTION, "c1", nn::output_format{ conv_x, conv_y, conv_feats });
+    auto &conv_args = conv->arguments.forward_convolution;
+    conv_args.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv_args.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv_args.weights = &conv_weights;
+    conv_args.biases = &conv_biases;
+    conv_args.stride[0] = 1;
+    conv_args.stride[1] = 1;
+
+    auto fc = create_item(conv, NN_WORK_ITEM_TYPE_FULLY_CONNECTED, "fc1", nn::output_format{ fc_feats });
+    fc->arguments.forward_fully_connected.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc->arguments.forward_fully_connected.weights = &fc_weights;
+    fc->arguments.forward_fully_connected.biases = &fc_biases;
+
+    auto output = create_item(fc, NN_WORK_ITEM_TYPE_OUTPUT, nullptr, nn::output_format{ fc_feats });
+    output->arguments.output.index = 0;
+
+    uint32_t calibrating = 1;
+    std::remove(C_configuration_path);
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_FIXEDPOINT_CONFIGURATION, (void *)C_configuration_path, sizeof(C_configuration_path)));
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_FIXEDPOINT_CALIBRATION, &calibrating, sizeof(calibrating)));
+    nn::data<float, 2> out_float(fc_feats, batch);
+    execute(input, output, NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH, &out_float);
+    calibrating = 0;
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_FIXEDPOINT_CALIBRATION, &calibrating, sizeof(calibrating)));
+
+    // configuration has formats of input and both layers
+    std::map<std::string, std::vector<std::string>> configuration;
+    {
+        std::ifstream file(C_configuration_path);
+        std::string line;
+        EXPECT_TRUE(static_cast<bool>(std::getline(file, line)));
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream fields(line);
+            std::string name, field;
+            fields >> name;
+            while (fields >> field)
+                configuration[name].push_back(field);
+        }
+    }
+    ASSERT_EQ(3u, configuration.size());
+    EXPECT_EQ(std::to_string(fixedpoint_calibration::fraction(max_abs(in))), configuration["input0"].at(0));
+    EXPECT_EQ(std::to_string(fixedpoint_calibration::fraction(max_abs(conv_weights))), configuration["c1"].at(1));
+    EXPECT_EQ(std::to_string(fixedpoint_calibration::fraction(max_abs(out_float))), configuration["fc1"].at(0));
+    EXPECT_EQ(std::to_string(fixedpoint_calibration::fraction(max_abs(fc_weights))), configuration["fc1"].at(1));
+
+    // int16 workflow: weights quantized by the builder, fractions of activations deliberately wrong
+    const uint32_t wrong_fraction = 0;
+    nn::data<int16_t, 4> conv_weights_int16(3, 3, size_z, conv_feats), fc_weights_int16(conv_x, conv_y, conv_feats, fc_feats);
+    nn::data<int32_t, 1> conv_biases_int32(conv_feats), fc_biases_int32(fc_feats);
+    quantize<int16_t>(conv_weights, conv_weights_int16, weights_fraction);
+    quantize<int32_t>(conv_biases, conv_biases_int32, wrong_fraction + weights_fraction);
+    quantize<int16_t>(fc_weights, fc_weights_int16, weights_fraction);
+    quantize<int32_t>(fc_biases, fc_biases_int32, wrong_fraction + weights_fraction);
+
+    auto input_int16 = create_item(nullptr, NN_WORK_ITEM_TYPE_INPUT, nullptr, nn::output_format{ size_x, size_y, size_z });
+    input_int16->arguments.input.index = 0;
+
+    auto convert = create_item(input_int16, NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_INT16_FIXEDPOINT, nullptr, nn::output_format{ size_x, size_y, size_z });
+    convert->arguments.forward_convert_float_to_int16_fixedpoint.output_fraction = wrong_fraction;
+
+    auto conv_int16 = create_item(convert, NN_WORK_ITEM_TYPE_CONVOLUTION_INT16_FIXEDPOINT, "c1", nn::output_format{ conv_x, conv_y, conv_feats });
+    auto &conv_int16_args = conv_int16->arguments.forward_convolution_int16_fixedpoint;
+    conv_int16_args.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv_int16_args.activation.basic_arguments.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv_int16_args.activation.fractions.accumulator = wrong_fraction + weights_fraction;
+    conv_int16_args.activation.fractions.output = wrong_fraction;
+    conv_int16_args.weights = &conv_weights_int16;
+    conv_int16_args.biases = &conv_biases_int32;
+    conv_int16_args.stride[0] = 1;
+    conv_int16_args.stride[1] = 1;
+
+    auto fc_int16 = create_item(conv_int16, NN_WORK_ITEM_TYPE_FULLY_CONNECTED_FORWARD_I16QN_I32QN, "fc1", nn::output_format{ fc_feats });
+    auto &fc_int16_args = fc_int16->arguments.fully_connected_forward_i16qn_i32qn;
+    fc_int16_args.activation.basic_arguments.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc_int16_args.activation.fractions.accumulator = wrong_fraction + weights_fraction;
+    fc_int16_args.activation.fractions.output = wrong_fraction;
+    fc_int16_args.weights = &fc_weights_int16;
+    fc_int16_args.biases = &fc_biases_int32;
+
+    // int32 output of fully connected layer is blocked, softmax converts it to float
+    auto softmax_int16 = create_item(fc_int16, NN_WORK_ITEM_TYPE_SOFTMAX_FIXEDPOINT, nullptr, nn::output_format{ fc_feats });
+    softmax_int16->arguments.forward_softmax_fixedpoint.input_fraction = wrong_fraction;
+
+    auto output_int16 = create_item(softmax_int16, NN_WORK_ITEM_TYPE_OUTPUT, nullptr, nn::output_format{ fc_feats });
+    output_int16->arguments.output.index = 0;
+
+    nn::data<float, 2> reference(fc_feats, batch);
+    for (auto n = 0u; n < batch; ++n)
+    {
+        float sum = 0.0f;
+        for (auto o = 0u; o < fc_feats; ++o)
+            sum += reference(o, n) = std::exp(out_float(o, n));
+        for (auto o = 0u; o < fc_feats; ++o)
+            reference(o, n) /= sum;
+    }
+    auto max_error = [&](nn::data<float, 2> &out) {
+        float error = 0.0f;
+        for (auto n = 0u; n < batch; ++n)
+            for (auto o = 0u; o < fc_feats; ++o)
+                error = std::max(error, std::abs(out(o, n) - reference(o, n)));
+        return error;
+    };
+
+    nn::data<float, 2> out_calibrated(fc_feats, batch);
+    execute(input_int16, output_int16, NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH, &out_calibrated);
+    const auto calibrated_error = max_error(out_calibrated);
+    EXPECT_LT(calibrated_error, 0.01f);
+
+    // without configuration fractions of arguments are used
+    EXPECT_EQ(NN_API_STATUS_OK, di.parameter_set_function(di.device, NN_PARAMETER_FIXEDPOINT_CONFIGURATION, (void *)"", 1));
+    nn::data<float, 2> out_uncalibrated(fc_feats, batch);
+    execute(input_int16, output_int16, NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH, &out_uncalibrated);
+    EXPECT_GT(max_error(out_uncalibrated), 10 * calibrated_error);
+    std::remove(C_configuration_path);
+
+    for (auto item = items.rbegin(); item != items.rend(); ++item)
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(*item));
+
+    test_teardown(device_description, device_interface_0);
+}
@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2014, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+* Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/layer_convolution_avx2_forward.h"
+#include "device/cpu/core/jit_conv_generic.h"
+#include "device/common/nn_allocate.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <memory>
+#include <tuple>
+
+namespace
+{
+const uint64_t C_batch_block = jit_convolution_generic::batch_size;
+
+struct aligned_deleter { void operator()(float *ptr) { nn_delete_aligned(ptr); } };
+typedef std::unique_ptr<float, aligned_deleter> aligned_buffer;
+
+aligned_buffer make_buffer(uint64_t size, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    aligned_buffer result(static_cast<float *>(nn_allocate_aligned(size * sizeof(float))));
+    for (auto i = 0u; i < size; ++i)
+        result.get()[i] = distribution(generator);
+    return result;
+}
+
+// runs fully connected JIT with given thread count on two sets of buffers and compares it with
+// naive implementation; input is [block][input][24], output is [block][output][24],
+// weights are [output/4][input][4]
+void run_fully_connected_jit(uint64_t batch_blocks,
+                             uint64_t num_of_threads,
+                             uint64_t input_feats,
+                             uint64_t output_feats,
+                             uint64_t output_feats_in_block,
+                             bool apply_relu)
+{
+    const auto features_per_iteration = jit_convolution_generic::output_features_per_iteration;
+    std::mt19937 generator(1);
+    auto weights = make_buffer(input_feats * output_feats, generator);
+    auto bias = make_buffer(output_feats, generator);
+
+    std::vector<float> original_weights(weights.get(), weights.get() + input_feats * output_feats);
+    jit_convolution_generic fully_connected(batch_blocks, apply_relu, num_of_threads,
+                                            output_feats, input_feats,
+                                            weights.get(), 128u, output_feats_in_block);
+
+    // pool without worker threads runs jobs sequentially on calling thread
+    nn_thread_worker_pool thread_pool(1);
+    for (auto execution = 0u; execution < 2; ++execution)
+    {
+        auto input = make_buffer(batch_blocks * input_feats * C_batch_block, generator);
+        auto output = make_buffer(batch_blocks * output_feats * C_batch_block, generator);
+
+        std::vector<float> reference(batch_blocks * output_feats * C_batch_block);
+        for (auto b = 0u; b < batch_blocks; ++b)
+            for (auto o = 0u; o < output_feats; ++o)
+                for (auto n = 0u; n < C_batch_block; ++n)
+                {
+                    auto acc = bias.get()[o];
+                    for (auto i = 0u; i < input_feats; ++i)
+                        acc += input.get()[(b * input_feats + i) * C_batch_block + n]
+                             * original_weights[((o / features_per_iteration) * input_feats + i) * features_per_iteration
+                                                + o % features_per_iteration];
+                    reference[(b * output_feats + o) * C_batch_block + n] = apply_relu ? std::max(acc, 0.0f) : acc;
+                }
+
+        fully_connected.execute(thread_pool, output.get(), input.get(), weights.get(), bias.get());
+
+        auto mismatches = 0u;
+        for (auto i = 0u; i < reference.size(); ++i)
+            if (std::abs(reference[i] - output.get()[i]) > 1e-3f * std::max(1.0f, std::abs(reference[i])))
+                ++mismatches;
+        EXPECT_EQ(0u, mismatches) << "threads: " << num_of_threads << " input: " << input_feats
+                                  << " output: " << output_feats << " batch blocks: " << batch_blocks
+                                  << " relu: " << apply_relu << " execution: " << execution;
+    }
+}
+} //namespace
+
+TEST(cpu_fully_connected_jit, thread_grid_any_thread_count)
+{
+    // (input features, output features, output features in block)
+    const std::tuple<uint64_t, uint64_t, uint64_t> shapes[] = {
+        std::make_tuple(128u, 4u, 4u),
+        std::make_tuple(256u, 36u, 4u),
+        std::make_tuple(512u, 64u, 32u),
+        std::make_tuple(1024u, 1000u, 8u)};
+
+    for (auto &shape : shapes)
+        for (uint64_t threads : { 1u, 3u, 8u, 28u, 64u })
+            for (uint64_t batch_blocks : { 1u, 2u })
+                for (bool relu : { false, true })
+                    run_fully_connected_jit(batch_blocks, threads,
+                                            std::get<0>(shape), std::get<1>(shape), std::get<2>(shape), relu);
+}
@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "device/cpu/api_internal/nn_device_interface_0_internal.h"
 #include "device/cpu/core/fixedpoint/layer_convert_float_to_int16_fixedpoint_avx2.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,3 +144,99 @@ TEST(cpu_int16_convert_float_to_int16_fixedpoint, convert_RGB_to_ZRGB) {
     EXPECT_TRUE(check_result(reinterpret_cast<float *>(input_data->parent->data_buffer),
         reinterpret_cast<std::int16_t *>(work_item->output[0]->parent->data_buffer)));
 }
+
+TEST(cpu_int16_convert_float_to_int16_fixedpoint, convert_contiguous) {
+    // 4 feature maps fill z-block of output, so data is converted as contiguous buffer; 5x3 image has tail of 12 values
+    const uint32_t width = 5, height = 3, feature_maps = 4;
+    const int8_t output_fraction = 3;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    std::unique_ptr<int16_fixedpoint::convert_float_to_int16> primitive(new int16_fixedpoint::convert_float_to_int16(
+        feature_maps,
+        width,
+        height,
+        1,
+        0,
+        0,
+        0,
+        0,
+        output_fraction,
+        reinterpret_cast<nn_device_internal*>(device_interface_0.device)));
+
+    std::unique_ptr<nn_workload_data_t> input_data(primitive->create_inputs(false)[0]);
+    std::unique_ptr<nn_workload_data_t> output_data(primitive->create_outputs(false)[0]);
+
+    const auto count = width * height * feature_maps;
+    auto input = reinterpret_cast<float *>(input_data->parent->data_buffer);
+    for (uint32_t i = 0; i < count; ++i)
+        input[i] = (i % 2 ? -1.0f : 1.0f) * i * i * 1.3f;
+
+    primitive->forward({ input_data.get() }, {}, { output_data.get() });
+
+    auto output = reinterpret_cast<std::int16_t *>(output_data->parent->data_buffer);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto expected = std::max(-32768.0f, std::min(32767.0f, std::nearbyint(input[i] * (1 << output_fraction))));
+        EXPECT_EQ(static_cast<std::int16_t>(expected), output[i]) << "at " << i;
+    }
+
+    test_teardown(device_description, device_interface_0);
+}
+
+TEST(cpu_int16_convert_float_to_int16_fixedpoint, convert_z_blocks_padded) {
+    // 6 feature maps give two z-blocks with zeroed tail of the second one; output is padded for next convolution
+    const uint32_t width = 7, height = 5, feature_maps = 6, batch = 2, block_size = 4;
+    const uint32_t padding_left = 1, padding_right = 2, padding_top = 1, padding_bottom = 1;
+    const int8_t output_fraction = 5;
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    std::unique_ptr<int16_fixedpoint::convert_float_to_int16> primitive(new int16_fixedpoint::convert_float_to_int16(
+        feature_maps,
+        width,
+        height,
+        batch,
+        padding_left,
+        padding_right,
+        padding_top,
+        padding_bottom,
+        output_fraction,
+        reinterpret_cast<nn_device_internal*>(device_interface_0.device)));
+
+    std::unique_ptr<nn_workload_data_t> input_data(primitive->create_inputs(false)[0]);
+    std::unique_ptr<nn_workload_data_t> output_data(primitive->create_outputs(false)[0]);
+
+    auto input = reinterpret_cast<float *>(input_data->parent->data_buffer);
+    const auto count = width * height * feature_maps * batch;
+    for (uint32_t i = 0; i < count; ++i)
+        input[i] = (i % 3 ? -1.0f : 1.0f) * i * i * 0.37f;
+
+    primitive->forward({ input_data.get() }, {}, { output_data.get() });
+
+    const uint32_t padded_width = width + padding_left + padding_right;
+    const uint32_t padded_height = height + padding_top + padding_bottom;
+    const uint32_t z_blocks = (feature_maps + block_size - 1) / block_size;
+    auto output = reinterpret_cast<std::int16_t *>(output_data->parent->data_buffer);
+    for (uint32_t n = 0; n < batch; ++n)
+        for (uint32_t z_block = 0; z_block < z_blocks; ++z_block)
+            for (uint32_t y = 0; y < height; ++y)
+                for (uint32_t x = 0; x < width; ++x)
+                    for (uint32_t p = 0; p < block_size; ++p)
+                    {
+                        const uint32_t z = z_block * block_size + p;
+                        float expected = 0.0f;
+                        if (z < feature_maps)
+                            expected = std::max(-32768.0f, std::min(32767.0f,
+                                std::nearbyint(input[((n * height + y) * width + x) * feature_maps + z] * (1 << output_fraction))));
+
+                        const auto offset = ((((n * z_blocks + z_block) * padded_height + y + padding_top) * padded_width + x + padding_left) * block_size) + p;
+                        EXPECT_EQ(static_cast<std::int16_t>(expected), output[offset]) << "at n=" << n << " z=" << z << " y=" << y << " x=" << x;
+                    }
+
+    test_teardown(device_description, device_interface_0);
+}
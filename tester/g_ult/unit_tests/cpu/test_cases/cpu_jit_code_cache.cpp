@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2014, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+* Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/layer_convolution_avx2_forward.h"
+#include "device/cpu/core/jit_conv_generic.h"
+#include "device/cpu/core/jit_code_cache.h"
+#include "device/common/nn_allocate.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <memory>
+
+namespace
+{
+const uint64_t C_batch_block = jit_convolution_generic::batch_size;
+const uint64_t C_input_feats = 256;
+const uint64_t C_output_feats = 64;
+const char C_cache_path[] = "cpu_jit_code_cache_test.bin";
+
+struct aligned_deleter { void operator()(float *ptr) { nn_delete_aligned(ptr); } };
+typedef std::unique_ptr<float, aligned_deleter> aligned_buffer;
+
+aligned_buffer make_buffer(const std::vector<float> &values)
+{
+    aligned_buffer result(static_cast<float *>(nn_allocate_aligned(values.size() * sizeof(float))));
+    std::copy(values.begin(), values.end(), result.get());
+    return result;
+}
+
+std::vector<float> make_values(uint64_t size, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> result(size);
+    for (auto &value : result)
+        value = distribution(generator);
+    return result;
+}
+
+// builds fully connected kernel with given cache and runs it, returns output
+std::vector<float> run_fully_connected(jit_code_cache *cache, bool expect_cached)
+{
+    std::mt19937 generator(1);
+    auto input = make_buffer(make_values(C_input_feats * C_batch_block, generator));
+    auto weights = make_buffer(make_values(C_input_feats * C_output_feats, generator));
+    auto bias = make_buffer(make_values(C_output_feats, generator));
+    auto output = make_buffer(std::vector<float>(C_output_feats * C_batch_block));
+
+    jit_convolution_generic fully_connected(1, true, 8, C_output_feats, C_input_feats, weights.get(), 128u, 8u, cache);
+    EXPECT_EQ(expect_cached, fully_connected.generated_code == nullptr);
+    EXPECT_EQ(expect_cached, fully_connected.generated_code_bias == nullptr);
+
+    nn_thread_worker_pool thread_pool(1);
+    fully_connected.execute(thread_pool, output.get(), input.get(), weights.get(), bias.get());
+    return std::vector<float>(output.get(), output.get() + C_output_feats * C_batch_block);
+}
+} //namespace
+
+TEST(cpu_jit_code_cache, kernels_reused_from_file)
+{
+    std::remove(C_cache_path);
+    auto generated = run_fully_connected(nullptr, false);
+
+    {
+        jit_code_cache cache;
+        cache.set_path(C_cache_path);
+        cache.load();
+        EXPECT_EQ(generated, run_fully_connected(&cache, false));
+        cache.save();
+    }
+    {
+        jit_code_cache cache;
+        cache.set_path(C_cache_path);
+        cache.load();
+        EXPECT_EQ(generated, run_fully_connected(&cache, true));
+    }
+    std::remove(C_cache_path);
+}
+
+TEST(cpu_jit_code_cache, invalid_file_ignored)
+{
+    {
+        std::ofstream file(C_cache_path, std::ios::binary | std::ios::trunc);
+        file << "not a cache of jit code";
+    }
+    auto generated = run_fully_connected(nullptr, false);
+    {
+        jit_code_cache cache;
+        cache.set_path(C_cache_path);
+        cache.load();
+        EXPECT_EQ(generated, run_fully_connected(&cache, false));
+        cache.save();
+    }
+    {
+        jit_code_cache cache;
+        cache.set_path(C_cache_path);
+        cache.load();
+        EXPECT_EQ(generated, run_fully_connected(&cache, true));
+    }
+    std::remove(C_cache_path);
+}
+
+TEST(cpu_jit_code_cache, disabled_without_path)
+{
+    jit_code_cache cache;
+    cache.load();
+    run_fully_connected(&cache, false);
+    cache.save();
+    run_fully_connected(&cache, false);
+}
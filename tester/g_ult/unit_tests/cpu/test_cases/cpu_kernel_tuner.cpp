@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_kernel_tuner.h"
+#include "device/common/nn_device_internal.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+namespace
+{
+const char C_tuning_path[] = "cpu_kernel_tuner_test.txt";
+
+// primitive without buffers whose forward pass takes given time
+struct sleeping_primitive : nn_primitive_t
+{
+    explicit sleeping_primitive(uint32_t id, std::chrono::microseconds delay) : id(id), delay(delay) {}
+
+    void forward(const std::vector<const nn_workload_data_t *> &,
+                 const std::vector<const nn_workload_data_t *> &,
+                 const std::vector<nn_workload_data_t *> &) override
+    {
+        std::this_thread::sleep_for(delay);
+    }
+
+    std::vector<nn_workload_data_t *> create_inputs(bool) override { return {}; }
+    std::vector<nn_workload_data_t *> create_outputs(bool) override { return {}; }
+    bool validate_input(size_t, nn_workload_data_t *) override { return true; }
+
+    const uint32_t id;
+    const std::chrono::microseconds delay;
+};
+
+// primitive which can't run in configuration it was created for
+struct failing_primitive : sleeping_primitive
+{
+    failing_primitive() : sleeping_primitive(0, std::chrono::microseconds(0)) {}
+
+    std::vector<nn_workload_data_t *> create_inputs(bool) override { throw std::logic_error("unimplemented"); }
+};
+
+std::vector<kernel_tuner::candidate> make_candidates()
+{
+    return {{"slow", [] { return new sleeping_primitive(1, std::chrono::microseconds(2000)); }},
+            {"broken", [] { return new failing_primitive(); }},
+            {"fast", [] { return new sleeping_primitive(2, std::chrono::microseconds(0)); }}};
+}
+
+uint32_t chosen_id(kernel_tuner &tuner, const std::string &key)
+{
+    std::unique_ptr<nn_primitive_t> primitive(tuner.choose(key, make_candidates()));
+    return static_cast<sleeping_primitive *>(primitive.get())->id;
+}
+} //namespace
+
+TEST(cpu_kernel_tuner, heuristic_choice_without_tuning)
+{
+    kernel_tuner tuner;
+    EXPECT_EQ(1u, chosen_id(tuner, tuning_key("layer", 1, 2)));
+}
+
+TEST(cpu_kernel_tuner, fastest_candidate_saved_and_reused)
+{
+    std::remove(C_tuning_path);
+    {
+        kernel_tuner tuner;
+        tuner.set_path(C_tuning_path);
+        tuner.set_enabled(true);
+        tuner.load();
+        EXPECT_EQ(2u, chosen_id(tuner, tuning_key("layer", 1, 2)));
+        tuner.save();
+    }
+
+    std::ifstream file(C_tuning_path);
+    std::string magic, key, decision;
+    EXPECT_TRUE(static_cast<bool>(std::getline(file, magic)));
+    EXPECT_TRUE(static_cast<bool>(file >> key >> decision));
+    EXPECT_EQ("layer,1,2", key);
+    EXPECT_EQ("fast", decision);
+    file.close();
+
+    // decision is taken from file, other layers keep heuristic choice when tuning is disabled
+    kernel_tuner tuner;
+    tuner.set_path(C_tuning_path);
+    tuner.load();
+    EXPECT_EQ(2u, chosen_id(tuner, tuning_key("layer", 1, 2)));
+    EXPECT_EQ(1u, chosen_id(tuner, tuning_key("layer", 1, 3)));
+    std::remove(C_tuning_path);
+}
+
+TEST(cpu_kernel_tuner, unknown_decision_falls_back_to_heuristic)
+{
+    {
+        std::ofstream file(C_tuning_path);
+        file << "NNTUNE01\nlayer,1,2 removed_kernel\n";
+    }
+
+    kernel_tuner tuner;
+    tuner.set_path(C_tuning_path);
+    tuner.load();
+    EXPECT_EQ(1u, chosen_id(tuner, tuning_key("layer", 1, 2)));
+    std::remove(C_tuning_path);
+}
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/layer_convert_data_layout.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <memory>
+
+namespace
+{
+void fill(float *buffer, size_t size)
+{
+    std::mt19937 generator(1);
+    for (size_t i = 0; i < size; ++i)
+        buffer[i] = static_cast<float>(generator() % 20000);
+}
+
+// conv -> fc conversion interleaves batches: output(i, n) = input(n, i), backward pass does the reverse
+void test_zxyn_nx(nn_device_internal &device, uint32_t size_x, uint32_t size_y, uint32_t size_z, uint32_t batch)
+{
+    const size_t image_size = size_x * size_y * size_z;
+    layer::convert_zxyn_nx_f32 primitive(size_x, size_y, size_z, batch, &device);
+
+    std::unique_ptr<nn_workload_data_t> input(primitive.create_inputs(true)[0]);
+    std::unique_ptr<nn_workload_data_t> output(primitive.create_outputs(true)[0]);
+    auto input_data = static_cast<float *>(input->parent->data_buffer);
+    auto output_data = static_cast<float *>(output->parent->data_buffer);
+    auto input_delta = static_cast<float *>(input->parent->delta_buffer);
+    auto output_delta = static_cast<float *>(output->parent->delta_buffer);
+
+    fill(input_data, image_size * batch);
+    primitive.forward({input.get()}, {}, {output.get()});
+
+    uint32_t mismatches = 0;
+    for (size_t n = 0; n < batch; ++n)
+        for (size_t i = 0; i < image_size; ++i)
+            if (output_data[i * batch + n] != input_data[n * image_size + i])
+                ++mismatches;
+    EXPECT_EQ(0u, mismatches) << "forward, batch: " << batch << " image: " << image_size;
+
+    fill(output_delta, image_size * batch);
+    primitive.backward({input.get()}, {}, {output.get()});
+
+    mismatches = 0;
+    for (size_t n = 0; n < batch; ++n)
+        for (size_t i = 0; i < image_size; ++i)
+            if (input_delta[n * image_size + i] != output_delta[i * batch + n])
+                ++mismatches;
+    EXPECT_EQ(0u, mismatches) << "backward, batch: " << batch << " image: " << image_size;
+}
+} //namespace
+
+TEST(cpu_convert_data_layout, zxyn_nx_any_batch_and_image_size)
+{
+    nn_device_internal device(4);
+    for (auto batch : {1u, 2u, 5u, 8u, 16u, 24u, 32u, 48u, 64u})
+    {
+        test_zxyn_nx(device, 6, 6, 256, batch);
+        test_zxyn_nx(device, 13, 13, 3, batch);
+        test_zxyn_nx(device, 1, 1, 7, batch);
+    }
+}
@@ -27,8 +27,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "device/cpu/core/layer_convolution_avx2.h"
 #include "tester/g_ult/unit_tests/cpu/naive_implementations.h"
+#include <atomic>
 #include <cfloat>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 const uint32_t C_simd_width = sizeof(__m256)/sizeof(float);
@@ -986,6 +990,133 @@ bool ult_perform_padding_test(
 
     return passed;
 }
+
+// Forwards inputs without padding through one primitive from several threads at once, every thread with its own inputs.
+// Returns count of output values that differ from the same inputs forwarded one by one.
+uint32_t ult_perform_concurrent_padding_test(
+    uint_least32_t batch_size,
+    uint_least32_t num_output_feature_maps,
+    uint_least32_t num_input_feature_maps,
+    uint_least32_t input_feature_map_width,
+    uint_least32_t input_feature_map_height,
+    uint_least32_t kernel_width,
+    uint_least32_t kernel_height,
+    uint_least32_t number_of_threads,
+    uint_least32_t number_of_runs)
+{
+    uint32_t center_offset_x = (kernel_width - 1) / 2;
+    uint32_t center_offset_y = (kernel_height - 1) / 2;
+
+    nn_workload_data_layout_t img_layout = nn::layout_t<nn::layout_zxynpq_f32>::layout;
+    nn_workload_data_layout_t kernel_layout = nn::layout_t<nn::layout_pzxyqn_f32>::layout;
+
+    nn_workload_data_coords_t in_size = { batch_size, input_feature_map_width, input_feature_map_height, num_input_feature_maps, 1, 1 };
+    nn_workload_data_coords_t out_size = { batch_size, input_feature_map_width, input_feature_map_height, num_output_feature_maps, 1, 1 };
+    nn_workload_data_coords_t bias_size = { 1, num_output_feature_maps, 1, 1, 1, 1 };
+    nn_workload_data_coords_t kernel_size =
+    {
+        1,
+        kernel_width,
+        kernel_height,
+        num_input_feature_maps,
+        C_slice_size,
+        (num_output_feature_maps + C_slice_size - 1) / C_slice_size
+    };
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+
+    nn_device_load(&device_description);
+    nn_device_interface_open(0, &device_interface_0);
+
+    nn_argument_activation_t s_activation;
+    s_activation.function = NN_ACTIVATION_FUNCTION_RELU;
+
+    auto conv = new layer::convolution_f32(kernel_width,
+                                           kernel_height,
+                                           num_input_feature_maps,
+                                           num_output_feature_maps,
+                                           input_feature_map_width,
+                                           input_feature_map_height,
+                                           center_offset_x,
+                                           center_offset_y,
+                                           1,
+                                           1,
+                                           s_activation,
+                                           batch_size,
+                                           0,
+                                           0,
+                                           0,
+                                           0,
+                                           reinterpret_cast<nn_device_internal *>(device_interface_0.device));
+
+    nn::workload_data<> weights(kernel_size, kernel_layout);
+    nn::workload_data<> biases(bias_size, img_layout);
+
+    for (uint32_t out_map = 0; out_map < num_output_feature_maps; ++out_map)
+    {
+        for (uint32_t row = 0; row < kernel_height; ++row)
+            for (uint32_t column = 0; column < kernel_width; ++column)
+                for (uint32_t map = 0; map < num_input_feature_maps; ++map)
+                    nn_workload_data_get<float>(&weights, 0, column, row, map, out_map % C_slice_size, out_map / C_slice_size) =
+                        ((out_map + row + column + map) % 5) * 0.25f - 0.5f;
+
+        nn_workload_data_get<float>(&biases, 0, out_map, 0, 0, 0, 0) = (out_map % 3) * 0.5f;
+    }
+
+    // Inputs of all runs and their outputs forwarded one by one.
+    std::vector<std::unique_ptr<nn::workload_data<>>> inputs, expected;
+    for (uint32_t run = 0; run < number_of_threads * number_of_runs; ++run)
+    {
+        inputs.emplace_back(new nn::workload_data<>(in_size, img_layout));
+        for (uint32_t batch = 0; batch < batch_size; ++batch)
+            for (uint32_t row = 0; row < input_feature_map_height; ++row)
+                for (uint32_t column = 0; column < input_feature_map_width; ++column)
+                    for (uint32_t map = 0; map < num_input_feature_maps; ++map)
+                        nn_workload_data_get<float>(inputs.back().get(), batch, column, row, map, 0, 0) =
+                            ((run + batch + 3 * row + 5 * column + 7 * map) % 11) * 0.2f - 1.0f;
+
+        expected.emplace_back(new nn::workload_data<>(out_size, img_layout));
+        conv->forward({inputs.back().get()}, {&weights, &biases}, {expected.back().get()});
+    }
+
+    std::vector<uint32_t> thread_mismatches(number_of_threads, 0);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> threads_ready(0);
+    for (uint32_t thread = 0; thread < number_of_threads; ++thread)
+        threads.push_back(std::thread([&, thread]() {
+            for (++threads_ready; threads_ready < number_of_threads;)
+                std::this_thread::yield();
+
+            nn::workload_data<> output(out_size, img_layout);
+            for (uint32_t run = thread * number_of_runs; run < (thread + 1) * number_of_runs; ++run)
+            {
+                conv->forward({inputs[run].get()}, {&weights, &biases}, {&output});
+
+                for (uint32_t batch = 0; batch < batch_size; ++batch)
+                    for (uint32_t row = 0; row < input_feature_map_height; ++row)
+                        for (uint32_t column = 0; column < input_feature_map_width; ++column)
+                            for (uint32_t out_map = 0; out_map < num_output_feature_maps; ++out_map)
+                                if (nn_workload_data_get<float>(&output, batch, column, row, out_map, 0, 0) !=
+                                    nn_workload_data_get<float>(expected[run].get(), batch, column, row, out_map, 0, 0))
+                                    ++thread_mismatches[thread];
+            }
+        }));
+
+    for (auto &thread : threads)
+        thread.join();
+
+    delete conv;
+
+    nn_device_interface_close(&device_interface_0);
+    nn_device_unload();
+
+    uint32_t mismatches = 0;
+    for (auto count : thread_mismatches)
+        mismatches += count;
+
+    return mismatches;
+}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1222,3 +1353,27 @@ TEST(cpu_convolution_padding, cpu_convolution_padding_stride4x3)
                     }
 
 }
+
+TEST(cpu_convolution_padding, cpu_convolution_padding_same_small_maps)
+{
+    for (uint32_t num_ofm : { 16, 32 })
+        for (uint32_t num_ifm : { 3, 16 })
+            for (uint32_t fm_size : { 7, 14 })
+                for (uint32_t kernel_size : { 3, 5 })
+                    for (uint32_t stride : { 1, 2 })
+                    {
+                        uint32_t batches[] = { 1, 8 };
+                        NN_ACTIVATION_FUNCTION activations[] = { NN_ACTIVATION_FUNCTION_NONE, NN_ACTIVATION_FUNCTION_RELU };
+                        for (auto batch : batches)
+                            for (auto activation : activations)
+                                EXPECT_EQ(true, ult_perform_padding_test(batch, num_ofm, num_ifm, fm_size, fm_size, kernel_size, kernel_size, stride, stride, activation));
+                    }
+}
+
+TEST(cpu_convolution_padding, cpu_convolution_padding_concurrent_forward)
+{
+    // borders staged by one call are not overwritten by calls running at the same time
+    for (uint32_t kernel_size : { 3, 5 })
+        for (uint32_t batch : { 1, 8 })
+            EXPECT_EQ(0u, ult_perform_concurrent_padding_test(batch, 32, 16, 14, 14, kernel_size, kernel_size, 4, 8));
+}
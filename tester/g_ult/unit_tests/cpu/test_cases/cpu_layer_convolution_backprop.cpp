@@ -415,6 +415,7 @@ namespace
         // execute convolution backpropagation
         nn_event_t backward = primitives.backward_async(
             primitive, 1, primitive_inputs, 2, parameters, 1, outputs, 0, nullptr, nullptr);
+        primitives.wait(1, &backward);
 
         // we no longer need this
         reinterpret_cast<nn::workload_data<nn::layout_f32>*>(primitive_inputs[0])->parent->delta_buffer = nullptr;
@@ -244,11 +244,7 @@ TEST_P(PerfTest, DISABLED_performance)
         stride,
         make<InputFeatsStart>(0u),
         make<OutputFeatsStart>(0u),
-        (batch + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK,
-        alignedInput.get(),
-        alignedOutput.get(),
-        alignedWeights.get(),
-        &bias.front());
+        (batch + BATCH_ACCEPTED_BLOCK - 1) / BATCH_ACCEPTED_BLOCK);
 
     uint64_t min_time = UINT64_MAX;
     uint64_t max_time = 0;
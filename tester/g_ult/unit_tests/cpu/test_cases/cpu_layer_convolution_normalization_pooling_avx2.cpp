@@ -0,0 +1,299 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "device/api/nn_device_api.h"
+#include "device/api/nn_device_interface_0.h"
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/layer_convolution_normalization_pooling_avx2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+void test_setup(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+    // load device & validate it has 0 as a startin interface version
+    nn_device_load(&device_description);
+    EXPECT_EQ(device_description.version_first, 0);
+    // open interface 0
+    EXPECT_EQ(0, nn_device_interface_open(0, &device_interface_0));
+}
+
+void test_teardown(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+    // close interface 0
+    EXPECT_EQ(0, nn_device_interface_close(&device_interface_0));
+    // unload device
+    EXPECT_EQ(0, nn_device_unload());
+}
+
+// convolution 3x3 with stride 1, input outside of image is zero
+void naive_convolution(nn::data<float, 4> &input,
+                       nn::data<float, 4> &weights,
+                       nn::data<float, 1> &biases,
+                       int32_t center_offset,
+                       bool relu,
+                       nn::data<float, 4> &output) {
+    for (uint32_t n = 0; n < output.size[3]; ++n)
+        for (uint32_t y = 0; y < output.size[2]; ++y)
+            for (uint32_t x = 0; x < output.size[1]; ++x)
+                for (uint32_t o = 0; o < output.size[0]; ++o)
+                {
+                    float sum = biases(o);
+                    for (uint32_t ky = 0; ky < 3; ++ky)
+                        for (uint32_t kx = 0; kx < 3; ++kx)
+                        {
+                            const int32_t ix = static_cast<int32_t>(x + kx) - center_offset, iy = static_cast<int32_t>(y + ky) - center_offset;
+                            if (ix < 0 || iy < 0 || ix >= static_cast<int32_t>(input.size[1]) || iy >= static_cast<int32_t>(input.size[2]))
+                                continue;
+                            for (uint32_t z = 0; z < input.size[0]; ++z)
+                                sum += weights(kx, ky, z, o) * input(z, static_cast<uint32_t>(ix), static_cast<uint32_t>(iy), n);
+                        }
+                    output(o, x, y, n) = relu ? std::max(sum, 0.0f) : sum;
+                }
+}
+} //namespace
+
+// input -> convolution 3x3 with ReLU -> response normalization across maps -> max pooling 3x3 stride 2 -> convolution 3x3
+// centered on outputs -> output; first three layers are compiled to single item whose output has padding required by
+// second convolution, images are split into bands of pooled rows when there are more threads than images
+TEST(cpu_convolution_normalization_pooling, fused_workflow_matches_naive)
+{
+    const uint32_t batch = 2, size_x = 17, size_y = 15, size_z = 4;
+    const uint32_t feats = 16, conv_x = size_x - 2, conv_y = size_y - 2, pooled_x = 7, pooled_y = 6, out_feats = 8;
+    const float alpha = 0.01f, beta = 0.75f, k = 1.0f;
+    const uint32_t n = 5;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator);
+    };
+
+    nn::data<float, 4> conv_weights(3, 3, size_z, feats), out_weights(3, 3, feats, out_feats);
+    nn::data<float, 1> conv_biases(feats), out_biases(out_feats);
+    nn::data<float, 4> in(size_z, size_x, size_y, batch);
+    randomize(conv_weights);
+    randomize(conv_biases);
+    randomize(out_weights);
+    randomize(out_biases);
+    randomize(in);
+
+    // reference
+    nn::data<float, 4> convolved(feats, conv_x, conv_y, batch), pooled(feats, pooled_x, pooled_y, batch);
+    nn::data<float, 4> reference(out_feats, pooled_x, pooled_y, batch);
+    naive_convolution(in, conv_weights, conv_biases, 0, true, convolved);
+    nn::data<float, 4> normalized(feats, conv_x, conv_y, batch);
+    for (uint32_t b = 0; b < batch; ++b)
+        for (uint32_t y = 0; y < conv_y; ++y)
+            for (uint32_t x = 0; x < conv_x; ++x)
+                for (uint32_t f = 0; f < feats; ++f)
+                {
+                    float sum = 0.0f;
+                    for (int32_t j = static_cast<int32_t>(f) - static_cast<int32_t>(n / 2); j <= static_cast<int32_t>(f + n / 2); ++j)
+                        if (j >= 0 && j < static_cast<int32_t>(feats))
+                            sum += convolved(j, x, y, b) * convolved(j, x, y, b);
+                    normalized(f, x, y, b) = convolved(f, x, y, b) * std::pow(k + alpha * sum, -beta);
+                }
+    for (uint32_t b = 0; b < batch; ++b)
+        for (uint32_t y = 0; y < pooled_y; ++y)
+            for (uint32_t x = 0; x < pooled_x; ++x)
+                for (uint32_t f = 0; f < feats; ++f)
+                {
+                    float maximum = normalized(f, 2 * x, 2 * y, b);
+                    for (uint32_t py = 0; py < 3; ++py)
+                        for (uint32_t px = 0; px < 3; ++px)
+                            maximum = std::max(maximum, normalized(f, 2 * x + px, 2 * y + py, b));
+                    pooled(f, x, y, b) = maximum;
+                }
+    naive_convolution(pooled, out_weights, out_biases, 1, false, reference);
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    std::vector<nn_workflow_item_t *> items;
+    auto create_item = [&](nn_workflow_item_t *input_item, NN_WORK_ITEM_TYPE type, nn_output_format format) {
+        nn_workflow_item_t *item = nullptr;
+        nn_workflow_use_descriptor_t descriptor = { input_item, 0 };
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&item, input_item ? 1 : 0, input_item ? &descriptor : nullptr, 1));
+        item->type = type;
+        item->output_format[0] = format;
+        items.push_back(item);
+        return item;
+    };
+    auto set_convolution = [](nn_workflow_item_t *item, nn_data_t *weights, nn_data_t *biases, uint32_t center_offset, NN_ACTIVATION_FUNCTION function) {
+        auto &args = item->arguments.forward_convolution;
+        args.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+        args.activation.function = function;
+        args.weights = weights;
+        args.biases = biases;
+        args.center_offset[0] = center_offset;
+        args.center_offset[1] = center_offset;
+        args.stride[0] = 1;
+        args.stride[1] = 1;
+    };
+
+    auto input = create_item(nullptr, NN_WORK_ITEM_TYPE_INPUT, nn::output_format{ size_x, size_y, size_z });
+    input->arguments.input.index = 0;
+
+    auto conv = create_item(input, NN_WORK_ITEM_TYPE_CONVOLUTION, nn::output_format{ conv_x, conv_y, feats });
+    set_convolution(conv, &conv_weights, &conv_biases, 0, NN_ACTIVATION_FUNCTION_RELU);
+
+    auto norm = create_item(conv, NN_WORK_ITEM_TYPE_NORMALIZATION, nn::output_format{ conv_x, conv_y, feats });
+    auto &norm_args = norm->arguments.forward_normalization;
+    norm_args.normalization.mode = NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS;
+    norm_args.normalization.alpha = alpha;
+    norm_args.normalization.beta = beta;
+    norm_args.normalization.k = k;
+    norm_args.normalization.n = n;
+
+    auto pool = create_item(norm, NN_WORK_ITEM_TYPE_POOLING, nn::output_format{ pooled_x, pooled_y, feats });
+    auto &pool_args = pool->arguments.forward_pooling;
+    pool_args.mode = NN_POOLING_MODE_MAX;
+    pool_args.size[0] = 3;
+    pool_args.size[1] = 3;
+    pool_args.stride[0] = 2;
+    pool_args.stride[1] = 2;
+
+    auto conv_out = create_item(pool, NN_WORK_ITEM_TYPE_CONVOLUTION, nn::output_format{ pooled_x, pooled_y, out_feats });
+    set_convolution(conv_out, &out_weights, &out_biases, 1, NN_ACTIVATION_FUNCTION_NONE);
+
+    auto output = create_item(conv_out, NN_WORK_ITEM_TYPE_OUTPUT, nn::output_format{ pooled_x, pooled_y, out_feats });
+    output->arguments.output.index = 0;
+
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    nn_workload_t *workload = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+    auto &order_of_execution = static_cast<nn_workload_opaque_t *>(workload)->order_of_execution;
+    EXPECT_EQ(1, std::count_if(order_of_execution.begin(), order_of_execution.end(), [](nn_workload_item_t *item) {
+        return dynamic_cast<layer::convolution_normalization_pooling_f32 *>(item->primitive) != nullptr; }));
+    EXPECT_TRUE(std::none_of(order_of_execution.begin(), order_of_execution.end(), [](nn_workload_item_t *item) {
+        return item->type == NN_WORK_ITEM_TYPE_NORMALIZATION || item->type == NN_WORK_ITEM_TYPE_POOLING; }));
+
+    nn::data<float, 4> out(out_feats, pooled_x, pooled_y, batch);
+    NN_API_STATUS status;
+    nn_data_t *in_ptr = &in;
+    nn_data_t *out_ptr = &out;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+    EXPECT_EQ(NN_API_WORK_FINISHED, status);
+
+    for (uint32_t b = 0; b < batch; ++b)
+        for (uint32_t y = 0; y < pooled_y; ++y)
+            for (uint32_t x = 0; x < pooled_x; ++x)
+                for (uint32_t o = 0; o < out_feats; ++o)
+                    ASSERT_NEAR(reference(o, x, y, b), out(o, x, y, b), 1e-3f * std::max(1.0f, std::abs(reference(o, x, y, b))))
+                        << "at " << o << " " << x << " " << y << " " << b;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+    for (auto item = items.rbegin(); item != items.rend(); ++item)
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(*item));
+
+    test_teardown(device_description, device_interface_0);
+}
+
+// fused primitive on device with four threads splits bands of images between jobs, result of each call has to be
+// the same as of merged primitives run one after another; second call runs in tiles kept from first one
+TEST(cpu_convolution_normalization_pooling, jobs_of_threads_match_separate_primitives)
+{
+    const uint32_t batch = 3, size_x = 17, size_y = 15, size_z = 4;
+    const uint32_t feats = 16, conv_x = size_x - 2, conv_y = size_y - 2, pooled_x = 7, pooled_y = 6;
+    const nn_argument_activation_t relu = { NN_ACTIVATION_FUNCTION_RELU };
+
+    nn_device_internal device(4);
+    auto create_convolution = [&]() {
+        return std::unique_ptr<layer::convolution_f32>(new layer::convolution_f32(
+            3, 3, size_z, feats, conv_x, conv_y, 0, 0, 1, 1, relu, batch, 0, 0, 0, 0, &device));
+    };
+    auto create_normalization = [&]() {
+        return std::unique_ptr<layer::normalization_response_across_maps_f32>(new layer::normalization_response_across_maps_f32(
+            0.01f, 0.75f, 1, 5, conv_x, conv_y, feats, batch, 0, 0, 0, 0, &device));
+    };
+    auto create_pooling = [&]() {
+        return std::unique_ptr<layer::pooling_f32>(new layer::pooling_f32(
+            NN_POOLING_MODE_MAX, 3, 3, 2, 2, feats, pooled_x, pooled_y, 0, 0, batch, 1, 1, 1, 1, &device));
+    };
+
+    auto convolution = create_convolution();
+    auto normalization = create_normalization();
+    auto pooling = create_pooling();
+    layer::convolution_normalization_pooling_f32 fused(create_convolution(), create_normalization(), create_pooling());
+
+    auto input = convolution->create_inputs();
+    auto parameters = convolution->create_parameters();
+    auto convolved = convolution->create_outputs();
+    auto normalized = normalization->create_outputs();
+    auto reference = pooling->create_outputs();
+    auto output = fused.create_outputs();
+
+    std::mt19937 engine(7);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (auto data : { input[0], parameters[0], parameters[1] })
+    {
+        auto buffer = static_cast<float *>(data->parent->data_buffer);
+        std::generate(buffer, buffer + data->parent->buffer_size / sizeof(float), [&]() { return distribution(engine); });
+    }
+
+    // primitives are run through interface common to all of them, as in workload
+    static_cast<nn_primitive_t *>(convolution.get())->forward({ input[0] }, { parameters[0], parameters[1] }, convolved);
+    static_cast<nn_primitive_t *>(normalization.get())->forward({ convolved[0] }, {}, normalized);
+    static_cast<nn_primitive_t *>(pooling.get())->forward({ normalized[0] }, {}, reference);
+
+    const auto expected = static_cast<float *>(reference[0]->parent->data_buffer);
+    const auto size = reference[0]->parent->buffer_size / sizeof(float);
+    ASSERT_EQ(reference[0]->parent->buffer_size, output[0]->parent->buffer_size);
+    for (auto call = 0; call < 2; ++call)
+    {
+        auto actual = static_cast<float *>(output[0]->parent->data_buffer);
+        std::fill(actual, actual + size, 0.0f);
+        fused.forward({ input[0] }, { parameters[0], parameters[1] }, output);
+
+        for (size_t index = 0; index < size; ++index)
+            ASSERT_NEAR(expected[index], actual[index], 1e-5f * std::max(1.0f, std::abs(expected[index])))
+                << "call " << call << " at " << index;
+    }
+
+    for (auto data : { input, parameters, convolved, normalized, reference, output })
+        for (auto item : data)
+            delete nn::workload_data_cast<>(item);
+}
@@ -371,7 +371,7 @@ namespace
   
         // Call droput forward
         nn_event_t dropout = primitives.forward_async(
-            primitive, 3, input_internal, 0, nullptr, 1, &output_internal, 1, copy_inputs_done, nullptr);
+            primitive, 3, input_internal, 0, nullptr, 1, &output_internal, 3, copy_inputs_done, nullptr);
 
         // Get output
         nn_event_t output_ready = primitives.copy_from_opaque_async(device, &output, output_internal, 1, &dropout, nullptr);
@@ -0,0 +1,303 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "device/api/nn_device_api.h"
+#include "device/common/nn_workload_data.h"
+#include "device/api/nn_device_interface_0.h"
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+
+#include <random>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace {
+    void test_setup(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+        // load device & validate it has 0 as a startin interface version
+        nn_device_load(&device_description);
+        EXPECT_EQ(device_description.version_first, 0);
+        // open interface 0
+        EXPECT_EQ(0, nn_device_interface_open(0, &device_interface_0));
+    }
+
+    void test_teardown(nn_device_description_t &device_description, nn_device_interface_0_t &device_interface_0) {
+        // close interface 0
+        EXPECT_EQ(0, nn_device_interface_close(&device_interface_0));
+        // unload device
+        EXPECT_EQ(0, nn_device_unload());
+    }
+
+    // symmetric per output channel quantization to 7 bits, output is the last dimension of weights
+    void quantize_weights(const nn_data_t &weights, nn_data_t &weights_int8, std::vector<float> &scales) {
+        const auto num_output = weights.size[weights.dimension - 1];
+        const auto output_size = nn_data_buffer_size_ptr(1, weights.dimension, weights.size) / num_output;
+        auto src = static_cast<const float *>(weights.buffer);
+        auto dst = static_cast<int8_t *>(weights_int8.buffer);
+        scales.resize(num_output);
+        for (auto o = 0u; o < num_output; ++o) {
+            float max_abs = 0.0f;
+            for (auto i = 0u; i < output_size; ++i)
+                max_abs = std::max(max_abs, std::abs(src[o * output_size + i]));
+            scales[o] = max_abs > 0.0f ? 64.0f / max_abs : 1.0f;
+            for (auto i = 0u; i < output_size; ++i)
+                dst[o * output_size + i] = static_cast<int8_t>(std::lround(src[o * output_size + i] * scales[o]));
+        }
+    }
+
+    uint8_t saturate_u8(double value) {
+        return static_cast<uint8_t>(std::min(255.0, std::max(0.0, std::round(value))));
+    }
+} // namespace
+
+// input -> convert to uint8 -> convolution 3x3 with ReLU -> max pooling 3x3/2 -> LRN -> fully connected with ReLU ->
+// fully connected with float output -> output; compared against quantized naive computation
+TEST(cpu_int8_compilation, convolution_pooling_lrn_fully_connected)
+{
+    const uint32_t batch = 2, size_x = 13, size_y = 13, size_z = 4;
+    const uint32_t conv_feats = 32, conv_x = size_x - 2, conv_y = size_y - 2;
+    const uint32_t pool_x = (conv_x - 3) / 2 + 1, pool_y = (conv_y - 3) / 2 + 1;
+    const uint32_t fc1_feats = 40, fc2_feats = 10;
+
+    const float input_scale = 40.0f, conv_scale = 30.0f, fc1_scale = 12.0f;
+    const uint8_t input_zero_point = 128;
+    const uint32_t lrn_k = 1, lrn_n = 5;
+    const float lrn_alpha = 0.0001f, lrn_beta = 0.75f;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomize = [&](nn_data_t &data, float range) {
+        for (auto index = 0u; index < nn_data_buffer_size_ptr(1, data.dimension, data.size); ++index)
+            static_cast<float *>(data.buffer)[index] = distribution(generator) * range;
+    };
+
+    nn::data<float, 4> conv_weights(3, 3, size_z, conv_feats), fc1_weights(pool_x, pool_y, conv_feats, fc1_feats);
+    nn::data<float, 2> fc2_weights(fc1_feats, fc2_feats);
+    nn::data<float, 1> conv_biases(conv_feats), fc1_biases(fc1_feats), fc2_biases(fc2_feats);
+    randomize(conv_weights, 1.0f);
+    randomize(conv_biases, 1.0f);
+    randomize(fc1_weights, 0.1f);
+    randomize(fc1_biases, 1.0f);
+    randomize(fc2_weights, 1.0f);
+    randomize(fc2_biases, 1.0f);
+
+    nn::data<int8_t, 4> conv_weights_int8(3, 3, size_z, conv_feats), fc1_weights_int8(pool_x, pool_y, conv_feats, fc1_feats);
+    nn::data<int8_t, 2> fc2_weights_int8(fc1_feats, fc2_feats);
+    std::vector<float> conv_scales, fc1_scales, fc2_scales;
+    quantize_weights(conv_weights, conv_weights_int8, conv_scales);
+    quantize_weights(fc1_weights, fc1_weights_int8, fc1_scales);
+    quantize_weights(fc2_weights, fc2_weights_int8, fc2_scales);
+    nn::data<float, 1> conv_weights_scale(conv_scales.data(), conv_feats), fc1_weights_scale(fc1_scales.data(), fc1_feats),
+        fc2_weights_scale(fc2_scales.data(), fc2_feats);
+
+    nn::data<float, 4> in(size_z, size_x, size_y, batch);
+    randomize(in, 1.0f);
+
+    // naive quantized reference
+    std::vector<float> reference(fc2_feats * batch);
+    for (auto n = 0u; n < batch; ++n) {
+        std::vector<uint8_t> input_u8(size_x * size_y * size_z);
+        for (auto y = 0u; y < size_y; ++y)
+            for (auto x = 0u; x < size_x; ++x)
+                for (auto z = 0u; z < size_z; ++z)
+                    input_u8[z + size_z * (x + size_x * y)] = saturate_u8(in(z, x, y, n) * input_scale + input_zero_point);
+
+        std::vector<uint8_t> conv(conv_x * conv_y * conv_feats);
+        for (auto y = 0u; y < conv_y; ++y)
+            for (auto x = 0u; x < conv_x; ++x)
+                for (auto o = 0u; o < conv_feats; ++o) {
+                    int64_t acc = 0;
+                    for (auto ky = 0u; ky < 3; ++ky)
+                        for (auto kx = 0u; kx < 3; ++kx)
+                            for (auto i = 0u; i < size_z; ++i)
+                                acc += conv_weights_int8(kx, ky, i, o) *
+                                       (input_u8[i + size_z * (x + kx + size_x * (y + ky))] - input_zero_point);
+                    conv[o + conv_feats * (x + conv_x * y)] =
+                        saturate_u8(acc * conv_scale / (input_scale * conv_scales[o]) + conv_biases(o) * conv_scale);
+                }
+
+        std::vector<uint8_t> pool(pool_x * pool_y * conv_feats, 0);
+        for (auto y = 0u; y < pool_y; ++y)
+            for (auto x = 0u; x < pool_x; ++x)
+                for (auto z = 0u; z < conv_feats; ++z)
+                    for (auto py = 0u; py < 3; ++py)
+                        for (auto px = 0u; px < 3; ++px)
+                            pool[z + conv_feats * (x + pool_x * y)] = std::max(
+                                pool[z + conv_feats * (x + pool_x * y)], conv[z + conv_feats * (x * 2 + px + conv_x * (y * 2 + py))]);
+
+        std::vector<uint8_t> lrn(pool.size());
+        for (auto pixel = 0u; pixel < pool_x * pool_y; ++pixel)
+            for (auto z = 0u; z < conv_feats; ++z) {
+                double sum = 0.0;
+                for (auto j = std::max<int>(0, z - lrn_n / 2); j <= std::min<int>(conv_feats - 1, z + lrn_n / 2); ++j) {
+                    const double value = pool[j + conv_feats * pixel] / conv_scale;
+                    sum += value * value;
+                }
+                const double value = pool[z + conv_feats * pixel] / conv_scale;
+                lrn[z + conv_feats * pixel] = saturate_u8(value * std::pow(lrn_k + lrn_alpha * sum, -lrn_beta) * conv_scale);
+            }
+
+        std::vector<uint8_t> fc1(fc1_feats);
+        for (auto o = 0u; o < fc1_feats; ++o) {
+            int64_t acc = 0;
+            for (auto y = 0u; y < pool_y; ++y)
+                for (auto x = 0u; x < pool_x; ++x)
+                    for (auto z = 0u; z < conv_feats; ++z)
+                        acc += fc1_weights_int8(x, y, z, o) * lrn[z + conv_feats * (x + pool_x * y)];
+            fc1[o] = saturate_u8(acc * fc1_scale / (conv_scale * fc1_scales[o]) + fc1_biases(o) * fc1_scale);
+        }
+
+        for (auto o = 0u; o < fc2_feats; ++o) {
+            int64_t acc = 0;
+            for (auto i = 0u; i < fc1_feats; ++i)
+                acc += fc2_weights_int8(i, o) * fc1[i];
+            reference[o + fc2_feats * n] = static_cast<float>(acc / (fc1_scale * fc2_scales[o]) + fc2_biases(o));
+        }
+    }
+
+    nn_device_description_t device_description;
+    nn_device_interface_0_t device_interface_0;
+    test_setup(device_description, device_interface_0);
+
+    // shorter name for function calls
+    nn_device_interface_0_t &di = device_interface_0;
+
+    nn_workflow_t *workflow = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+    nn_workflow_item_t *input = nullptr, *convert = nullptr, *conv = nullptr, *pooling = nullptr, *norm = nullptr,
+                       *fc1 = nullptr, *fc2 = nullptr, *output = nullptr;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+    input->type = NN_WORK_ITEM_TYPE_INPUT;
+    input->arguments.input.index = 0;
+    input->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_convert = { input, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&convert, 1, &desc_convert, 1));
+    convert->type = NN_WORK_ITEM_TYPE_CONVERT_FLOAT_TO_UINT8;
+    convert->arguments.forward_convert_float_to_uint8.output_scale = input_scale;
+    convert->arguments.forward_convert_float_to_uint8.output_zero_point = input_zero_point;
+    convert->output_format[0] = nn::output_format{ size_x, size_y, size_z };
+
+    nn_workflow_use_descriptor_t desc_conv = { convert, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&conv, 1, &desc_conv, 1));
+    conv->type = NN_WORK_ITEM_TYPE_CONVOLUTION_INT8;
+    auto &conv_args = conv->arguments.forward_convolution_int8;
+    conv_args.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+    conv_args.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    conv_args.weights = &conv_weights_int8;
+    conv_args.biases = &conv_biases;
+    conv_args.center_offset[0] = 0;
+    conv_args.center_offset[1] = 0;
+    conv_args.stride[0] = 1;
+    conv_args.stride[1] = 1;
+    conv_args.quantization = { input_scale, input_zero_point, conv_scale, &conv_weights_scale };
+    conv->output_format[0] = nn::output_format{ conv_x, conv_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_pooling = { conv, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&pooling, 1, &desc_pooling, 1));
+    pooling->type = NN_WORK_ITEM_TYPE_MAX_POOLING_INT8;
+    auto &pooling_args = pooling->arguments.forward_pooling_fixedpoint;
+    pooling_args.pool_size[0] = 3;
+    pooling_args.pool_size[1] = 3;
+    pooling_args.pool_stride[0] = 2;
+    pooling_args.pool_stride[1] = 2;
+    pooling_args.mode = NN_POOLING_MODE_MAX;
+    pooling->output_format[0] = nn::output_format{ pool_x, pool_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_norm = { pooling, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&norm, 1, &desc_norm, 1));
+    norm->type = NN_WORK_ITEM_TYPE_NORMALIZATION_RESPONSE_ACROSS_MAPS_INT8;
+    norm->arguments.normalization_response_across_maps_int8 = { lrn_alpha, lrn_beta, lrn_k, lrn_n, conv_scale, conv_scale };
+    norm->output_format[0] = nn::output_format{ pool_x, pool_y, conv_feats };
+
+    nn_workflow_use_descriptor_t desc_fc1 = { norm, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fc1, 1, &desc_fc1, 1));
+    fc1->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8;
+    auto &fc1_args = fc1->arguments.forward_fully_connected_int8;
+    fc1_args.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+    fc1_args.weights = &fc1_weights_int8;
+    fc1_args.biases = &fc1_biases;
+    fc1_args.quantization = { conv_scale, 0, fc1_scale, &fc1_weights_scale };
+    fc1->output_format[0] = nn::output_format{ fc1_feats };
+
+    nn_workflow_use_descriptor_t desc_fc2 = { fc1, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fc2, 1, &desc_fc2, 1));
+    fc2->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED_INT8_F32;
+    auto &fc2_args = fc2->arguments.forward_fully_connected_int8;
+    fc2_args.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+    fc2_args.weights = &fc2_weights_int8;
+    fc2_args.biases = &fc2_biases;
+    fc2_args.quantization = { fc1_scale, 0, 1.0f, &fc2_weights_scale };
+    fc2->output_format[0] = nn::output_format{ fc2_feats };
+
+    nn_workflow_use_descriptor_t desc_out = { fc2, 0 };
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc_out, 1));
+    output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+    output->arguments.output.index = 0;
+    output->output_format[0] = nn::output_format{ fc2_feats };
+
+    workflow->input[0] = input;
+    workflow->output[0] = output;
+
+    NN_WORKLOAD_DATA_TYPE input_format = NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH;
+    NN_WORKLOAD_DATA_TYPE output_format = NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH;
+    nn_workload_t *workload = nullptr;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_compile_function(&workload, di.device, workflow, &input_format, &output_format, batch));
+
+    nn::data<float, 2> out(fc2_feats, batch);
+    NN_API_STATUS status;
+    nn::data<float, 4> *in_ptr = &in;
+    nn::data<float, 2> *out_ptr = &out;
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_execute_function(workload, (void **)&in_ptr, (void **)&out_ptr, &status));
+    EXPECT_EQ(NN_API_WORK_FINISHED, status);
+    EXPECT_EQ(NN_API_STATUS_OK, di.workload_delete_function(workload));
+
+    // rounding of intermediate uint8 values may differ by 1 between float and double requantization
+    float max_reference = 0.0f;
+    for (auto value : reference)
+        max_reference = std::max(max_reference, std::abs(value));
+    for (auto n = 0u; n < batch; ++n)
+        for (auto o = 0u; o < fc2_feats; ++o)
+            EXPECT_NEAR(reference[o + fc2_feats * n], out(o, n), 0.02f * max_reference) << "n: " << n << " o: " << o;
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fc2));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fc1));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(norm));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(pooling));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(conv));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(convert));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+    test_teardown(device_description, device_interface_0);
+}
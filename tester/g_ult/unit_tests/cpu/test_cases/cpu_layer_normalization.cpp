@@ -326,3 +326,37 @@ TEST(cpu_normalization_artificial_localresponse, cpu_normalization_view)
         }
     }
 }
+
+TEST(cpu_normalization_artificial_localresponse, cpu_normalization_beta)
+{
+    // 0.5 and 1.0 have dedicated forms, other exponents are computed from logarithm and exponent
+    float b_coeffs[] = { 0.5f, 1.0f, 0.6f, 1.5f };
+    uint32_t batches[] = { 1, 8 };
+    for (auto b_coeff : b_coeffs)
+    {
+        for (auto batch : batches)
+        {
+            for (uint32_t input_sizes_z = 8; input_sizes_z <= 32; input_sizes_z += 8)
+            {
+                for (uint32_t k_coeff = 1; k_coeff <= 2; ++k_coeff)
+                {
+                    for (uint32_t n_coeff = 3; n_coeff <= 5; n_coeff += 2)
+                    {
+                        EXPECT_EQ(true,
+                                  ult_perform_test<layer::normalization_response_across_maps_f32>(
+                                      3,             // input/output width
+                                      2,             // input/output height
+                                      input_sizes_z, // input/output depth
+                                      2.0f,          // A coefficient
+                                      b_coeff,       // B coefficient
+                                      n_coeff,       // N coefficient
+                                      k_coeff,       // K coefficient
+                                      batch,         // batch size
+                                      true           // check views
+                                      )) << "beta " << b_coeff;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -445,3 +445,19 @@ TEST(cpu_normalization_artificial_linear_latency, cpu_normalization_lnr_base)
 }
 
 
+
+TEST(cpu_normalization_artificial_linear_latency, cpu_normalization_lnr_beta)
+{
+    for (auto coeff_beta : { 0.5f, 1.0f, 0.6f })
+        EXPECT_EQ(true, ult_perform_test(
+            2,                                 //batch_size
+            5,                                 //feature_map_width
+            3,                                 //feature_map_height
+            32,                                //num_feature_maps
+            0.0001f,                           //coeff_alpha
+            coeff_beta,                        //coeff_beta
+            2,                                 //coeff_k
+            8,                                 //input_fraction
+            8,                                 //output_fraction
+            NN_NORMALIZATION_MODE_RESPONSE_ACROSS_MAPS)) << "beta " << coeff_beta;
+}
@@ -114,6 +114,7 @@ static bool ult_perform_test(
     // cleanup
     primitives.delete_event(output_ready);
     primitives.delete_event(relu);
+    primitives.delete_event(input_ready);
     primitives.delete_opaque_data(input_internal);
     primitives.delete_opaque_data(output_internal);
     primitives.delete_primitive(primitive);
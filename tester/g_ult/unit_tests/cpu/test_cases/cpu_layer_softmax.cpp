@@ -240,3 +240,15 @@ TEST(cpu_softmax_artificial, cpu_softmax_base)
                 batch          // batch size
                 ));
 }
+
+TEST(cpu_softmax_artificial, cpu_softmax_odd_batches_and_wide_outputs)
+{
+    uint32_t batches[] = { 1, 3, 13, 24 };
+    uint32_t input_sizes[] = { 1000, 1999 };
+    for (auto batch : batches)
+        for (auto input_size : input_sizes)
+            EXPECT_EQ(true, ult_perform_test(
+                input_size,    // input/output width
+                batch          // batch size
+                ));
+}
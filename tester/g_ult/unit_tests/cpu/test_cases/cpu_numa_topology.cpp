@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_numa_topology.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+TEST(cpu_numa_topology, parse_cpu_list)
+{
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}), nn_parse_cpu_list("0-3,8,10-11\n"));
+    EXPECT_EQ(std::vector<uint32_t>({5}), nn_parse_cpu_list("5"));
+    EXPECT_TRUE(nn_parse_cpu_list("").empty());
+    EXPECT_THROW(nn_parse_cpu_list("3-1"), std::runtime_error);
+}
+
+TEST(cpu_numa_topology, nodes_cover_allowed_cpus)
+{
+    auto nodes = nn_numa_nodes();
+    ASSERT_LE(1u, nodes.size());
+    for (auto &node : nodes)
+        EXPECT_FALSE(node.cpus.empty()) << "node: " << node.id;
+}
+
+TEST(cpu_numa_topology, worker_groups)
+{
+    std::vector<nn_numa_node> nodes{{0, {0, 1, 2, 3}}, {1, {4, 5, 6, 7}}};
+
+    // group per node
+    auto groups = nn_numa_worker_groups(nodes, 2);
+    ASSERT_EQ(2u, groups.size());
+    EXPECT_EQ(nodes[0].cpus, groups[0]);
+    EXPECT_EQ(nodes[1].cpus, groups[1]);
+
+    // nodes split between groups assigned round robin
+    groups = nn_numa_worker_groups(nodes, 4);
+    ASSERT_EQ(4u, groups.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 1}), groups[0]);
+    EXPECT_EQ(std::vector<uint32_t>({4, 5}), groups[1]);
+    EXPECT_EQ(std::vector<uint32_t>({2, 3}), groups[2]);
+    EXPECT_EQ(std::vector<uint32_t>({6, 7}), groups[3]);
+
+    // groups share node with fewer CPUs than groups
+    groups = nn_numa_worker_groups({{0, {0}}}, 2);
+    ASSERT_EQ(2u, groups.size());
+    EXPECT_EQ(std::vector<uint32_t>({0}), groups[0]);
+    EXPECT_EQ(std::vector<uint32_t>({0}), groups[1]);
+}
+
+TEST(cpu_numa_topology, cores_cover_given_cpus)
+{
+    auto nodes = nn_numa_nodes();
+    ASSERT_LE(1u, nodes.size());
+
+    std::vector<uint32_t> cpus;
+    for (auto &core : nn_cpu_cores(nodes[0].cpus))
+    {
+        ASSERT_FALSE(core.cpus.empty());
+        cpus.insert(cpus.end(), core.cpus.begin(), core.cpus.end());
+    }
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(nodes[0].cpus, cpus);
+}
+
+TEST(cpu_numa_topology, thread_placement)
+{
+    std::vector<nn_cpu_core> cores{{{0, 4}}, {{1, 5}}, {{2, 6}}, {{3, 7}}};
+
+    // separate cores, siblings of used cores left for secondary workers
+    auto placement = nn_place_threads(cores, 2);
+    EXPECT_EQ(std::vector<uint32_t>({0, 1}), placement.primary);
+    EXPECT_EQ(std::vector<uint32_t>({4, 5}), placement.secondary);
+
+    // more workers than cores take siblings
+    placement = nn_place_threads(cores, 6);
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 3, 4, 5}), placement.primary);
+    EXPECT_EQ(std::vector<uint32_t>({6, 7}), placement.secondary);
+
+    // and wrap around when there are more workers than CPUs
+    placement = nn_place_threads({{{0}}, {{1}}}, 3);
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 0}), placement.primary);
+    EXPECT_TRUE(placement.secondary.empty());
+}
@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/cpu_device_internal.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// job of given number of requests, each counting its runs
+struct counting_job
+{
+    explicit counting_job(size_t count)
+        : runs(count)
+        , requests(count)
+    {
+        for (auto &run : runs)
+            run = 0;
+        for (size_t index = 0; index < count; ++index)
+            requests[index] = {[](void *run) { ++*static_cast<std::atomic<uint32_t> *>(run); }, &runs[index]};
+    }
+
+    uint32_t requests_not_run_once() const
+    {
+        uint32_t result = 0;
+        for (auto &run : runs)
+            if (run != 1)
+                ++result;
+        return result;
+    }
+
+    std::vector<std::atomic<uint32_t>> runs;
+    std::vector<nn_multithreaded_request> requests;
+};
+} //namespace
+
+TEST(cpu_thread_pool, each_request_run_once)
+{
+    nn_thread_worker_pool thread_pool(4);
+    for (auto count : {1u, 3u, 4u, 64u, 1000u})
+        for (uint32_t job = 0; job < 20; ++job)
+        {
+            counting_job requests(count);
+            thread_pool.push_job(requests.requests);
+            EXPECT_EQ(0u, requests.requests_not_run_once()) << "requests: " << count;
+        }
+}
+
+TEST(cpu_thread_pool, nested_requests_stolen_by_idle_workers)
+{
+    // nested job is queued on deque of worker that pushed it, each of its requests waits
+    // until some other thread has run one - so job completes only if other workers steal
+    nn_thread_worker_pool thread_pool(4);
+
+    std::mutex threads_mutex;
+    std::set<std::thread::id> threads;
+    auto seen_threads = [&]() {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        return threads.size();
+    };
+
+    std::vector<nn_multithreaded_request> inner(8);
+    for (auto &request : inner)
+        request = {[&](void *) {
+                       {
+                           std::lock_guard<std::mutex> lock(threads_mutex);
+                           threads.insert(std::this_thread::get_id());
+                       }
+                       auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                       while (seen_threads() < 2 && std::chrono::steady_clock::now() < deadline)
+                           std::this_thread::yield();
+                   },
+                   nullptr};
+
+    std::vector<nn_multithreaded_request> outer(1);
+    outer[0] = {[&](void *) { thread_pool.push_job(inner); }, nullptr};
+    thread_pool.push_job(outer);
+    EXPECT_LE(2u, seen_threads());
+}
+
+TEST(cpu_thread_pool, exception_of_request_rethrown_by_push_job)
+{
+    nn_thread_worker_pool thread_pool(4);
+    for (auto throwing : {0u, 5u, 31u})
+    {
+        counting_job requests(32);
+        requests.requests[throwing].callback = [](void *) { throw std::runtime_error("request failed"); };
+        EXPECT_THROW(thread_pool.push_job(requests.requests), std::runtime_error);
+
+        // remaining requests are run anyway, workers survive
+        requests.runs[throwing] = 1;
+        EXPECT_EQ(0u, requests.requests_not_run_once());
+    }
+
+    counting_job requests(32);
+    thread_pool.push_job(requests.requests);
+    EXPECT_EQ(0u, requests.requests_not_run_once());
+}
+
+TEST(cpu_thread_pool, low_latency_each_request_run_once)
+{
+    nn_thread_worker_pool thread_pool(4);
+    thread_pool.set_spin_time(std::chrono::microseconds(200));
+    EXPECT_EQ(std::chrono::nanoseconds(200000), thread_pool.get_spin_time());
+
+    for (auto count : {1u, 3u, 4u, 64u})
+        for (uint32_t job = 0; job < 50; ++job)
+        {
+            counting_job requests(count);
+            thread_pool.push_job(requests.requests);
+            EXPECT_EQ(0u, requests.requests_not_run_once()) << "requests: " << count;
+        }
+}
+
+TEST(cpu_thread_pool, low_latency_jobs_pushed_concurrently)
+{
+    // only one job is broadcast at a time, others go through queues of workers
+    nn_thread_worker_pool thread_pool(4);
+    thread_pool.set_spin_time(std::chrono::microseconds(200));
+
+    std::atomic<uint32_t> failures(0);
+    std::vector<std::thread> callers;
+    for (uint32_t caller = 0; caller < 3; ++caller)
+        callers.emplace_back([&]() {
+            for (uint32_t job = 0; job < 50; ++job)
+            {
+                counting_job requests(16);
+                thread_pool.push_job(requests.requests);
+                failures += requests.requests_not_run_once();
+            }
+        });
+    for (auto &caller : callers)
+        caller.join();
+    EXPECT_EQ(0u, failures.load());
+}
+
+TEST(cpu_thread_pool, low_latency_nested_jobs)
+{
+    nn_thread_worker_pool thread_pool(4);
+    thread_pool.set_spin_time(std::chrono::microseconds(200));
+
+    std::atomic<uint32_t> failures(0);
+    std::vector<nn_multithreaded_request> outer(8);
+    for (auto &request : outer)
+        request = {[&](void *) {
+                       counting_job requests(8);
+                       thread_pool.push_job(requests.requests);
+                       failures += requests.requests_not_run_once();
+                   },
+                   nullptr};
+    thread_pool.push_job(outer);
+    EXPECT_EQ(0u, failures.load());
+}
+
+TEST(cpu_thread_pool, low_latency_exception_of_request_rethrown_by_push_job)
+{
+    nn_thread_worker_pool thread_pool(4);
+    thread_pool.set_spin_time(std::chrono::microseconds(200));
+    for (auto throwing : {0u, 7u, 15u})
+    {
+        counting_job requests(16);
+        requests.requests[throwing].callback = [](void *) { throw std::runtime_error("request failed"); };
+        EXPECT_THROW(thread_pool.push_job(requests.requests), std::runtime_error);
+
+        requests.runs[throwing] = 1;
+        EXPECT_EQ(0u, requests.requests_not_run_once());
+    }
+
+    // next broadcast job neither waits for failed one nor gets its exception
+    counting_job requests(16);
+    thread_pool.push_job(requests.requests);
+    EXPECT_EQ(0u, requests.requests_not_run_once());
+}
+
+TEST(cpu_thread_pool, low_latency_workers_parked_after_spin_time)
+{
+    // workers stop spinning and park, next job wakes them up
+    nn_thread_worker_pool thread_pool(4);
+    thread_pool.set_spin_time(std::chrono::microseconds(10));
+    for (uint32_t job = 0; job < 5; ++job)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        counting_job requests(32);
+        thread_pool.push_job(requests.requests);
+        EXPECT_EQ(0u, requests.requests_not_run_once());
+    }
+
+    // switching mode off between jobs
+    thread_pool.set_spin_time(std::chrono::nanoseconds(0));
+    counting_job requests(32);
+    thread_pool.push_job(requests.requests);
+    EXPECT_EQ(0u, requests.requests_not_run_once());
+}
+
+TEST(cpu_thread_pool, placement_modes)
+{
+    nn_thread_worker_pool thread_pool(4);
+    EXPECT_EQ(nn_thread_placement_mode::none, thread_pool.get_placement());
+    EXPECT_EQ(4u, thread_pool.get_num_threads_with_siblings());
+
+    for (auto mode : {nn_thread_placement_mode::physical_cores,
+                      nn_thread_placement_mode::siblings,
+                      nn_thread_placement_mode::none})
+    {
+        thread_pool.set_placement(mode);
+        EXPECT_EQ(mode, thread_pool.get_placement());
+        EXPECT_EQ(4u, thread_pool.get_num_threads());
+        EXPECT_LE(thread_pool.get_num_threads(), thread_pool.get_num_threads_with_siblings());
+
+        for (uint32_t job = 0; job < 20; ++job)
+        {
+            counting_job requests(24);
+            thread_pool.push_job(requests.requests);
+            EXPECT_EQ(0u, requests.requests_not_run_once());
+
+            counting_job sibling_requests(24);
+            thread_pool.push_job_with_siblings(sibling_requests.requests);
+            EXPECT_EQ(0u, sibling_requests.requests_not_run_once());
+        }
+    }
+}
@@ -0,0 +1,238 @@
+/*
+Copyright (c) 2015, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Intel Corporation nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "device/api/nn_device_api.h"
+#include "device/api/nn_device_interface_0.h"
+#include "device/common/nn_workload_data.h"
+#include "device/cpu/api_internal/nn_workflow_cost_model.h"
+
+namespace
+{
+    nn_device_interface_0_t load_device()
+    {
+        nn_device_description_t device_description;
+        nn_device_interface_0_t di;
+
+        EXPECT_EQ(0, nn_device_load(&device_description));
+        EXPECT_EQ(0, nn_device_interface_open(device_description.version_first, &di));
+
+        return di;
+    }
+
+    void unload_device(nn_device_interface_0_t* di)
+    {
+        EXPECT_EQ(0, nn_device_interface_close(di));
+        EXPECT_EQ(0, nn_device_unload());
+    }
+
+    // Returns metrics array of workflow: input -> convolution 3x3 -> fully connected -> softmax -> output.
+    nn_workflow_metrics_array_t* query_metrics(nn_device_interface_0_t& di, uint32_t conv_ofm)
+    {
+        nn::data<float, 4> conv_weights(3, 3, 8, conv_ofm);
+        nn::data<float, 1> conv_biases(conv_ofm);
+        nn::data<float, 4> fc_weights(14, 14, conv_ofm, 10);
+        nn::data<float, 1> fc_biases(10);
+
+        nn_workflow_t *workflow = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_create_function(&workflow, 1, 1));
+
+        nn_workflow_item_t *input = nullptr;
+        {
+            EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&input, 0, nullptr, 1));
+            input->type = NN_WORK_ITEM_TYPE_INPUT;
+            input->arguments.input.index = 0;
+            input->output_format[0] = nn::output_format{ 16, 16, 8 };
+        }
+
+        nn_workflow_item_t *convolution = nullptr;
+        {
+            nn_workflow_use_descriptor_t desc0 = { input, 0 };
+            EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&convolution, 1, &desc0, 1));
+            convolution->type = NN_WORK_ITEM_TYPE_CONVOLUTION;
+
+            auto& args = convolution->arguments.forward_convolution;
+            args.activation.function = NN_ACTIVATION_FUNCTION_RELU;
+            args.padding = NN_PADDING_MODE_DATA_OR_ZERO;
+            args.stride[0] = 1;
+            args.stride[1] = 1;
+            args.weights = &conv_weights;
+            args.biases = &conv_biases;
+
+            convolution->output_format[0] = nn::output_format{ 14, 14, conv_ofm };
+        }
+
+        nn_workflow_item_t *fully_connected = nullptr;
+        {
+            nn_workflow_use_descriptor_t desc0 = { convolution, 0 };
+            EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&fully_connected, 1, &desc0, 1));
+            fully_connected->type = NN_WORK_ITEM_TYPE_FULLY_CONNECTED;
+
+            auto& args = fully_connected->arguments.forward_fully_connected;
+            args.activation.function = NN_ACTIVATION_FUNCTION_NONE;
+            args.weights = &fc_weights;
+            args.biases = &fc_biases;
+
+            fully_connected->output_format[0] = nn::output_format{ 10 };
+        }
+
+        nn_workflow_item_t *softmax = nullptr;
+        {
+            nn_workflow_use_descriptor_t desc0 = { fully_connected, 0 };
+            EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&softmax, 1, &desc0, 1));
+            softmax->type = NN_WORK_ITEM_TYPE_SOFTMAX;
+            softmax->output_format[0] = nn::output_format{ 10 };
+        }
+
+        nn_workflow_item_t *output = nullptr;
+        {
+            nn_workflow_use_descriptor_t desc0 = { softmax, 0 };
+            EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_create_function(&output, 1, &desc0, 1));
+            output->type = NN_WORK_ITEM_TYPE_OUTPUT;
+            output->arguments.output.index = 0;
+            output->output_format[0] = nn::output_format{ 10 };
+        }
+
+        workflow->input[0] = input;
+        workflow->output[0] = output;
+
+        nn_workflow_metrics_array_t *array = nullptr;
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_metrics_query_function(&array, di.device, workflow));
+
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(input));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(convolution));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(fully_connected));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(softmax));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_item_delete_function(output));
+        EXPECT_EQ(NN_API_STATUS_OK, di.workflow_delete_function(workflow));
+
+        return array;
+    }
+
+    // Variant with given formats and batch, nullptr if not reported.
+    const nn_workflow_metrics_t* find_variant(const nn_workflow_metrics_array_t* array,
+                                              NN_WORKLOAD_DATA_TYPE input_format,
+                                              uint32_t batch)
+    {
+        for (auto entry = array->array; *entry != nullptr; ++entry)
+            if ((*entry)->input_format[0] == input_format && (*entry)->batch == batch)
+                return *entry;
+        return nullptr;
+    }
+}
+
+TEST(cpu_workflow_metrics, variants_sorted_by_time_per_image)
+{
+    auto di = load_device();
+
+    auto array = query_metrics(di, 16);
+    ASSERT_NE(nullptr, array);
+    EXPECT_EQ(1u, array->input_count);
+    EXPECT_EQ(1u, array->output_count);
+
+    auto count = 0u;
+    double previous = 0.0;
+    for (auto entry = array->array; *entry != nullptr; ++entry, ++count)
+    {
+        auto &metrics = **entry;
+        EXPECT_GT(metrics.batch, 0u);
+        EXPECT_EQ(NN_WORKLOAD_DATA_TYPE_F32_1D_BATCH, metrics.output_format[0]);
+        EXPECT_GT(metrics.metric[0], 0u);                   // time
+        EXPECT_GT(metrics.metric[1], 0u);                   // energy
+        EXPECT_GT(metrics.metric[2], 0u);                   // single thread time
+        EXPECT_GT(metrics.metric[3], 0u);                   // operations
+        EXPECT_GT(metrics.metric[4], 0u);                   // bytes
+        EXPECT_GT(metrics.metric[5], 0u);                   // threads
+        if (metrics.metric[5] == 1)
+        {
+            EXPECT_EQ(metrics.metric[2], metrics.metric[0]);
+        }
+
+        double time_per_image = static_cast<double>(metrics.metric[0]) / metrics.batch;
+        EXPECT_LE(previous, time_per_image);
+        previous = time_per_image;
+    }
+    EXPECT_GT(count, 0u);
+
+    // Input in XYZ layout is converted, so it costs more than ZXY.
+    auto zxy = find_variant(array, NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, 32);
+    auto xyz = find_variant(array, NN_WORKLOAD_DATA_TYPE_F32_3D_BATCH, 32);
+    ASSERT_NE(nullptr, zxy);
+    ASSERT_NE(nullptr, xyz);
+    EXPECT_LT(zxy->metric[4], xyz->metric[4]);
+
+    // Larger batch does proportionally more work.
+    auto small = find_variant(array, NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, 8);
+    ASSERT_NE(nullptr, small);
+    EXPECT_EQ(small->metric[3] * 4, zxy->metric[3]);
+
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_metrics_delete_function(array));
+
+    // Wider convolution needs more operations.
+    auto narrow = query_metrics(di, 16);
+    auto wide = query_metrics(di, 32);
+    ASSERT_NE(nullptr, narrow);
+    ASSERT_NE(nullptr, wide);
+    EXPECT_LT(find_variant(narrow, NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, 8)->metric[3],
+              find_variant(wide, NN_WORKLOAD_DATA_TYPE_F32_ZXY_BATCH, 8)->metric[3]);
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_metrics_delete_function(narrow));
+    EXPECT_EQ(NN_API_STATUS_OK, di.workflow_metrics_delete_function(wide));
+
+    unload_device(&di);
+}
+
+TEST(cpu_workflow_metrics, estimate_per_thread_count)
+{
+    nn_machine_model machine;
+    machine.flops_per_ns = 16.0;
+    machine.bytes_per_ns = 20.0;
+    machine.single_bytes_per_ns = 8.0;
+    machine.dispatch_ns = 3000.0;
+    machine.threads = 4;
+
+    // Compute bound item, roughly millisecond on single thread.
+    std::vector<nn_workflow_item_cost> compute = {{nullptr, 16000000, 100000, 1.0}};
+
+    auto single = nn_workflow_estimate_cost(compute, machine, 1);
+    auto dual = nn_workflow_estimate_cost(compute, machine, 2);
+    auto all = nn_workflow_estimate_cost(compute, machine, 4);
+    EXPECT_EQ(1u, single.threads);
+    EXPECT_EQ(2u, dual.threads);
+    EXPECT_EQ(4u, all.threads);
+    EXPECT_EQ(single.single_thread_time_ns, single.time_ns);
+    EXPECT_LT(dual.time_ns, single.time_ns);
+    EXPECT_LT(all.time_ns, dual.time_ns);
+
+    // Threads beyond pool are not modelled.
+    EXPECT_EQ(4u, nn_workflow_estimate_cost(compute, machine, 16).threads);
+
+    // Small item does not pay for dispatch to other threads.
+    std::vector<nn_workflow_item_cost> small = {{nullptr, 16000, 1000, 1.0}};
+    EXPECT_LT(nn_workflow_estimate_cost(small, machine, 1).time_ns,
+              nn_workflow_estimate_cost(small, machine, 4).time_ns);
+}
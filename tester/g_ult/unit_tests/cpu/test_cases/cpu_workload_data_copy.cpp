@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2014, Intel Corporation
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+* Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "device/cpu/api_internal/nn_device_interface_0_internal.h"
+#include "device/cpu/core/helper_workload_data_copy.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <memory>
+
+namespace
+{
+typedef nn::workload_data<> data_t;
+
+template <typename T>
+void fill(nn_workload_data_t &data, bool delta = false)
+{
+    std::mt19937 generator(1);
+    auto buffer = static_cast<T *>(delta ? data.parent->delta_buffer : data.parent->data_buffer);
+    for (uint32_t i = 0; i < data.parent->buffer_size / sizeof(T); ++i)
+        buffer[i] = static_cast<T>(generator() % 20000);
+}
+
+template <typename T>
+void check_equal(const nn_workload_data_t &destination, const nn_workload_data_t &source, bool delta = false)
+{
+    auto lengths = get_length(source);
+    uint32_t mismatches = 0;
+    for (uint32_t q = 0; q < lengths.t[NN_DATA_COORD_q]; ++q)
+    for (uint32_t p = 0; p < lengths.t[NN_DATA_COORD_p]; ++p)
+    for (uint32_t z = 0; z < lengths.t[NN_DATA_COORD_z]; ++z)
+    for (uint32_t y = 0; y < lengths.t[NN_DATA_COORD_y]; ++y)
+    for (uint32_t x = 0; x < lengths.t[NN_DATA_COORD_x]; ++x)
+    for (uint32_t n = 0; n < lengths.t[NN_DATA_COORD_n]; ++n)
+        if (delta ? nn_workload_data_get_delta<T>(&destination, n, x, y, z, p, q) != nn_workload_data_get_delta<T>(&source, n, x, y, z, p, q)
+                  : nn_workload_data_get<T>(&destination, n, x, y, z, p, q) != nn_workload_data_get<T>(&source, n, x, y, z, p, q))
+            ++mismatches;
+    EXPECT_EQ(0u, mismatches);
+}
+
+// copy between views of buffers with different layouts, both views cut out of bigger buffers
+template <typename T>
+void test_copy_views(const nn_workload_data_layout_t &source_layout, const nn_workload_data_layout_t &destination_layout)
+{
+    data_t source(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{11, 13, 5, 19, 2, 1}, source_layout);
+    data_t destination(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{10, 14, 7, 21, 2, 1}, destination_layout);
+    fill<T>(source);
+
+    data_t source_view(source, nn_workload_data_coords_t{1, 2, 0, 1, 0, 0}, nn_workload_data_coords_t{10, 12, 3, 18, 1, 0});
+    data_t destination_view(destination, nn_workload_data_coords_t{0, 1, 2, 3, 0, 0}, nn_workload_data_coords_t{9, 11, 5, 20, 1, 0});
+
+    EXPECT_EQ(NN_DATA_STATUS_OK, nn_workload_data_copy(&destination_view, &source_view));
+    check_equal<T>(destination_view, source_view);
+}
+} //namespace
+
+TEST(cpu_workload_data_copy, same_layout_without_views)
+{
+    auto &layout = nn::layout_t<nn::layout_zxynpq_f32>::layout;
+    data_t source(NN_WORKLOAD_DATA_TAG_ZXYN, nn_workload_data_coords_t{3, 7, 5, 17, 1, 1}, layout);
+    data_t destination(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{3, 7, 5, 17, 1, 1}, layout);
+    fill<float>(source);
+
+    EXPECT_EQ(NN_DATA_STATUS_OK, nn_workload_data_copy(&destination, &source));
+    check_equal<float>(destination, source);
+    EXPECT_EQ(NN_WORKLOAD_DATA_TAG_ZXYN, destination.parent->tag);
+}
+
+TEST(cpu_workload_data_copy, transposed_float_views)
+{
+    test_copy_views<float>(nn::layout_t<nn::layout_zxynpq_f32>::layout, nn::layout_t<nn::layout_nzxypq_f32>::layout);
+    test_copy_views<float>(nn::layout_t<nn::layout_nxyzpq_f32>::layout, nn::layout_t<nn::layout_pzxyqn_f32>::layout);
+}
+
+TEST(cpu_workload_data_copy, strided_views)
+{
+    test_copy_views<float>(nn::layout_t<nn::layout_zxynpq_f32>::layout, nn::layout_t<nn::layout_zxynpq_f32>::layout);
+    test_copy_views<int16_t>(nn::layout_t<nn::layout_zxynpq_i16>::layout, nn::layout_t<nn::layout_nxyzpq_i16>::layout);
+    test_copy_views<int32_t>(nn::layout_t<nn::layout_xyzpqn_i32>::layout, nn::layout_t<nn::layout_nxyzpq_i32>::layout);
+}
+
+TEST(cpu_workload_data_copy, delta)
+{
+    auto &layout = nn::layout_t<nn::layout_nxyzpq_f32>::layout;
+    data_t source(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{9, 4, 4, 3, 1, 1}, layout, false, true);
+    data_t destination(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{9, 4, 4, 3, 1, 1}, nn::layout_t<nn::layout_zxynpq_f32>::layout, false, true);
+    fill<float>(source, true);
+
+    EXPECT_EQ(NN_DATA_STATUS_OK, nn_workload_delta_copy(&destination, &source));
+    check_equal<float>(destination, source, true);
+}
+
+TEST(cpu_workload_data_copy, multithreaded)
+{
+    nn_thread_worker_pool thread_pool(4);
+
+    // Contiguous copy big enough to use streaming stores, then transposed one shared by threads.
+    auto &layout = nn::layout_t<nn::layout_zxynpq_f32>::layout;
+    data_t source(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{16, 56, 56, 64, 1, 1}, layout);
+    data_t destination(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{16, 56, 56, 64, 1, 1}, layout);
+    data_t transposed(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{16, 56, 56, 64, 1, 1}, nn::layout_t<nn::layout_nzxypq_f32>::layout);
+    fill<float>(source);
+
+    EXPECT_EQ(NN_DATA_STATUS_OK, layer::workload_data_copy(thread_pool, &destination, &source));
+    check_equal<float>(destination, source);
+
+    EXPECT_EQ(NN_DATA_STATUS_OK, layer::workload_data_copy(thread_pool, &transposed, &source));
+    check_equal<float>(transposed, source);
+}
+
+TEST(cpu_workload_data_copy, different_lengths)
+{
+    auto &layout = nn::layout_t<nn::layout_zxynpq_f32>::layout;
+    data_t source(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{1, 2, 2, 8, 1, 1}, layout);
+    data_t destination(NN_WORKLOAD_DATA_TAG_UNKNOWN, nn_workload_data_coords_t{1, 2, 2, 9, 1, 1}, layout);
+
+    EXPECT_THROW(nn_workload_data_copy(&destination, &source), std::runtime_error);
+}